@@ -0,0 +1,590 @@
+/*  Thread Pool (Work Stealing)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <thread>
+#include "Common/Cpp/PanicDump.h"
+#include "Common/Cpp/Concurrency/SpinPause.h"
+#include "AsyncTask_Default.h"
+#include "ThreadPool_WorkStealing.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+//
+//  Dispatched tasks are all the same size. Keep a small per-thread stash of
+//  freed ones so that steady-state dispatching doesn't go to the allocator.
+//
+namespace{
+
+struct TaskFreeList{
+    static constexpr size_t MAX_BLOCKS = 64;
+
+    size_t count = 0;
+    void* blocks[MAX_BLOCKS];
+
+    ~TaskFreeList();
+};
+
+//  Trivially destructible so it can still be read after "task_free_list" is
+//  gone during thread exit.
+thread_local bool task_free_list_dead = false;
+thread_local TaskFreeList task_free_list;
+
+TaskFreeList::~TaskFreeList(){
+    task_free_list_dead = true;
+    while (count > 0){
+        ::operator delete(blocks[--count]);
+    }
+}
+
+}
+
+
+
+class ThreadPool_WorkStealing::Task final : public AsyncTask_Cpp{
+public:
+    Task(ThreadPool_WorkStealing& pool, std::function<void()>&& func)
+        : AsyncTask_Cpp(std::move(func))
+        , m_pool(pool)
+    {}
+
+    virtual void run() noexcept override{
+        //  The owner is allowed to destroy us as soon as the base run()
+        //  returns. So don't touch "this" after that.
+        ThreadPool_WorkStealing& pool = m_pool;
+        AsyncTask_Cpp::run();
+        pool.task_finished();
+    }
+
+    static void* operator new(size_t bytes){
+        if (!task_free_list_dead){
+            TaskFreeList& list = task_free_list;
+            if (list.count > 0){
+                return list.blocks[--list.count];
+            }
+        }
+        return ::operator new(bytes);
+    }
+    static void operator delete(void* ptr) noexcept{
+        if (!task_free_list_dead){
+            TaskFreeList& list = task_free_list;
+            if (list.count < TaskFreeList::MAX_BLOCKS){
+                list.blocks[list.count++] = ptr;
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+
+private:
+    ThreadPool_WorkStealing& m_pool;
+};
+
+
+
+//
+//  One run_in_parallel() call. Blocks are handed out through an atomic
+//  counter. The same job is pushed onto the queues once per helper thread
+//  and each helper just keeps grabbing blocks until there are none left.
+//
+class ThreadPool_WorkStealing::ParallelJob final : public AsyncTaskCore{
+public:
+    ParallelJob(
+        const std::function<void(size_t index)>& func,
+        size_t start, size_t end,
+        size_t block_size, size_t blocks,
+        size_t helpers
+    )
+        : m_func(func)
+        , m_start(start)
+        , m_end(end)
+        , m_block_size(block_size)
+        , m_blocks(blocks)
+        , m_next_block(0)
+        , m_helpers(helpers)
+        , m_exception_block(blocks)
+    {}
+
+    void work() noexcept{
+        while (true){
+            size_t block = m_next_block.fetch_add(1, std::memory_order_relaxed);
+            if (block >= m_blocks){
+                return;
+            }
+            size_t s = m_start + block * m_block_size;
+            size_t e = std::min(s + m_block_size, m_end);
+            try{
+                for (; s < e; s++){
+                    m_func(s);
+                }
+            }catch (...){
+                //  Keep the exception from the lowest block to match what
+                //  ThreadPool_Default would throw.
+                std::lock_guard<Mutex> lg(m_lock);
+                if (block < m_exception_block){
+                    m_exception_block = block;
+                    m_exception = std::current_exception();
+                }
+            }
+        }
+    }
+
+    virtual bool is_finished() const noexcept override{
+        return m_helpers.load(std::memory_order_acquire) == 0;
+    }
+    virtual void wait_and_rethrow_exceptions() override{
+        //  Always take the lock at least once. The last helper may still be
+        //  inside helper_done() even after it zeroed the counter.
+        std::unique_lock<Mutex> lg(m_lock);
+        m_cv.wait(lg, [this]{ return m_helpers.load(std::memory_order_relaxed) == 0; });
+        if (m_exception){
+            std::rethrow_exception(m_exception);
+        }
+    }
+
+    virtual void report_started() noexcept override{}
+    virtual void report_cancelled() noexcept override{
+        helper_done();
+    }
+    virtual void run() noexcept override{
+        work();
+        helper_done();
+    }
+
+private:
+    void helper_done() noexcept{
+        std::lock_guard<Mutex> lg(m_lock);
+        if (m_helpers.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            m_cv.notify_all();
+        }
+    }
+
+private:
+    const std::function<void(size_t index)>& m_func;
+    const size_t m_start;
+    const size_t m_end;
+    const size_t m_block_size;
+    const size_t m_blocks;
+
+    std::atomic<size_t> m_next_block;
+    std::atomic<size_t> m_helpers;
+
+    Mutex m_lock;
+    ConditionVariable m_cv;
+    size_t m_exception_block;
+    std::exception_ptr m_exception;
+};
+
+
+
+struct ThreadPool_WorkStealing::Worker{
+    ThreadPool_WorkStealing* pool = nullptr;
+    size_t index = 0;
+
+    WorkStealingDeque<AsyncTaskCore> deque;
+
+    //  Time spent awake. "active_since" is zero while asleep.
+    std::atomic<WallDuration::rep> active_total{0};
+    std::atomic<WallClock::rep> active_since{0};
+
+    Thread thread;
+
+    void start_active(){
+        active_since.store(current_time().time_since_epoch().count(), std::memory_order_relaxed);
+    }
+    void stop_active(){
+        WallClock::rep since = active_since.exchange(0, std::memory_order_relaxed);
+        if (since != 0){
+            active_total.fetch_add(
+                current_time().time_since_epoch().count() - since,
+                std::memory_order_relaxed
+            );
+        }
+    }
+};
+
+thread_local ThreadPool_WorkStealing::Worker* ThreadPool_WorkStealing::t_worker = nullptr;
+
+
+
+ThreadPool_WorkStealing::ThreadPool_WorkStealing(
+    std::function<void()>&& new_thread_callback,
+    size_t starting_threads,
+    size_t max_threads
+)
+    : m_new_thread_callback(std::move(new_thread_callback))
+    , m_max_threads(
+        max_threads != 0
+            ? max_threads
+            : std::max((size_t)std::thread::hardware_concurrency(), (size_t)1)
+    )
+    , m_workers(new Worker[m_max_threads])
+    , m_thread_count(0)
+    , m_injected_size(0)
+    , m_queued(0)
+    , m_outstanding(0)
+    , m_stopping(false)
+    , m_sleeping(0)
+    , m_dispatch_waiters(0)
+{
+    for (size_t c = 0; c < m_max_threads; c++){
+        m_workers[c].pool = this;
+        m_workers[c].index = c;
+    }
+    ensure_threads(starting_threads);
+}
+ThreadPool_WorkStealing::~ThreadPool_WorkStealing(){
+    stop();
+}
+void ThreadPool_WorkStealing::stop(){
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        if (m_stopping.load(std::memory_order_relaxed)){
+            return;
+        }
+        m_stopping.store(true, std::memory_order_release);
+    }
+    m_thread_cv.notify_all();
+
+    size_t threads = m_thread_count.load(std::memory_order_acquire);
+    for (size_t c = 0; c < threads; c++){
+        m_workers[c].thread.join();
+    }
+
+    //  Nothing is running anymore. Cancel whatever is left in the queues.
+    for (size_t c = 0; c < threads; c++){
+        while (AsyncTaskCore* task = m_workers[c].deque.pop()){
+            task->report_cancelled();
+        }
+    }
+    std::deque<AsyncTaskCore*> injected;
+    {
+        std::lock_guard<Mutex> lg(m_inject_lock);
+        injected.swap(m_injected);
+        m_injected_size.store(0, std::memory_order_relaxed);
+    }
+    for (AsyncTaskCore* task : injected){
+        task->report_cancelled();
+    }
+    m_queued.store(0, std::memory_order_relaxed);
+}
+void ThreadPool_WorkStealing::ensure_threads(size_t threads){
+    std::lock_guard<Mutex> lg(m_lock);
+    threads = std::min(threads, m_max_threads);
+    while (m_thread_count.load(std::memory_order_relaxed) < threads){
+        spawn_thread();
+    }
+}
+
+
+WallDuration ThreadPool_WorkStealing::cpu_time() const{
+    WallClock::rep now = current_time().time_since_epoch().count();
+    WallDuration::rep ret = 0;
+    size_t threads = m_thread_count.load(std::memory_order_acquire);
+    for (size_t c = 0; c < threads; c++){
+        const Worker& worker = m_workers[c];
+        ret += worker.active_total.load(std::memory_order_relaxed);
+        WallClock::rep since = worker.active_since.load(std::memory_order_relaxed);
+        if (since != 0){
+            ret += now - since;
+        }
+    }
+    return WallDuration(ret);
+}
+
+
+
+void ThreadPool_WorkStealing::task_finished() noexcept{
+    m_outstanding.fetch_sub(1, std::memory_order_seq_cst);
+    if (m_dispatch_waiters.load(std::memory_order_seq_cst) == 0){
+        return;
+    }
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+    }
+    m_dispatch_cv.notify_one();
+}
+bool ThreadPool_WorkStealing::try_reserve_slot() noexcept{
+    size_t current = m_outstanding.load(std::memory_order_relaxed);
+    do{
+        if (current >= m_max_threads){
+            return false;
+        }
+    }while (!m_outstanding.compare_exchange_weak(current, current + 1, std::memory_order_seq_cst));
+    return true;
+}
+
+
+AsyncTask ThreadPool_WorkStealing::dispatch(std::function<void()>&& func){
+    m_outstanding.fetch_add(1, std::memory_order_seq_cst);
+    AsyncTask task;
+    try{
+        task = AsyncTask(std::make_unique<Task>(*this, std::move(func)));
+    }catch (...){
+        task_finished();
+        throw;
+    }
+    task.core()->report_started();
+    submit(task.core());
+    return task;
+}
+AsyncTask ThreadPool_WorkStealing::dispatch_now_blocking(std::function<void()>&& func){
+    if (!try_reserve_slot()){
+        std::unique_lock<Mutex> lg(m_lock);
+        m_dispatch_waiters.fetch_add(1, std::memory_order_seq_cst);
+        m_dispatch_cv.wait(lg, [this]{ return try_reserve_slot(); });
+        m_dispatch_waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+    AsyncTask task;
+    try{
+        task = AsyncTask(std::make_unique<Task>(*this, std::move(func)));
+    }catch (...){
+        task_finished();
+        throw;
+    }
+    task.core()->report_started();
+    submit(task.core());
+    return task;
+}
+AsyncTask ThreadPool_WorkStealing::try_dispatch_now(std::function<void()>& func){
+    if (!try_reserve_slot()){
+        return AsyncTask();
+    }
+    AsyncTask task;
+    try{
+        task = AsyncTask(std::make_unique<Task>(*this, std::move(func)));
+    }catch (...){
+        task_finished();
+        throw;
+    }
+    task.core()->report_started();
+    submit(task.core());
+    return task;
+}
+
+
+void ThreadPool_WorkStealing::run_in_parallel(
+    const std::function<void(size_t index)>& func,
+    size_t start, size_t end,
+    size_t block_size
+){
+    if (start >= end){
+        return;
+    }
+    size_t total = end - start;
+
+    if (block_size == 0){
+        block_size = total / m_max_threads / 16;
+        if (block_size == 0){
+            block_size = 1;
+        }
+    }
+
+    size_t blocks = (total + block_size - 1) / block_size;
+
+    //  Not worth waking anyone up.
+    if (blocks == 1){
+        for (size_t c = start; c < end; c++){
+            func(c);
+        }
+        return;
+    }
+
+    Worker* self = t_worker;
+    if (self != nullptr && self->pool != this){
+        self = nullptr;
+    }
+
+    //  This thread is one of the workers. Only bring in enough helpers to
+    //  cover the rest of the blocks.
+    size_t helpers = std::min(blocks - 1, m_max_threads);
+
+    ParallelJob job(func, start, end, block_size, blocks, helpers);
+    submit(&job, helpers);
+    job.work();
+
+    //  Our blocks are all claimed, but helpers may still be running them.
+    //  Keep running other tasks while we wait. This is what prevents nested
+    //  run_in_parallel() calls from deadlocking: the thread that would block
+    //  is the one that runs the queued work instead.
+    //
+    //  Once nothing is queued anywhere, all our helpers have been picked up
+    //  and will finish on their own. So it's safe to sleep.
+    while (!job.is_finished()){
+        if (run_one(self)){
+            continue;
+        }
+        if (m_queued.load(std::memory_order_acquire) == 0){
+            break;
+        }
+        pause();
+    }
+
+    job.wait_and_rethrow_exceptions();
+}
+
+
+
+void ThreadPool_WorkStealing::submit(AsyncTaskCore* task, size_t count){
+    //  Count before publishing so a worker never sees the task without the
+    //  count. (otherwise it could go to sleep with work queued)
+    m_queued.fetch_add(count, std::memory_order_seq_cst);
+
+    Worker* self = t_worker;
+    if (self != nullptr && self->pool == this){
+        for (size_t c = 0; c < count; c++){
+            self->deque.push(task);
+        }
+    }else{
+        std::lock_guard<Mutex> lg(m_inject_lock);
+        for (size_t c = 0; c < count; c++){
+            m_injected.emplace_back(task);
+        }
+        m_injected_size.fetch_add(count, std::memory_order_release);
+    }
+
+    wake_threads(count);
+}
+AsyncTaskCore* ThreadPool_WorkStealing::find_task(Worker* self){
+    AsyncTaskCore* task = nullptr;
+
+    //  Our own queue first. Most recent first since it's still in cache.
+    if (self != nullptr){
+        task = self->deque.pop();
+    }
+
+    //  Then anything dispatched from outside the pool.
+    if (task == nullptr && m_injected_size.load(std::memory_order_acquire) > 0){
+        std::lock_guard<Mutex> lg(m_inject_lock);
+        if (!m_injected.empty()){
+            task = m_injected.front();
+            m_injected.pop_front();
+            m_injected_size.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    //  Then steal from the other workers.
+    if (task == nullptr){
+        size_t threads = m_thread_count.load(std::memory_order_acquire);
+        size_t first = self != nullptr ? self->index + 1 : 0;
+        for (size_t c = 0; c < threads; c++){
+            Worker& victim = m_workers[(first + c) % threads];
+            if (&victim == self){
+                continue;
+            }
+            task = victim.deque.steal();
+            if (task != nullptr){
+                break;
+            }
+        }
+    }
+
+    if (task != nullptr){
+        m_queued.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    return task;
+}
+bool ThreadPool_WorkStealing::run_one(Worker* self){
+    AsyncTaskCore* task = find_task(self);
+    if (task == nullptr){
+        return false;
+    }
+    task->run();
+    return true;
+}
+void ThreadPool_WorkStealing::wake_threads(size_t count){
+    size_t sleeping = m_sleeping.load(std::memory_order_seq_cst);
+
+    //  Everyone is awake. Add threads if we're not at the cap yet.
+    if (sleeping == 0){
+        if (m_thread_count.load(std::memory_order_acquire) >= m_max_threads){
+            return;
+        }
+        std::lock_guard<Mutex> lg(m_lock);
+        size_t target = std::min(m_thread_count.load(std::memory_order_relaxed) + count, m_max_threads);
+        while (!m_stopping.load(std::memory_order_relaxed) && m_thread_count.load(std::memory_order_relaxed) < target){
+            spawn_thread();
+        }
+        return;
+    }
+
+    //  A sleeper holds the lock from when it announces itself until it's
+    //  waiting. So taking the lock here guarantees it will get the notify.
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+    }
+    if (count >= sleeping){
+        m_thread_cv.notify_all();
+    }else{
+        for (size_t c = 0; c < count; c++){
+            m_thread_cv.notify_one();
+        }
+    }
+}
+
+
+
+void ThreadPool_WorkStealing::spawn_thread(){
+    //  Must call under lock.
+    size_t index = m_thread_count.load(std::memory_order_relaxed);
+    Worker& worker = m_workers[index];
+    worker.thread = Thread([this, &worker]{
+        run_with_catch(
+            "ThreadPool_WorkStealing::thread_loop()",
+            [this, &worker]{ thread_loop(worker); }
+        );
+    });
+    m_thread_count.store(index + 1, std::memory_order_release);
+}
+void ThreadPool_WorkStealing::thread_loop(Worker& worker){
+    t_worker = &worker;
+
+    if (m_new_thread_callback){
+        m_new_thread_callback();
+    }
+
+    worker.start_active();
+    while (!m_stopping.load(std::memory_order_acquire)){
+        if (run_one(&worker)){
+            continue;
+        }
+
+        //  Spin a bit before going to sleep. Work tends to come in bursts.
+        bool queued = false;
+        for (size_t c = 0; c < 64 && !queued; c++){
+            pause();
+            queued = m_queued.load(std::memory_order_relaxed) > 0;
+        }
+        if (queued){
+            continue;
+        }
+
+        worker.stop_active();
+        {
+            std::unique_lock<Mutex> lg(m_lock);
+            m_sleeping.fetch_add(1, std::memory_order_seq_cst);
+            m_thread_cv.wait(lg, [this]{
+                return m_stopping.load(std::memory_order_relaxed) ||
+                    m_queued.load(std::memory_order_seq_cst) > 0;
+            });
+            m_sleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+        worker.start_active();
+    }
+    worker.stop_active();
+
+    t_worker = nullptr;
+}
+
+
+
+
+}
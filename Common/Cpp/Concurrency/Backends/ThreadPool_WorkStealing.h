@@ -0,0 +1,131 @@
+/*  Thread Pool (Work Stealing)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      A fixed-size thread pool where each worker has its own work-stealing
+ *  deque. Tasks dispatched from a worker go onto that worker's deque. Tasks
+ *  dispatched from anywhere else go into a shared injection queue. Idle
+ *  workers steal from each other.
+ *
+ *  Compared to ThreadPool_Default:
+ *    - Dispatching from inside the pool does not touch a shared lock.
+ *    - Task objects are recycled instead of being allocated per dispatch.
+ *    - run_in_parallel() hands out blocks through a single counter instead
+ *      of allocating a task per block.
+ *    - A thread waiting on run_in_parallel() runs other queued tasks while it
+ *      waits. So nesting run_in_parallel() inside run_in_parallel() (or inside
+ *      a dispatched task) will not deadlock.
+ *
+ *  The thread count is capped so this is only suitable for compute pools.
+ *  Use ThreadPool_Default for the unlimited pools.
+ *
+ */
+
+#ifndef PokemonAutomation_ThreadPool_WorkStealing_H
+#define PokemonAutomation_ThreadPool_WorkStealing_H
+
+#include <functional>
+#include <memory>
+#include <deque>
+#include <atomic>
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/Thread.h"
+#include "Common/Cpp/Concurrency/WorkStealingDeque.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "Common/Cpp/Concurrency/ThreadPool.h"
+
+namespace PokemonAutomation{
+
+
+
+
+class ThreadPool_WorkStealing final : public ThreadPool{
+public:
+    //  "max_threads = 0" means use the # of hardware threads.
+    ThreadPool_WorkStealing(
+        std::function<void()>&& new_thread_callback,
+        size_t starting_threads,
+        size_t max_threads = 0
+    );
+    ~ThreadPool_WorkStealing();
+
+    virtual void stop() override;
+    virtual void ensure_threads(size_t threads) override;
+
+
+public:
+    virtual size_t current_threads() const override{
+        return m_thread_count.load(std::memory_order_acquire);
+    }
+    virtual size_t max_threads() const override{
+        return m_max_threads;
+    }
+    virtual WallDuration cpu_time() const override;
+
+
+public:
+    [[nodiscard]] virtual AsyncTask dispatch(std::function<void()>&& func) override;
+    [[nodiscard]] virtual AsyncTask dispatch_now_blocking(std::function<void()>&& func) override;
+    [[nodiscard]] virtual AsyncTask try_dispatch_now(std::function<void()>& func) override;
+
+    virtual void run_in_parallel(
+        const std::function<void(size_t index)>& func,
+        size_t start, size_t end,
+        size_t block_size = 0
+    ) override;
+
+
+private:
+    class Task;
+    class ParallelJob;
+    struct Worker;
+
+    void task_finished() noexcept;
+    bool try_reserve_slot() noexcept;
+
+    void submit(AsyncTaskCore* task, size_t count = 1);
+    AsyncTaskCore* find_task(Worker* self);
+    bool run_one(Worker* self);
+    void wake_threads(size_t count);
+
+    void spawn_thread();
+    void thread_loop(Worker& worker);
+
+    //  The worker of this thread, if any. (may belong to another pool)
+    static thread_local Worker* t_worker;
+
+
+private:
+    std::function<void()> m_new_thread_callback;
+    const size_t m_max_threads;
+
+    //  All the workers are allocated up front so that thieves can walk them
+    //  without a lock. Only the first "m_thread_count" are running.
+    std::unique_ptr<Worker[]> m_workers;
+    std::atomic<size_t> m_thread_count;
+
+    //  Tasks dispatched from threads outside this pool.
+    Mutex m_inject_lock;
+    std::deque<AsyncTaskCore*> m_injected;
+    std::atomic<size_t> m_injected_size;
+
+    //  # of tasks sitting in any queue. Workers only sleep when this is zero.
+    std::atomic<size_t> m_queued;
+
+    //  # of dispatched tasks that have not finished. (running or queued)
+    std::atomic<size_t> m_outstanding;
+
+    std::atomic<bool> m_stopping;
+    std::atomic<size_t> m_sleeping;
+    std::atomic<size_t> m_dispatch_waiters;
+    mutable Mutex m_lock;
+    ConditionVariable m_thread_cv;
+    ConditionVariable m_dispatch_cv;
+};
+
+
+
+
+}
+#endif
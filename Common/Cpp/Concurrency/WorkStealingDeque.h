@@ -0,0 +1,156 @@
+/*  Work Stealing Deque
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      A Chase-Lev work-stealing deque of pointers. One thread (the owner)
+ *  pushes and pops at the bottom. Any thread may steal from the top.
+ *
+ *  This follows "Correct and Efficient Work-Stealing for Weak Memory Models"
+ *  (Le, Pop, Cohen, Zappa Nardelli - PPoPP 2013).
+ *
+ *  When the buffer fills up, the owner replaces it with one twice the size.
+ *  Old buffers are kept until the deque is destroyed since a thief may still
+ *  be reading from them.
+ *
+ */
+
+#ifndef PokemonAutomation_WorkStealingDeque_H
+#define PokemonAutomation_WorkStealingDeque_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include <atomic>
+
+namespace PokemonAutomation{
+
+
+
+template <typename Object>
+class WorkStealingDeque{
+public:
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    void operator=(const WorkStealingDeque&) = delete;
+
+    //  "initial_capacity" must be a power of two.
+    WorkStealingDeque(size_t initial_capacity = 256)
+        : m_top(0)
+        , m_bottom(0)
+    {
+        m_buffers.emplace_back(std::make_unique<Buffer>(initial_capacity));
+        m_buffer.store(m_buffers.back().get(), std::memory_order_relaxed);
+    }
+
+    //  Approximate. Only exact if nobody else is touching the deque.
+    size_t size() const{
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+        return b > t ? (size_t)(b - t) : 0;
+    }
+
+
+public:
+    //  Owner only.
+    void push(Object* object){
+        int64_t b = m_bottom.load(std::memory_order_relaxed);
+        int64_t t = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (b - t > (int64_t)buffer->mask){
+            buffer = grow(buffer, t, b);
+        }
+        buffer->put(b, object);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    //  Owner only. Returns null if empty.
+    Object* pop(){
+        int64_t b = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = m_top.load(std::memory_order_relaxed);
+
+        if (t > b){
+            //  Empty.
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Object* object = buffer->get(b);
+        if (t == b){
+            //  Last item. Race against the thieves for it.
+            if (!m_top.compare_exchange_strong(
+                t, t + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed
+            )){
+                object = nullptr;
+            }
+            m_bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return object;
+    }
+
+    //  Any thread. Returns null if empty or if another thread got there first.
+    Object* steal(){
+        int64_t t = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = m_bottom.load(std::memory_order_acquire);
+        if (t >= b){
+            return nullptr;
+        }
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        Object* object = buffer->get(t);
+        if (!m_top.compare_exchange_strong(
+            t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed
+        )){
+            return nullptr;
+        }
+        return object;
+    }
+
+
+private:
+    struct Buffer{
+        size_t mask;
+        std::unique_ptr<std::atomic<Object*>[]> data;
+
+        Buffer(size_t capacity)
+            : mask(capacity - 1)
+            , data(new std::atomic<Object*>[capacity])
+        {}
+        Object* get(int64_t index) const{
+            return data[(size_t)index & mask].load(std::memory_order_relaxed);
+        }
+        void put(int64_t index, Object* object){
+            data[(size_t)index & mask].store(object, std::memory_order_relaxed);
+        }
+    };
+
+    Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom){
+        std::unique_ptr<Buffer> bigger = std::make_unique<Buffer>(2 * (buffer->mask + 1));
+        for (int64_t c = top; c < bottom; c++){
+            bigger->put(c, buffer->get(c));
+        }
+        m_buffers.emplace_back(std::move(bigger));
+        buffer = m_buffers.back().get();
+        m_buffer.store(buffer, std::memory_order_release);
+        return buffer;
+    }
+
+
+private:
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    std::atomic<Buffer*> m_buffer;
+
+    //  Owner only.
+    std::vector<std::unique_ptr<Buffer>> m_buffers;
+};
+
+
+
+}
+#endif
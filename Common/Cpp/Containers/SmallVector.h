@@ -0,0 +1,198 @@
+/*  Small Vector
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      A vector that keeps up to "InlineCapacity" elements inside the object
+ *  itself and only goes to the heap when it grows past that. Use it for
+ *  short, frequently built lists on hot paths.
+ *
+ */
+
+#ifndef PokemonAutomation_SmallVector_H
+#define PokemonAutomation_SmallVector_H
+
+#include <stddef.h>
+#include <new>
+#include <utility>
+
+namespace PokemonAutomation{
+
+
+
+template <typename Object, size_t InlineCapacity>
+class SmallVector{
+public:
+    ~SmallVector();
+    SmallVector(SmallVector&& x) noexcept;
+    SmallVector& operator=(SmallVector&& x) noexcept;
+    SmallVector(const SmallVector& x);
+    SmallVector& operator=(const SmallVector& x);
+
+public:
+    SmallVector() = default;
+
+    void clear() noexcept;
+    void reserve(size_t capacity);
+
+    bool empty() const{ return m_size == 0; }
+    size_t size() const{ return m_size; }
+    size_t capacity() const{ return m_capacity; }
+    bool is_inline() const{ return m_ptr == inline_data(); }
+
+    const Object& operator[](size_t index) const{ return m_ptr[index]; }
+          Object& operator[](size_t index)      { return m_ptr[index]; }
+    const Object& back() const{ return m_ptr[m_size - 1]; }
+          Object& back()      { return m_ptr[m_size - 1]; }
+
+    const Object* begin() const{ return m_ptr; }
+          Object* begin()      { return m_ptr; }
+    const Object* end() const{ return m_ptr + m_size; }
+          Object* end()      { return m_ptr + m_size; }
+
+    template <class... Args>
+    Object& emplace_back(Args&&... args);
+    void pop_back();
+
+private:
+    const Object* inline_data() const{ return reinterpret_cast<const Object*>(m_inline); }
+          Object* inline_data()      { return reinterpret_cast<Object*>(m_inline); }
+
+    //  Move the elements of "x" into this (empty, inline) vector.
+    void take(SmallVector& x) noexcept;
+
+private:
+    Object* m_ptr = inline_data();
+    size_t m_size = 0;
+    size_t m_capacity = InlineCapacity;
+    alignas(Object) unsigned char m_inline[InlineCapacity * sizeof(Object)];
+};
+
+
+
+template <typename Object, size_t InlineCapacity>
+SmallVector<Object, InlineCapacity>::~SmallVector(){
+    clear();
+    if (!is_inline()){
+        ::operator delete(m_ptr);
+    }
+}
+template <typename Object, size_t InlineCapacity>
+SmallVector<Object, InlineCapacity>::SmallVector(SmallVector&& x) noexcept{
+    take(x);
+}
+template <typename Object, size_t InlineCapacity>
+SmallVector<Object, InlineCapacity>& SmallVector<Object, InlineCapacity>::operator=(SmallVector&& x) noexcept{
+    if (this == &x){
+        return *this;
+    }
+    clear();
+    if (!is_inline()){
+        ::operator delete(m_ptr);
+        m_ptr = inline_data();
+        m_capacity = InlineCapacity;
+    }
+    take(x);
+    return *this;
+}
+template <typename Object, size_t InlineCapacity>
+SmallVector<Object, InlineCapacity>::SmallVector(const SmallVector& x){
+    reserve(x.m_size);
+    for (const Object& item : x){
+        emplace_back(item);
+    }
+}
+template <typename Object, size_t InlineCapacity>
+SmallVector<Object, InlineCapacity>& SmallVector<Object, InlineCapacity>::operator=(const SmallVector& x){
+    if (this == &x){
+        return *this;
+    }
+    SmallVector tmp(x);
+    *this = std::move(tmp);
+    return *this;
+}
+
+template <typename Object, size_t InlineCapacity>
+void SmallVector<Object, InlineCapacity>::take(SmallVector& x) noexcept{
+    if (!x.is_inline()){
+        //  Steal the heap buffer.
+        m_ptr = x.m_ptr;
+        m_size = x.m_size;
+        m_capacity = x.m_capacity;
+        x.m_ptr = x.inline_data();
+        x.m_size = 0;
+        x.m_capacity = InlineCapacity;
+        return;
+    }
+    for (size_t c = 0; c < x.m_size; c++){
+        new (m_ptr + c) Object(std::move(x.m_ptr[c]));
+        x.m_ptr[c].~Object();
+    }
+    m_size = x.m_size;
+    x.m_size = 0;
+}
+
+template <typename Object, size_t InlineCapacity>
+void SmallVector<Object, InlineCapacity>::clear() noexcept{
+    while (m_size > 0){
+        pop_back();
+    }
+}
+template <typename Object, size_t InlineCapacity>
+void SmallVector<Object, InlineCapacity>::reserve(size_t capacity){
+    if (capacity <= m_capacity){
+        return;
+    }
+    Object* ptr = (Object*)::operator new(capacity * sizeof(Object));
+    for (size_t c = 0; c < m_size; c++){
+        new (ptr + c) Object(std::move(m_ptr[c]));
+        m_ptr[c].~Object();
+    }
+    if (!is_inline()){
+        ::operator delete(m_ptr);
+    }
+    m_ptr = ptr;
+    m_capacity = capacity;
+}
+
+template <typename Object, size_t InlineCapacity>
+template <class... Args>
+Object& SmallVector<Object, InlineCapacity>::emplace_back(Args&&... args){
+    if (m_size < m_capacity){
+        Object* ret = new (m_ptr + m_size) Object(std::forward<Args>(args)...);
+        m_size++;
+        return *ret;
+    }
+
+    //  Full. Construct the new element in the new buffer before moving the old
+    //  ones out, since "args" may refer to one of them.
+    size_t capacity = m_capacity == 0 ? 1 : m_capacity * 2;
+    Object* ptr = (Object*)::operator new(capacity * sizeof(Object));
+    Object* ret;
+    try{
+        ret = new (ptr + m_size) Object(std::forward<Args>(args)...);
+    }catch (...){
+        ::operator delete(ptr);
+        throw;
+    }
+    for (size_t c = 0; c < m_size; c++){
+        new (ptr + c) Object(std::move(m_ptr[c]));
+        m_ptr[c].~Object();
+    }
+    if (!is_inline()){
+        ::operator delete(m_ptr);
+    }
+    m_ptr = ptr;
+    m_capacity = capacity;
+    m_size++;
+    return *ret;
+}
+template <typename Object, size_t InlineCapacity>
+void SmallVector<Object, InlineCapacity>::pop_back(){
+    m_size--;
+    m_ptr[m_size].~Object();
+}
+
+
+
+}
+#endif
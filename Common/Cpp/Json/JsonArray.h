@@ -36,6 +36,7 @@ public:
     const JsonValue& operator[](size_t index) const;
           JsonValue& operator[](size_t index)      ;
 
+    void reserve(size_t size){ m_data.reserve(size); }
     void push_back(JsonValue&& x){ m_data.emplace_back(std::move(x)); }
 
 public:
@@ -0,0 +1,306 @@
+/*  JSON Binary
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <QFile>
+#include "JsonArray.h"
+#include "JsonObject.h"
+#include "JsonParser.h"
+#include "JsonTools.h"
+#include "JsonBinary.h"
+
+namespace PokemonAutomation{
+
+
+
+//
+//  Layout: (all little-endian, no alignment requirements)
+//
+//      Header
+//      Value
+//
+//  Each value is a 1-byte tag followed by:
+//      null, false, true:  nothing
+//      integer:            int64
+//      float:              double
+//      string:             uint32 length, bytes
+//      array:              uint32 count, values
+//      object:             uint32 count, (uint32 length, key bytes, value) pairs
+//
+
+namespace{
+
+const char MAGIC[8] = {'P', 'A', 'J', 'S', 'O', 'N', 'B', '1'};
+
+struct Header{
+    char magic[8];
+    uint64_t source_size;
+    uint64_t source_hash;
+    uint64_t payload_size;
+};
+
+enum class Tag : uint8_t{
+    EMPTY,
+    FALSE_,
+    TRUE_,
+    INTEGER,
+    FLOAT,
+    STRING,
+    ARRAY,
+    OBJECT,
+};
+
+
+class BinaryWriter{
+public:
+    BinaryWriter(std::string& out)
+        : m_out(out)
+    {}
+
+    template <typename Type>
+    void write_pod(Type x){
+        m_out.append((const char*)&x, sizeof(Type));
+    }
+    void write_string(const std::string& str){
+        write_pod((uint32_t)str.size());
+        m_out += str;
+    }
+
+    void write_value(const JsonValue& value){
+        switch (value.type()){
+        case JsonType::EMPTY:
+            write_pod(Tag::EMPTY);
+            return;
+        case JsonType::BOOLEAN:
+            write_pod(value.to_boolean_default() ? Tag::TRUE_ : Tag::FALSE_);
+            return;
+        case JsonType::INTEGER:
+            write_pod(Tag::INTEGER);
+            write_pod(value.to_integer_default());
+            return;
+        case JsonType::FLOAT:
+            write_pod(Tag::FLOAT);
+            write_pod(value.to_double_default());
+            return;
+        case JsonType::STRING:
+            write_pod(Tag::STRING);
+            write_string(*value.to_string());
+            return;
+        case JsonType::ARRAY:{
+            const JsonArray& array = *value.to_array();
+            write_pod(Tag::ARRAY);
+            write_pod((uint32_t)array.size());
+            for (const JsonValue& item : array){
+                write_value(item);
+            }
+            return;
+        }
+        case JsonType::OBJECT:{
+            const JsonObject& object = *value.to_object();
+            write_pod(Tag::OBJECT);
+            write_pod((uint32_t)object.size());
+            for (const auto& item : object){
+                write_string(item.first);
+                write_value(item.second);
+            }
+            return;
+        }
+        }
+    }
+
+private:
+    std::string& m_out;
+};
+
+
+class BinaryReader{
+    static constexpr size_t MAX_DEPTH = 512;
+
+public:
+    BinaryReader(const char* data, size_t bytes)
+        : m_ptr(data)
+        , m_end(data + bytes)
+    {}
+
+    bool at_end() const{ return m_ptr == m_end; }
+
+    template <typename Type>
+    bool read_pod(Type& x){
+        if ((size_t)(m_end - m_ptr) < sizeof(Type)){
+            return false;
+        }
+        memcpy(&x, m_ptr, sizeof(Type));
+        m_ptr += sizeof(Type);
+        return true;
+    }
+    bool read_string(std::string& str){
+        uint32_t length;
+        if (!read_pod(length) || (size_t)(m_end - m_ptr) < length){
+            return false;
+        }
+        str.assign(m_ptr, length);
+        m_ptr += length;
+        return true;
+    }
+
+    bool read_value(JsonValue& value, size_t depth){
+        Tag tag;
+        if (depth > MAX_DEPTH || !read_pod(tag)){
+            return false;
+        }
+        switch (tag){
+        case Tag::EMPTY:
+            value = JsonValue();
+            return true;
+        case Tag::FALSE_:
+            value = JsonValue(false);
+            return true;
+        case Tag::TRUE_:
+            value = JsonValue(true);
+            return true;
+        case Tag::INTEGER:{
+            int64_t x;
+            if (!read_pod(x)){
+                return false;
+            }
+            value = JsonValue(x);
+            return true;
+        }
+        case Tag::FLOAT:{
+            double x;
+            if (!read_pod(x)){
+                return false;
+            }
+            value = JsonValue(x);
+            return true;
+        }
+        case Tag::STRING:{
+            std::string str;
+            if (!read_string(str)){
+                return false;
+            }
+            value = JsonValue(std::move(str));
+            return true;
+        }
+        case Tag::ARRAY:{
+            uint32_t count;
+            //  Every item is at least one byte. Reject absurd counts early.
+            if (!read_pod(count) || count > (size_t)(m_end - m_ptr)){
+                return false;
+            }
+            JsonArray array;
+            array.reserve(count);
+            for (uint32_t c = 0; c < count; c++){
+                JsonValue item;
+                if (!read_value(item, depth + 1)){
+                    return false;
+                }
+                array.push_back(std::move(item));
+            }
+            value = std::move(array);
+            return true;
+        }
+        case Tag::OBJECT:{
+            uint32_t count;
+            if (!read_pod(count) || count > (size_t)(m_end - m_ptr)){
+                return false;
+            }
+            JsonObject object;
+            std::string key;
+            for (uint32_t c = 0; c < count; c++){
+                if (!read_string(key) || !read_value(object[key], depth + 1)){
+                    return false;
+                }
+            }
+            value = std::move(object);
+            return true;
+        }
+        }
+        return false;
+    }
+
+private:
+    const char* m_ptr;
+    const char* m_end;
+};
+
+}
+
+
+
+std::string json_to_binary(const JsonValue& value, const SourceFingerprint& source){
+    std::string ret(sizeof(Header), '\0');
+    BinaryWriter writer(ret);
+    writer.write_value(value);
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.source_size = source.size;
+    header.source_hash = source.hash;
+    header.payload_size = ret.size() - sizeof(Header);
+    memcpy(&ret[0], &header, sizeof(Header));
+    return ret;
+}
+bool json_from_binary(
+    JsonValue& value,
+    const void* data, size_t bytes,
+    const SourceFingerprint& source
+){
+    Header header;
+    if (bytes < sizeof(Header)){
+        return false;
+    }
+    memcpy(&header, data, sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.source_size != source.size ||
+        header.source_hash != source.hash ||
+        header.payload_size != bytes - sizeof(Header)
+    ){
+        return false;
+    }
+
+    BinaryReader reader((const char*)data + sizeof(Header), bytes - sizeof(Header));
+    if (!reader.read_value(value, 0) || !reader.at_end()){
+        value.clear();
+        return false;
+    }
+    return true;
+}
+
+
+JsonValue load_json_file_cached(const std::string& filename, const std::string& cache_folder){
+    std::string text = file_to_string(filename);
+    const std::string cache_path = source_cache_path(cache_folder, filename, ".json.bin");
+
+    JsonValue value;
+    if (cache_path.empty()){
+        parse_json(value, text.data(), text.size());
+        return value;
+    }
+
+    SourceFingerprint source = fingerprint_source(text.data(), text.size());
+    {
+        QFile cache(QString::fromStdString(cache_path));
+        if (cache.open(QFile::ReadOnly)){
+            qint64 bytes = cache.size();
+            const uchar* data = bytes > 0 ? cache.map(0, bytes) : nullptr;
+            if (data != nullptr && json_from_binary(value, data, (size_t)bytes, source)){
+                return value;
+            }
+        }
+    }
+
+    //  No usable cache. Parse the text and try to (re)write the cache.
+    if (!parse_json(value, text.data(), text.size())){
+        return value;
+    }
+    write_source_cache(cache_path, json_to_binary(value, source));
+    return value;
+}
+
+
+
+}
@@ -0,0 +1,48 @@
+/*  JSON Binary
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Compact binary serialization of JsonValue.
+ *
+ *      The format is flat and position-independent so it can be read straight
+ *      out of a memory-mapped file. It is only meant as a cache for JSON text
+ *      files. It is not a stable interchange format.
+ *
+ */
+
+#ifndef PokemonAutomation_Common_Json_JsonBinary_H
+#define PokemonAutomation_Common_Json_JsonBinary_H
+
+#include <stddef.h>
+#include <string>
+#include "Common/Cpp/SourceFileCache.h"
+#include "JsonValue.h"
+
+namespace PokemonAutomation{
+
+
+//  Serialize "value" into the binary format. "source" identifies the text
+//  that "value" was parsed from.
+std::string json_to_binary(const JsonValue& value, const SourceFingerprint& source);
+
+//  Deserialize a binary blob. Returns false if it is malformed or if it
+//  doesn't belong to "source".
+bool json_from_binary(
+    JsonValue& value,
+    const void* data, size_t bytes,
+    const SourceFingerprint& source
+);
+
+
+//  Same as load_json_file(), but keeps a binary copy of the parsed file in
+//  "cache_folder". (see source_cache_path()) If the cache exists and matches
+//  the current file, the text isn't parsed at all.
+//
+//  Use this for large, read-only resource files. The text is parsed with
+//  parse_json() from JsonParser.h. If "cache_folder" is empty or the cache
+//  can't be written, this falls back to parsing the text every time.
+JsonValue load_json_file_cached(const std::string& filename, const std::string& cache_folder);
+
+
+}
+#endif
@@ -0,0 +1,467 @@
+/*  JSON Parser
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <cmath>
+#include <clocale>
+#include "JsonArray.h"
+#include "JsonObject.h"
+#include "JsonParser.h"
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+class JsonParser{
+    static constexpr size_t MAX_DEPTH = 512;
+
+public:
+    JsonParser(const char* data, size_t size)
+        : m_ptr(data)
+        , m_start(data)
+        , m_end(data + size)
+    {}
+
+    bool parse(JsonValue& value){
+        if (m_end - m_ptr >= 3 && memcmp(m_ptr, "\xef\xbb\xbf", 3) == 0){
+            m_ptr += 3;
+        }
+        skip_whitespace();
+        if (!parse_value(value, 0)){
+            return false;
+        }
+        skip_whitespace();
+        if (m_ptr != m_end){
+            return fail("Unexpected data after the end of the document.");
+        }
+        return true;
+    }
+
+    std::string error() const{
+        return m_error + " (offset " + std::to_string(m_error_offset) + ")";
+    }
+
+private:
+    bool fail(const char* message){
+        if (m_error.empty()){
+            m_error = message;
+            m_error_offset = m_ptr - m_start;
+        }
+        return false;
+    }
+
+    void skip_whitespace(){
+        while (m_ptr < m_end){
+            switch (*m_ptr){
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                m_ptr++;
+                continue;
+            }
+            return;
+        }
+    }
+
+    bool consume_literal(const char* literal, size_t length){
+        if ((size_t)(m_end - m_ptr) < length || memcmp(m_ptr, literal, length) != 0){
+            return fail("Invalid literal.");
+        }
+        m_ptr += length;
+        return true;
+    }
+
+    bool parse_value(JsonValue& value, size_t depth){
+        if (m_ptr == m_end){
+            return fail("Unexpected end of input.");
+        }
+        switch (*m_ptr){
+        case 'n':
+            value = JsonValue();
+            return consume_literal("null", 4);
+        case 't':
+            value = JsonValue(true);
+            return consume_literal("true", 4);
+        case 'f':
+            value = JsonValue(false);
+            return consume_literal("false", 5);
+        case '"':{
+            std::string str;
+            if (!parse_string(str)){
+                return false;
+            }
+            value = JsonValue(std::move(str));
+            return true;
+        }
+        case '[':
+            return parse_array(value, depth + 1);
+        case '{':
+            return parse_object(value, depth + 1);
+        default:
+            return parse_number(value);
+        }
+    }
+
+    bool parse_array(JsonValue& value, size_t depth){
+        if (depth > MAX_DEPTH){
+            return fail("Nesting is too deep.");
+        }
+        m_ptr++;    //  '['
+        JsonArray array;
+        skip_whitespace();
+        if (m_ptr < m_end && *m_ptr == ']'){
+            m_ptr++;
+            value = std::move(array);
+            return true;
+        }
+        while (true){
+            JsonValue item;
+            if (!parse_value(item, depth)){
+                return false;
+            }
+            array.push_back(std::move(item));
+            skip_whitespace();
+            if (m_ptr == m_end){
+                return fail("Unexpected end of input.");
+            }
+            char ch = *m_ptr++;
+            if (ch == ']'){
+                break;
+            }
+            if (ch != ','){
+                m_ptr--;
+                return fail("Expected ',' or ']'.");
+            }
+            skip_whitespace();
+        }
+        value = std::move(array);
+        return true;
+    }
+
+    bool parse_object(JsonValue& value, size_t depth){
+        if (depth > MAX_DEPTH){
+            return fail("Nesting is too deep.");
+        }
+        m_ptr++;    //  '{'
+        JsonObject object;
+        skip_whitespace();
+        if (m_ptr < m_end && *m_ptr == '}'){
+            m_ptr++;
+            value = std::move(object);
+            return true;
+        }
+        std::string key;
+        while (true){
+            if (m_ptr == m_end || *m_ptr != '"'){
+                return fail("Expected a key.");
+            }
+            key.clear();
+            if (!parse_string(key)){
+                return false;
+            }
+            skip_whitespace();
+            if (m_ptr == m_end || *m_ptr != ':'){
+                return fail("Expected ':'.");
+            }
+            m_ptr++;
+            skip_whitespace();
+            if (!parse_value(object[key], depth)){
+                return false;
+            }
+            skip_whitespace();
+            if (m_ptr == m_end){
+                return fail("Unexpected end of input.");
+            }
+            char ch = *m_ptr++;
+            if (ch == '}'){
+                break;
+            }
+            if (ch != ','){
+                m_ptr--;
+                return fail("Expected ',' or '}'.");
+            }
+            skip_whitespace();
+        }
+        value = std::move(object);
+        return true;
+    }
+
+    bool parse_hex4(uint32_t& code){
+        if (m_end - m_ptr < 4){
+            return fail("Truncated unicode escape.");
+        }
+        code = 0;
+        for (size_t c = 0; c < 4; c++){
+            char ch = *m_ptr++;
+            code <<= 4;
+            if ('0' <= ch && ch <= '9'){
+                code |= ch - '0';
+            }else if ('a' <= ch && ch <= 'f'){
+                code |= ch - 'a' + 10;
+            }else if ('A' <= ch && ch <= 'F'){
+                code |= ch - 'A' + 10;
+            }else{
+                m_ptr--;
+                return fail("Invalid unicode escape.");
+            }
+        }
+        return true;
+    }
+    static void append_utf8(std::string& str, uint32_t code){
+        if (code < 0x80){
+            str += (char)code;
+        }else if (code < 0x800){
+            str += (char)(0xc0 | (code >> 6));
+            str += (char)(0x80 | (code & 0x3f));
+        }else if (code < 0x10000){
+            str += (char)(0xe0 | (code >> 12));
+            str += (char)(0x80 | ((code >> 6) & 0x3f));
+            str += (char)(0x80 | (code & 0x3f));
+        }else{
+            str += (char)(0xf0 | (code >> 18));
+            str += (char)(0x80 | ((code >> 12) & 0x3f));
+            str += (char)(0x80 | ((code >> 6) & 0x3f));
+            str += (char)(0x80 | (code & 0x3f));
+        }
+    }
+
+    //  Skip one multi-byte UTF-8 sequence. (RFC 3629)
+    //  Rejects overlong forms, surrogates and code points above 0x10ffff.
+    bool skip_utf8_sequence(){
+        unsigned char lead = *m_ptr;
+        size_t length;
+        unsigned char low = 0x80;   //  Allowed range of the 2nd byte.
+        unsigned char high = 0xbf;
+        if (0xc2 <= lead && lead <= 0xdf){
+            length = 2;
+        }else if (lead == 0xe0){
+            length = 3;
+            low = 0xa0;
+        }else if (lead == 0xed){
+            length = 3;
+            high = 0x9f;
+        }else if (0xe1 <= lead && lead <= 0xef){
+            length = 3;
+        }else if (lead == 0xf0){
+            length = 4;
+            low = 0x90;
+        }else if (lead == 0xf4){
+            length = 4;
+            high = 0x8f;
+        }else if (0xf1 <= lead && lead <= 0xf3){
+            length = 4;
+        }else{
+            return fail("Invalid UTF-8.");
+        }
+        if ((size_t)(m_end - m_ptr) < length){
+            return fail("Invalid UTF-8.");
+        }
+        unsigned char second = m_ptr[1];
+        if (second < low || second > high){
+            return fail("Invalid UTF-8.");
+        }
+        for (size_t c = 2; c < length; c++){
+            if (((unsigned char)m_ptr[c] & 0xc0) != 0x80){
+                return fail("Invalid UTF-8.");
+            }
+        }
+        m_ptr += length;
+        return true;
+    }
+
+    //  Appends the decoded string to "str".
+    bool parse_string(std::string& str){
+        m_ptr++;    //  '"'
+        while (true){
+            //  Copy the run of plain characters in one go.
+            const char* run = m_ptr;
+            while (m_ptr < m_end){
+                unsigned char ch = *m_ptr;
+                if (ch >= 0x80){
+                    if (!skip_utf8_sequence()){
+                        return false;
+                    }
+                    continue;
+                }
+                if (ch == '"' || ch == '\\' || ch < 0x20){
+                    break;
+                }
+                m_ptr++;
+            }
+            str.append(run, m_ptr);
+
+            if (m_ptr == m_end){
+                return fail("Unterminated string.");
+            }
+            char ch = *m_ptr++;
+            if (ch == '"'){
+                return true;
+            }
+            if (ch != '\\'){
+                m_ptr--;
+                return fail("Control character in string.");
+            }
+            if (m_ptr == m_end){
+                return fail("Unterminated string.");
+            }
+            switch (*m_ptr++){
+            case '"':   str += '"';     break;
+            case '\\':  str += '\\';    break;
+            case '/':   str += '/';     break;
+            case 'b':   str += '\b';    break;
+            case 'f':   str += '\f';    break;
+            case 'n':   str += '\n';    break;
+            case 'r':   str += '\r';    break;
+            case 't':   str += '\t';    break;
+            case 'u':{
+                uint32_t code;
+                if (!parse_hex4(code)){
+                    return false;
+                }
+                if (0xdc00 <= code && code < 0xe000){
+                    return fail("Unpaired low surrogate.");
+                }
+                if (0xd800 <= code && code < 0xdc00){
+                    uint32_t low;
+                    if (m_end - m_ptr < 2 || m_ptr[0] != '\\' || m_ptr[1] != 'u'){
+                        return fail("Unpaired high surrogate.");
+                    }
+                    m_ptr += 2;
+                    if (!parse_hex4(low)){
+                        return false;
+                    }
+                    if (low < 0xdc00 || low >= 0xe000){
+                        return fail("Unpaired high surrogate.");
+                    }
+                    code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                }
+                append_utf8(str, code);
+                break;
+            }
+            default:
+                m_ptr--;
+                return fail("Invalid escape sequence.");
+            }
+        }
+    }
+
+    bool parse_number(JsonValue& value){
+        const char* start = m_ptr;
+        bool negative = false;
+        if (*m_ptr == '-'){
+            negative = true;
+            m_ptr++;
+        }
+
+        //  Integer part. Accumulate it as we go in case this is an integer.
+        if (m_ptr == m_end || *m_ptr < '0' || *m_ptr > '9'){
+            return fail("Invalid value.");
+        }
+        uint64_t magnitude = 0;
+        bool overflow = false;
+        if (*m_ptr == '0'){
+            m_ptr++;
+        }else{
+            while (m_ptr < m_end && '0' <= *m_ptr && *m_ptr <= '9'){
+                uint64_t digit = *m_ptr++ - '0';
+                if (magnitude > (UINT64_MAX - digit) / 10){
+                    overflow = true;
+                }
+                magnitude = magnitude * 10 + digit;
+            }
+        }
+
+        bool is_integer = true;
+        if (m_ptr < m_end && *m_ptr == '.'){
+            is_integer = false;
+            m_ptr++;
+            if (m_ptr == m_end || *m_ptr < '0' || *m_ptr > '9'){
+                return fail("Invalid number.");
+            }
+            while (m_ptr < m_end && '0' <= *m_ptr && *m_ptr <= '9'){
+                m_ptr++;
+            }
+        }
+        if (m_ptr < m_end && (*m_ptr == 'e' || *m_ptr == 'E')){
+            is_integer = false;
+            m_ptr++;
+            if (m_ptr < m_end && (*m_ptr == '+' || *m_ptr == '-')){
+                m_ptr++;
+            }
+            if (m_ptr == m_end || *m_ptr < '0' || *m_ptr > '9'){
+                return fail("Invalid number.");
+            }
+            while (m_ptr < m_end && '0' <= *m_ptr && *m_ptr <= '9'){
+                m_ptr++;
+            }
+        }
+
+        if (is_integer && !overflow){
+            if (!negative){
+                value = JsonValue((int64_t)magnitude);
+                return true;
+            }
+            if (magnitude <= (uint64_t)1 << 63){
+                value = JsonValue((int64_t)(0 - magnitude));
+                return true;
+            }
+        }
+
+        //  strtod() honors the C locale's decimal point. So swap it in.
+        std::string text(start, m_ptr);
+        char decimal_point = *std::localeconv()->decimal_point;
+        if (decimal_point != '.'){
+            for (char& ch : text){
+                if (ch == '.'){
+                    ch = decimal_point;
+                }
+            }
+        }
+        double x = strtod(text.c_str(), nullptr);
+        if (!std::isfinite(x)){
+            m_ptr = start;
+            return fail("Number is out of range.");
+        }
+        value = JsonValue(x);
+        return true;
+    }
+
+private:
+    const char* m_ptr;
+    const char* m_start;
+    const char* m_end;
+
+    std::string m_error;
+    size_t m_error_offset = 0;
+};
+
+}
+
+
+
+bool parse_json(
+    JsonValue& value,
+    const char* data, size_t size,
+    std::string* error
+){
+    JsonParser parser(data, size);
+    if (parser.parse(value)){
+        return true;
+    }
+    value.clear();
+    if (error){
+        *error = parser.error();
+    }
+    return false;
+}
+
+
+
+}
@@ -0,0 +1,37 @@
+/*  JSON Parser
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Single-pass JSON text parser that builds JsonValue directly without
+ *      going through an intermediate DOM.
+ *
+ */
+
+#ifndef PokemonAutomation_Common_Json_JsonParser_H
+#define PokemonAutomation_Common_Json_JsonParser_H
+
+#include <stddef.h>
+#include <string>
+#include "JsonValue.h"
+
+namespace PokemonAutomation{
+
+
+//  Parse "data" as strict JSON (RFC 8259). A leading UTF-8 BOM is skipped.
+//  Strings must be valid UTF-8.
+//
+//  Returns true on success. On failure, returns false, "value" is cleared,
+//  and "error" (if not null) describes the first problem and its offset.
+//
+//  Integers that fit in 64 bits are stored as integers. Unsigned values above
+//  INT64_MAX wrap around. Everything else is stored as a double. Duplicate
+//  keys keep the last value.
+bool parse_json(
+    JsonValue& value,
+    const char* data, size_t size,
+    std::string* error = nullptr
+);
+
+
+}
+#endif
@@ -10,6 +10,7 @@
 #include <exception>
 #include <map>
 #include <atomic>
+#include <thread>
 //#include "Common/Cpp/PrettyPrint.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 
@@ -160,7 +161,16 @@ void ListenerSet<ListenerType>::remove(ListenerType& listener) noexcept{
 
 //    bool printed = false;
 
+    bool retry = false;
     while (true){
+        //  The listener is running a callback. Don't retry in a tight loop.
+        //  "run_method()" needs "m_lock" to move past the node when the
+        //  callback returns. Hammering it here can starve it for seconds.
+        if (retry){
+            std::this_thread::yield();
+        }
+        retry = true;
+
         WriteSpinLock lg(m_lock, "ListenerSet::remove()");
         auto iter = m_listeners.find(&listener);
         if (iter == m_listeners.end()){
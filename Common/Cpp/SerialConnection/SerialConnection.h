@@ -7,8 +7,10 @@
 #ifndef PokemonAutomation_SerialConnection_H
 #define PokemonAutomation_SerialConnection_H
 
-#ifdef _WIN32
+#if defined(_WIN32)
 #include "SerialConnectionWinAPI.h"
+#elif defined(__linux__)
+#include "SerialConnectionEpoll.h"
 #else
 #include "SerialConnectionPOSIX.h"
 #endif
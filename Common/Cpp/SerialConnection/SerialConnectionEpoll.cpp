@@ -0,0 +1,213 @@
+/*  Serial Connection for Linux (epoll)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#if defined(__linux__)
+
+#include "SerialPortPOSIX.h"
+#include "SerialConnectionEpoll.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+SerialConnection::SerialConnection(
+    ThreadPool& thread_pool,
+    const std::string& name,
+    uint32_t baud_rate
+)
+    : SerialConnection(SerialEventLoop::instance(thread_pool), name, baud_rate)
+{}
+SerialConnection::SerialConnection(
+    SerialEventLoop& event_loop,
+    const std::string& name,
+    uint32_t baud_rate
+)
+    : m_event_loop(event_loop)
+    , m_exit(false)
+    , m_consecutive_errors(0)
+    , m_writable(true)
+    , m_hung_up(false)
+{
+    m_fd = serial_open_posix(name, O_NONBLOCK | O_CLOEXEC);
+    try{
+        set_baud_rate(baud_rate);
+        m_event_loop.add(m_fd, *this);
+    }catch (...){
+        close(m_fd);
+        throw;
+    }
+}
+SerialConnection::~SerialConnection(){
+    if (!m_exit.load(std::memory_order_acquire)){
+        stop();
+    }
+}
+void SerialConnection::stop() noexcept{
+    {
+        std::lock_guard<Mutex> lg(m_write_lock);
+        m_exit.store(true, std::memory_order_release);
+    }
+    m_write_cv.notify_all();
+
+    //  No callbacks after this.
+    m_event_loop.remove(m_fd);
+
+    //  Wait for any sender to leave before closing the fd under it.
+    std::lock_guard<Mutex> lg(m_send_lock);
+    close(m_fd);
+}
+
+
+void SerialConnection::set_baud_rate(uint32_t baud_rate){
+    serial_set_baud_rate_posix(m_fd, baud_rate);
+}
+void SerialConnection::get_control_state(bool& dtr, bool& rts){
+    serial_get_control_state_posix(m_fd, dtr, rts);
+}
+void SerialConnection::set_control_state(bool dtr, bool rts){
+    serial_set_control_state_posix(m_fd, dtr, rts);
+}
+
+
+size_t SerialConnection::unreliable_send(const void* data, size_t bytes) noexcept{
+    std::lock_guard<Mutex> lg(m_send_lock);
+
+    const char* ptr = (const char*)data;
+    size_t remaining = bytes;
+
+    while (remaining > 0 && !m_exit.load(std::memory_order_acquire)){
+        ssize_t sent = write(m_fd, ptr, remaining);
+        if (sent > 0){
+            ptr += sent;
+            remaining -= sent;
+            continue;
+        }
+
+        int error = errno;
+        if (sent < 0 && error == EINTR){
+            continue;
+        }
+        if (sent == 0 || error == EAGAIN || error == EWOULDBLOCK){
+            //  Device is full. Sleep until the event loop says it's writable.
+            try{
+                std::unique_lock<Mutex> lg1(m_write_lock);
+                if (!m_hung_up){
+                    m_writable = false;
+                    m_event_loop.set_write_notifications(m_fd, true);
+                    m_write_cv.wait(lg1, [this]{
+                        return m_writable || m_hung_up || m_exit.load(std::memory_order_acquire);
+                    });
+                }
+                if (!m_hung_up){
+                    continue;
+                }
+                error = EIO;
+            }catch (...){
+                error = errno;
+            }
+        }
+
+        //  Real error occurred
+        try{
+            process_error(
+                "Failed to write: " + std::to_string(bytes - remaining) +
+                " / " + std::to_string(bytes) +
+                ", error = " + std::to_string(error)
+            );
+        }catch (...){}
+        return bytes - remaining;
+    }
+
+    if (remaining == 0){
+        m_consecutive_errors.store(0, std::memory_order_release);
+    }
+
+    return bytes - remaining;
+}
+
+
+void SerialConnection::on_readable() noexcept{
+    char buffer[1024];
+    while (true){
+        ssize_t actual = read(m_fd, buffer, sizeof(buffer));
+        if (actual > 0){
+            m_consecutive_errors.store(0, std::memory_order_release);
+            try{
+                on_unreliable_recv(buffer, actual);
+            }catch (...){
+                try{
+                    process_error("Exception thrown by serial listener.");
+                }catch (...){}
+            }
+            continue;
+        }
+        if (actual == 0){
+            return;
+        }
+
+        int error = errno;
+        if (error == EINTR){
+            continue;
+        }
+        if (error == EAGAIN || error == EWOULDBLOCK){
+            return;
+        }
+
+        //  Anything else won't go away. (e.g. EIO when a USB adapter is
+        //  unplugged) Stop listening to avoid spinning on it.
+        try{
+            process_error("read serial POSIX() failed. Error = " + std::to_string(error));
+        }catch (...){}
+        on_hangup();
+        return;
+    }
+}
+void SerialConnection::on_writable() noexcept{
+    {
+        std::lock_guard<Mutex> lg(m_write_lock);
+        m_writable = true;
+        try{
+            m_event_loop.set_write_notifications(m_fd, false);
+        }catch (...){}
+    }
+    m_write_cv.notify_all();
+}
+void SerialConnection::on_hangup() noexcept{
+    try{
+        process_error("Serial port hung up.");
+    }catch (...){}
+    m_event_loop.remove(m_fd);
+
+    //  Release any sender waiting for the port to become writable.
+    {
+        std::lock_guard<Mutex> lg(m_write_lock);
+        m_hung_up = true;
+    }
+    m_write_cv.notify_all();
+}
+
+
+void SerialConnection::process_error(const std::string& message){
+    WriteSpinLock lg(m_error_lock);
+
+    const size_t consecutive_errors = m_consecutive_errors.fetch_add(1);
+
+    if (consecutive_errors <= 100){
+        serial_debug_log(message);
+    }
+    if (consecutive_errors == 100){
+        serial_debug_log("Further error messages will be suppressed.");
+    }
+}
+
+
+
+}
+#endif
@@ -0,0 +1,87 @@
+/*  Serial Connection for Linux (epoll)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Same interface as the POSIX version. But instead of a receive thread per
+ *  port, all the ports on a thread pool share one SerialEventLoop thread.
+ *  Stopping a port no longer waits out a read() timeout and a blocked send
+ *  waits on write-readiness instead of sleeping and retrying.
+ *
+ */
+
+#ifndef PokemonAutomation_SerialConnectionEpoll_H
+#define PokemonAutomation_SerialConnectionEpoll_H
+
+#include <string>
+#include <atomic>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/ThreadPool.h"
+#include "Common/Cpp/StreamConnections/PushingStreamConnections.h"
+#include "SerialEventLoop.h"
+
+namespace PokemonAutomation{
+
+void serial_debug_log(const std::string& msg);
+
+
+
+class SerialConnection : public UnreliableStreamConnectionPushing, private SerialEventLoop::Handler{
+public:
+    //  UTF-8
+    SerialConnection(
+        ThreadPool& thread_pool,
+        const std::string& name,
+        uint32_t baud_rate
+    );
+    SerialConnection(
+        SerialEventLoop& event_loop,
+        const std::string& name,
+        uint32_t baud_rate
+    );
+    virtual ~SerialConnection();
+
+    virtual void stop() noexcept final;
+
+    void set_baud_rate(uint32_t baud_rate);
+
+    void get_control_state(bool& dtr, bool& rts);
+    void set_control_state(bool dtr, bool rts);
+
+
+private:
+    //  Send the specified data to the serial port. Returns the # of bytes actually sent.
+    //  This function is blocking and will only return when one of the following happens:
+    //  1. The data is fully sent out. (in which it will return bytes)
+    //  2. There is an error. (returns less than bytes)
+    //  3. The connection is stopped from a different thread.
+    virtual size_t unreliable_send(const void* data, size_t bytes) noexcept override;
+
+    virtual void on_readable() noexcept override;
+    virtual void on_writable() noexcept override;
+    virtual void on_hangup() noexcept override;
+
+    void process_error(const std::string& message);
+
+
+private:
+    SerialEventLoop& m_event_loop;
+    int m_fd;
+    std::atomic<bool> m_exit;
+    std::atomic<size_t> m_consecutive_errors;
+
+    Mutex m_send_lock;
+    SpinLock m_error_lock;
+
+    //  Set by the event loop when the port can take more data or is gone.
+    Mutex m_write_lock;
+    ConditionVariable m_write_cv;
+    bool m_writable;
+    bool m_hung_up;
+};
+
+
+}
+
+#endif
@@ -0,0 +1,208 @@
+/*  Serial Event Loop
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#if defined(__linux__)
+
+#include <memory>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PanicDump.h"
+#include "SerialConnection.h"
+#include "SerialEventLoop.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+SerialEventLoop& SerialEventLoop::instance(ThreadPool& thread_pool){
+    static Mutex lock;
+    static std::map<ThreadPool*, std::unique_ptr<SerialEventLoop>> loops;
+
+    std::lock_guard<Mutex> lg(lock);
+    std::unique_ptr<SerialEventLoop>& loop = loops[&thread_pool];
+    if (!loop){
+        loop.reset(new SerialEventLoop(thread_pool));
+    }
+    return *loop;
+}
+
+
+SerialEventLoop::SerialEventLoop(ThreadPool& thread_pool)
+    : m_stopping(false)
+    , m_running_fd(-1)
+{
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "epoll_create1() failed. Error = " + std::to_string(error));
+    }
+    m_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wake_fd == -1){
+        int error = errno;
+        close(m_epoll_fd);
+        throw ConnectionException(nullptr, "eventfd() failed. Error = " + std::to_string(error));
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = m_wake_fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_wake_fd, &event) == -1){
+        int error = errno;
+        close(m_wake_fd);
+        close(m_epoll_fd);
+        throw ConnectionException(nullptr, "epoll_ctl() failed. Error = " + std::to_string(error));
+    }
+
+    try{
+        m_thread = thread_pool.dispatch_now_blocking([this]{
+            run_with_catch(
+                "SerialEventLoop::thread_loop()",
+                [this]{ thread_loop(); }
+            );
+        });
+    }catch (...){
+        close(m_wake_fd);
+        close(m_epoll_fd);
+        throw;
+    }
+}
+SerialEventLoop::~SerialEventLoop(){
+    m_stopping.store(true, std::memory_order_release);
+    uint64_t one = 1;
+    if (write(m_wake_fd, &one, sizeof(one)) < 0){
+        serial_debug_log("Unable to wake serial event loop. Error = " + std::to_string(errno));
+    }
+    m_thread.wait_and_ignore_exceptions();
+    close(m_wake_fd);
+    close(m_epoll_fd);
+}
+
+
+size_t SerialEventLoop::ports() const{
+    std::lock_guard<Mutex> lg(m_lock);
+    return m_handlers.size();
+}
+void SerialEventLoop::add(int fd, Handler& handler){
+    std::lock_guard<Mutex> lg(m_lock);
+    if (!m_handlers.emplace(fd, &handler).second){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Attempted to add the same fd twice: " + std::to_string(fd));
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1){
+        int error = errno;
+        m_handlers.erase(fd);
+        throw ConnectionException(nullptr, "epoll_ctl() failed. Error = " + std::to_string(error));
+    }
+}
+void SerialEventLoop::set_write_notifications(int fd, bool enabled){
+    epoll_event event{};
+    event.events = enabled ? EPOLLIN | EPOLLOUT : EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_MOD, fd, &event) == -1){
+        int error = errno;
+        //  Already removed.
+        if (error == ENOENT){
+            return;
+        }
+        throw ConnectionException(nullptr, "epoll_ctl() failed. Error = " + std::to_string(error));
+    }
+}
+void SerialEventLoop::remove(int fd) noexcept{
+    std::unique_lock<Mutex> lg(m_lock);
+    if (m_handlers.erase(fd) != 0){
+        epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+    }
+
+    //  Called from inside a callback. Nothing to wait for.
+    if (std::this_thread::get_id() == m_thread_id){
+        return;
+    }
+
+    //  Still wait if it was already removed. It may have removed itself from
+    //  a callback that hasn't returned yet.
+    m_cv.wait(lg, [this, fd]{ return m_running_fd != fd; });
+}
+
+
+void SerialEventLoop::thread_loop(){
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        m_thread_id = std::this_thread::get_id();
+    }
+
+    epoll_event events[64];
+    while (true){
+        int count = epoll_wait(m_epoll_fd, events, sizeof(events) / sizeof(epoll_event), -1);
+        if (count < 0){
+            int error = errno;
+            if (error == EINTR){
+                continue;
+            }
+            serial_debug_log("epoll_wait() failed. Error = " + std::to_string(error));
+            return;
+        }
+
+        for (int c = 0; c < count; c++){
+            const epoll_event& event = events[c];
+            int fd = event.data.fd;
+
+            if (fd == m_wake_fd){
+                uint64_t value;
+                while (read(m_wake_fd, &value, sizeof(value)) > 0);
+                continue;
+            }
+
+            Handler* handler;
+            {
+                std::lock_guard<Mutex> lg(m_lock);
+                auto iter = m_handlers.find(fd);
+
+                //  Removed after epoll_wait() returned.
+                if (iter == m_handlers.end()){
+                    continue;
+                }
+                handler = iter->second;
+                m_running_fd = fd;
+            }
+
+            //  Drain any data before reporting the hangup.
+            if (event.events & EPOLLIN){
+                handler->on_readable();
+            }
+            if (event.events & EPOLLOUT){
+                handler->on_writable();
+            }
+            if (event.events & (EPOLLHUP | EPOLLERR)){
+                handler->on_hangup();
+            }
+
+            {
+                std::lock_guard<Mutex> lg(m_lock);
+                m_running_fd = -1;
+            }
+            m_cv.notify_all();
+        }
+
+        if (m_stopping.load(std::memory_order_acquire)){
+            return;
+        }
+    }
+}
+
+
+
+}
+#endif
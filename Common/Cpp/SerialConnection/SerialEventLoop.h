@@ -0,0 +1,80 @@
+/*  Serial Event Loop
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  A single I/O thread that serves any number of serial ports through epoll.
+ *  (Linux only)
+ *
+ *  The ports are non-blocking. The loop calls the handler when the port is
+ *  readable and, only while someone is waiting to send, when it is writable.
+ *
+ */
+
+#ifndef PokemonAutomation_SerialEventLoop_H
+#define PokemonAutomation_SerialEventLoop_H
+
+#include <map>
+#include <atomic>
+#include <thread>
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "Common/Cpp/Concurrency/ThreadPool.h"
+
+namespace PokemonAutomation{
+
+
+class SerialEventLoop{
+public:
+    struct Handler{
+        //  These are called on the event loop thread. Don't block in them.
+        virtual void on_readable() noexcept = 0;
+        virtual void on_writable() noexcept = 0;
+        virtual void on_hangup() noexcept = 0;
+    };
+
+public:
+    //  The loop runs on a thread taken from "thread_pool".
+    SerialEventLoop(ThreadPool& thread_pool);
+    ~SerialEventLoop();
+
+    //  One shared loop per thread pool.
+    static SerialEventLoop& instance(ThreadPool& thread_pool);
+
+    size_t ports() const;
+
+    //  "fd" must be non-blocking.
+    void add(int fd, Handler& handler);
+
+    //  Turn write-readiness notifications for "fd" on or off.
+    void set_write_notifications(int fd, bool enabled);
+
+    //  Once this returns, no callback for "fd" is running or will run.
+    //  Safe to call from inside a callback and to call more than once.
+    void remove(int fd) noexcept;
+
+
+private:
+    void thread_loop();
+
+
+private:
+    int m_epoll_fd;
+    int m_wake_fd;
+    std::atomic<bool> m_stopping;
+
+    mutable Mutex m_lock;
+    ConditionVariable m_cv;
+    std::map<int, Handler*> m_handlers;
+
+    //  The fd whose callback is currently running. -1 if none.
+    int m_running_fd;
+    std::thread::id m_thread_id;
+
+    AsyncTask m_thread;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,197 @@
+/*  Serial Port for POSIX
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Port setup shared by the POSIX serial connection backends.
+ *
+ */
+
+#ifndef PokemonAutomation_SerialPortPOSIX_H
+#define PokemonAutomation_SerialPortPOSIX_H
+
+#include <stdint.h>
+#include <string>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include "Common/Cpp/Exceptions.h"
+
+namespace PokemonAutomation{
+
+
+//  Open the serial port. "flags" is OR'ed into the open() flags.
+inline int serial_open_posix(const std::string& name, int flags = 0){
+    int fd = open(name.c_str(), O_RDWR | O_NOCTTY | flags);
+    if (fd == -1){
+        int error = errno;
+        std::string str = "Unable to open serial connection. Error = " + std::to_string(error);
+        if (error == EACCES){
+            str += " (permission denied)\nPlease run as sudo.";
+        }
+        throw ConnectionException(nullptr, std::move(str));
+    }
+    return fd;
+}
+
+
+inline void serial_set_baud_rate_posix(int fd, uint32_t baud_rate){
+#ifdef __APPLE__
+    speed_t baud = baud_rate;
+#else
+    speed_t baud = B9600;
+    switch (baud_rate){
+    case 9600:   baud = B9600;   break;
+    case 19200:  baud = B19200;  break;
+    case 38400:  baud = B38400;  break;
+    case 57600:  baud = B57600;  break;
+    case 115200: baud = B115200; break;
+    case 230400: baud = B230400; break;
+    case 460800: baud = B460800; break;
+    case 500000: baud = B500000; break;
+    case 576000: baud = B576000; break;
+    case 921600: baud = B921600; break;
+    case 1000000: baud = B1000000; break;
+    case 1152000: baud = B1152000; break;
+    case 1500000: baud = B1500000; break;
+    case 2000000: baud = B2000000; break;
+    case 2500000: baud = B2500000; break;
+    case 3000000: baud = B3000000; break;
+    case 3500000: baud = B3500000; break;
+    case 4000000: baud = B4000000; break;
+    default:
+        throw ConnectionException(nullptr, "Unsupported Baud Rate: " + std::to_string(baud_rate));
+    }
+#endif
+
+    struct termios options;
+    if (tcgetattr(fd, &options) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "tcgetattr() failed. Error = " + std::to_string(error));
+    }
+//        std::cout << "read baud = " << cfgetispeed(&options) << std::endl;
+//        std::cout << "write baud = " << cfgetospeed(&options) << std::endl;
+
+    //  Baud Rate
+    if (cfsetispeed(&options, baud) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "cfsetispeed() failed. Error = " + std::to_string(error));
+    }
+    if (cfsetospeed(&options, baud) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "cfsetospeed() failed. Error = " + std::to_string(error));
+    }
+
+#if 0
+    std::cout << "BRKINT  = " << (options.c_iflag & BRKINT) << std::endl;
+    std::cout << "ICRNL   = " << (options.c_iflag & ICRNL) << std::endl;
+    std::cout << "IMAXBEL = " << (options.c_iflag & IMAXBEL) << std::endl;
+    std::cout << "OPOST   = " << (options.c_oflag & OPOST) << std::endl;
+    std::cout << "ONLCR   = " << (options.c_oflag & ONLCR) << std::endl;
+    std::cout << "ISIG    = " << (options.c_lflag & ISIG) << std::endl;
+    std::cout << "ICANON  = " << (options.c_lflag & ICANON) << std::endl;
+    std::cout << "ECHO    = " << (options.c_lflag & ECHO) << std::endl;
+    std::cout << "ECHOE   = " << (options.c_lflag & ECHOE) << std::endl;
+#endif
+    //  Disable hangup on close.
+    options.c_lflag &= ~HUPCL;
+
+    //  Configure for raw binary mode (8 bits, no parity, 1 stop bit)
+    // No parity
+    options.c_cflag &= ~PARENB;
+    // 1 stop bit
+    options.c_cflag &= ~CSTOPB;
+    // Clear size bits
+    options.c_cflag &= ~CSIZE;
+    // 8 data bits
+    options.c_cflag |= CS8;
+    // Ignore modem control lines. Important for USB-to-serial adapters (Arduino, etc.) that don't have real modem signals.
+    // Without this, the port may wait for carrier detect.
+    options.c_cflag |= CLOCAL;
+    // Enable receiver. Should be on by default, but some systems don't enable it automatically.
+    options.c_cflag |= CREAD;
+
+    //  Disable all input processing for raw binary mode.
+    //  This prevents POSIX from treating the data as text and mangling it.
+
+    // Don't send SIGINT on break
+    options.c_iflag &= ~BRKINT;
+    // Don't strip 8th bit. Critical for binary data
+    options.c_iflag &= ~ISTRIP;
+    // Don't map CR to NL
+    options.c_iflag &= ~ICRNL;
+    // Disable XON/XOFF flow control (input & output)
+    options.c_iflag &= ~(IXON | IXOFF);
+    // Don't ring bell on full input buffer
+    options.c_iflag &= ~IMAXBEL;
+
+    // Disable output processing
+    options.c_oflag &= ~OPOST;
+    // Don't map NL to CR-NL
+    options.c_oflag &= ~ONLCR;
+
+    // Disable all local processing for raw binary mode
+
+    // Don't generate signals
+    options.c_lflag &= ~ISIG;
+    // Disable canonical (line-based) mode
+    options.c_lflag &= ~ICANON;
+    // Don't echo input
+    options.c_lflag &= ~ECHO;
+    // Don't erase character echo
+    options.c_lflag &= ~ECHOE;
+    // Disable extended input processing
+    options.c_lflag &= ~IEXTEN;
+
+    //  Set blocking read with timeout so read() waits for data but can exit periodically
+    //  to check m_exit flag. VMIN=0 with VTIME>0 means: wait up to VTIME for data,
+    //  return 0 if timeout, or return immediately if any data arrives.
+    // Minimum characters to read (0 = return after timeout)
+    options.c_cc[VMIN] = 0;
+    // Read timeout in deciseconds (1 = 100ms)
+    options.c_cc[VTIME] = 1;
+
+    if (tcsetattr(fd, TCSANOW, &options) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "tcsetattr() failed. Error = " + std::to_string(error));
+    }
+
+    if (tcgetattr(fd, &options) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "tcgetattr() failed. Error = " + std::to_string(error));
+    }
+    if (cfgetispeed(&options) != baud){
+//            std::cout << "actual baud = " << cfgetispeed(&options) << std::endl;
+        throw ConnectionException(nullptr, "Unable to set input baud rate.");
+    }
+    if (cfgetospeed(&options) != baud){
+//            std::cout << "actual baud = " << cfgetospeed(&options) << std::endl;
+        throw ConnectionException(nullptr, "Unable to set output baud rate.");
+    }
+}
+
+inline void serial_get_control_state_posix(int fd, bool& dtr, bool& rts){
+    int flags;
+    if (ioctl(fd, TIOCMGET, &flags) < 0){
+        int error = errno;
+        throw ConnectionException(nullptr, "ioctl() failed. Error = " + std::to_string(error));
+    }
+
+    dtr = flags & TIOCM_DTR;
+    rts = flags & TIOCM_RTS;
+}
+inline void serial_set_control_state_posix(int fd, bool dtr, bool rts){
+    int flags;
+    if (ioctl(fd, TIOCMGET, &flags) >= 0){
+        //  Set the bitmasks for DTR and RTS
+        flags |= dtr ? TIOCM_DTR : 0;
+        flags |= rts ? TIOCM_RTS : 0;
+        ioctl(fd, TIOCMSET, &flags);
+    }
+}
+
+
+
+}
+#endif
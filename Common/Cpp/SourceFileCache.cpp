@@ -0,0 +1,111 @@
+/*  Source File Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include "Common/Cpp/Exceptions.h"
+#include "SourceFileCache.h"
+
+namespace PokemonAutomation{
+
+
+
+uint64_t source_hash(const void* data, size_t bytes){
+    //  FNV-1a style, 8 bytes at a time.
+    const uint64_t PRIME = 0x100000001b3;
+    const char* ptr = (const char*)data;
+    uint64_t hash = 0xcbf29ce484222325 ^ bytes;
+    while (bytes >= 8){
+        uint64_t word;
+        memcpy(&word, ptr, sizeof(word));
+        hash = (hash ^ word) * PRIME;
+        hash ^= hash >> 29;
+        ptr += 8;
+        bytes -= 8;
+    }
+    while (bytes > 0){
+        hash = (hash ^ (uint8_t)*ptr) * PRIME;
+        ptr++;
+        bytes--;
+    }
+    return hash ^ (hash >> 32);
+}
+
+SourceFingerprint fingerprint_source(const void* data, size_t bytes){
+    SourceFingerprint ret;
+    ret.size = bytes;
+    ret.hash = source_hash(data, bytes);
+    return ret;
+}
+
+SourceFingerprint fingerprint_source_file(const std::string& path){
+    QFile file(QString::fromStdString(path));
+    if (!file.open(QFile::ReadOnly)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", path);
+    }
+    qint64 bytes = file.size();
+    if (bytes <= 0){
+        return fingerprint_source(nullptr, 0);
+    }
+    const uchar* data = file.map(0, bytes);
+    if (data == nullptr){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to read file.", path);
+    }
+    return fingerprint_source(data, (size_t)bytes);
+}
+
+
+
+std::string source_cache_path(
+    const std::string& cache_folder,
+    const std::string& source_path,
+    const std::string& extension
+){
+    if (cache_folder.empty()){
+        return "";
+    }
+    QFileInfo info(QString::fromStdString(source_path));
+    std::string full_path = info.absoluteFilePath().toStdString();
+
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)source_hash(full_path.data(), full_path.size()));
+
+    std::string ret = cache_folder;
+    if (ret.back() != '/'){
+        ret += '/';
+    }
+    ret += info.fileName().toStdString();
+    ret += '-';
+    ret += hex;
+    ret += extension;
+    return ret;
+}
+
+bool write_source_cache(const std::string& path, const void* data, size_t bytes){
+    QString qpath = QString::fromStdString(path);
+    if (!QDir().mkpath(QFileInfo(qpath).absolutePath())){
+        return false;
+    }
+    QSaveFile file(qpath);
+    if (!file.open(QFile::WriteOnly)){
+        return false;
+    }
+    if (file.write((const char*)data, (qint64)bytes) != (qint64)bytes){
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+bool write_source_cache(const std::string& path, const std::string& data){
+    return write_source_cache(path, data.data(), data.size());
+}
+
+
+
+}
@@ -0,0 +1,66 @@
+/*  Source File Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Helpers for files that are derived from a source file and are only
+ *      kept to avoid redoing expensive work. (parsed JSON, sprite bundles)
+ *
+ *      Each derived file records the fingerprint of the source it was built
+ *      from and is thrown away when that no longer matches. Derived files
+ *      live in a cache folder of their own. They are never written next to
+ *      the source.
+ *
+ */
+
+#ifndef PokemonAutomation_SourceFileCache_H
+#define PokemonAutomation_SourceFileCache_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+
+namespace PokemonAutomation{
+
+
+//  Identifies the contents of a source file.
+struct SourceFingerprint{
+    uint64_t size = 0;
+    uint64_t hash = 0;
+
+    bool operator==(const SourceFingerprint& x) const{
+        return size == x.size && hash == x.hash;
+    }
+    bool operator!=(const SourceFingerprint& x) const{
+        return !(*this == x);
+    }
+};
+
+//  64-bit hash. Not cryptographic. It only needs to notice edits.
+uint64_t source_hash(const void* data, size_t bytes);
+
+SourceFingerprint fingerprint_source(const void* data, size_t bytes);
+
+//  Throws FileException if the file can't be read.
+SourceFingerprint fingerprint_source_file(const std::string& path);
+
+
+//  Path of the file in "cache_folder" that holds data derived from
+//  "source_path". The name is made from the file name of the source and a
+//  hash of its full path, so sources with the same name in different folders
+//  don't collide.
+//
+//  Returns empty if "cache_folder" is empty. That means "don't cache".
+std::string source_cache_path(
+    const std::string& cache_folder,
+    const std::string& source_path,
+    const std::string& extension
+);
+
+//  Atomically replace "path" with "data", creating its folder if needed.
+//  Returns false on failure. A cache that can't be written isn't an error.
+bool write_source_cache(const std::string& path, const void* data, size_t bytes);
+bool write_source_cache(const std::string& path, const std::string& data);
+
+
+}
+#endif
@@ -0,0 +1,502 @@
+/*  PABotBase2 PTY Emulator (FW)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef _WIN32
+
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/SerialPABotBase/SerialPABotBase_Protocol_IDs.h"
+#include "Common/PABotBase2/Controllers/PABotBase2_Controller_HID_Keyboard.h"
+#include "Common/PABotBase2/Controllers/PABotBase2_Controller_NS_WiredController.h"
+#include "Common/PABotBase2/Controllers/PABotBase2_Controller_NS1_OemController.h"
+#include "PABotBase2FW_PtyEmulator.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace PABotBase2{
+
+
+//  How much the device can have in flight on the line before sends start
+//  coming back short. (like a UART TX buffer)
+static constexpr size_t DEVICE_TO_HOST_CAPACITY = 4096;
+
+static constexpr uint32_t EMULATOR_FIRMWARE_VERSION = 1;
+static const char EMULATOR_DEVICE_NAME[] = "PABotBase2 PTY Emulator";
+
+
+static void set_nonblocking(int fd){
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags == -1 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1){
+        int error = errno;
+        throw ConnectionException(nullptr, "Unable to set PTY to non-blocking. Error = " + std::to_string(error));
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+}
+
+
+
+PtyEmulator::PtyEmulator(ThreadPool& thread_pool, const PtyEmulatorOptions& options)
+    : m_options(options)
+    , m_start_time(current_time())
+    , m_stopping(false)
+    , m_chunks_dropped(0)
+    , m_commands_finished(0)
+    , m_rng(options.seed)
+    , m_host_to_device_last(m_start_time)
+    , m_device_to_host_last(m_start_time)
+    , m_connection(*this)
+    , m_controller_id(PABB_CID_NintendoSwitch_WiredController)
+{
+    try{
+        m_master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0){
+            int error = errno;
+            throw ConnectionException(nullptr, "Unable to open PTY. Error = " + std::to_string(error));
+        }
+        set_nonblocking(m_master);
+        m_slave_name = ptsname(m_master);
+
+        //  Hold the slave open ourselves so the master never sees a hangup
+        //  while the host isn't connected. Put it in raw mode so the line
+        //  discipline doesn't echo or translate anything.
+        m_slave = open(m_slave_name.c_str(), O_RDWR | O_NOCTTY);
+        if (m_slave < 0){
+            int error = errno;
+            throw ConnectionException(nullptr, "Unable to open PTY slave. Error = " + std::to_string(error));
+        }
+        fcntl(m_slave, F_SETFD, FD_CLOEXEC);
+        struct termios options;
+        if (tcgetattr(m_slave, &options) == 0){
+            cfmakeraw(&options);
+            tcsetattr(m_slave, TCSANOW, &options);
+        }
+
+        if (pipe(m_wake_pipe) != 0){
+            int error = errno;
+            throw ConnectionException(nullptr, "Unable to create wake pipe. Error = " + std::to_string(error));
+        }
+        set_nonblocking(m_wake_pipe[0]);
+        set_nonblocking(m_wake_pipe[1]);
+
+        m_line_thread = thread_pool.dispatch_now_blocking([this]{ line_thread(); });
+        m_firmware_thread = thread_pool.dispatch_now_blocking([this]{ firmware_thread(); });
+    }catch (...){
+        m_stopping.store(true, std::memory_order_release);
+        wake_line_thread();
+        m_line_thread.wait_and_ignore_exceptions();
+        close_fds();
+        throw;
+    }
+}
+PtyEmulator::~PtyEmulator(){
+    m_stopping.store(true, std::memory_order_release);
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+    }
+    m_device_cv.notify_all();
+    wake_line_thread();
+    m_firmware_thread.wait_and_ignore_exceptions();
+    m_line_thread.wait_and_ignore_exceptions();
+    close_fds();
+}
+void PtyEmulator::close_fds() noexcept{
+    for (int* fd : {&m_master, &m_slave, &m_wake_pipe[0], &m_wake_pipe[1]}){
+        if (*fd >= 0){
+            close(*fd);
+            *fd = -1;
+        }
+    }
+}
+
+
+
+//
+//  Line
+//
+
+bool PtyEmulator::should_drop(){
+    if (m_options.drop_rate <= 0){
+        return false;
+    }
+    std::uniform_real_distribution<double> distribution(0, 1);
+    if (distribution(m_rng) >= m_options.drop_rate){
+        return false;
+    }
+    m_chunks_dropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+WallClock PtyEmulator::release_time(WallClock& last_release){
+    WallDuration delay = m_options.latency;
+    if (m_options.jitter > WallDuration::zero()){
+        std::uniform_int_distribution<int64_t> distribution(0, m_options.jitter.count());
+        delay += WallDuration(distribution(m_rng));
+    }
+    WallClock release = std::max(current_time() + delay, last_release);
+    last_release = release;
+    return release;
+}
+
+size_t PtyEmulator::unreliable_send(const void* data, size_t bytes) noexcept{
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+
+        //  Lost on the wire. The sender can't tell.
+        if (should_drop()){
+            return bytes;
+        }
+
+        bytes = std::min(bytes, DEVICE_TO_HOST_CAPACITY - m_device_to_host_bytes);
+        if (bytes == 0){
+            return 0;
+        }
+
+        Chunk& chunk = m_device_to_host.emplace_back();
+        chunk.release = release_time(m_device_to_host_last);
+        chunk.data.assign((const uint8_t*)data, (const uint8_t*)data + bytes);
+        m_device_to_host_bytes += bytes;
+    }
+    wake_line_thread();
+    return bytes;
+}
+size_t PtyEmulator::unreliable_recv(void* data, size_t max_bytes, const WallDuration& timeout) noexcept{
+    WallClock deadline = timeout == WallDuration::max()
+        ? WallClock::max()
+        : current_time() + timeout;
+
+    std::unique_lock<Mutex> lg(m_lock);
+    while (true){
+        WallClock now = current_time();
+
+        size_t read = 0;
+        while (read < max_bytes && !m_host_to_device.empty()){
+            Chunk& chunk = m_host_to_device.front();
+            if (chunk.release > now){
+                break;
+            }
+            size_t bytes = std::min(max_bytes - read, chunk.data.size() - chunk.offset);
+            memcpy((uint8_t*)data + read, chunk.data.data() + chunk.offset, bytes);
+            read += bytes;
+            chunk.offset += bytes;
+            if (chunk.offset == chunk.data.size()){
+                m_host_to_device.pop_front();
+            }
+        }
+
+        if (read > 0 || now >= deadline || m_stopping.load(std::memory_order_relaxed)){
+            return read;
+        }
+
+        WallClock wake = deadline;
+        if (!m_host_to_device.empty()){
+            wake = std::min(wake, m_host_to_device.front().release);
+        }
+        m_device_cv.wait_until(lg, wake);
+    }
+}
+
+void PtyEmulator::wake_line_thread(){
+    if (m_wake_pipe[1] >= 0){
+        char ch = 0;
+        [[maybe_unused]] ssize_t ret = write(m_wake_pipe[1], &ch, 1);
+    }
+}
+void PtyEmulator::line_thread(){
+    uint8_t buffer[4096];
+    while (!m_stopping.load(std::memory_order_acquire)){
+        //  Host -> Device
+        while (true){
+            ssize_t bytes = read(m_master, buffer, sizeof(buffer));
+            if (bytes <= 0){
+                break;
+            }
+            {
+                std::lock_guard<Mutex> lg(m_lock);
+                if (should_drop()){
+                    continue;
+                }
+                Chunk& chunk = m_host_to_device.emplace_back();
+                chunk.release = release_time(m_host_to_device_last);
+                chunk.data.assign(buffer, buffer + bytes);
+            }
+            m_device_cv.notify_all();
+        }
+
+        //  Device -> Host
+        WallClock next_release = WallClock::max();
+        bool blocked = false;
+        {
+            std::lock_guard<Mutex> lg(m_lock);
+            WallClock now = current_time();
+            while (!m_device_to_host.empty()){
+                Chunk& chunk = m_device_to_host.front();
+                if (chunk.release > now){
+                    next_release = chunk.release;
+                    break;
+                }
+                ssize_t bytes = write(
+                    m_master,
+                    chunk.data.data() + chunk.offset,
+                    chunk.data.size() - chunk.offset
+                );
+                if (bytes <= 0){
+                    blocked = true;
+                    break;
+                }
+                chunk.offset += bytes;
+                m_device_to_host_bytes -= bytes;
+                if (chunk.offset < chunk.data.size()){
+                    blocked = true;
+                    break;
+                }
+                m_device_to_host.pop_front();
+            }
+        }
+
+        //  Sleep until the PTY has something for us, the next delayed chunk is
+        //  due, or the device sends something.
+        int64_t timeout_us = 100000;
+        if (next_release != WallClock::max()){
+            int64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(
+                next_release - current_time()
+            ).count();
+            timeout_us = std::clamp<int64_t>(micros, 0, timeout_us);
+        }
+
+        struct pollfd fds[2];
+        fds[0].fd = m_master;
+        fds[0].events = blocked ? POLLIN | POLLOUT : POLLIN;
+        fds[0].revents = 0;
+        fds[1].fd = m_wake_pipe[0];
+        fds[1].events = POLLIN;
+        fds[1].revents = 0;
+#if defined(__linux__)
+        //  poll() would round the injected delays up to the millisecond.
+        struct timespec timeout;
+        timeout.tv_sec = (time_t)(timeout_us / 1000000);
+        timeout.tv_nsec = (long)(timeout_us % 1000000) * 1000;
+        ppoll(fds, 2, &timeout, nullptr);
+#else
+        poll(fds, 2, (int)((timeout_us + 999) / 1000));
+#endif
+
+        if (fds[1].revents & POLLIN){
+            char drain[64];
+            while (read(m_wake_pipe[0], drain, sizeof(drain)) > 0);
+        }
+    }
+}
+
+
+
+//
+//  Firmware
+//
+
+uint32_t PtyEmulator::device_timestamp() const{
+    return (uint32_t)std::chrono::duration_cast<Milliseconds>(current_time() - m_start_time).count();
+}
+void PtyEmulator::firmware_thread(){
+    while (!m_stopping.load(std::memory_order_acquire)){
+        WallClock now = current_time();
+        run_command_queue(now);
+        flush_sends();
+
+        WallDuration timeout = Milliseconds(10);
+        if (m_command_running){
+            timeout = std::min(timeout, std::max(m_command_finish - now, WallDuration::zero()));
+        }
+
+        m_connection.run_send_events(WallDuration::zero());
+        m_connection.run_recv_events(timeout);
+        process_messages();
+    }
+}
+
+void PtyEmulator::process_messages(){
+    char buffer[256];
+    size_t bytes;
+    while ((bytes = m_connection.reliable_recv(buffer, sizeof(buffer))) > 0){
+        m_recv_buffer.append(buffer, bytes);
+    }
+
+    size_t offset = 0;
+    while (m_recv_buffer.size() - offset >= sizeof(MessageHeader)){
+        MessageHeader header;
+        memcpy(&header, m_recv_buffer.data() + offset, sizeof(MessageHeader));
+
+        //  The stream is corrupted. There's nothing to resync on.
+        if (header.message_bytes < sizeof(MessageHeader)){
+            m_recv_buffer.clear();
+            return;
+        }
+
+        //  Message is incomplete.
+        if (m_recv_buffer.size() - offset < header.message_bytes){
+            break;
+        }
+
+        process_message((const MessageHeader*)(m_recv_buffer.data() + offset));
+        offset += header.message_bytes;
+    }
+    m_recv_buffer.erase(0, offset);
+}
+void PtyEmulator::process_message(const MessageHeader* header){
+    switch (header->opcode){
+    case PABB2_MESSAGE_OPCODE_PROTOCOL_VERSION:
+        send_ret_u32(header->id, PABB2_MESSAGE_PROTOCOL_VERSION);
+        return;
+    case PABB2_MESSAGE_OPCODE_FIRMWARE_VERSION:
+        send_ret_u32(header->id, EMULATOR_FIRMWARE_VERSION);
+        return;
+    case PABB2_MESSAGE_OPCODE_DEVICE_IDENTIFIER:
+        send_ret_u32(header->id, PABB_PID_UNSPECIFIED);
+        return;
+    case PABB2_MESSAGE_OPCODE_DEVICE_NAME:
+        send_ret_data(header->id, EMULATOR_DEVICE_NAME, sizeof(EMULATOR_DEVICE_NAME) - 1);
+        return;
+    case PABB2_MESSAGE_OPCODE_CONTROLLER_LIST:{
+        pabb_ControllerID list[] = {PABB_CID_NintendoSwitch_WiredController};
+        send_ret_data(header->id, list, sizeof(list));
+        return;
+    }
+    case PABB2_MESSAGE_OPCODE_CQ_CAPACITY:
+        send_ret_u32(header->id, m_options.command_queue_size);
+        return;
+    case PABB2_MESSAGE_OPCODE_READ_CONTROLLER_MODE:
+        send_ret_u32(header->id, m_controller_id);
+        return;
+    case PABB2_MESSAGE_OPCODE_CHANGE_CONTROLLER_MODE:
+    case PABB2_MESSAGE_OPCODE_RESET_TO_CONTROLLER:
+        if (header->message_bytes >= sizeof(Message_u32)){
+            memcpy(&m_controller_id, &((const Message_u32*)header)->data, sizeof(uint32_t));
+        }
+        return;
+    case PABB2_MESSAGE_OPCODE_SET_LOGGING_FLAG:
+        return;
+
+    case PABB2_MESSAGE_OPCODE_CQ_CANCEL:
+        m_commands.clear();
+        m_command_running = false;
+        m_replace_on_next = false;
+        return;
+    case PABB2_MESSAGE_OPCODE_CQ_REPLACE_ON_NEXT:
+        m_replace_on_next = true;
+        return;
+
+    case PABB2_MESSAGE_CMD_HID_KEYBOARD_STATE:
+    case PABB2_MESSAGE_CMD_NS_WIRED_CONTROLLER_STATE:
+    case PABB2_MESSAGE_CMD_NS1_OEM_CONTROLLER_BUTTONS:
+    case PABB2_MESSAGE_CMD_NS1_OEM_CONTROLLER_FULL_STATE:{
+        if (m_replace_on_next){
+            m_replace_on_next = false;
+            m_commands.clear();
+            m_command_running = false;
+        }
+        if (m_commands.size() >= m_options.command_queue_size){
+            MessageHeader dropped;
+            dropped.message_bytes = sizeof(MessageHeader);
+            dropped.opcode = PABB2_MESSAGE_OPCODE_CQ_COMMAND_DROPPED;
+            dropped.id = header->id;
+            send_message(&dropped, sizeof(dropped));
+            return;
+        }
+
+        //  All commands start with the duration.
+        Command command;
+        command.id = header->id;
+        command.milliseconds = 0;
+        if (header->message_bytes >= sizeof(MessageHeader) + sizeof(uint16_t)){
+            memcpy(&command.milliseconds, header + 1, sizeof(uint16_t));
+        }
+        m_commands.emplace_back(command);
+        return;
+    }
+
+    default:{
+        MessageHeader dropped;
+        dropped.message_bytes = sizeof(MessageHeader);
+        dropped.opcode = PABB2_MESSAGE_OPCODE_REQUEST_DROPPED;
+        dropped.id = header->id;
+        send_message(&dropped, sizeof(dropped));
+    }
+    }
+}
+void PtyEmulator::run_command_queue(WallClock now){
+    while (!m_commands.empty()){
+        const Command& command = m_commands.front();
+        if (!m_command_running){
+            m_command_running = true;
+            m_command_finish = m_options.honor_command_durations
+                ? now + Milliseconds(command.milliseconds)
+                : now;
+        }
+        if (now < m_command_finish){
+            return;
+        }
+
+        Message_u32 finished;
+        finished.message_bytes = sizeof(Message_u32);
+        finished.opcode = PABB2_MESSAGE_OPCODE_CQ_COMMAND_FINISHED;
+        finished.id = command.id;
+        finished.data = device_timestamp();
+        send_message(&finished, sizeof(finished));
+
+        m_commands.pop_front();
+        m_command_running = false;
+        m_commands_finished.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PtyEmulator::send_message(const void* message, size_t bytes){
+    m_pending_sends.emplace_back((const char*)message, bytes);
+    flush_sends();
+}
+void PtyEmulator::send_ret_u32(uint8_t id, uint32_t data){
+    Message_u32 message;
+    message.message_bytes = sizeof(Message_u32);
+    message.opcode = PABB2_MESSAGE_OPCODE_RET_U32;
+    message.id = id;
+    message.data = data;
+    send_message(&message, sizeof(message));
+}
+void PtyEmulator::send_ret_data(uint8_t id, const void* data, size_t bytes){
+    MessageHeader header;
+    header.message_bytes = (uint16_t)(sizeof(MessageHeader) + bytes);
+    header.opcode = PABB2_MESSAGE_OPCODE_RET_DATA;
+    header.id = id;
+    std::string message((const char*)&header, sizeof(MessageHeader));
+    message.append((const char*)data, bytes);
+    m_pending_sends.emplace_back(std::move(message));
+    flush_sends();
+}
+bool PtyEmulator::flush_sends(){
+    //  Messages go out in order. If the send window is full, the rest wait
+    //  for the next iteration.
+    while (!m_pending_sends.empty()){
+        const std::string& message = m_pending_sends.front();
+        if (!m_connection.reliable_send_all_or_nothing(message.data(), message.size())){
+            return false;
+        }
+        m_pending_sends.pop_front();
+    }
+    return true;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,159 @@
+/*  PABotBase2 PTY Emulator (FW)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Emulates a PABotBase2 microcontroller on the other end of a pseudo-terminal.
+ *  (POSIX only)
+ *
+ *  Unlike MockDevice, the host connects to this with a real SerialConnection
+ *  on "slave_name()". The device side runs the same ReliableStreamConnectionFW
+ *  as the firmware does and answers the basic device queries and the command
+ *  queue. Latency, jitter and packet loss can be injected on the line.
+ *
+ */
+
+#ifndef PokemonAutomation_PABotBase2FW_PtyEmulator_H
+#define PokemonAutomation_PABotBase2FW_PtyEmulator_H
+
+#ifndef _WIN32
+
+#include <stdint.h>
+#include <string>
+#include <deque>
+#include <vector>
+#include <random>
+#include <atomic>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "Common/Cpp/Concurrency/ThreadPool.h"
+#include "Common/Cpp/StreamConnections/PollingStreamConnections.h"
+#include "Common/PABotBase2/PABotBase2_MessageProtocol.h"
+#include "Common/PABotBase2/ReliableConnectionLayer/PABotBase2FW_ReliableStreamConnection.h"
+
+namespace PokemonAutomation{
+namespace PABotBase2{
+
+
+
+struct PtyEmulatorOptions{
+    //  One-way delay added to everything crossing the line in either direction.
+    WallDuration latency = WallDuration::zero();
+
+    //  Additional uniformly random delay in [0, jitter]. The line never
+    //  reorders bytes, so a chunk is never released before the one ahead of it.
+    WallDuration jitter = WallDuration::zero();
+
+    //  Probability that a chunk of bytes is lost. A chunk is one read from the
+    //  PTY (host -> device) or one send from the device (device -> host).
+    double drop_rate = 0;
+
+    uint32_t seed = 0;
+
+    uint8_t command_queue_size = 16;
+
+    //  If true, each command is held for its "milliseconds" like the real
+    //  firmware. Otherwise commands finish as soon as they reach the front of
+    //  the queue which isolates the transport latency.
+    bool honor_command_durations = false;
+};
+
+
+class PtyEmulator final : private UnreliableStreamConnectionPolling{
+public:
+    //  Takes 2 threads from "thread_pool".
+    PtyEmulator(ThreadPool& thread_pool, const PtyEmulatorOptions& options = PtyEmulatorOptions());
+    ~PtyEmulator();
+
+    //  Open this with a SerialConnection.
+    const std::string& slave_name() const{
+        return m_slave_name;
+    }
+
+    uint64_t chunks_dropped() const{
+        return m_chunks_dropped.load(std::memory_order_relaxed);
+    }
+    uint64_t commands_finished() const{
+        return m_commands_finished.load(std::memory_order_relaxed);
+    }
+
+
+private:
+    struct Chunk{
+        WallClock release;
+        size_t offset = 0;
+        std::vector<uint8_t> data;
+    };
+    struct Command{
+        uint8_t id;
+        uint16_t milliseconds;
+    };
+
+    void close_fds() noexcept;
+
+    //  Must call under "m_lock".
+    bool should_drop();
+    WallClock release_time(WallClock& last_release);
+
+    virtual size_t unreliable_send(const void* data, size_t bytes) noexcept override;
+    virtual size_t unreliable_recv(void* data, size_t max_bytes, const WallDuration& timeout) noexcept override;
+
+    void line_thread();
+    void wake_line_thread();
+
+    void firmware_thread();
+    void process_messages();
+    void process_message(const MessageHeader* header);
+    void run_command_queue(WallClock now);
+    void send_message(const void* message, size_t bytes);
+    void send_ret_u32(uint8_t id, uint32_t data);
+    void send_ret_data(uint8_t id, const void* data, size_t bytes);
+    bool flush_sends();
+    uint32_t device_timestamp() const;
+
+
+private:
+    const PtyEmulatorOptions m_options;
+    const WallClock m_start_time;
+
+    int m_master = -1;
+    int m_slave = -1;
+    int m_wake_pipe[2] = {-1, -1};
+    std::string m_slave_name;
+
+    std::atomic<bool> m_stopping;
+    std::atomic<uint64_t> m_chunks_dropped;
+    std::atomic<uint64_t> m_commands_finished;
+
+    //  The line. Protected by "m_lock".
+    mutable Mutex m_lock;
+    ConditionVariable m_device_cv;
+    std::mt19937 m_rng;
+    std::deque<Chunk> m_host_to_device;
+    std::deque<Chunk> m_device_to_host;
+    size_t m_device_to_host_bytes = 0;
+    WallClock m_host_to_device_last;
+    WallClock m_device_to_host_last;
+
+    //  Everything below is only touched by the firmware thread.
+    ReliableStreamConnectionFW m_connection;
+    std::string m_recv_buffer;
+    std::deque<std::string> m_pending_sends;
+
+    std::deque<Command> m_commands;
+    bool m_replace_on_next = false;
+    bool m_command_running = false;
+    WallClock m_command_finish;
+    uint32_t m_controller_id;
+
+    AsyncTask m_line_thread;
+    AsyncTask m_firmware_thread;
+};
+
+
+
+}
+}
+#endif
+#endif
@@ -119,7 +119,14 @@ void ReliableStreamConnection::reliable_send_all_or_nothing(
             m_cv.wait(lg);
             continue;
         }
+        bool idle = m_reliable_sender.slots_used() == 0;
         if (m_reliable_sender.send_stream_all_or_nothing(ptr, bytes)){
+            //  The retransmit thread sleeps with no timeout while nothing is
+            //  in flight. Wake it up so it will retransmit this if it's lost.
+            if (idle){
+                lg.unlock();
+                m_cv.notify_all();
+            }
             return;
         }
         m_cv.wait(lg);
@@ -141,7 +148,12 @@ bool ReliableStreamConnection::reliable_send_all_or_nothing(
             m_cv.wait_until(lg, deadline);
             continue;
         }
+        bool idle = m_reliable_sender.slots_used() == 0;
         if (m_reliable_sender.send_stream_all_or_nothing(ptr, bytes)){
+            if (idle){
+                lg.unlock();
+                m_cv.notify_all();
+            }
             return true;
         }
         m_cv.wait_until(lg, deadline);
@@ -228,21 +240,34 @@ bool ReliableStreamConnection::reset(WallDuration timeout){
 }
 
 bool ReliableStreamConnection::try_send_request(uint8_t opcode){
-    std::lock_guard<Mutex> lg(m_lock);
+    std::unique_lock<Mutex> lg(m_lock);
 //    cout << "Sending: " << tostr_hex(opcode) << endl;
     throw_if_cancelled();
     if (m_reliable_sender.slots_used() >= m_max_unacked_packets){
         return 0;
     }
-    return m_reliable_sender.send_packet(opcode, 0, nullptr);
+    bool idle = m_reliable_sender.slots_used() == 0;
+    if (!m_reliable_sender.send_packet(opcode, 0, nullptr)){
+        return false;
+    }
+    if (idle){
+        lg.unlock();
+        m_cv.notify_all();
+    }
+    return true;
 }
 void ReliableStreamConnection::send_request(uint8_t opcode){
     std::unique_lock<Mutex> lg(m_lock);
     while (true){
         throw_if_cancelled();
+        bool idle = m_reliable_sender.slots_used() == 0;
         if (m_reliable_sender.slots_used() < m_max_unacked_packets &&
             m_reliable_sender.send_packet(opcode, 0, nullptr)
         ){
+            if (idle){
+                lg.unlock();
+                m_cv.notify_all();
+            }
             return;
         }
         m_cv.wait(lg);
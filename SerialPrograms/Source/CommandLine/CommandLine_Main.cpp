@@ -8,6 +8,7 @@
 
 #include <iostream>
 #include "Common/Cpp/Color.h"
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Logging/MultiOutputLogger.h"
 #include "Common/Cpp/Logging/FileLogger.h"
 #include "Common/Cpp/Logging/GlobalLogger.h"
@@ -15,6 +16,7 @@
 #include "CommonFramework/Logging/Logger.h"
 // #include "CommonFramework/Logging/OutputRedirector.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "CommonTools/Resources/SpriteDatabase.h"
 #include "Integrations/PybindSwitchController.h"
 #include "NintendoSwitch/Controllers/NintendoSwitch_ControllerButtons.h"
 
@@ -37,6 +39,27 @@ FileLogger& global_file_logger(){
 }
 
 
+//  Offline build step for the precompiled sprite bundles.
+//  "args" are pairs of sprite sheet and json paths relative to the resource folder.
+int build_sprite_bundles(Logger& logger, int argc, char* argv[]){
+    if (argc == 0 || argc % 2 != 0){
+        logger.log("Usage: --build-sprite-bundle <sprites.png> <sprites.json> [<sprites.png> <sprites.json> ...]", COLOR_RED);
+        return 1;
+    }
+    int errors = 0;
+    for (int c = 0; c < argc; c += 2){
+        logger.log("Building sprite bundle: " + std::string(argv[c]));
+        try{
+            SpriteDatabase::build_bundle(argv[c], argv[c + 1]);
+        }catch (const Exception& e){
+            logger.log("Failed: " + e.to_str(), COLOR_RED);
+            errors++;
+        }
+    }
+    return errors == 0 ? 0 : 1;
+}
+
+
 }
 
 int main(int argc, char* argv[]){
@@ -56,6 +79,12 @@ int main(int argc, char* argv[]){
     logger.log("Starting Program...");
     logger.log("Pokemon Automation - Command Line Tool");
 
+    if (argc >= 2 && std::string(argv[1]) == "--build-sprite-bundle"){
+        int ret = build_sprite_bundles(logger, argc - 2, argv + 2);
+        global_file_logger().stop();
+        return ret;
+    }
+
     // Check if port name argument is provided
     if (argc < 2){
         logger.log("Usage: " + std::string(argv[0]) + " <port_name>", COLOR_RED);
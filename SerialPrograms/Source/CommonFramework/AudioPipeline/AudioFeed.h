@@ -9,8 +9,11 @@
 
 #include <memory>
 #include <vector>
+#include <atomic>
+#include <optional>
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Containers/AlignedVector.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
 
 namespace PokemonAutomation{
 
@@ -37,6 +40,88 @@ public:
     {}
 };
 
+//  One slot of a spectrum ring. The lock is only held while a spectrum is
+//  copied in or out of the slot. The writer is normally far ahead of every
+//  reader, so it is almost never contended.
+struct AudioSpectrumSlot{
+    mutable SpinLockMRSW lock;
+    AudioSpectrum spectrum{0, 0, nullptr};
+};
+
+//  A read-only window into the spectrum ring of an audio feed. Making one
+//  copies nothing. Index 0 is the newest spectrum, same as the vectors
+//  returned by "spectrums_since()".
+//
+//  The spectrums still belong to the ring and their slots will eventually be
+//  reused. Every read checks the stamp of the slot, so a spectrum that the
+//  writer has already replaced is never returned. Use a view right away and
+//  don't hold onto it or the older spectrums will be gone.
+class AudioSpectrumView{
+public:
+    AudioSpectrumView() = default;
+    AudioSpectrumView(
+        const AudioSpectrumSlot* slots, size_t capacity,
+        const std::atomic<uint64_t>* writer_end,
+        uint64_t begin_stamp, uint64_t end_stamp
+    )
+        : m_slots(slots)
+        , m_capacity(capacity)
+        , m_writer_end(writer_end)
+        , m_begin(begin_stamp)
+        , m_end(end_stamp)
+    {}
+
+    bool empty() const{ return m_begin == m_end; }
+    size_t size() const{ return (size_t)(m_end - m_begin); }
+
+    //  Stamp of the oldest spectrum and one past the newest one.
+    uint64_t begin_stamp() const{ return m_begin; }
+    uint64_t end_stamp() const{ return m_end; }
+
+    //  Returns nothing if the spectrum has already been overwritten.
+    std::optional<AudioSpectrum> get(size_t index) const{
+        std::optional<AudioSpectrum> ret;
+        const AudioSpectrumSlot& slot = m_slots[(m_end - 1 - index) & (m_capacity - 1)];
+        ReadSpinLock lg(slot.lock);
+        if (slot.spectrum.stamp == m_end - 1 - index){
+            ret.emplace(slot.spectrum);
+        }
+        return ret;
+    }
+
+    //  The writer has caught up to this view and may be overwriting it.
+    bool stale() const{
+        return m_writer_end != nullptr &&
+            m_writer_end->load(std::memory_order_acquire) >= m_begin + m_capacity;
+    }
+
+    //  Copy out as a vector (newest first). "spectrums" is cleared first, but
+    //  its capacity is kept.
+    //
+    //  The writer overwrites oldest first. So if it has lapped this view, the
+    //  copy stops at the first spectrum that is gone and only the newer ones
+    //  are returned.
+    void copy_to(std::vector<AudioSpectrum>& spectrums) const{
+        spectrums.clear();
+        spectrums.reserve(size());
+        for (uint64_t stamp = m_end; stamp-- > m_begin;){
+            const AudioSpectrumSlot& slot = m_slots[stamp & (m_capacity - 1)];
+            ReadSpinLock lg(slot.lock);
+            if (slot.spectrum.stamp != stamp){
+                return;
+            }
+            spectrums.emplace_back(slot.spectrum);
+        }
+    }
+
+private:
+    const AudioSpectrumSlot* m_slots = nullptr;
+    size_t m_capacity = 0;
+    const std::atomic<uint64_t>* m_writer_end = nullptr;
+    uint64_t m_begin = 0;
+    uint64_t m_end = 0;
+};
+
 //  Define basic interface of an audio feed to be used by programs or other services.
 //  All the functions in the interface should be thread safe.
 class AudioFeed{
@@ -52,6 +137,11 @@ public:
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) = 0;
 
+    //  Same as above, but returns a view into the feed instead of a copy.
+    //  These never lock so they are safe to poll at a high rate.
+    virtual AudioSpectrumView spectrum_view_since(uint64_t starting_seqnum) = 0;
+    virtual AudioSpectrumView spectrum_view_latest(size_t num_last_spectrums) = 0;
+
     //  Add visual overlay to the spectrums starting at `starting_stamp` and before `end_stamp` with `color`.
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) = 0;
 };
@@ -26,6 +26,7 @@ AudioSpectrumHolder::AudioSpectrumHolder()
 //    , m_freq_visualization_block_boundaries(m_num_freq_visualization_blocks + 1)
 //    , m_spectrograph(m_num_freq_visualization_blocks, m_num_freq_windows)
     , m_freqVisStamps(m_num_freq_windows)
+    , m_spectrums(40)
 {
     // We will display frequencies in log scale, so need to convert
     // log scale: 0, 1/m_numFreqVisBlocks, 2/m_numFreqVisBlocks, ..., 1.0
@@ -112,11 +113,8 @@ void AudioSpectrumHolder::clear(){
         m_freqVisStamps.assign(m_freqVisStamps.size(), SIZE_MAX);
 
         {
-            // update m_spectrum_stamp_start in case the audio widget is used
+            // Stamps keep counting up in case the audio widget is used
             // again to store new spectrums.
-            if (m_spectrums.size() > 0){
-                m_spectrum_stamp_start = m_spectrums.front().stamp + 1;
-            }
             m_spectrums.clear();
 
             m_spectrograph->clear();
@@ -165,11 +163,7 @@ void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<cons
         const AlignedVector<float>& output = *fft_output;
 
         {
-            const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-            m_spectrums.emplace_front(stamp, sample_rate, fft_output);
-            if (m_spectrums.size() > m_spectrum_history_length){
-                m_spectrums.pop_back();
-            }
+            const size_t stamp = m_spectrums.push(sample_rate, fft_output);
 
             // std::cout << "Load FFT output , stamp " << spectrum->stamp << std::endl;
             m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
@@ -259,31 +253,12 @@ void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stam
 
 std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t starting_stamp){
     std::vector<AudioSpectrum> spectrums;
-
-    std::lock_guard<Mutex> lg(m_state_lock);
-
-    for (const auto& ptr : m_spectrums){
-        if (ptr.stamp >= starting_stamp){
-            spectrums.emplace_back(ptr);
-        }else{
-            break;
-        }
-    }
+    m_spectrums.since(starting_stamp).copy_to(spectrums);
     return spectrums;
 }
 std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_latest(size_t num_latest_spectrums){
     std::vector<AudioSpectrum> spectrums;
-
-    std::lock_guard<Mutex> lg(m_state_lock);
-
-    size_t i = 0;
-    for (const auto& ptr : m_spectrums){
-        if (i == num_latest_spectrums){
-            break;
-        }
-        spectrums.push_back(ptr);
-        i++;
-    }
+    m_spectrums.latest(num_latest_spectrums).copy_to(spectrums);
     return spectrums;
 }
 AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum() const{
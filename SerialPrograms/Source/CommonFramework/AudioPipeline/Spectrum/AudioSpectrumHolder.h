@@ -14,6 +14,7 @@
 #include "Common/Cpp/Concurrency/Mutex.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "AudioSpectrumRing.h"
 #include "Spectrograph.h"
 
 namespace PokemonAutomation{
@@ -44,6 +45,15 @@ public:
 public:
     //  Asynchronous and thread-safe getters.
 
+    //  Lock-free. See AudioSpectrumRing.
+    AudioSpectrumView spectrum_view_since(uint64_t starting_stamp) const{
+        return m_spectrums.since(starting_stamp);
+    }
+    AudioSpectrumView spectrum_view_latest(size_t num_latest_spectrums) const{
+        return m_spectrums.latest(num_latest_spectrums);
+    }
+
+    //  Same as above, but copied out.
     std::vector<AudioSpectrum> spectrums_since(uint64_t starting_stamp);
     std::vector<AudioSpectrum> spectrums_latest(size_t num_latest_spectrums);
 
@@ -90,12 +100,8 @@ private:
 
     // record the past FFT output frequencies to serve as the interface
     // of audio inference for automation programs.
-    // The head of the list is the most recent FFT window, while the tail
-    // is the oldest in history.
-    std::list<AudioSpectrum> m_spectrums;
-    size_t m_spectrum_history_length = 40;
-    // The initial timestamp for the incoming spectrums.
-    size_t m_spectrum_stamp_start = 0;
+    // Written under m_state_lock. Read without it.
+    AudioSpectrumRing m_spectrums;
 
     // Develop purpose: used to save received frequencies to disk
     bool m_saveFreqToDisk = false;
@@ -0,0 +1,74 @@
+/*  Audio Spectrum Ring
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Common/Cpp/Exceptions.h"
+#include "AudioSpectrumRing.h"
+
+namespace PokemonAutomation{
+
+static_assert((AudioSpectrumRing::CAPACITY & (AudioSpectrumRing::CAPACITY - 1)) == 0, "Capacity must be a power of two.");
+
+
+
+AudioSpectrumRing::AudioSpectrumRing(size_t history_length)
+    : m_history_length(history_length)
+    , m_slots(new AudioSpectrumSlot[CAPACITY])
+    , m_begin(0)
+    , m_end(0)
+{
+    //  Leave at least as much slack as what's visible.
+    if (history_length > CAPACITY / 2){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Spectrum history is too long for the ring: " + std::to_string(history_length)
+        );
+    }
+}
+
+
+uint64_t AudioSpectrumRing::push(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> magnitudes){
+    uint64_t stamp = m_end.load(std::memory_order_relaxed);
+    AudioSpectrumSlot& slot = m_slots[stamp & (CAPACITY - 1)];
+
+    //  Release the old buffer outside the lock.
+    std::shared_ptr<const AlignedVector<float>> old;
+    {
+        WriteSpinLock lg(slot.lock);
+        old = std::move(slot.spectrum.magnitudes);
+        slot.spectrum = AudioSpectrum(stamp, sample_rate, std::move(magnitudes));
+    }
+
+    m_end.store(stamp + 1, std::memory_order_release);
+    return stamp;
+}
+void AudioSpectrumRing::clear(){
+    m_begin.store(m_end.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+
+AudioSpectrumView AudioSpectrumRing::make_view(uint64_t end, uint64_t starting_stamp) const{
+    uint64_t begin = m_begin.load(std::memory_order_acquire);
+
+    begin = std::max(begin, end - std::min(end, (uint64_t)m_history_length));
+    begin = std::max(begin, starting_stamp);
+
+    //  A clear() and push() landed between the two loads.
+    begin = std::min(begin, end);
+
+    return AudioSpectrumView(m_slots.get(), CAPACITY, &m_end, begin, end);
+}
+AudioSpectrumView AudioSpectrumRing::since(uint64_t starting_stamp) const{
+    return make_view(m_end.load(std::memory_order_acquire), starting_stamp);
+}
+AudioSpectrumView AudioSpectrumRing::latest(size_t count) const{
+    uint64_t end = m_end.load(std::memory_order_acquire);
+    return make_view(end, end - std::min(end, (uint64_t)count));
+}
+
+
+
+}
@@ -0,0 +1,77 @@
+/*  Audio Spectrum Ring
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Fixed-capacity ring of the most recent spectrums. It is addressed by
+ *  stamp: spectrum "stamp" lives in slot "stamp % CAPACITY". So finding
+ *  where a reader left off is O(1).
+ *
+ *  Single writer, any number of readers. Writes must be serialized by the
+ *  owner. Readers get an AudioSpectrumView into the slots. Each slot has its
+ *  own spin lock that is held only to copy one spectrum in or out. There is
+ *  no lock on the ring as a whole.
+ *
+ *  Only the last "history_length" spectrums are visible to readers. A slot is
+ *  not rewritten until it is CAPACITY - history_length stamps older than
+ *  that. (several seconds of audio) That is how long a reader has to finish
+ *  with a view. If it takes longer, the view drops what got overwritten
+ *  instead of returning it.
+ *
+ */
+
+#ifndef PokemonAutomation_AudioPipeline_AudioSpectrumRing_H
+#define PokemonAutomation_AudioPipeline_AudioSpectrumRing_H
+
+#include <atomic>
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+
+namespace PokemonAutomation{
+
+
+class AudioSpectrumRing{
+public:
+    static constexpr size_t CAPACITY = 256;
+
+    AudioSpectrumRing(size_t history_length);
+
+
+public:
+    //  Writer
+
+    //  Returns the stamp of the new spectrum.
+    uint64_t push(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> magnitudes);
+
+    //  Hide everything that has been pushed so far. Stamps keep counting up
+    //  from where they were.
+    void clear();
+
+
+public:
+    //  Readers
+
+    //  All visible spectrums with stamp >= "starting_stamp".
+    AudioSpectrumView since(uint64_t starting_stamp) const;
+
+    //  Up to the last "count" visible spectrums.
+    AudioSpectrumView latest(size_t count) const;
+
+
+private:
+    AudioSpectrumView make_view(uint64_t end, uint64_t starting_stamp) const;
+
+
+private:
+    const size_t m_history_length;
+    std::unique_ptr<AudioSpectrumSlot[]> m_slots;
+
+    //  First stamp that hasn't been cleared.
+    std::atomic<uint64_t> m_begin;
+
+    //  Stamp of the next spectrum to be pushed.
+    std::atomic<uint64_t> m_end;
+};
+
+
+
+}
+#endif
@@ -12,12 +12,14 @@
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
 #include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "Common/Cpp/Concurrency/ScheduledTaskRunner.h"
 #include "Common/Cpp/Hardware/Hardware.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Notifications/ProgramNotifications.h"
 #include "CommonFramework/Options/Environment/ThemeSelectorOption.h"
+#include "CommonFramework/Recording/StreamHistoryOption.h"
 #include "CommonFramework/Recording/StreamHistorySession.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "ProgramDumper.h"
@@ -97,6 +99,7 @@ ErrorReportOption::ErrorReportOption()
 }
 
 
+SendableErrorReport::~SendableErrorReport() = default;
 SendableErrorReport::SendableErrorReport()
     : m_timestamp(now_to_filestring())
     , m_directory(RUNTIME_BASE_PATH() + ERROR_PATH_UNSENT + "/" + m_timestamp + "/")
@@ -132,6 +135,22 @@ SendableErrorReport::SendableErrorReport(
     m_title = std::move(title);
     m_messages = std::move(messages);
     m_image = image;
+
+    //  Saving the video is slow. Start it first and let it run in the
+    //  background. It is attached later by attach_video().
+    if (stream_history){
+        std::string video_name = std::string("Video") + GlobalSettings::instance().STREAM_HISTORY->file_extension();
+        AsyncTask video_task = stream_history->save_async(m_directory + video_name);
+        if (video_task){
+            m_pending_video_name = std::move(video_name);
+            m_video_task = std::make_unique<AsyncTask>(std::move(video_task));
+
+            //  The report may outlive the caller's image while it waits.
+            m_image_owner = image.copy();
+            m_image = m_image_owner;
+        }
+    }
+
     {
         std::string log;
         for (const LogLine& line : global_logger_raw().get_last()){
@@ -150,11 +169,6 @@ SendableErrorReport::SendableErrorReport(
         }
         m_logs_name = ERROR_LOGS_NAME;
     }
-    if (stream_history){
-        if (stream_history->save(m_directory + "Video.mp4")){
-            m_video_name = "Video.mp4";
-        }
-    }
     if (program_dump(logger, m_directory + ERROR_DUMP_NAME)){
         m_dump_name = ERROR_DUMP_NAME;
     }
@@ -232,6 +246,25 @@ SendableErrorReport::SendableErrorReport(std::string directory)
 void SendableErrorReport::add_file(std::string filename){
     m_files.emplace_back(std::move(filename));
 }
+void SendableErrorReport::attach_video(Logger* logger){
+    if (!m_video_task){
+        return;
+    }
+    if (logger == nullptr){
+        logger = &global_logger_tagged();
+    }
+    try{
+        m_video_task->wait_and_rethrow_exceptions();
+        m_video_name = std::move(m_pending_video_name);
+    }catch (Exception& e){
+        logger->log("Unable to save stream history: " + e.to_str(), COLOR_RED);
+    }catch (std::exception& e){
+        logger->log("Unable to save stream history: " + std::string(e.what()), COLOR_RED);
+    }catch (...){
+        logger->log("Unable to save stream history.", COLOR_RED);
+    }
+    m_video_task.reset();
+}
 
 void SendableErrorReport::save_report_json(Logger* logger) const{
     if (logger){
@@ -396,6 +429,13 @@ AsyncTask send_all_unsent_reports(Logger& logger, bool allow_prompt){
 #endif
 }
 
+//  Reports that are waiting on their video are finished here so that the
+//  thread reporting the error does not wait for the video.
+static ScheduledTaskRunner& pending_report_runner(){
+    static ScheduledTaskRunner runner(GlobalThreadPools::unlimited_normal());
+    return runner;
+}
+
 void report_error(
     Logger* logger,
     const ProgramInfo& info,
@@ -409,25 +449,47 @@ void report_error(
         logger = &global_logger_tagged();
     }
 
-    {
-        SendableErrorReport report(
-            logger,
-            info,
-            std::move(title),
-            std::move(messages),
-            image,
-            stream_history
-        );
+    std::shared_ptr<SendableErrorReport> report = std::make_shared<SendableErrorReport>(
+        logger,
+        info,
+        std::move(title),
+        std::move(messages),
+        image,
+        stream_history
+    );
 
-        std::vector<std::string> full_file_paths;
-        for (const std::string& file: files){
-            full_file_paths.emplace_back(report.directory() + file);
-        }
+    std::vector<std::string> full_file_paths;
+    for (const std::string& file: files){
+        full_file_paths.emplace_back(report->directory() + file);
+    }
+
+    //  Save what we have now so the report survives if we crash before the
+    //  video is done.
+    report->save_report_json(logger);
 
-        report.save_report_json(logger);
+    if (!report->video_pending()){
+        send_all_unsent_reports(*logger, false);
+        return;
     }
 
-    send_all_unsent_reports(*logger, false);
+    //  The caller's logger may be gone by the time the video is done.
+    pending_report_runner().add_event(
+        std::chrono::milliseconds(0),
+        [report = std::move(report)]{
+            Logger& logger = global_logger_tagged();
+            report->attach_video(&logger);
+            try{
+                report->save_report_json(&logger);
+                send_all_unsent_reports(logger, false);
+            }catch (Exception& e){
+                logger.log("Unable to finish error report: " + e.to_str(), COLOR_RED);
+            }catch (std::exception& e){
+                logger.log("Unable to finish error report: " + std::string(e.what()), COLOR_RED);
+            }catch (...){
+                logger.log("Unable to finish error report.", COLOR_RED);
+            }
+        }
+    );
 }
 
 
@@ -59,15 +59,20 @@ public:
 
 // Represents a complete error report that can be saved locally and sent to developers.
 // Each report is stored in its own timestamped directory (e.g., ErrorReportsLocal/20250216-155318967416/)
-// containing: Screenshot.png, Logs.log, Report.json, and optionally Video.mp4 and Minidump.dmp
+// containing: Screenshot.png, Logs.log, Report.json, and optionally Video.mp4 (or .avi) and Minidump.dmp
 class SendableErrorReport{
 public:
+    // Waits for the video if it is still being saved.
+    ~SendableErrorReport();
+
     // Default constructor: Creates an empty error report with timestamp and directory
     SendableErrorReport();
 
     // Create a new error report from current error info.
     // - Creates a timestamped directory in ErrorReportsLocal/
     // - Generates Report.json with metadata
+    // - Starts saving the video in the background. Call `attach_video()`
+    //   to wait for it and add it to the report.
     // Parameters:
     //   logger: Logger for status messages during report creation
     //   info: Program metadata (name, ID, runtime)
@@ -109,6 +114,15 @@ public:
     // Add an additional file to be included in this error report
     void add_file(std::string filename);
 
+    // Returns true if the video is still being saved in the background.
+    bool video_pending() const{
+        return (bool)m_video_task;
+    }
+
+    // Wait for the video to finish saving and add it to the report.
+    // If the save fails, it is logged and the report is kept without video.
+    void attach_video(Logger* logger);
+
     // Save an error report JSON "Report.json" in `directory()`:
     // Also save the image to the error report directory.
     void save_report_json(Logger* logger) const;
@@ -139,6 +153,9 @@ private:
     std::string m_video_name;
     std::string m_dump_name;
     std::vector<std::string> m_files;
+
+    std::string m_pending_video_name;
+    std::unique_ptr<AsyncTask> m_video_task;
 };
 
 
@@ -163,7 +180,9 @@ AsyncTask send_all_unsent_reports(Logger& logger, bool allow_prompt);
 //    - Screenshot image
 //    - Logs.log (recent log entries)
 //    - Report.json (metadata including title, messages, timestamps)
-//    - Video.mp4 (if stream_history provided)
+//    - Video.mp4 or Video.avi (if stream_history provided)
+//      The video is saved in the background. The report is re-saved with it
+//      and sent once it is done. This function does not wait for it.
 //    - Minidump.dmp (if available)
 //    - other additional files
 // 3. Only functional in official builds (PA_OFFICIAL defined): call `send_all_unsent_reports()`
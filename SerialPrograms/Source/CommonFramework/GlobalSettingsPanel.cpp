@@ -365,6 +365,8 @@ void GlobalSettings::load_json(const JsonValue& json){
         if (!command_line_tests_setting->read_string(COMMAND_LINE_TEST_FOLDER, "FOLDER")){
             COMMAND_LINE_TEST_FOLDER = "CommandLineTests";
         }
+        command_line_tests_setting->read_boolean(COMMAND_LINE_TEST_PARALLEL, "PARALLEL");
+        command_line_tests_setting->read_string(COMMAND_LINE_TEST_REPORT, "REPORT");
 
         const JsonArray* test_list = command_line_tests_setting->get_array("TEST_LIST");
         if (test_list){
@@ -175,6 +175,10 @@ public:
     // Which tests to ignore running under the command line test mode.
     // If a test path appears in both COMMAND_LINE_TEST_LIST and COMMAND_LINE_IGNORE_LIST, it's still ignored.
     std::vector<std::string> COMMAND_LINE_IGNORE_LIST;
+    // Run the test files in parallel on the computation thread pool.
+    bool COMMAND_LINE_TEST_PARALLEL = false;
+    // If not empty, write the timing report of the tests to this file.
+    std::string COMMAND_LINE_TEST_REPORT;
 };
 
 
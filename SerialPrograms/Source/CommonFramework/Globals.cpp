@@ -308,6 +308,10 @@ const std::string& ML_MODEL_CACHE_PATH(){
     static const std::string path = RUNTIME_BASE_PATH() + "ModelCache/";
     return path;
 }
+const std::string& RESOURCE_CACHE_PATH(){
+    static const std::string path = RUNTIME_BASE_PATH() + "ResourceCache/";
+    return path;
+}
 
 #if 0
 // Program executable path information
@@ -99,6 +99,9 @@ const std::string& ML_ANNOTATION_PATH();
 // for the Apple CoreML model acceleration framework to create model cache for faster model inference
 // sessions.
 const std::string& ML_MODEL_CACHE_PATH();
+// Folder path (end with "/") to hold files derived from resources to speed up loading them. (parsed
+// JSON, sprite bundles) Anything in here can be deleted. It will be rebuilt from the resources.
+const std::string& RESOURCE_CACHE_PATH();
 
 
 enum class ProgramState{
@@ -0,0 +1,62 @@
+/*  Image (RGB 32) Pool
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "ImageRGB32Pool.h"
+
+namespace PokemonAutomation{
+
+
+
+std::shared_ptr<ImageRGB32> ImageRGB32Pool::get(size_t width, size_t height){
+    ImageRGB32 image;
+    {
+        WriteSpinLock lg(m_lock);
+        auto iter = m_free.find({width, height});
+        if (iter != m_free.end() && !iter->second.empty()){
+            image = std::move(iter->second.back());
+            iter->second.pop_back();
+        }
+    }
+    if (!image){
+        image = ImageRGB32(width, height);
+    }
+
+    std::weak_ptr<ImageRGB32Pool> pool = weak_from_this();
+    return std::shared_ptr<ImageRGB32>(
+        new ImageRGB32(std::move(image)),
+        [pool = std::move(pool)](ImageRGB32* ptr){
+            std::shared_ptr<ImageRGB32Pool> owner = pool.lock();
+            if (owner){
+                owner->give_back(std::move(*ptr));
+            }
+            delete ptr;
+        }
+    );
+}
+size_t ImageRGB32Pool::free_images() const{
+    ReadSpinLock lg(m_lock);
+    size_t ret = 0;
+    for (const auto& item : m_free){
+        ret += item.second.size();
+    }
+    return ret;
+}
+void ImageRGB32Pool::give_back(ImageRGB32&& image) noexcept{
+    if (!image){
+        return;
+    }
+    try{
+        WriteSpinLock lg(m_lock);
+        std::vector<ImageRGB32>& list = m_free[{image.width(), image.height()}];
+        if (list.size() < m_max_free_per_size){
+            list.emplace_back(std::move(image));
+        }
+    }catch (...){}
+}
+
+
+
+}
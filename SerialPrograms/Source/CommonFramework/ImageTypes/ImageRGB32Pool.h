@@ -0,0 +1,55 @@
+/*  Image (RGB 32) Pool
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Recycle the pixel buffers of same-sized images. Video snapshots are
+ *  all the same size and are created and dropped many times a second. Getting
+ *  a fresh multi-megabyte buffer each time means page-faulting in the whole
+ *  thing before the first pixel can be written.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageRGB32Pool_H
+#define PokemonAutomation_CommonFramework_ImageRGB32Pool_H
+
+#include <memory>
+#include <map>
+#include <vector>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+class ImageRGB32Pool : public std::enable_shared_from_this<ImageRGB32Pool>{
+    struct PrivateToken{};
+
+public:
+    //  Keep up to "max_free_per_size" unused images of each size.
+    static std::shared_ptr<ImageRGB32Pool> make(size_t max_free_per_size = 4){
+        return std::make_shared<ImageRGB32Pool>(PrivateToken(), max_free_per_size);
+    }
+    ImageRGB32Pool(PrivateToken, size_t max_free_per_size)
+        : m_max_free_per_size(max_free_per_size)
+    {}
+
+    //  Returns an image of the requested size. The pixels are uninitialized.
+    //  When the last reference to it is dropped, the buffer goes back into
+    //  this pool. (or is freed if the pool is gone)
+    std::shared_ptr<ImageRGB32> get(size_t width, size_t height);
+
+    size_t free_images() const;
+
+private:
+    void give_back(ImageRGB32&& image) noexcept;
+
+private:
+    const size_t m_max_free_per_size;
+    mutable SpinLock m_lock;
+    std::map<std::pair<size_t, size_t>, std::vector<ImageRGB32>> m_free;
+};
+
+
+
+}
+#endif
@@ -169,6 +169,8 @@ int run_program(int argc, char *argv[]){
     for (size_t i = 0; i < argc; i++){
         constexpr const char* force_run_tests = "--command-line-test-mode";
         constexpr const char* command_line_test_folder = "--command-line-test-folder";
+        constexpr const char* command_line_test_parallel = "--command-line-test-parallel";
+        constexpr const char* command_line_test_report = "--command-line-test-report";
 
         if (strcmp(argv[i], force_run_tests) == 0){
             GlobalSettings::instance().COMMAND_LINE_TEST_MODE = true;
@@ -176,6 +178,12 @@ int run_program(int argc, char *argv[]){
         if (strcmp(argv[i], command_line_test_folder) == 0 && (i + 1 < argc)){
             GlobalSettings::instance().COMMAND_LINE_TEST_FOLDER = argv[i + 1];
         }
+        if (strcmp(argv[i], command_line_test_parallel) == 0){
+            GlobalSettings::instance().COMMAND_LINE_TEST_PARALLEL = true;
+        }
+        if (strcmp(argv[i], command_line_test_report) == 0 && (i + 1 < argc)){
+            GlobalSettings::instance().COMMAND_LINE_TEST_REPORT = argv[i + 1];
+        }
     }
 
     if (GlobalSettings::instance().COMMAND_LINE_TEST_MODE){
@@ -194,6 +202,11 @@ int run_program(int argc, char *argv[]){
     //  Run this asynchronously to we don't block startup.
     AsyncTask task = send_all_unsent_reports(logger, true);
 
+    //  Load OCR in the background so the first OCR of a program doesn't stall.
+    AsyncTask ocr_preload = GlobalThreadPools::unlimited_normal().dispatch_now_blocking([]{
+        OCR::preload_ocr_instances();
+    });
+
 
 
     Integration::DiscordIntegrationSettingsOption& discord_settings = GlobalSettings::instance().DISCORD->integration;
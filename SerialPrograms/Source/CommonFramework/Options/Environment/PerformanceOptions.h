@@ -8,6 +8,9 @@
 #define PokemonAutomation_PerformanceOptions_H
 
 #include "Common/Cpp/Options/GroupOption.h"
+#include "Common/Cpp/Options/BooleanCheckBoxOption.h"
+#include "Common/Cpp/Options/SimpleIntegerOption.h"
+#include "Common/Cpp/Options/StringOption.h"
 #include "Common/Cpp/Options/TimeDurationOption.h"
 #include "CommonFramework/Options/ThreadPoolOption.h"
 #include "ProcessPriorityOption.h"
@@ -57,6 +60,57 @@ public:
             DEFAULT_PRIORITY_NORMAL_INFERENCE,
             1.0
         )
+        , PARALLEL_VISUAL_INFERENCE(
+            "<b>Parallel Visual Inference:</b><br>"
+            "Run the visual inference callbacks that watch the same video feed "
+            "in parallel on the real-time thread pool instead of one after "
+            "another on the inference pivot thread. This keeps a slow detector "
+            "(OCR, ML) from delaying the others.",
+            LockMode::LOCK_WHILE_RUNNING,
+            false
+        )
+        , TESSERACT_MAX_INSTANCES(
+            "<b>Max Tesseract Instances:</b><br>"
+            "The maximum # of Tesseract OCR instances per language. Each "
+            "instance uses a lot of memory. OCR requests beyond this limit will "
+            "wait for an instance to free up. Zero means no limit.<br>"
+            "Restart the program for this to fully take effect.",
+            LockMode::LOCK_WHILE_RUNNING,
+            16
+        )
+        , TESSERACT_IDLE_TIMEOUT(
+            "<b>Tesseract Idle Timeout:</b><br>"
+            "Free Tesseract OCR instances that have not been used for this long. "
+            "Zero means never free them.<br>"
+            "Restart the program for this to fully take effect.",
+            LockMode::LOCK_WHILE_RUNNING,
+            "300 s"
+        )
+        , TESSERACT_PRELOAD_LANGUAGES(
+            false,
+            "<b>Preload Tesseract Languages:</b><br>"
+            "Comma-separated list of Tesseract language codes to load when the "
+            "program starts so that the first OCR of a program does not stall. "
+            "(e.g. \"eng, jpn\")",
+            LockMode::LOCK_WHILE_RUNNING,
+            "",
+            "eng, jpn"
+        )
+        , TESSERACT_PRELOAD_INSTANCES(
+            "<b>Preload Tesseract Instances:</b><br>"
+            "# of Tesseract OCR instances to load for each of the above languages.",
+            LockMode::LOCK_WHILE_RUNNING,
+            1, 1
+        )
+        , OCR_CACHE_SIZE(
+            "<b>OCR Cache Size:</b><br>"
+            "# of recent OCR results to remember for each language. Reading the "
+            "exact same image again will reuse the result instead of running "
+            "Tesseract. Zero disables the cache.<br>"
+            "Restart the program for this to fully take effect.",
+            LockMode::LOCK_WHILE_RUNNING,
+            64
+        )
         , PRECISE_WAKE_MARGIN(
             "<b>Precise Wake Time Margin:</b><br>"
             "Some operations require a thread to wake up at a very precise time - "
@@ -81,6 +135,14 @@ public:
         PA_ADD_OPTION(REALTIME_THREAD_POOL);
         PA_ADD_OPTION(NORMAL_THREAD_POOL);
 
+        PA_ADD_OPTION(PARALLEL_VISUAL_INFERENCE);
+
+        PA_ADD_OPTION(TESSERACT_MAX_INSTANCES);
+        PA_ADD_OPTION(TESSERACT_IDLE_TIMEOUT);
+        PA_ADD_OPTION(TESSERACT_PRELOAD_LANGUAGES);
+        PA_ADD_OPTION(TESSERACT_PRELOAD_INSTANCES);
+        PA_ADD_OPTION(OCR_CACHE_SIZE);
+
         PA_ADD_OPTION(PRECISE_WAKE_MARGIN);
     }
 
@@ -97,6 +159,14 @@ public:
     ThreadPoolOption REALTIME_THREAD_POOL;
     ThreadPoolOption NORMAL_THREAD_POOL;
 
+    BooleanCheckBoxOption PARALLEL_VISUAL_INFERENCE;
+
+    SimpleIntegerOption<uint16_t> TESSERACT_MAX_INSTANCES;
+    MillisecondsOption TESSERACT_IDLE_TIMEOUT;
+    StringOption TESSERACT_PRELOAD_LANGUAGES;
+    SimpleIntegerOption<uint16_t> TESSERACT_PRELOAD_INSTANCES;
+    SimpleIntegerOption<uint16_t> OCR_CACHE_SIZE;
+
     MicrosecondsOption PRECISE_WAKE_MARGIN;
 };
 
@@ -42,11 +42,25 @@ ThreadPoolOption::ThreadPoolOption(
         LockMode::UNLOCK_WHILE_RUNNING,
         m_default_max_threads, 1
     )
+    , BACKEND(
+        "<b>Scheduler:</b><br>"
+        "Single Queue: All tasks go through one shared queue.<br>"
+        "Work Stealing: Each thread has its own queue and idle threads take "
+        "work from busy ones. Lower overhead for lots of small tasks.<br>"
+        "Restart program for changes to take effect.",
+        {
+            {ThreadPoolBackend::DEFAULT,        "default",          "Single Queue"},
+            {ThreadPoolBackend::WORK_STEALING,  "work-stealing",    "Work Stealing"},
+        },
+        LockMode::UNLOCK_WHILE_RUNNING,
+        ThreadPoolBackend::DEFAULT
+    )
 {
     PA_ADD_OPTION(HARDWARE_THREADS);
     PA_ADD_STATIC(m_description);
     PA_ADD_OPTION(PRIORITY);
     PA_ADD_OPTION(MAX_THREADS);
+    PA_ADD_OPTION(BACKEND);
     HARDWARE_THREADS.set_visibility(ConfigOptionState::HIDDEN);
 }
 
@@ -9,12 +9,19 @@
 
 #include "Common/Cpp/Options/StaticTextOption.h"
 #include "Common/Cpp/Options/SimpleIntegerOption.h"
+#include "Common/Cpp/Options/EnumDropdownOption.h"
 #include "Common/Cpp/Options/GroupOption.h"
 #include "Environment/ProcessPriorityOption.h"
 
 namespace PokemonAutomation{
 
 
+enum class ThreadPoolBackend{
+    DEFAULT,
+    WORK_STEALING,
+};
+
+
 class ThreadPoolOption : public GroupOption{
 public:
     ThreadPoolOption(
@@ -34,6 +41,7 @@ public:
     StaticTextOption m_description;
     ThreadPriorityOption PRIORITY;
     SimpleIntegerOption<size_t> MAX_THREADS;
+    EnumDropdownOption<ThreadPoolBackend> BACKEND;
 };
 
 
@@ -4,9 +4,14 @@
  *
  */
 
+#include <algorithm>
 #include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
 #include <QSaveFile>
+#include <QLockFile>
 #include "Common/Cpp/Time.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "StatsDatabase.h"
 
 #include <iostream>
@@ -81,10 +86,13 @@ std::string StatLine::to_str() const{
 
 
 void StatList::operator+=(StatsTracker& tracker){
-    m_list.emplace_back(tracker);
+    add_to_totals(m_list.emplace_back(tracker));
 }
 void StatList::operator+=(const std::string& line){
-    m_list.emplace_back(line);
+    add_to_totals(m_list.emplace_back(line));
+}
+void StatList::add_to_totals(const StatLine& line){
+    StatsTracker::parse_line(m_totals, line.stats());
 }
 std::string StatList::to_str() const{
     std::string str;
@@ -96,10 +104,7 @@ std::string StatList::to_str() const{
 }
 
 void StatList::aggregate(StatsTracker& tracker) const{
-    for (const StatLine& line : m_list){
-        tracker.parse_and_append_line(line.stats());
-//        cout << tracker.to_str() << endl;
-    }
+    tracker.append(m_totals);
 }
 
 
@@ -150,29 +155,6 @@ void StatSet::open_from_file(const std::string& filepath){
     load_from_string(str.c_str());
 }
 
-bool StatSet::update_file(
-    const std::string& filepath,
-    const std::string& identifier,
-    StatsTracker& tracker
-){
-    QFile file(QString::fromStdString(filepath));
-    while (!file.open(QIODevice::ReadWrite)){
-        return false;
-    }
-    std::string data = file.readAll().data();
-
-    StatSet set;
-    set.load_from_string(data.c_str());
-
-    set[identifier] += tracker;
-
-    data = set.to_str();
-    file.seek(0);
-    file.write(data.c_str(), data.size());
-    file.resize(data.size());
-
-    return true;
-}
 
 
 bool StatSet::get_line(std::string& line, const char*& ptr){
@@ -242,10 +224,302 @@ void StatSet::load_from_string(const char* ptr){
 
 
 
+//
+//  Journal Format:
+//
+//  One line per run: "<identifier>\t<StatLine>\r\n"
+//
+//  Writers hold "<stats file>.lock" so a line without the terminating newline
+//  can only be a write that was cut off by a crash. It is not read and the
+//  next append truncates it.
+//
+//  Compaction writes the stats file first, then drops the journal bytes that
+//  went into it. If it is interrupted in between, the journal entries will
+//  already be at the end of their lists in the stats file. Those are dropped
+//  when the journal is read.
+//
+
+static std::string journal_path(const std::string& filepath){
+    return filepath + ".journal";
+}
+static std::string lock_path(const std::string& filepath){
+    return filepath + ".lock";
+}
+static void file_state(const std::string& path, int64_t& size, int64_t& modified){
+    QFileInfo info(QString::fromStdString(path));
+    if (!info.exists()){
+        size = -1;
+        modified = 0;
+        return;
+    }
+    size = info.size();
+    modified = info.lastModified().toMSecsSinceEpoch();
+}
+
+
+StatsDatabase& StatsDatabase::instance(){
+    static StatsDatabase database;
+    return database;
+}
+StatsDatabase::StatsDatabase(){
+    //  Make sure the thread pool is constructed first so that it outlives the
+    //  compaction task.
+    GlobalThreadPools::unlimited_normal();
+}
+StatsDatabase::~StatsDatabase(){
+    m_compaction.wait_and_ignore_exceptions();
+}
+
+void StatsDatabase::aggregate(
+    const std::string& filepath,
+    const std::string& identifier,
+    StatsTracker& tracker
+){
+    std::lock_guard<Mutex> lg(m_lock);
+    refresh(filepath);
+    auto iter = m_index.m_data.find(identifier);
+    if (iter != m_index.m_data.end()){
+        iter->second.aggregate(tracker);
+    }
+}
+bool StatsDatabase::append(
+    const std::string& filepath,
+    const std::string& identifier,
+    StatsTracker& tracker
+){
+    std::lock_guard<Mutex> lg(m_lock);
+    QLockFile file_lock(QString::fromStdString(lock_path(filepath)));
+    if (!file_lock.tryLock(FILE_LOCK_TIMEOUT_MS)){
+        return false;
+    }
+    refresh(filepath);
+
+    std::string record = identifier;
+    record += '\t';
+    record += StatLine(tracker).to_str();
+    record += "\r\n";
+    {
+        QFile file(QString::fromStdString(journal_path(filepath)));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Append)){
+            return false;
+        }
+
+        //  Everything that was read ended with a newline. What's left is a
+        //  record that was cut off by a crash.
+        if ((uint64_t)file.size() > m_journal_bytes && !file.resize(m_journal_bytes)){
+            return false;
+        }
+
+        if (file.write(record.c_str(), record.size()) != (qint64)record.size()){
+            return false;
+        }
+    }
+
+    //  Pick up our own entry (along with anything that another process may
+    //  have appended) from the file.
+    read_journal(false);
+
+    if (m_journal_entries >= COMPACTION_THRESHOLD){
+        schedule_compaction();
+    }
+    return true;
+}
+bool StatsDatabase::compact(const std::string& filepath){
+    std::lock_guard<Mutex> lg(m_lock);
+    refresh(filepath);
+    return compact_locked();
+}
+
+
+void StatsDatabase::refresh(const std::string& filepath){
+    int64_t file_size, file_modified;
+    file_state(filepath, file_size, file_modified);
+    int64_t journal_size, journal_modified;
+    file_state(journal_path(filepath), journal_size, journal_modified);
+    if (journal_size < 0){
+        journal_size = 0;
+    }
+
+    if (filepath != m_filepath ||
+        file_size != m_file_size ||
+        file_modified != m_file_modified ||
+        (uint64_t)journal_size < m_journal_bytes
+    ){
+        //  Different file or it was rewritten by someone else.
+        reload(filepath);
+        return;
+    }
+    if ((uint64_t)journal_size > m_journal_bytes){
+        read_journal(false);
+    }
+}
+void StatsDatabase::reload(const std::string& filepath){
+    m_filepath = filepath;
+    m_index = StatSet();
+    file_state(filepath, m_file_size, m_file_modified);
+    m_index.open_from_file(filepath);
+
+    m_journal_bytes = 0;
+    m_journal_entries = 0;
+    read_journal(true);
+
+    //  Bring the stats file up-to-date with what previous sessions journaled.
+    if (m_journal_entries > 0 && !m_compacting){
+        schedule_compaction();
+    }
+}
+void StatsDatabase::read_journal(bool drop_compacted){
+    QFile file(QString::fromStdString(journal_path(m_filepath)));
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(m_journal_bytes)){
+        return;
+    }
+    QByteArray data = file.readAll();
+    const char* ptr = data.constData();
+    const char* end = ptr + data.size();
+
+    std::vector<std::pair<std::string, std::string>> records;
+    while (true){
+        const char* newline = std::find(ptr, end, '\n');
+        if (newline == end){
+            break;
+        }
+        const char* line_end = newline;
+        if (line_end > ptr && line_end[-1] == '\r'){
+            line_end--;
+        }
+        const char* tab = std::find(ptr, line_end, '\t');
+        if (tab != line_end){
+            std::string identifier(ptr, tab);
+            auto iter = STATS_DATABASE_ALIASES.find(identifier);
+            if (iter != STATS_DATABASE_ALIASES.end()){
+                identifier = iter->second;
+            }
+            records.emplace_back(std::move(identifier), std::string(tab + 1, line_end));
+        }
+        m_journal_bytes += newline + 1 - ptr;
+        ptr = newline + 1;
+    }
+
+    if (drop_compacted){
+        //  Group by identifier. If a list in the stats file already ends with
+        //  exactly those entries, a compaction was interrupted after writing it.
+        std::map<std::string, std::vector<std::string>> groups;
+        for (auto& record : records){
+            groups[record.first].emplace_back(std::move(record.second));
+        }
+        for (auto& group : groups){
+            StatList& list = m_index[group.first];
+            const std::vector<StatLine>& lines = list.list();
+            const std::vector<std::string>& entries = group.second;
+            bool compacted = lines.size() >= entries.size();
+            for (size_t c = 0; compacted && c < entries.size(); c++){
+                compacted = lines[lines.size() - entries.size() + c].to_str() == StatLine(entries[c]).to_str();
+            }
+            m_journal_entries += entries.size();
+            if (compacted){
+                continue;
+            }
+            for (const std::string& entry : entries){
+                list += entry;
+            }
+        }
+        return;
+    }
+
+    for (const auto& record : records){
+        m_index[record.first] += record.second;
+    }
+    m_journal_entries += records.size();
+}
+bool StatsDatabase::compact_locked(){
+    if (m_filepath.empty()){
+        return true;
+    }
+
+    QLockFile file_lock(QString::fromStdString(lock_path(m_filepath)));
+    if (!file_lock.tryLock(FILE_LOCK_TIMEOUT_MS)){
+        return false;
+    }
+
+    //  Another instance may have appended or compacted since we last looked.
+    //  Whatever is written here must include that.
+    m_compacting = true;
+    refresh(m_filepath);
+    m_compacting = false;
+
+    if (m_journal_entries == 0){
+        return true;
+    }
 
+    std::string data = m_index.to_str();
+    QSaveFile file(QString::fromStdString(m_filepath));
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
+    if (file.write(data.c_str(), data.size()) != (qint64)data.size()){
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()){
+        return false;
+    }
 
+    if (!drop_consumed_journal()){
+        //  The entries are still in the journal. Reload so that they are
+        //  recognized as already being in the stats file.
+        m_compacting = true;
+        reload(m_filepath);
+        m_compacting = false;
+        return false;
+    }
 
+    //  The index already has everything. Don't reload what we just wrote.
+    file_state(m_filepath, m_file_size, m_file_modified);
+    m_journal_bytes = 0;
+    m_journal_entries = 0;
+    return true;
+}
+bool StatsDatabase::drop_consumed_journal(){
+    QString path = QString::fromStdString(journal_path(m_filepath));
+    QByteArray remaining;
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)){
+            return true;
+        }
+        if ((uint64_t)file.size() > m_journal_bytes){
+            file.seek(m_journal_bytes);
+            remaining = file.readAll();
+        }
+    }
 
+    if (remaining.isEmpty()){
+        return QFile::remove(path);
+    }
 
+    //  Keep the unread tail. Under the lock, that can only be a cut off record
+    //  which the next append will truncate. But it's not ours to drop.
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)){
+        return false;
+    }
+    if (file.write(remaining) != remaining.size()){
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
 }
+void StatsDatabase::schedule_compaction(){
+    if (m_compaction && !m_compaction.is_finished()){
+        return;
+    }
+    m_compaction = GlobalThreadPools::unlimited_normal().dispatch_now_blocking([this]{
+        std::lock_guard<Mutex> lg(m_lock);
+        compact_locked();
+    });
+}
+
 
+
+
+}
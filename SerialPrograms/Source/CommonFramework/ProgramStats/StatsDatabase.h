@@ -7,6 +7,8 @@
 #ifndef PokemonAutomation_StatsDatabase_H
 #define PokemonAutomation_StatsDatabase_H
 
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "StatsTracking.h"
 
 namespace PokemonAutomation{
@@ -37,10 +39,16 @@ public:
 
     const std::vector<StatLine>& list() const{ return m_list; }
 
+    //  Add the totals of all the lines to "tracker". The lines are parsed as
+    //  they are added so this doesn't touch the text.
     void aggregate(StatsTracker& tracker) const;
 
+private:
+    void add_to_totals(const StatLine& line);
+
 private:
     std::vector<StatLine> m_list;
+    std::map<std::string, uint64_t> m_totals;
 };
 
 
@@ -56,18 +64,81 @@ public:
     void save_to_file(const std::string& filepath);
     void open_from_file(const std::string& filepath);
 
-    static bool update_file(
+private:
+    friend class StatsDatabase;
+
+    bool get_line(std::string& line, const char*& ptr);
+    void load_from_string(const char* ptr);
+
+private:
+    std::map<std::string, StatList> m_data;
+};
+
+
+
+//
+//  The stats file and an in-memory index of it.
+//
+//  The file is read once. New entries are appended to a journal next to it
+//  ("<stats file>.journal") so saving the stats of a run is O(1) I/O instead
+//  of a rewrite of the entire history. Once the journal gets long enough, it
+//  is merged back into the stats file on a background thread.
+//
+//  Appends and compactions hold a lock file ("<stats file>.lock") so that
+//  other instances of the program can share the same files. Changes to either
+//  file by other instances are picked up before each operation.
+//
+class StatsDatabase{
+public:
+    static StatsDatabase& instance();
+
+    //  Tests construct their own to stand in for separate instances.
+    StatsDatabase();
+    ~StatsDatabase();
+
+    //  Add the historical stats of "identifier" to "tracker".
+    void aggregate(
         const std::string& filepath,
         const std::string& identifier,
         StatsTracker& tracker
     );
 
+    //  Record the stats of a run. Returns false if it can't be written.
+    bool append(
+        const std::string& filepath,
+        const std::string& identifier,
+        StatsTracker& tracker
+    );
+
+    //  Merge the journal into the stats file now. Returns false on failure.
+    bool compact(const std::string& filepath);
+
 private:
-    bool get_line(std::string& line, const char*& ptr);
-    void load_from_string(const char* ptr);
+    //  All of these must be called under the lock.
+    void refresh(const std::string& filepath);
+    void reload(const std::string& filepath);
+    void read_journal(bool drop_compacted);
+    bool compact_locked();
+    bool drop_consumed_journal();
+    void schedule_compaction();
 
 private:
-    std::map<std::string, StatList> m_data;
+    static constexpr size_t COMPACTION_THRESHOLD = 32;
+    static constexpr int FILE_LOCK_TIMEOUT_MS = 5000;
+
+    Mutex m_lock;
+
+    std::string m_filepath;
+    StatSet m_index;
+
+    //  What the index was built from.
+    int64_t m_file_size = -1;
+    int64_t m_file_modified = 0;
+    uint64_t m_journal_bytes = 0;
+    size_t m_journal_entries = 0;
+
+    bool m_compacting = false;
+    AsyncTask m_compaction;
 };
 
 
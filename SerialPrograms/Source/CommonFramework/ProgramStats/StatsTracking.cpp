@@ -78,7 +78,8 @@ std::string StatsTracker::to_str(PrintMode mode) const{
 
 
 
-void StatsTracker::parse_and_append_line(const std::string& line){
+template <typename CountMap>
+static void parse_stats_line(CountMap& stats, const std::string& line){
     const char* ptr = line.c_str();
     while (true){
         //  Parse label.
@@ -103,7 +104,7 @@ void StatsTracker::parse_and_append_line(const std::string& line){
         while (true){
             char ch = *ptr++;
             if (ch < 32){
-                m_stats[label] += count;
+                stats[label] += count;
                 return;
             }
             if (ch == ',') continue;
@@ -113,7 +114,7 @@ void StatsTracker::parse_and_append_line(const std::string& line){
         }
 
 //        cout << label << " = " << count << endl;
-        m_stats[label] += count;
+        stats[label] += count;
 
         //  Skip to next;
         while (true){
@@ -124,6 +125,17 @@ void StatsTracker::parse_and_append_line(const std::string& line){
         }
     }
 }
+void StatsTracker::parse_and_append_line(const std::string& line){
+    parse_stats_line(m_stats, line);
+}
+void StatsTracker::parse_line(std::map<std::string, uint64_t>& counts, const std::string& line){
+    parse_stats_line(counts, line);
+}
+void StatsTracker::append(const std::map<std::string, uint64_t>& counts){
+    for (const auto& item : counts){
+        m_stats[item.first] += item.second;
+    }
+}
 
 
 
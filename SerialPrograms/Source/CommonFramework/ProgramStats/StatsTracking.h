@@ -36,6 +36,11 @@ public:
 
     void parse_and_append_line(const std::string& line);
 
+    //  Same as parse_and_append_line(), but parse into "counts" instead.
+    //  Use with append() to add a line to many trackers without reparsing it.
+    static void parse_line(std::map<std::string, uint64_t>& counts, const std::string& line);
+    void append(const std::map<std::string, uint64_t>& counts);
+
 
 protected:
 //    static constexpr bool HIDDEN_IF_ZERO = true;
@@ -104,12 +104,25 @@ StreamHistoryOption::StreamHistoryOption()
         80,
         0, 100
     )
+    , VIDEO_FORMAT(
+        "<b>Video Format:</b><br>"
+        "MP4: Re-encode the frames. Smaller files, but saving takes longer.<br>"
+        "AVI (Motion JPEG): Write the stored frames as-is. Saving is nearly "
+        "instant, but the files are larger.",
+        {
+            {VideoFormat::MP4,          "mp4",          "MP4"},
+            {VideoFormat::MJPEG_AVI,    "mjpeg-avi",    "AVI (Motion JPEG)"},
+        },
+        LockMode::UNLOCK_WHILE_RUNNING,
+        VideoFormat::MP4
+    )
 {
     PA_ADD_STATIC(DESCRIPTION);
     PA_ADD_OPTION(HISTORY_SECONDS);
     PA_ADD_OPTION(RESOLUTION);
     PA_ADD_OPTION(VIDEO_FPS);
     PA_ADD_OPTION(JPEG_QUALITY);
+    PA_ADD_OPTION(VIDEO_FORMAT);
     // PA_ADD_OPTION(ENCODING_MODE);
     // PA_ADD_OPTION(VIDEO_QUALITY);
     // PA_ADD_OPTION(VIDEO_BITRATE);
@@ -122,6 +135,16 @@ StreamHistoryOption::~StreamHistoryOption(){
     ENCODING_MODE.remove_listener(*this);
 }
 
+const char* StreamHistoryOption::file_extension() const{
+    switch (VIDEO_FORMAT){
+    case VideoFormat::MP4:
+        return ".mp4";
+    case VideoFormat::MJPEG_AVI:
+        return ".avi";
+    }
+    return ".mp4";
+}
+
 void StreamHistoryOption::on_config_value_changed(void* object){
     switch (ENCODING_MODE){
     case EncodingMode::FIXED_QUALITY:
@@ -60,6 +60,15 @@ public:
     };
     EnumDropdownOption<VideoFPS> VIDEO_FPS;
     SimpleIntegerOption<uint16_t> JPEG_QUALITY;
+
+    enum class VideoFormat{
+        MP4,
+        MJPEG_AVI,
+    };
+    EnumDropdownOption<VideoFormat> VIDEO_FORMAT;
+
+    //  File extension (including the dot) for the selected video format.
+    const char* file_extension() const;
 };
 
 
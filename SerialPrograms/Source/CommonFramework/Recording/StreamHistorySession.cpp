@@ -91,6 +91,21 @@ bool StreamHistorySession::save(const std::string& filename) const{
 
     return tracker->save(filename);
 }
+AsyncTask StreamHistorySession::save_async(const std::string& filename) const{
+    const Data& data = *m_data;
+
+    std::shared_ptr<StreamHistoryTracker> tracker;
+    {
+        WriteSpinLock lg(data.m_lock);
+        if (!data.m_current){
+            data.m_logger.log("Cannot save stream history: Stream history is not enabled.", COLOR_RED);
+            return AsyncTask();
+        }
+        tracker = data.m_current;
+    }
+
+    return tracker->save_async(filename);
+}
 void StreamHistorySession::on_samples(const float* samples, size_t frames){
     Data& data = *m_data;
     WriteSpinLock lg(data.m_lock);
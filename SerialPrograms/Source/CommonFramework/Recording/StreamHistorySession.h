@@ -11,6 +11,7 @@
 
 #include "Common/Cpp/Logging/AbstractLogger.h"
 #include "Common/Cpp/Containers/Pimpl.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "CommonFramework/AudioPipeline/AudioSession.h"
 #include "CommonFramework/VideoPipeline/VideoSession.h"
 
@@ -29,6 +30,10 @@ public:
     void start(AudioChannelFormat format, bool has_video);
     bool save(const std::string& filename) const;
 
+    //  Start saving in the background and return immediately.
+    //  Returns a null task if there is nothing to save.
+    AsyncTask save_async(const std::string& filename) const;
+
 public:
     virtual void on_samples(const float* data, size_t frames) override;
     virtual void on_frame(std::shared_ptr<const VideoFrame> frame) override;
@@ -11,6 +11,7 @@
 
 #include "Common/Compiler.h"
 #include "Common/Cpp/Logging/AbstractLogger.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "CommonFramework/VideoPipeline/Backends/VideoFrameQt.h"
 
 namespace PokemonAutomation{
@@ -29,6 +30,10 @@ public:
     {}
     void set_window(std::chrono::seconds window){}
 
+    AsyncTask save_async(const std::string& filename) const{
+        m_logger.log("Cannot save stream history: Not implemented.", COLOR_RED);
+        return AsyncTask();
+    }
     bool save(const std::string& filename) const{
         m_logger.log("Cannot save stream history: Not implemented.", COLOR_RED);
         return false;
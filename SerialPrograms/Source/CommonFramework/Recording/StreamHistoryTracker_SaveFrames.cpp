@@ -250,7 +250,10 @@ void StreamHistoryTracker::on_frame(std::shared_ptr<const VideoFrame> frame){
 
 void StreamHistoryTracker::clear_old(){
     //  Must call under lock.
-    WallClock latest_frame = m_compressed_frames.back().timestamp;
+    if (m_compressed_frames.empty()){
+        return;
+    }
+    WallClock latest_frame = m_compressed_frames.back()->timestamp;
     WallClock threshold = latest_frame - m_window;
 
     #if 0
@@ -275,7 +278,7 @@ void StreamHistoryTracker::clear_old(){
 //    cout << "exit" << endl;
 
     while (!m_compressed_frames.empty()){
-        if (m_compressed_frames.front().timestamp < threshold){
+        if (m_compressed_frames.front()->timestamp < threshold){
             m_compressed_frames.pop_front();
         }else{
             break;
@@ -284,78 +287,34 @@ void StreamHistoryTracker::clear_old(){
 }
 
 
-bool StreamHistoryTracker::save(const std::string& filename) const{
-    m_logger.log("Saving stream history...", COLOR_BLUE);
-
-    std::deque<CompressedVideoFrame> frames;
+AsyncTask StreamHistoryTracker::save_async(const std::string& filename) const{
+    std::shared_ptr<StreamHistorySnapshot> snapshot = std::make_shared<StreamHistorySnapshot>();
     {
-        //  Fast copy the current state of the stream.
+        //  Fast copy the current state of the stream. This only copies pointers.
         WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
         if (m_compressed_frames.empty()){
-            return false;
+            return AsyncTask();
         }
-        frames = m_compressed_frames;
-    }
-
-    m_logger.log("Total frames to save: " + std::to_string(frames.size()));
-
-    if (frames.empty()) return false;
-
-    // Use first frame to get size
-    QImage first_img = decompress_video_frame(frames.front().compressed_frame);
-    int width = first_img.width();
-    int height = first_img.height();
-
-    m_logger.log("Frame size: " + std::to_string(width) + " x " + std::to_string(height));
-
-    // 1. Initialize VideoWriter (e.g., MP4 with 30 FPS)
-    cv::VideoWriter writer(filename, cv::VideoWriter::fourcc('m', 'p', '4', 'v'), 
-                           m_target_fps, cv::Size(width, height), true);
-
-    if (!writer.isOpened()){
-        throw std::runtime_error("Could not open video file for writing.");
+        snapshot->frames.assign(m_compressed_frames.begin(), m_compressed_frames.end());
     }
-
-    std::vector<unsigned char> last_good_buffer = frames[0].compressed_frame;
-
-    size_t frame_index = 0;
-    size_t frames_inserted = 0;
-    WallClock start_time = frames[0].timestamp;
-
-    // 2. Loop through frames
-    for (CompressedVideoFrame frame : frames){
-        if (frame_index % 100 == 0){
-            m_logger.log("Saving frame " + std::to_string(frame_index) + " / " + std::to_string(frames.size()));
+    snapshot->fps = m_target_fps;
+    snapshot->frame_interval = m_frame_interval;
+
+    //  The task does not reference the tracker. So the tracker is free to be
+    //  destroyed (stream change) while the save is still running.
+    Logger& logger = m_logger;
+    return GlobalThreadPools::unlimited_normal().dispatch_now_blocking(
+        [&logger, filename, snapshot = std::move(snapshot)]{
+            save_stream_history(logger, filename, *snapshot);
         }
-
-        // Insert duplicate frames if there is a gap due to dropping frames.
-        // Because VideoWriter can only handle a fixed frame rate.
-
-        // calculates the frame index that this timestamp SHOULD be at
-        double elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(frame.timestamp - start_time).count();
-        double interval = std::chrono::duration_cast<std::chrono::milliseconds>(m_frame_interval).count();
-        size_t target_frame_index = (size_t)std::round(elapsed/interval);
-        // fill the gap with duplicate frames until we reach the target index
-        while (frames_inserted < target_frame_index){
-            // Decompress last known good frame and write again
-            QImage img = decompress_video_frame(last_good_buffer);
-            cv::Mat mat(height, width, CV_8UC3, (void*)img.bits(), img.bytesPerLine());
-            writer.write(mat);
-            frames_inserted++;
-        }
-
-        // 3. decompress frame and write to video
-        QImage img = decompress_video_frame(frame.compressed_frame);
-        cv::Mat mat(height, width, CV_8UC3, (void*)img.bits(), img.bytesPerLine());
-        writer.write(mat);
-
-        last_good_buffer = frame.compressed_frame;
-        frames_inserted++;
-        frame_index++;
+    );
+}
+bool StreamHistoryTracker::save(const std::string& filename) const{
+    AsyncTask task = save_async(filename);
+    if (!task){
+        return false;
     }
-    // Writer automatically releases when going out of scope
-
-    m_logger.log("Done saving stream history...", COLOR_BLUE);
+    task.wait_and_rethrow_exceptions();
     return true;
 }
 
@@ -381,10 +340,10 @@ void StreamHistoryTracker::worker_loop(){
         // 3. Move the result into the main storage
         {
             WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
-            m_compressed_frames.emplace_back(CompressedVideoFrame{
-                frame->timestamp, 
+            m_compressed_frames.emplace_back(std::make_shared<const CompressedVideoFrame>(CompressedVideoFrame{
+                frame->timestamp,
                 std::move(compressed_data)
-            });
+            }));
             clear_old(); // Cleanup happens here
         }
     }
@@ -20,6 +20,7 @@
 #include "Common/Cpp/Concurrency/ConditionVariable.h"
 #include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "StreamHistoryVideoWriter.h"
 
 
 namespace PokemonAutomation{
@@ -38,11 +39,6 @@ struct AudioBlock{
     {}
 };
 
-struct CompressedVideoFrame{
-    WallClock timestamp;
-    std::vector<unsigned char> compressed_frame;
-};
-
 QImage decompress_video_frame(const std::vector<uchar> &compressed_buffer);
 std::vector<uchar> compress_video_frame(const QVideoFrame& const_frame);
 
@@ -58,6 +54,12 @@ public:
     );
     void set_window(std::chrono::seconds window);
 
+    //  Start saving the history to "filename" on a background thread and
+    //  return immediately. Returns a null task if there is nothing to save.
+    //  The container is picked from the extension. (see StreamHistoryVideoWriter.h)
+    AsyncTask save_async(const std::string& filename) const;
+
+    //  Same as above, but blocks until the save is done.
     bool save(const std::string& filename) const;
 
 public:
@@ -87,7 +89,7 @@ private:
     //  everything asynchronously.
     // std::deque<std::shared_ptr<AudioBlock>> m_audio;
     // std::deque<std::shared_ptr<const VideoFrame>> m_frames;
-    std::deque<CompressedVideoFrame> m_compressed_frames;
+    std::deque<std::shared_ptr<const CompressedVideoFrame>> m_compressed_frames;
 
     AsyncTask m_worker;
     std::atomic<bool> m_stopping{false};
@@ -0,0 +1,361 @@
+/*  Stream History Video Writer
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <cmath>
+#include <fstream>
+#include <opencv2/opencv.hpp>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Logging/AbstractLogger.h"
+#include "Common/Cpp/Concurrency/ThreadPool.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "StreamHistoryVideoWriter.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+//  The writers only support a fixed frame rate. So return the index of the
+//  source frame to use for each output frame. Gaps from dropped frames are
+//  filled by repeating the previous frame.
+std::vector<size_t> stream_history_frame_schedule(const StreamHistorySnapshot& snapshot){
+    std::vector<size_t> schedule;
+    if (snapshot.frames.empty()){
+        return schedule;
+    }
+
+    WallClock start_time = snapshot.frames[0]->timestamp;
+    double interval = (double)std::chrono::duration_cast<std::chrono::milliseconds>(snapshot.frame_interval).count();
+
+    size_t last_good = 0;
+    for (size_t c = 0; c < snapshot.frames.size(); c++){
+        //  Calculates the frame index that this timestamp SHOULD be at.
+        double elapsed = (double)std::chrono::duration_cast<std::chrono::milliseconds>(
+            snapshot.frames[c]->timestamp - start_time
+        ).count();
+        size_t target_frame_index = (size_t)std::round(elapsed / interval);
+
+        while (schedule.size() < target_frame_index){
+            schedule.emplace_back(last_good);
+        }
+
+        schedule.emplace_back(c);
+        last_good = c;
+    }
+
+    return schedule;
+}
+
+
+
+//
+//  MPEG-4
+//
+
+void save_stream_history_mp4(
+    Logger& logger,
+    const std::string& filename,
+    const StreamHistorySnapshot& snapshot
+){
+    const std::vector<std::shared_ptr<const CompressedVideoFrame>>& frames = snapshot.frames;
+    std::vector<size_t> schedule = stream_history_frame_schedule(snapshot);
+
+    //  # of frames to decode at once. Bounds the memory of the decoded frames.
+    const size_t BATCH_SIZE = 16;
+
+    auto decode = [](const CompressedVideoFrame& frame){
+        return cv::imdecode(frame.compressed_frame, cv::IMREAD_COLOR);
+    };
+
+    cv::Mat last = decode(*frames[0]);
+    if (last.empty()){
+        throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "Unable to decode stream history frame.");
+    }
+    cv::Size size(last.cols, last.rows);
+    logger.log("Frame size: " + std::to_string(size.width) + " x " + std::to_string(size.height));
+
+    cv::VideoWriter writer(
+        filename, cv::VideoWriter::fourcc('m', 'p', '4', 'v'),
+        (double)snapshot.fps, size, true
+    );
+    if (!writer.isOpened()){
+        throw FileException(&logger, PA_CURRENT_FUNCTION, "Could not open video file for writing.", filename);
+    }
+
+    ThreadPool& pool = GlobalThreadPools::computation_normal();
+    std::vector<cv::Mat> decoded(BATCH_SIZE);
+
+    size_t last_index = 0;
+    for (size_t batch_start = 0; batch_start < frames.size(); batch_start += BATCH_SIZE){
+        size_t batch_end = std::min(batch_start + BATCH_SIZE, frames.size());
+        logger.log("Saving frame " + std::to_string(batch_start) + " / " + std::to_string(frames.size()));
+
+        pool.run_in_parallel(
+            [&](size_t index){
+                cv::Mat& mat = decoded[index - batch_start];
+                mat = decode(*frames[index]);
+                if (!mat.empty() && (mat.cols != size.width || mat.rows != size.height)){
+                    cv::resize(mat, mat, size);
+                }
+            },
+            batch_start, batch_end, 1
+        );
+
+        //  Write every output frame that uses a source frame in this batch.
+        //  Duplicates reuse the decoded frame.
+        while (last_index < schedule.size() && schedule[last_index] < batch_end){
+            size_t source = schedule[last_index];
+            if (source >= batch_start){
+                cv::Mat& mat = decoded[source - batch_start];
+                if (!mat.empty()){
+                    last = mat;
+                }
+            }
+            writer.write(last);
+            last_index++;
+        }
+    }
+}
+
+
+
+//
+//  Motion JPEG (AVI)
+//
+
+bool read_jpeg_size(const std::vector<unsigned char>& jpeg, uint32_t& width, uint32_t& height){
+    size_t c = 2;
+    while (c + 9 < jpeg.size()){
+        if (jpeg[c] != 0xff){
+            return false;
+        }
+        uint8_t marker = jpeg[c + 1];
+        size_t length = (size_t)jpeg[c + 2] << 8 | jpeg[c + 3];
+
+        //  SOF0 - SOF15, excluding DHT, JPG and DAC.
+        if (0xc0 <= marker && marker <= 0xcf && marker != 0xc4 && marker != 0xc8 && marker != 0xcc){
+            height = (uint32_t)jpeg[c + 5] << 8 | jpeg[c + 6];
+            width  = (uint32_t)jpeg[c + 7] << 8 | jpeg[c + 8];
+            return true;
+        }
+
+        c += 2 + length;
+    }
+    return false;
+}
+
+
+class AviWriter{
+public:
+    AviWriter(const std::string& filename)
+        : m_filename(filename)
+        , m_file(filename, std::ios::binary)
+    {
+        if (!m_file){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Could not open video file for writing.", filename);
+        }
+    }
+
+    void write_fourcc(const char* fourcc){
+        m_file.write(fourcc, 4);
+    }
+    void write_u16(uint16_t x){
+        char bytes[2] = {(char)x, (char)(x >> 8)};
+        m_file.write(bytes, 2);
+    }
+    void write_u32(uint32_t x){
+        char bytes[4] = {(char)x, (char)(x >> 8), (char)(x >> 16), (char)(x >> 24)};
+        m_file.write(bytes, 4);
+    }
+    void write_bytes(const void* data, size_t bytes){
+        m_file.write((const char*)data, bytes);
+    }
+    void finish(){
+        m_file.flush();
+        if (!m_file){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Error while writing video file.", m_filename);
+        }
+    }
+
+private:
+    std::string m_filename;
+    std::ofstream m_file;
+};
+
+
+//  Since every frame is already compressed, all the sizes are known before
+//  we start. So the file is written front to back without seeking.
+void save_stream_history_mjpeg(
+    Logger& logger,
+    const std::string& filename,
+    const StreamHistorySnapshot& snapshot
+){
+    const std::vector<std::shared_ptr<const CompressedVideoFrame>>& frames = snapshot.frames;
+    std::vector<size_t> schedule = stream_history_frame_schedule(snapshot);
+
+    uint32_t width, height;
+    if (!read_jpeg_size(frames[0]->compressed_frame, width, height)){
+        throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "Unable to read the size of stream history frame.");
+    }
+    logger.log("Frame size: " + std::to_string(width) + " x " + std::to_string(height));
+
+    auto padded = [](size_t bytes){ return (bytes + 1) & ~(size_t)1; };
+
+    uint64_t movi_bytes = 4;
+    uint32_t max_frame_bytes = 0;
+    for (size_t index : schedule){
+        size_t bytes = frames[index]->compressed_frame.size();
+        movi_bytes += 8 + padded(bytes);
+        max_frame_bytes = std::max(max_frame_bytes, (uint32_t)bytes);
+    }
+    const uint32_t total_frames = (uint32_t)schedule.size();
+    const uint32_t idx1_bytes = 16 * total_frames;
+    const uint32_t strl_bytes = 4 + (8 + 56) + (8 + 40);
+    const uint32_t hdrl_bytes = 4 + (8 + 56) + (8 + strl_bytes);
+    const uint64_t riff_bytes = 4 + (8 + hdrl_bytes) + (8 + movi_bytes) + (8 + idx1_bytes);
+    if (riff_bytes > 0xffffffff){
+        throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "Stream history is too large for an AVI file.");
+    }
+
+    const uint32_t AVIF_HASINDEX = 0x10;
+    const uint32_t AVIIF_KEYFRAME = 0x10;
+
+    AviWriter file(filename);
+
+    file.write_fourcc("RIFF");
+    file.write_u32((uint32_t)riff_bytes);
+    file.write_fourcc("AVI ");
+
+    file.write_fourcc("LIST");
+    file.write_u32(hdrl_bytes);
+    file.write_fourcc("hdrl");
+    {
+        file.write_fourcc("avih");
+        file.write_u32(56);
+        file.write_u32((uint32_t)snapshot.frame_interval.count()); //  dwMicroSecPerFrame
+        file.write_u32(max_frame_bytes * (uint32_t)snapshot.fps);   //  dwMaxBytesPerSec
+        file.write_u32(0);                                          //  dwPaddingGranularity
+        file.write_u32(AVIF_HASINDEX);                              //  dwFlags
+        file.write_u32(total_frames);                               //  dwTotalFrames
+        file.write_u32(0);                                          //  dwInitialFrames
+        file.write_u32(1);                                          //  dwStreams
+        file.write_u32(max_frame_bytes);                            //  dwSuggestedBufferSize
+        file.write_u32(width);
+        file.write_u32(height);
+        for (size_t c = 0; c < 4; c++){
+            file.write_u32(0);                                      //  dwReserved
+        }
+
+        file.write_fourcc("LIST");
+        file.write_u32(strl_bytes);
+        file.write_fourcc("strl");
+
+        file.write_fourcc("strh");
+        file.write_u32(56);
+        file.write_fourcc("vids");                                  //  fccType
+        file.write_fourcc("MJPG");                                  //  fccHandler
+        file.write_u32(0);                                          //  dwFlags
+        file.write_u16(0);                                          //  wPriority
+        file.write_u16(0);                                          //  wLanguage
+        file.write_u32(0);                                          //  dwInitialFrames
+        file.write_u32(1);                                          //  dwScale
+        file.write_u32((uint32_t)snapshot.fps);                     //  dwRate
+        file.write_u32(0);                                          //  dwStart
+        file.write_u32(total_frames);                               //  dwLength
+        file.write_u32(max_frame_bytes);                            //  dwSuggestedBufferSize
+        file.write_u32(0xffffffff);                                 //  dwQuality
+        file.write_u32(0);                                          //  dwSampleSize
+        file.write_u16(0);                                          //  rcFrame
+        file.write_u16(0);
+        file.write_u16((uint16_t)width);
+        file.write_u16((uint16_t)height);
+
+        file.write_fourcc("strf");
+        file.write_u32(40);
+        file.write_u32(40);                                         //  biSize
+        file.write_u32(width);                                      //  biWidth
+        file.write_u32(height);                                     //  biHeight
+        file.write_u16(1);                                          //  biPlanes
+        file.write_u16(24);                                         //  biBitCount
+        file.write_fourcc("MJPG");                                  //  biCompression
+        file.write_u32(width * height * 3);                         //  biSizeImage
+        file.write_u32(0);                                          //  biXPelsPerMeter
+        file.write_u32(0);                                          //  biYPelsPerMeter
+        file.write_u32(0);                                          //  biClrUsed
+        file.write_u32(0);                                          //  biClrImportant
+    }
+
+    file.write_fourcc("LIST");
+    file.write_u32((uint32_t)movi_bytes);
+    file.write_fourcc("movi");
+    for (size_t c = 0; c < schedule.size(); c++){
+        if (c % 100 == 0){
+            logger.log("Saving frame " + std::to_string(c) + " / " + std::to_string(schedule.size()));
+        }
+        const std::vector<unsigned char>& jpeg = frames[schedule[c]]->compressed_frame;
+        file.write_fourcc("00dc");
+        file.write_u32((uint32_t)jpeg.size());
+        file.write_bytes(jpeg.data(), jpeg.size());
+        if (jpeg.size() % 2){
+            file.write_bytes("", 1);
+        }
+    }
+
+    //  Offsets are relative to the "movi" fourcc.
+    file.write_fourcc("idx1");
+    file.write_u32(idx1_bytes);
+    uint32_t offset = 4;
+    for (size_t index : schedule){
+        size_t bytes = frames[index]->compressed_frame.size();
+        file.write_fourcc("00dc");
+        file.write_u32(AVIIF_KEYFRAME);
+        file.write_u32(offset);
+        file.write_u32((uint32_t)bytes);
+        offset += 8 + (uint32_t)padded(bytes);
+    }
+
+    file.finish();
+}
+
+
+
+void save_stream_history(
+    Logger& logger,
+    const std::string& filename,
+    const StreamHistorySnapshot& snapshot
+){
+    logger.log("Saving stream history...", COLOR_BLUE);
+    logger.log("Total frames to save: " + std::to_string(snapshot.frames.size()));
+
+    if (snapshot.frames.empty()){
+        throw InternalProgramError(&logger, PA_CURRENT_FUNCTION, "No stream history frames to save.");
+    }
+
+    WallClock start = current_time();
+
+    bool mjpeg = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".avi") == 0;
+    if (mjpeg){
+        save_stream_history_mjpeg(logger, filename, snapshot);
+    }else{
+        save_stream_history_mp4(logger, filename, snapshot);
+    }
+
+    logger.log(
+        "Done saving stream history... (" +
+        std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(current_time() - start).count()) +
+        " ms)",
+        COLOR_BLUE
+    );
+}
+
+
+
+}
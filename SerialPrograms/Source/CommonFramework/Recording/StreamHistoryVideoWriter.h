@@ -0,0 +1,54 @@
+/*  Stream History Video Writer
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Write a snapshot of the stream history to a video file. This does not
+ *  touch the tracker so it can run on a background thread while the tracker
+ *  keeps recording.
+ *
+ */
+
+#ifndef PokemonAutomation_StreamHistoryVideoWriter_H
+#define PokemonAutomation_StreamHistoryVideoWriter_H
+
+#include <memory>
+#include <vector>
+#include <string>
+#include "Common/Cpp/Time.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+struct CompressedVideoFrame{
+    WallClock timestamp;
+    std::vector<unsigned char> compressed_frame;
+};
+
+
+//  A snapshot of the history. The frames are immutable and shared with the
+//  tracker, so taking a snapshot only copies pointers.
+struct StreamHistorySnapshot{
+    std::vector<std::shared_ptr<const CompressedVideoFrame>> frames;
+    size_t fps;
+    std::chrono::microseconds frame_interval;
+};
+
+
+//  Save the snapshot to "filename". The container is picked from the file
+//  extension:
+//      ".avi": Motion JPEG. The stored JPEGs are written as-is.
+//      Otherwise: MPEG-4. The JPEGs are decoded in parallel and re-encoded.
+//
+//  Throws on failure.
+void save_stream_history(
+    Logger& logger,
+    const std::string& filename,
+    const StreamHistorySnapshot& snapshot
+);
+
+
+
+}
+#endif
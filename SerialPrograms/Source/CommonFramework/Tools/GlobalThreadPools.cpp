@@ -5,6 +5,7 @@
  */
 
 #include "Common/Cpp/Concurrency/Backends/ThreadPool_Default.h"
+#include "Common/Cpp/Concurrency/Backends/ThreadPool_WorkStealing.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/Options/Environment/PerformanceOptions.h"
@@ -15,23 +16,41 @@ namespace GlobalThreadPools{
 
 
 
+static std::unique_ptr<ThreadPool> make_computation_pool(
+    const ThreadPoolOption& option,
+    std::function<void()>&& new_thread_callback
+){
+    switch (option.BACKEND){
+    case ThreadPoolBackend::WORK_STEALING:
+        return std::make_unique<ThreadPool_WorkStealing>(
+            std::move(new_thread_callback), 0, option.MAX_THREADS
+        );
+    default:
+        return std::make_unique<ThreadPool_Default>(
+            std::move(new_thread_callback), 0, option.MAX_THREADS
+        );
+    }
+}
+
+
+
 ThreadPool& computation_realtime(){
-    static ThreadPool_Default runner(
+    static std::unique_ptr<ThreadPool> runner = make_computation_pool(
+        GlobalSettings::instance().PERFORMANCE->REALTIME_THREAD_POOL,
         [](){
             GlobalSettings::instance().PERFORMANCE->REALTIME_THREAD_POOL.PRIORITY.set_on_this_thread(global_logger_tagged());
-        },
-        0, GlobalSettings::instance().PERFORMANCE->REALTIME_THREAD_POOL.MAX_THREADS
+        }
     );
-    return runner;
+    return *runner;
 }
 ThreadPool& computation_normal(){
-    static ThreadPool_Default runner(
+    static std::unique_ptr<ThreadPool> runner = make_computation_pool(
+        GlobalSettings::instance().PERFORMANCE->NORMAL_THREAD_POOL,
         [](){
             GlobalSettings::instance().PERFORMANCE->NORMAL_THREAD_POOL.PRIORITY.set_on_this_thread(global_logger_tagged());
-        },
-        0, GlobalSettings::instance().PERFORMANCE->NORMAL_THREAD_POOL.MAX_THREADS
+        }
     );
-    return runner;
+    return *runner;
 }
 
 ThreadPool& unlimited_realtime(){
@@ -4,9 +4,11 @@
  *
  */
 
+#include <QScopeGuard>
 #include "Common/Cpp/Concurrency/ReverseLockGuard.h"
 #include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "Kernels/YUVToRGB32/Kernels_YUVToRGB32.h"
 #include "SnapshotManager.h"
 
 //#include <iostream>
@@ -28,24 +30,123 @@ SnapshotManager::~SnapshotManager(){
 SnapshotManager::SnapshotManager(Logger& logger, QVideoFrameCache& cache)
     : m_logger(logger)
     , m_cache(cache)
+    , m_image_pool(ImageRGB32Pool::make())
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
 {}
 
 
-QImage SnapshotManager::frame_to_image(const QVideoFrame& frame){
+//  Convert the raw YUV planes of the frame straight into a pooled image.
+//  Returns null if the frame isn't something we handle here.
+static std::shared_ptr<const ImageRGB32> convert_yuv_frame(QVideoFrame frame, ImageRGB32Pool& pool){
+    QVideoFrameFormat format = frame.surfaceFormat();
+    QVideoFrameFormat::PixelFormat pixel_format = format.pixelFormat();
+    switch (pixel_format){
+    case QVideoFrameFormat::Format_NV12:
+    case QVideoFrameFormat::Format_YUV420P:
+    case QVideoFrameFormat::Format_YUYV:
+        break;
+    default:
+        return nullptr;
+    }
+
+    //  Leave anything that needs to be transformed to Qt.
+    if (format.scanLineDirection() != QVideoFrameFormat::TopToBottom || frame.mirrored()){
+        return nullptr;
+    }
+#if QT_VERSION >= 0x060700
+    if (frame.rotation() != QtVideo::Rotation::None){
+        return nullptr;
+    }
+#else
+    if (frame.rotationAngle() != QVideoFrame::Rotation0){
+        return nullptr;
+    }
+#endif
+
+    //  Same choice of matrix as QVideoFrame::toImage(). Unknown is BT.709.
+    bool bt709;
+    switch (format.colorSpace()){
+    case QVideoFrameFormat::ColorSpace_Undefined:
+    case QVideoFrameFormat::ColorSpace_BT709:
+        bt709 = true;
+        break;
+    case QVideoFrameFormat::ColorSpace_BT601:
+        bt709 = false;
+        break;
+    default:
+        return nullptr;
+    }
+    bool full_range = format.colorRange() == QVideoFrameFormat::ColorRange_Full;
+
+    if (!frame.map(QVideoFrame::ReadOnly)){
+        return nullptr;
+    }
+    auto guard = qScopeGuard([&frame]{ frame.unmap(); });
+
+    size_t width = frame.width();
+    size_t height = frame.height();
+    if (width == 0 || height == 0){
+        return nullptr;
+    }
+
+    std::shared_ptr<ImageRGB32> image = pool.get(width, height);
+    const Kernels::YUVToRGB32Coefficients coefficients = Kernels::YUVToRGB32Coefficients::make(bt709, full_range);
+
+    const QVideoFrame& mapped = frame;
+    switch (pixel_format){
+    case QVideoFrameFormat::Format_NV12:
+        Kernels::convert_nv12_to_rgb32(
+            coefficients, width, height,
+            mapped.bits(0), mapped.bytesPerLine(0),
+            mapped.bits(1), mapped.bytesPerLine(1),
+            image->data(), image->bytes_per_row()
+        );
+        break;
+    case QVideoFrameFormat::Format_YUV420P:
+        Kernels::convert_yuv420p_to_rgb32(
+            coefficients, width, height,
+            mapped.bits(0), mapped.bytesPerLine(0),
+            mapped.bits(1), mapped.bytesPerLine(1),
+            mapped.bits(2), mapped.bytesPerLine(2),
+            image->data(), image->bytes_per_row()
+        );
+        break;
+    case QVideoFrameFormat::Format_YUYV:
+        Kernels::convert_yuyv_to_rgb32(
+            coefficients, width, height,
+            mapped.bits(0), mapped.bytesPerLine(0),
+            image->data(), image->bytes_per_row()
+        );
+        break;
+    default:
+        return nullptr;
+    }
+
+    return image;
+}
+
+
+std::shared_ptr<const ImageRGB32> SnapshotManager::frame_to_image(const QVideoFrame& frame){
+    std::shared_ptr<const ImageRGB32> ret = convert_yuv_frame(frame, *m_image_pool);
+    if (ret){
+        return ret;
+    }
+
+    //  Everything else (MJPEG, P010, RGB, ...) goes through Qt.
     QImage image = frame.toImage();
     QImage::Format format = image.format();
     if (format != QImage::Format_ARGB32 && format != QImage::Format_RGB32){
         image = image.convertToFormat(QImage::Format_ARGB32);
     }
-    return image;
+    return std::make_shared<const ImageRGB32>(std::move(image));
 }
 VideoSnapshot SnapshotManager::convert(QVideoFrame frame, WallClock timestamp) noexcept{
     VideoSnapshot snapshot;
     snapshot.timestamp = timestamp;
     try{
         WallClock time0 = current_time();
-        snapshot.frame = std::make_shared<const ImageRGB32>(frame_to_image(frame));
+        snapshot.frame = frame_to_image(frame);
+        snapshot.cache = std::make_shared<VideoSnapshotCache>();
         WallClock time1 = current_time();
         WriteSpinLock lg(m_stats_lock);
         m_stats_conversion.report_data(
@@ -11,6 +11,7 @@
 #include "Common/Cpp/Concurrency/Mutex.h"
 #include "Common/Cpp/Concurrency/ConditionVariable.h"
 #include "Common/Cpp/Logging/AbstractLogger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32Pool.h"
 #include "CommonFramework/Tools/StatAccumulator.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "QVideoFrameCache.h"
@@ -29,7 +30,7 @@ public:
     VideoSnapshot snapshot_recent_nonblocking(WallClock min_time);
 
 private:
-    static QImage frame_to_image(const QVideoFrame& frame);
+    std::shared_ptr<const ImageRGB32> frame_to_image(const QVideoFrame& frame);
     VideoSnapshot convert(QVideoFrame frame, WallClock timestamp) noexcept;
     void convert(uint64_t seqnum, QVideoFrame frame, WallClock timestamp) noexcept;
     bool try_dispatch_conversion(uint64_t seqnum, QVideoFrame frame, WallClock timestamp) noexcept;
@@ -49,6 +50,9 @@ private:
     Logger& m_logger;
     QVideoFrameCache& m_cache;
 
+    //  Snapshots are all the same size. Reuse their buffers.
+    std::shared_ptr<ImageRGB32Pool> m_image_pool;
+
     Mutex m_lock;
     ConditionVariable m_cv;
 
@@ -0,0 +1,54 @@
+/*  Video Snapshot Cache Stats
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/PrettyPrint.h"
+#include "CommonFramework/VideoPipeline/VideoSnapshotCache.h"
+#include "VideoSnapshotCacheStats.h"
+
+namespace PokemonAutomation{
+
+
+
+VideoSnapshotCacheStat::VideoSnapshotCacheStat(
+    std::shared_ptr<const VideoSnapshotCacheCounters> counters,
+    std::string label
+)
+    : m_counters(std::move(counters))
+    , m_label(std::move(label))
+    , m_last_hits(m_counters ? m_counters->hits.load(std::memory_order_relaxed) : 0)
+    , m_last_misses(m_counters ? m_counters->misses.load(std::memory_order_relaxed) : 0)
+{}
+
+OverlayStatSnapshot VideoSnapshotCacheStat::get_current(){
+    if (!m_counters){
+        return OverlayStatSnapshot();
+    }
+
+    std::lock_guard<Mutex> lg(m_lock);
+
+    uint64_t hits = m_counters->hits.load(std::memory_order_relaxed);
+    uint64_t misses = m_counters->misses.load(std::memory_order_relaxed);
+    uint64_t new_hits = hits - m_last_hits;
+    uint64_t new_misses = misses - m_last_misses;
+    m_last_hits = hits;
+    m_last_misses = misses;
+
+    uint64_t total = new_hits + new_misses;
+    if (total == 0){
+        return OverlayStatSnapshot();
+    }
+
+    double rate = (double)new_hits / total;
+    return OverlayStatSnapshot{
+        m_label + " " + std::to_string(new_hits) + " / " + std::to_string(total) +
+        " (" + tostr_fixed(rate * 100, 1) + " %)"
+    };
+}
+
+
+
+
+}
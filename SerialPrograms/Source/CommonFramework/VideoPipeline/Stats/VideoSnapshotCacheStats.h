@@ -0,0 +1,41 @@
+/*  Video Snapshot Cache Stats
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_VideoSnapshotCacheStats_H
+#define PokemonAutomation_VideoSnapshotCacheStats_H
+
+#include <stdint.h>
+#include <memory>
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
+
+namespace PokemonAutomation{
+
+struct VideoSnapshotCacheCounters;
+
+
+//  Hit rate of the per-frame derived image caches of one video feed since the
+//  last poll. Shows nothing if "counters" is null.
+class VideoSnapshotCacheStat : public OverlayStat{
+public:
+    VideoSnapshotCacheStat(std::shared_ptr<const VideoSnapshotCacheCounters> counters, std::string label);
+
+    virtual OverlayStatSnapshot get_current() override;
+
+private:
+    std::shared_ptr<const VideoSnapshotCacheCounters> m_counters;
+    std::string m_label;
+
+    Mutex m_lock;
+    uint64_t m_last_hits;
+    uint64_t m_last_misses;
+};
+
+
+
+
+}
+#endif
@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "VideoSnapshotCache.h"
 
 namespace PokemonAutomation{
 
@@ -22,6 +23,10 @@ struct VideoSnapshot{
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
 
+    //  Derived images (crops, scales, filters) of this frame.
+    //  Shared by all copies of this snapshot. May be null.
+    std::shared_ptr<VideoSnapshotCache> cache;
+
     VideoSnapshot()
          : frame(std::make_shared<const ImageRGB32>())
          , timestamp(WallClock::min())
@@ -29,6 +34,7 @@ struct VideoSnapshot{
     VideoSnapshot(ImageRGB32 p_frame, WallClock p_timestamp)
          : frame(std::make_shared<const ImageRGB32>(std::move(p_frame)))
          , timestamp(p_timestamp)
+         , cache(std::make_shared<VideoSnapshotCache>())
     {}
 
     //  Returns true if the snapshot is valid.
@@ -42,6 +48,7 @@ struct VideoSnapshot{
     void clear(){
         frame.reset();
         timestamp = WallClock::min();
+        cache.reset();
     }
 };
 
@@ -113,6 +120,13 @@ public:
     //  Returns the currently measured frames/second for the video display thread.
     //  Use this for diagnostic purposes.
     virtual double fps_display() const = 0;
+
+    //  Hit/miss counts of the snapshot caches of this feed's frames.
+    //  Null if this feed doesn't track them.
+    //  Use this for diagnostic purposes.
+    virtual std::shared_ptr<const VideoSnapshotCacheCounters> snapshot_cache_counters() const{
+        return nullptr;
+    }
 };
 
 
@@ -58,6 +58,7 @@ VideoSession::~VideoSession(){
 VideoSession::VideoSession(Logger& logger, VideoSourceOption& option)
     : m_logger(logger)
     , m_option(option)
+    , m_snapshot_cache_counters(std::make_shared<VideoSnapshotCacheCounters>())
     , m_descriptor(std::make_unique<VideoSourceDescriptor_Null>())
 {
     uint8_t watchdog_timeout = GlobalSettings::instance().VIDEO_PIPELINE->AUTO_RESET_SECONDS;
@@ -380,20 +381,30 @@ void VideoSession::run_commands(){
 
 
 VideoSnapshot VideoSession::snapshot_latest_blocking(){
-    ReadSpinLock lg(m_state_lock);
-    if (m_video_source){
-        return m_video_source->snapshot_latest_blocking();
-    }else{
-        return VideoSnapshot();
+    VideoSnapshot snapshot;
+    {
+        ReadSpinLock lg(m_state_lock);
+        if (m_video_source){
+            snapshot = m_video_source->snapshot_latest_blocking();
+        }
+    }
+    if (snapshot.cache){
+        snapshot.cache->attach_counters(m_snapshot_cache_counters);
     }
+    return snapshot;
 }
 VideoSnapshot VideoSession::snapshot_recent_nonblocking(WallClock min_time){
-    ReadSpinLock lg(m_state_lock);
-    if (m_video_source){
-        return m_video_source->snapshot_recent_nonblocking(min_time);
-    }else{
-        return VideoSnapshot();
+    VideoSnapshot snapshot;
+    {
+        ReadSpinLock lg(m_state_lock);
+        if (m_video_source){
+            snapshot = m_video_source->snapshot_recent_nonblocking(min_time);
+        }
+    }
+    if (snapshot.cache){
+        snapshot.cache->attach_counters(m_snapshot_cache_counters);
     }
+    return snapshot;
 }
 
 double VideoSession::fps_source() const{
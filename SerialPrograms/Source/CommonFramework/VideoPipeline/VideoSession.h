@@ -128,6 +128,12 @@ public:
     //  This function is thread-safe. It has a lock to prevent concurrent fps calls.
     virtual double fps_display() const override;
 
+    //  Implements VideoFeed::snapshot_cache_counters().
+    //  Counts the snapshot cache hits/misses of the frames from this session.
+    virtual std::shared_ptr<const VideoSnapshotCacheCounters> snapshot_cache_counters() const override{
+        return m_snapshot_cache_counters;
+    }
+
 
 public:
     //  Get current video source option
@@ -231,6 +237,8 @@ private:
     EventRateTracker m_fps_tracker_source;
     EventRateTracker m_fps_tracker_rendered;
 
+    const std::shared_ptr<VideoSnapshotCacheCounters> m_snapshot_cache_counters;
+
     std::shared_ptr<const VideoSourceDescriptor> m_descriptor;
     std::unique_ptr<VideoSource> m_video_source;
 
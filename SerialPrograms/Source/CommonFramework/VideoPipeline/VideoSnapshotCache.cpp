@@ -0,0 +1,16 @@
+/*  Video Snapshot Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "VideoSnapshotCache.h"
+
+namespace PokemonAutomation{
+
+
+std::atomic<uint64_t> VideoSnapshotCache::s_hits(0);
+std::atomic<uint64_t> VideoSnapshotCache::s_misses(0);
+
+
+}
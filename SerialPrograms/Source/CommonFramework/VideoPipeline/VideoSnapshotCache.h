@@ -0,0 +1,153 @@
+/*  Video Snapshot Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Memoize images that are derived from a single video frame so that
+ *      multiple inference callbacks looking at the same frame don't
+ *      recompute the same crops, scales, and filters.
+ *
+ *      Every copy of a VideoSnapshot shares the same cache. So the cache is
+ *      implicitly keyed by the frame (and its timestamp). The cache dies with
+ *      the last copy of the snapshot.
+ *
+ *      Each cache holds at most MAX_ENTRIES objects. Past that, results are
+ *      computed and returned without being kept, so a caller that derives
+ *      many different images from one frame cannot hold on to unbounded
+ *      memory for as long as the frame lives.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoSnapshotCache_H
+#define PokemonAutomation_VideoPipeline_VideoSnapshotCache_H
+
+#include <stdint.h>
+#include <memory>
+#include <map>
+#include <tuple>
+#include <atomic>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+
+
+//  Hit/miss counts of all the snapshot caches of one video feed.
+struct VideoSnapshotCacheCounters{
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+};
+
+
+class VideoSnapshotCache{
+public:
+    static constexpr size_t MAX_ENTRIES = 32;
+
+
+    //  The operation determines the type of the cached object.
+    //  Each operation must always be used with the same type.
+    enum class Operation : uint32_t{
+        SCALE_TO,               //  ImageRGB32
+        BINARY_RGB32_RANGE,     //  PackedBinaryMatrix
+        TILE_MAP,               //  VideoTileMap
+    };
+
+    struct Key{
+        Operation operation;
+        size_t min_x;
+        size_t min_y;
+        size_t max_x;
+        size_t max_y;
+        uint64_t param0 = 0;
+        uint64_t param1 = 0;
+
+        Key(Operation p_operation, const ImagePixelBox& box, uint64_t p_param0 = 0, uint64_t p_param1 = 0)
+            : operation(p_operation)
+            , min_x(box.min_x), min_y(box.min_y)
+            , max_x(box.max_x), max_y(box.max_y)
+            , param0(p_param0), param1(p_param1)
+        {}
+
+        bool operator<(const Key& x) const{
+            return std::tie(operation, min_x, min_y, max_x, max_y, param0, param1)
+                 < std::tie(x.operation, x.min_x, x.min_y, x.max_x, x.max_y, x.param0, x.param1);
+        }
+    };
+
+public:
+    //  Return the cached object for "key". If it doesn't exist, call
+    //  "compute()" to build it and cache the result.
+    //
+    //  "compute()" runs without holding the lock. If two threads race on the
+    //  same key, both will compute it and the first one to finish wins.
+    //  If the cache is full, the result is returned without being cached.
+    template <typename Type, typename Lambda>
+    std::shared_ptr<const Type> get_or_compute(const Key& key, Lambda&& compute){
+        VideoSnapshotCacheCounters* counters;
+        {
+            ReadSpinLock lg(m_lock);
+            counters = m_counters.get();
+            auto iter = m_cache.find(key);
+            if (iter != m_cache.end()){
+                s_hits.fetch_add(1, std::memory_order_relaxed);
+                if (counters){
+                    counters->hits.fetch_add(1, std::memory_order_relaxed);
+                }
+                return std::static_pointer_cast<const Type>(iter->second);
+            }
+        }
+        s_misses.fetch_add(1, std::memory_order_relaxed);
+        if (counters){
+            counters->misses.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::shared_ptr<const Type> value = std::make_shared<const Type>(compute());
+
+        WriteSpinLock lg(m_lock);
+        auto iter = m_cache.find(key);
+        if (iter != m_cache.end()){
+            return std::static_pointer_cast<const Type>(iter->second);
+        }
+        if (m_cache.size() < MAX_ENTRIES){
+            m_cache.emplace(key, value);
+        }
+        return value;
+    }
+
+    size_t size() const{
+        ReadSpinLock lg(m_lock);
+        return m_cache.size();
+    }
+
+    //  Also count the hits and misses of this cache into "counters". Only the
+    //  first call has an effect. Video feeds call this on the snapshots they
+    //  hand out so their stats only cover their own frames.
+    void attach_counters(std::shared_ptr<VideoSnapshotCacheCounters> counters){
+        WriteSpinLock lg(m_lock);
+        if (!m_counters){
+            m_counters = std::move(counters);
+        }
+    }
+
+public:
+    //  Process-wide hit/miss counters across all caches.
+    static uint64_t total_hits(){
+        return s_hits.load(std::memory_order_relaxed);
+    }
+    static uint64_t total_misses(){
+        return s_misses.load(std::memory_order_relaxed);
+    }
+
+private:
+    mutable SpinLock m_lock;
+    std::map<Key, std::shared_ptr<const void>> m_cache;
+    std::shared_ptr<VideoSnapshotCacheCounters> m_counters;
+
+    static std::atomic<uint64_t> s_hits;
+    static std::atomic<uint64_t> s_misses;
+};
+
+
+
+}
+#endif
@@ -0,0 +1,117 @@
+/*  Video Tile Map
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <cmath>
+#include <algorithm>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "VideoFeed.h"
+#include "VideoTileMap.h"
+
+namespace PokemonAutomation{
+
+
+
+//  Fold "count" pixels into "hash". Two pixels at a time and four independent
+//  lanes to keep the multiplier busy.
+//
+//  Each step "(h ^ w) * K" (K odd) is a bijection of both "h" and "w". Only
+//  lane 0 carries the incoming hash. The other lanes start from constants.
+//  So with everything else fixed, the result is a bijection of "hash" and of
+//  every single pixel. Changing any one pixel of a tile therefore always
+//  changes its hash, and rows folded in afterwards cannot undo it. Changes to
+//  several pixels can still collide, with the odds of a 64-bit hash.
+static uint64_t hash_pixels(uint64_t hash, const uint32_t* pixels, size_t count){
+    const uint64_t K = 0x9e3779b97f4a7c15;
+    uint64_t h0 = hash;
+    uint64_t h1 = 1;
+    uint64_t h2 = 2;
+    uint64_t h3 = 3;
+    size_t c = 0;
+    for (; c + 8 <= count; c += 8){
+        uint64_t w[4];
+        memcpy(w, pixels + c, sizeof(w));
+        h0 = (h0 ^ w[0]) * K;
+        h1 = (h1 ^ w[1]) * K;
+        h2 = (h2 ^ w[2]) * K;
+        h3 = (h3 ^ w[3]) * K;
+    }
+    for (; c < count; c++){
+        h0 = (h0 ^ pixels[c]) * K;
+    }
+    return h0 ^ (h1 >> 16 | h1 << 48) ^ (h2 >> 32 | h2 << 32) ^ (h3 >> 48 | h3 << 16);
+}
+
+
+VideoTileMap::VideoTileMap(const ImageViewRGB32& image)
+    : m_width(image.width())
+    , m_height(image.height())
+    , m_tiles_x((m_width + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles_y((m_height + TILE_SIZE - 1) / TILE_SIZE)
+    , m_hashes(m_tiles_x * m_tiles_y)
+{
+    //  Walk the image in memory order. Each row feeds a strip of tiles.
+    for (size_t y = 0; y < m_height; y++){
+        const uint32_t* row = (const uint32_t*)((const char*)image.data() + y * image.bytes_per_row());
+        uint64_t* hashes = m_hashes.data() + y / TILE_SIZE * m_tiles_x;
+        for (size_t tile_x = 0; tile_x < m_tiles_x; tile_x++){
+            size_t start = tile_x * TILE_SIZE;
+            size_t count = std::min(TILE_SIZE, m_width - start);
+            hashes[tile_x] = hash_pixels(hashes[tile_x], row + start, count);
+        }
+    }
+}
+
+bool VideoTileMap::unchanged(const VideoTileMap& previous, const ImageFloatBox& box) const{
+    if (m_width != previous.m_width || m_height != previous.m_height){
+        return false;
+    }
+    if (m_width == 0 || m_height == 0){
+        return true;
+    }
+
+    double min_x = std::floor(m_width * box.x) - 1;
+    double min_y = std::floor(m_height * box.y) - 1;
+    double max_x = std::ceil(m_width * (box.x + box.width)) + 1;
+    double max_y = std::ceil(m_height * (box.y + box.height)) + 1;
+    size_t tile_min_x = (size_t)std::max(min_x, 0.) / TILE_SIZE;
+    size_t tile_min_y = (size_t)std::max(min_y, 0.) / TILE_SIZE;
+    size_t tile_max_x = (size_t)std::max(std::min(max_x, m_width - 1.), 0.) / TILE_SIZE;
+    size_t tile_max_y = (size_t)std::max(std::min(max_y, m_height - 1.), 0.) / TILE_SIZE;
+
+    for (size_t tile_y = tile_min_y; tile_y <= tile_max_y; tile_y++){
+        for (size_t tile_x = tile_min_x; tile_x <= tile_max_x; tile_x++){
+            if (hash(tile_x, tile_y) != previous.hash(tile_x, tile_y)){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+
+
+std::shared_ptr<const VideoTileMap> get_tile_map(const VideoSnapshot& snapshot){
+    if (!snapshot){
+        return nullptr;
+    }
+    const ImageRGB32& frame = *snapshot.frame;
+    if (!snapshot.cache){
+        return std::make_shared<const VideoTileMap>(frame);
+    }
+    return snapshot.cache->get_or_compute<VideoTileMap>(
+        VideoSnapshotCache::Key(
+            VideoSnapshotCache::Operation::TILE_MAP,
+            ImagePixelBox(0, 0, frame.width(), frame.height())
+        ),
+        [&]{ return VideoTileMap(frame); }
+    );
+}
+
+
+
+}
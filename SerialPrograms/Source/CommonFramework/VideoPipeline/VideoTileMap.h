@@ -0,0 +1,72 @@
+/*  Video Tile Map
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      A coarse map of what changed between two video frames. The frame is
+ *      split into square tiles and each tile gets a hash of its pixels.
+ *      Comparing the hashes of two frames tells you which regions may have
+ *      changed without touching the pixels again.
+ *
+ *      The comparison is exact. A single pixel that differs in any channel
+ *      always changes the hash of its tile. Several changed pixels collide
+ *      only with the odds of a 64-bit hash. So noisy video sources will rarely
+ *      have unchanged tiles.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoTileMap_H
+#define PokemonAutomation_VideoPipeline_VideoTileMap_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+struct ImageFloatBox;
+struct VideoSnapshot;
+
+
+
+class VideoTileMap{
+public:
+    static constexpr size_t TILE_SIZE = 32;
+
+public:
+    VideoTileMap(const ImageViewRGB32& image);
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+    size_t tiles_x() const{ return m_tiles_x; }
+    size_t tiles_y() const{ return m_tiles_y; }
+
+    uint64_t hash(size_t tile_x, size_t tile_y) const{
+        return m_hashes[tile_y * m_tiles_x + tile_x];
+    }
+
+    //  Returns true if all the tiles that overlap "box" are the same in both
+    //  maps. Maps of different sized frames are never the same.
+    //  "box" is padded by a pixel to cover rounding differences in how
+    //  callers convert it to pixels.
+    bool unchanged(const VideoTileMap& previous, const ImageFloatBox& box) const;
+
+private:
+    size_t m_width;
+    size_t m_height;
+    size_t m_tiles_x;
+    size_t m_tiles_y;
+    std::vector<uint64_t> m_hashes;
+};
+
+
+
+//  Get the tile map for this snapshot. It is built at most once per frame and
+//  shared by all copies of the snapshot through its cache.
+//  Returns null if the snapshot is empty.
+std::shared_ptr<const VideoTileMap> get_tile_map(const VideoSnapshot& snapshot);
+
+
+
+}
+#endif
@@ -99,11 +99,21 @@ void InferenceSession::clear() noexcept{
             stopper.remove_cancel_listener(*this);
         }
         case InferenceType::VISUAL:{
-            StatAccumulatorI32 stats = m_stream.video_inference_pivot().remove_callback(
+            VisualInferencePivot::CallbackStats stats = m_stream.video_inference_pivot().remove_callback(
                 static_cast<VisualInferenceCallback&>(*item.first)
             );
             try{
-                stats.log(m_stream.logger(), item.first->label(), UNITS, DIVIDER);
+                stats.latency.log(m_stream.logger(), item.first->label(), UNITS, DIVIDER);
+                if (stats.skipped_frames != 0){
+                    m_stream.logger().log(
+                        item.first->label() + ": Skipped " + std::to_string(stats.skipped_frames) + " unchanged frames."
+                    );
+                }
+                if (stats.dropped_frames != 0){
+                    m_stream.logger().log(
+                        item.first->label() + ": Dropped " + std::to_string(stats.dropped_frames) + " frames that started too late."
+                    );
+                }
             }catch (...){}
             break;
         }
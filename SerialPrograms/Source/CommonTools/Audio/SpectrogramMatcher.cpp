@@ -6,6 +6,7 @@
 #include <fstream>
 //#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/Kernels_Alignment.h"
 #include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
 #include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
@@ -145,6 +146,10 @@ SpectrogramMatcher::SpectrogramMatcher(
 //    cout << "m_numSpectrumsNeeded = " << m_numSpectrumsNeeded << endl;
 
     m_templateNorm = buildTemplateNorm();
+
+    for (size_t i = 0; i < m_numSpectrumsNeeded; i++){
+        m_templateWindows.emplace_back(m_freqStart + m_template.getWindow(i));
+    }
 }
 
 uint64_t SpectrogramMatcher::latestTimestamp() const{
@@ -194,142 +199,132 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const{
     return ret;
 }
 
-bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
+PreprocessedSpectrum SpectrogramMatcher::preprocess(const AudioSpectrum& spectrum){
+    SpectrumPreprocessCache::Params params{
+        (size_t)m_mode, m_sample_rate, m_originalFreqStart, m_originalFreqEnd
+    };
+    return SpectrumPreprocessCache::instance().get(params, spectrum.magnitudes, [&]{
+        PreprocessedSpectrum ret;
+
+        //  Only one window worth of frequencies, padded to the SIMD size.
+        const size_t bufferSize = Kernels::align_int_up<PA_ALIGNMENT>(m_template.numFrequencies() * sizeof(float)) / sizeof(float);
+
+        switch(m_mode){
+        case Mode::SPIKE_CONV:
+        {
+            // Do the conv on new spectrum too.
+            auto convedSpectrum = std::make_shared<AlignedVector<float>>(bufferSize);
+            conv(spectrum.magnitudes->data() + m_originalFreqStart,
+                m_originalFreqEnd - m_originalFreqStart, convedSpectrum->data());
+            ret.magnitudes = std::move(convedSpectrum);
+            break;
+        }
+        case Mode::AVERAGE_5:
+        {
+            auto avgedSpectrum = std::make_shared<AlignedVector<float>>(bufferSize);
+            for (size_t j = 0; j < m_template.numFrequencies(); j++){
+                const float * rawFreqMag = spectrum.magnitudes->data() + m_originalFreqStart + j*5;
+                const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
+                (*avgedSpectrum)[j] = newMag;
+            }
+            ret.magnitudes = std::move(avgedSpectrum);
+            break;
+        }
+        case Mode::RAW:
+            ret.magnitudes = spectrum.magnitudes;
+            break;
+        }
+
+        // Compute the norm square (= sum squares) of the spectrum, used for matching:
+        const float* data = m_freqStart + ret.magnitudes->data();
+        Kernels::ScaleInvariantMatrixMatch::compute_dot_rows(
+            m_freqEnd - m_freqStart, 1,
+            &ret.norm_sqr, data, &data
+        );
+        return ret;
+    });
+}
+
+bool SpectrogramMatcher::update_to_new_spectrum(const AudioSpectrum& spectrum){
     if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
         std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
             m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
         return false;
     }
 
-    switch(m_mode){
-    case Mode::SPIKE_CONV:
-    {
-        // Do the conv on new spectrum too.
-        AlignedVector<float> convedSpectrum(m_template.bufferSize());
-        conv(spectrum.magnitudes->data() + m_originalFreqStart,
-            m_originalFreqEnd - m_originalFreqStart, convedSpectrum.data());
-        
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(convedSpectrum));
-        break;
-    }
-    case Mode::AVERAGE_5:
-    {
-        AlignedVector<float> avgedSpectrum(m_template.bufferSize());
-        for (size_t j = 0; j < m_template.numFrequencies(); j++){
-            const float * rawFreqMag = spectrum.magnitudes->data() + m_originalFreqStart + j*5;
-            const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
-            avgedSpectrum[j] = newMag;
-        }
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(avgedSpectrum));
-        break;
-    }
-    case Mode::RAW:
-        break;
-    }
+    PreprocessedSpectrum processed = preprocess(spectrum);
 
-    // Compute the norm square (= sum squares) of the spectrum, used for matching:
-    // TODO: if there will be multiple SpectrogramMatcher running on the same audio stream, can
-    // move this per-spectrum computation to a shared struct for those matchers to save computation.
-    float spectrumNormSqr = 0.0f;
-    for (size_t i = m_freqStart; i < m_freqEnd; i++){
-        float mag = (*spectrum.magnitudes)[i];
-        spectrumNormSqr += mag * mag;
+    StoredSpectrum stored;
+    stored.stamp = spectrum.stamp;
+    stored.normSqr = processed.norm_sqr;
+    if (!m_spareDots.empty()){
+        stored.templateDots = std::move(m_spareDots.back());
+        m_spareDots.pop_back();
     }
-    m_spectrumNormSqrs.push_front(spectrumNormSqr);
+    stored.templateDots.resize(m_templateWindows.size());
+
+    // This is the only place that touches every frequency. Each spectrum is
+    // dotted against each template window exactly once over its lifetime.
+    Kernels::ScaleInvariantMatrixMatch::compute_dot_rows(
+        m_freqEnd - m_freqStart, m_templateWindows.size(),
+        stored.templateDots.data(),
+        m_freqStart + processed.magnitudes->data(),
+        m_templateWindows.data()
+    );
 
-    m_spectrums.emplace_front(std::move(spectrum));
+    m_spectrums.emplace_front(std::move(stored));
 
     return true;
 }
 
 bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum>& new_spectrums){
-    for (auto it = new_spectrums.rbegin(); it != new_spectrums.rend(); it++){
-        if(!update_to_new_spectrum(*it)){
+    // Anything older than the newest `m_numSpectrumsNeeded` spectrums would be
+    // dropped right away. Don't bother processing them.
+    const size_t count = std::min(new_spectrums.size(), m_numSpectrumsNeeded);
+    for (size_t i = count; i > 0; i--){
+        if(!update_to_new_spectrum(new_spectrums[i - 1])){
             return false;
         }
     }
 
     // pop out too old spectrums
     while (m_spectrums.size() > m_numSpectrumsNeeded){
+        m_spareDots.emplace_back(std::move(m_spectrums.back().templateDots));
         m_spectrums.pop_back();
-        m_spectrumNormSqrs.pop_back();
     }
 
     return true;
 }
 
 std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index) const{
-#if 0
-    auto iter = m_spectrums.begin();
-    auto iter2 = m_spectrumNormSqrs.begin();
-    float streamSumSqr = 0.0f;
-    float sumMulti = 0.0f;
-
-    const size_t template_start = m_templateRange[sub_index].first;
-    const size_t template_end = m_templateRange[sub_index].second;
-    for (size_t i = template_start; i < template_end; i++, iter++, iter2++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        streamSumSqr += *iter2;
-        for (size_t j = m_freqStart; j < m_freqEnd; j++){
-            sumMulti += templateData[j] * streamData[j];
-        }
-    }
-//    cout << "sumMulti = " << sumMulti << ", streamSumSqr = " << streamSumSqr << endl;
-    const float scale = (streamSumSqr < 1e-6f ? 1.0f : sumMulti / streamSumSqr);
-
-    iter = m_spectrums.begin();
-    float sum = 0.0f;
-    for (size_t i = template_start; i < template_end; i++, iter++){
+    //  All sub-templates are lined up against the first `m_numSpectrumsNeeded`
+    //  template windows and normalized by the norm of the first sub-template.
+    const size_t windows = m_templateWindows.size();
+
+    //  Accumulate in double. The error below is a difference of large terms.
+    double sumMulti = 0;
+    double streamSumSqr = 0;
+    for (size_t i = 0; i < windows; i++){
         // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        for (size_t j = m_freqStart; j < m_freqEnd; j++){
-            float d = templateData[j] - scale * streamData[j];
-            sum += d * d;
-        }
-    }
-#else
-    //  Build matrix.
-    auto iter = m_spectrums.begin();
-    const size_t template_start = m_templateRange[sub_index].first;
-    const size_t template_end = m_templateRange[sub_index].second;
-    size_t windows = template_end - template_start;
-//    cout << windows << endl;
-//    cout << m_spectrums.size() << " / " << windows << endl;
-    size_t freqs = m_freqEnd - m_freqStart;
-    std::vector<const float*> matrixA(windows);
-    std::vector<const float*> matrixT(windows);
-    for (size_t i = 0; i < windows; i++, iter++){
-//        cout << "Template: " << ((size_t)m_template.getWindow(template_end - 1 - i) % 64) << endl;
-//        cout << "Samples:  " << ((size_t)iter->magnitudes->data() % 64) << endl;
-        matrixT[i] = m_freqStart + m_template.getWindow(windows - 1 - i);
-        matrixA[i] = m_freqStart + iter->magnitudes->data();
-//        cout << matrixT[i] << " : " << matrixA[i] << endl;
+        const StoredSpectrum& spectrum = m_spectrums[i];
+        sumMulti += spectrum.templateDots[windows - 1 - i];
+        streamSumSqr += spectrum.normSqr;
     }
 
     //  Compute scale.
-    float scale = Kernels::ScaleInvariantMatrixMatch::compute_scale(
-        freqs, windows,
-        matrixA.data(), matrixT.data()
-    );
-    scale = std::min<float>(scale, 1000000);
+    double scale = streamSumSqr > 0 ? sumMulti / streamSumSqr : 0;
+    scale = std::min<double>(scale, 1000000);
 
-    //  Compute error.
-    float sum = Kernels::ScaleInvariantMatrixMatch::compute_error(
-        freqs, windows,
-        scale,
-        matrixA.data(), matrixT.data()
-    );
-#endif
+    //  Compute error: |s A - T|^2 = |T|^2 - 2 s <A, T> + s^2 |A|^2
+    const double templateNormSqr = (double)m_templateNorm[0] * m_templateNorm[0];
+    double sum = templateNormSqr - 2 * scale * sumMulti + scale * scale * streamSumSqr;
+    sum = std::max(sum, 0.0);
 
-
-    float score = sqrt(sum) / m_templateNorm[0];
+    float score = (float)(std::sqrt(sum) / m_templateNorm[0]);
 //    cout << "score = " << score << endl;
     score = std::min<float>(score, 1.0);
 
-    return std::make_pair(score, scale);
+    return std::make_pair(score, (float)scale);
 }
 
 float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums){
@@ -383,17 +378,17 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums)
 }
 
 bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& new_spectrums){
-    // Note: ideally we don't want to have any computation while skipping.
-    // But update_to_new_spectrums() may still do some filtering and vector norm computation.
-    // Since the computation is relatively small and we won't be skipping lots of frames anyway,
-    // this should be fine for now.
-    // We can improve this later.
+    // Skipped spectrums will still be part of the windows matched later. So
+    // they still need to be filtered and dotted against the template here.
+    // This is the same work a match would do minus the O(windows) scoring.
     return update_to_new_spectrums(new_spectrums);
 }
 
 void SpectrogramMatcher::clear(){
+    for (StoredSpectrum& spectrum : m_spectrums){
+        m_spareDots.emplace_back(std::move(spectrum.templateDots));
+    }
     m_spectrums.clear();
-    m_spectrumNormSqrs.clear();
     m_lastStampTested = SIZE_MAX;
     m_lastScale = 0.0;
 }
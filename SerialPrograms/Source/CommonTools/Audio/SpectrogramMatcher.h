@@ -11,9 +11,10 @@
 #include <array>
 #include <memory>
 #include <vector>
-#include <list>
+#include <deque>
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "SpectrumPreprocessCache.h"
 
 namespace PokemonAutomation{
 
@@ -21,6 +22,11 @@ class AudioSpectrum;
 
 // Load an audio template from disk and use its spectrogram to match the
 // spectrogram of the incoming audio stream.
+//
+// The match is incremental. Each incoming spectrum is filtered once (shared
+// with other matchers on the same stream) and dotted against the template
+// windows once. Scoring the latest window then only needs to sum up those
+// stored dot products instead of rescanning the whole spectrogram.
 class SpectrogramMatcher{
 public:
     enum class Mode{
@@ -86,9 +92,13 @@ private:
     // For a given sub-template, return its match score and scaling factor
     std::pair<float, float> match_sub_template(size_t sub_index) const;
 
+    // Apply the filtering of `m_mode` to a new spectrum. The result is shared
+    // with all other matchers that use the same filtering on the same stream.
+    PreprocessedSpectrum preprocess(const AudioSpectrum& spectrum);
+
     // Update internal data for the next new spectrum. Called by `update_to_new_spectrums()`.
     // Return true if there is no error.
-    bool update_to_new_spectrum(AudioSpectrum newSpectrum);
+    bool update_to_new_spectrum(const AudioSpectrum& newSpectrum);
 
     // Update internal data for the new specttrums.
     // Return true if there is no error.
@@ -118,10 +128,21 @@ private:
 
     std::vector<float> m_convKernel;
 
-    // Spectrums from audio feed. They will be matched against the template.
-    std::list<AudioSpectrum> m_spectrums;
-    // Norm squares of each spectrum in `m_spectrums`.
-    std::list<float> m_spectrumNormSqrs;
+    // The template windows that the stream is matched against, already offset
+    // by `m_freqStart`.
+    std::vector<const float*> m_templateWindows;
+
+    struct StoredSpectrum{
+        uint64_t stamp;
+        // Norm square (= sum squares) of the filtered spectrum.
+        float normSqr;
+        // Dot product of the filtered spectrum with each of `m_templateWindows`.
+        std::vector<float> templateDots;
+    };
+    // Spectrums from audio feed. Newest at the front.
+    std::deque<StoredSpectrum> m_spectrums;
+    // Buffers of dropped spectrums. Reused so the steady state doesn't allocate.
+    std::vector<std::vector<float>> m_spareDots;
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
@@ -0,0 +1,71 @@
+/*  Spectrum Preprocess Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <tuple>
+#include "SpectrumPreprocessCache.h"
+
+namespace PokemonAutomation{
+
+
+//  Every matcher consumes a spectrum within a few windows of it arriving.
+//  So only a short history needs to be kept.
+const size_t SPECTRUM_PREPROCESS_CACHE_SIZE = 256;
+
+
+bool SpectrumPreprocessCache::Params::operator<(const Params& x) const{
+    return std::tie(mode, sample_rate, freq_start, freq_end)
+         < std::tie(x.mode, x.sample_rate, x.freq_start, x.freq_end);
+}
+
+SpectrumPreprocessCache& SpectrumPreprocessCache::instance(){
+    static SpectrumPreprocessCache cache;
+    return cache;
+}
+
+
+PreprocessedSpectrum SpectrumPreprocessCache::get(
+    const Params& params,
+    const std::shared_ptr<const AlignedVector<float>>& source,
+    const std::function<PreprocessedSpectrum()>& process
+){
+    Key key(source.get(), params);
+    {
+        WriteSpinLock lg(m_lock);
+        auto iter = m_map.find(key);
+        if (iter != m_map.end()){
+            m_lru.splice(m_lru.begin(), m_lru, iter->second);
+            return iter->second->result;
+        }
+    }
+
+    PreprocessedSpectrum result = process();
+
+    //  Free the evicted entries outside the lock.
+    std::list<Entry> evicted;
+    {
+        WriteSpinLock lg(m_lock);
+        auto iter = m_map.find(key);
+        if (iter != m_map.end()){
+            m_lru.splice(m_lru.begin(), m_lru, iter->second);
+            return iter->second->result;
+        }
+
+        m_lru.emplace_front(Entry{key, source, result});
+        m_map.emplace(key, m_lru.begin());
+
+        while (m_lru.size() > SPECTRUM_PREPROCESS_CACHE_SIZE){
+            auto last = std::prev(m_lru.end());
+            m_map.erase(last->key);
+            evicted.splice(evicted.begin(), m_lru, last);
+        }
+    }
+
+    return result;
+}
+
+
+
+}
@@ -0,0 +1,80 @@
+/*  Spectrum Preprocess Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_SpectrumPreprocessCache_H
+#define PokemonAutomation_CommonTools_SpectrumPreprocessCache_H
+
+#include <stddef.h>
+#include <memory>
+#include <functional>
+#include <list>
+#include <map>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Containers/AlignedVector.h"
+
+namespace PokemonAutomation{
+
+
+// A spectrum after the filtering of a SpectrogramMatcher mode.
+struct PreprocessedSpectrum{
+    std::shared_ptr<const AlignedVector<float>> magnitudes;
+    // Sum of squares of the magnitudes that are matched.
+    float norm_sqr = 0;
+};
+
+
+// All the SpectrogramMatchers that listen to the same audio stream see the
+// same AudioSpectrum objects. Matchers with the same mode and frequency range
+// will filter each of them the exact same way. This cache lets them share
+// that work instead of repeating it once per matcher.
+class SpectrumPreprocessCache{
+public:
+    // Everything that determines the result of the filtering other than the
+    // source spectrum itself.
+    struct Params{
+        size_t mode;
+        size_t sample_rate;
+        size_t freq_start;
+        size_t freq_end;
+
+        bool operator<(const Params& x) const;
+    };
+
+    // Return the filtered version of "source" for "params". If it isn't
+    // cached yet, call "process" to build it.
+    // "process" runs outside the lock. It may run concurrently for the same
+    // source if two matchers race on it. The first result to finish wins.
+    PreprocessedSpectrum get(
+        const Params& params,
+        const std::shared_ptr<const AlignedVector<float>>& source,
+        const std::function<PreprocessedSpectrum()>& process
+    );
+
+    static SpectrumPreprocessCache& instance();
+
+private:
+    SpectrumPreprocessCache() = default;
+
+    using Key = std::pair<const AlignedVector<float>*, Params>;
+    struct Entry{
+        Key key;
+        //  Hold the source so its address can't be reused by another spectrum
+        //  while it is still a key here.
+        std::shared_ptr<const AlignedVector<float>> source;
+        PreprocessedSpectrum result;
+    };
+
+private:
+    SpinLock m_lock;
+    //  Most recently used at the front.
+    std::list<Entry> m_lru;
+    std::map<Key, std::list<Entry>::iterator> m_map;
+};
+
+
+
+}
+#endif
@@ -24,6 +24,11 @@ public:
 
     void add(const std::string& slug, const ImageViewRGB32& image);
 
+    //  Same as add(), but for a template that has already been cropped with
+    //  trim_image_alpha(). The template is used in place without copying, so
+    //  it must outlive this matcher. "stats" must be template_stats(cropped).
+    void add_cropped(const std::string& slug, const ImageViewRGB32& cropped, const TemplateStats& stats);
+
     ImageMatchResult match(const ImageViewRGB32& image, double alpha_spread) const;
 
 
@@ -5,10 +5,13 @@
  */
 
 #include <cmath>
+#include <limits>
 #include <vector>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTools/ImageStats.h"
 #include "CommonFramework/ImageTools/ImageDiff.h"
 #include "ExactImageDictionaryMatcher.h"
 
@@ -67,7 +70,7 @@ std::vector<ImageRGB32> make_image_set(
 ExactImageDictionaryMatcher::ExactImageDictionaryMatcher(const WeightedExactImageMatcher::InverseStddevWeight& weight)
     : m_weight(weight)
 {}
-void ExactImageDictionaryMatcher::add(const std::string& slug, ImageRGB32 image){
+void ExactImageDictionaryMatcher::check_new_template(const std::string& slug, const ImageViewRGB32& image){
     if (!image){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Null image.");
     }
@@ -83,7 +86,9 @@ void ExactImageDictionaryMatcher::add(const std::string& slug, ImageRGB32 image)
     if (iter != m_database.end()){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Duplicate slug: " + slug);
     }
-
+}
+void ExactImageDictionaryMatcher::add(const std::string& slug, ImageRGB32 image){
+    check_new_template(slug, image);
     m_database.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(slug),
@@ -93,6 +98,14 @@ void ExactImageDictionaryMatcher::add(const std::string& slug, ImageRGB32 image)
 //        cout << slug << " = " << m_database.find(slug)->second.stats().stddev.sum() << endl;
 //    }
 }
+void ExactImageDictionaryMatcher::add(const std::string& slug, const ImageViewRGB32& image, const TemplateStats& stats){
+    check_new_template(slug, image);
+    m_database.emplace(
+        std::piecewise_construct,
+        std::forward_as_tuple(slug),
+        std::forward_as_tuple(image, stats, m_weight)
+    );
+}
 
 
 #if 0
@@ -125,11 +138,99 @@ double ExactImageDictionaryMatcher::compare(
 //    cout << best << endl;
     return best;
 }
+double ExactImageDictionaryMatcher::compare_bounded(
+    const WeightedExactImageMatcher& sprite,
+    const std::vector<ImageRGB32>& images,
+    double max_alpha
+){
+    //  An image can bail out as soon as it's worse than either the best image
+    //  so far (can't change the min) or "max_alpha" (caller doesn't care).
+    double best = 10000;
+    for (const ImageRGB32& image : images){
+        double rmsd_alpha = sprite.diff_bounded(image, std::min(best, max_alpha));
+        best = std::min(best, rmsd_alpha);
+    }
+    return best;
+}
+ImageMatchResult ExactImageDictionaryMatcher::match_pruned(
+    const std::vector<const Entry*>& candidates,
+    const std::vector<ImageRGB32>& images,
+    double alpha_spread
+){
+    //  Visit the templates whose color stats are closest to the input first so
+    //  that we get a tight bound early. This ordering is only a heuristic. It
+    //  does not affect the result.
+    std::vector<std::pair<double, size_t>> order;
+    order.reserve(candidates.size());
+    if (!images.empty()){
+        ImageStats stats = image_stats(images[images.size() / 2]);
+        for (size_t c = 0; c < candidates.size(); c++){
+            const ImageStats& template_stats = candidates[c]->second.stats();
+            double distance =
+                euclidean_distance(stats.average, template_stats.average) +
+                euclidean_distance(stats.stddev, template_stats.stddev);
+            order.emplace_back(distance, c);
+        }
+        std::sort(order.begin(), order.end());
+    }else{
+        for (size_t c = 0; c < candidates.size(); c++){
+            order.emplace_back(0, c);
+        }
+    }
+
+    //  A template is pruned once it's provably worse than the best so far plus
+    //  the spread. Since the best only goes down, ImageMatchResult would have
+    //  dropped it anyway.
+    std::vector<double> alphas(candidates.size());
+    std::vector<bool> pruned(candidates.size(), false);
+    double best = std::numeric_limits<double>::infinity();
+    for (const auto& item : order){
+        double max_alpha = best + alpha_spread;
+        double alpha = compare_bounded(candidates[item.second]->second, images, max_alpha);
+        if (alpha > max_alpha){
+            pruned[item.second] = true;
+            continue;
+        }
+        alphas[item.second] = alpha;
+        best = std::min(best, alpha);
+    }
+
+    //  Replay the survivors in the original order so that ties come out in the
+    //  same order as the exhaustive search.
+    ImageMatchResult results;
+    for (size_t c = 0; c < candidates.size(); c++){
+        if (pruned[c]){
+            continue;
+        }
+        results.add(alphas[c], candidates[c]->first);
+        results.clear_beyond_spread(alpha_spread);
+    }
+    return results;
+}
 
 ImageMatchResult ExactImageDictionaryMatcher::match(
     const ImageViewRGB32& image, const ImageFloatBox& box,
     size_t tolerance,
     double alpha_spread
+) const{
+    if (!image){
+        return ImageMatchResult();
+    }
+
+    std::vector<const Entry*> candidates;
+    candidates.reserve(m_database.size());
+    for (const auto& item : m_database){
+        candidates.emplace_back(&item);
+    }
+
+    // Translate the input image area a bit to careate matching candidates.
+    std::vector<ImageRGB32> image_set = make_image_set(image, box, m_width, m_height, tolerance);
+    return match_pruned(candidates, image_set, alpha_spread);
+}
+ImageMatchResult ExactImageDictionaryMatcher::match_exhaustive(
+    const ImageViewRGB32& image, const ImageFloatBox& box,
+    size_t tolerance,
+    double alpha_spread
 ) const{
     ImageMatchResult results;
     if (!image){
@@ -156,21 +257,23 @@ ImageMatchResult ExactImageDictionaryMatcher::subset_match(
     size_t tolerance,
     double alpha_spread
 ) const{
-    ImageMatchResult results;
     if (!image){
-        return results;
+        return ImageMatchResult();
     }
 
-    // Translate the input image area a bit to careate matching candidates.
-    std::vector<ImageRGB32> image_set = make_image_set(image, box,  m_width, m_height, tolerance);
+    std::vector<const Entry*> candidates;
+    candidates.reserve(subset.size());
     for (const auto& slug : subset){
-        const auto& matcher = image_matcher(slug);
-        double alpha = compare(matcher, image_set);
-        results.add(alpha, slug);
-        results.clear_beyond_spread(alpha_spread);
+        auto iter = m_database.find(slug);
+        if (iter == m_database.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown slug: " + slug);
+        }
+        candidates.emplace_back(&*iter);
     }
 
-    return results;
+    // Translate the input image area a bit to careate matching candidates.
+    std::vector<ImageRGB32> image_set = make_image_set(image, box,  m_width, m_height, tolerance);
+    return match_pruned(candidates, image_set, alpha_spread);
 }
 
 ImageViewRGB32 ExactImageDictionaryMatcher::image_template(const std::string& slug) const{
@@ -30,6 +30,10 @@ public:
     // Do not allow one slug to have more than one template.
     void add(const std::string& slug, ImageRGB32 image_template);
 
+    // Same as above, but use the template in place without copying it. It
+    // must outlive this matcher. "stats" must be template_stats(image_template).
+    void add(const std::string& slug, const ImageViewRGB32& image_template, const TemplateStats& stats);
+
 //    QSize dimensions() const{ return m_dimensions; }
 
     // Scale image to match the size of the templates.
@@ -45,12 +49,24 @@ public:
     // The input image area will be scaled to the template shape before matching.
     // The brightness of the input image and the stddev of the template is compensated during
     // matching. 
+    //
+    // Templates are visited in order of how close their color stats are to the input so that
+    // a good bound is found early. Any template whose score is provably outside `alpha_spread`
+    // of the best is abandoned partway through. The result is identical to match_exhaustive().
     ImageMatchResult match(
         const ImageViewRGB32& image, const ImageFloatBox& box,
         size_t tolerance,
         double alpha_spread
     ) const;
 
+    // Reference implementation of match() that fully scores every template.
+    // Used for verification and benchmarking.
+    ImageMatchResult match_exhaustive(
+        const ImageViewRGB32& image, const ImageFloatBox& box,
+        size_t tolerance,
+        double alpha_spread
+    ) const;
+
     // Match on a subset of the templates.
     // See match() for deatils on how the matching is done against a template.
     ImageMatchResult subset_match(
@@ -66,11 +82,32 @@ public:
 
 
 private:
+    using Entry = std::pair<const std::string, WeightedExactImageMatcher>;
+
+    // Throw if a template of this size can't be added under this slug.
+    void check_new_template(const std::string& slug, const ImageViewRGB32& image);
+
     static double compare(
         const WeightedExactImageMatcher& sprite,
         const std::vector<ImageRGB32>& images
     );
 
+    // Like compare(), but may return any value larger than `max_alpha` once
+    // the result is known to exceed it.
+    static double compare_bounded(
+        const WeightedExactImageMatcher& sprite,
+        const std::vector<ImageRGB32>& images,
+        double max_alpha
+    );
+
+    // Score `candidates` against `images` with pruning. The results are
+    // assembled in the order of `candidates`.
+    static ImageMatchResult match_pruned(
+        const std::vector<const Entry*>& candidates,
+        const std::vector<ImageRGB32>& images,
+        double alpha_spread
+    );
+
 
 private:
     WeightedExactImageMatcher::InverseStddevWeight m_weight;
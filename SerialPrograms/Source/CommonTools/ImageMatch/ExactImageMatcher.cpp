@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include "Common/Cpp/Exceptions.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqrDev.h"
 #include "CommonFramework/ImageTools/ImageDiff.h"
 #include "ExactImageMatcher.h"
 
@@ -17,8 +18,29 @@ namespace PokemonAutomation{
 namespace ImageMatch{
 
 
+static uint64_t count_opaque_pixels(const ImageViewRGB32& image){
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation(
+        count, sumsqrs,
+        image.width(), image.height(),
+        image.data(), image.bytes_per_row(),
+        image.data(), image.bytes_per_row()
+    );
+    return count;
+}
+TemplateStats template_stats(const ImageViewRGB32& image_template){
+    TemplateStats ret;
+    ret.stats = image_stats(image_template);
+    ret.opaque_pixels = count_opaque_pixels(image_template);
+    return ret;
+}
+
+
+
 ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
-    : m_image(std::move(image))
+    : m_storage(std::move(image))
+    , m_image(m_storage)
     , m_stats(image_stats(m_image))
 {
     if (!m_image){
@@ -26,6 +48,14 @@ ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
     }
 //    cout << m_stats.stddev.sum() << endl;
 }
+ExactImageMatcher::ExactImageMatcher(const ImageViewRGB32& image, const ImageStats& stats)
+    : m_image(image)
+    , m_stats(stats)
+{
+    if (!m_image){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Image is null.");
+    }
+}
 
 ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
     FloatPixel image_brightness = pixel_average(image, m_image);
@@ -97,6 +127,16 @@ double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
 WeightedExactImageMatcher::WeightedExactImageMatcher(ImageRGB32 image, const InverseStddevWeight& weight)
     : ExactImageMatcher(std::move(image))
     , m_multiplier(1. / (m_stats.stddev.sum() * weight.stddev_coefficient + weight.offset))
+    , m_opaque_pixels(count_opaque_pixels(m_image))
+{}
+WeightedExactImageMatcher::WeightedExactImageMatcher(
+    const ImageViewRGB32& image,
+    const TemplateStats& stats,
+    const InverseStddevWeight& weight
+)
+    : ExactImageMatcher(image, stats.stats)
+    , m_multiplier(1. / (m_stats.stddev.sum() * weight.stddev_coefficient + weight.offset))
+    , m_opaque_pixels(stats.opaque_pixels)
 {}
 
 
@@ -118,6 +158,43 @@ double WeightedExactImageMatcher::diff_masked(const ImageViewRGB32& image) const
     }
     return rmsd_masked(image) * m_multiplier;
 }
+double WeightedExactImageMatcher::diff_bounded(const ImageViewRGB32& image, double max_diff) const{
+    if (!image){
+        return 1000.;
+    }
+    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
+    ImageRGB32 reference = scale_template_brightness(scaled);
+
+    //  Same as pixel_RMSD(), but a few rows at a time so we can stop as soon
+    //  as the partial sum is already too large. The sums are integers so the
+    //  chunking does not change the final result.
+    //
+    //  The partial value uses the same expression as the final one and every
+    //  step of it is monotonic. So if it exceeds "max_diff", so will the final.
+    const size_t ROWS_PER_CHECK = 4;
+
+    const size_t width = reference.width();
+    const size_t height = reference.height();
+    const double opaque_pixels = (double)m_opaque_pixels;
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    for (size_t row = 0; row < height; row += ROWS_PER_CHECK){
+        size_t rows = std::min(ROWS_PER_CHECK, height - row);
+        Kernels::sum_sqr_deviation(
+            count, sumsqrs,
+            width, rows,
+            reference.sub_image(0, row, width, rows).data(), reference.bytes_per_row(),
+            scaled.sub_image(0, row, width, rows).data(), scaled.bytes_per_row()
+        );
+        double partial = std::sqrt((double)sumsqrs / opaque_pixels) * m_multiplier;
+        if (partial > max_diff){
+            return partial;
+        }
+    }
+
+    double rmsd = std::sqrt((double)sumsqrs / (double)count);
+    return rmsd * m_multiplier;
+}
 
 
 
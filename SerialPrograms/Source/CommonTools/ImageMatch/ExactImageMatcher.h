@@ -14,6 +14,16 @@ namespace PokemonAutomation{
 namespace ImageMatch{
 
 
+//  Everything the matchers below derive from a template image. This depends
+//  only on the template so it can be computed ahead of time and stored with it.
+struct TemplateStats{
+    ImageStats stats;
+    // # of pixels in the template with non-zero alpha.
+    uint64_t opaque_pixels = 0;
+};
+TemplateStats template_stats(const ImageViewRGB32& image_template);
+
+
 //  Match images against a template image.
 //  Before matching, resize the input image to the template shape and scale template brightness to
 //  match the input image. The template alpha channel is used as masks in matching.
@@ -29,7 +39,11 @@ public:
         : ExactImageMatcher(ImageRGB32(image_template))
     {}
     ExactImageMatcher(ImageRGB32 image_template);
-    
+
+    //  Use "image_template" in place without copying it. It must outlive this
+    //  matcher. "stats" must be image_stats(image_template).
+    ExactImageMatcher(const ImageViewRGB32& image_template, const ImageStats& stats);
+
     const ImageStats& stats() const{ return m_stats; }
 
     // Resize image to match the shape of the image template, scale the template brightness to match
@@ -50,15 +64,17 @@ public:
     // If both two images have alpha==0 on one pixel, that pixel is ignored.
     double rmsd_masked(const ImageViewRGB32& image) const;
 
-    const ImageRGB32& image_template() const { return m_image; }
+    const ImageViewRGB32& image_template() const { return m_image; }
 
-private:
+protected:
     // scale stored image template according to the brightness of `image`, assign
     // the scaled template to `reference`.
     ImageRGB32 scale_template_brightness(const ImageViewRGB32& image) const;
 
 protected:
-    ImageRGB32 m_image;
+    //  Empty if the template is not owned by this matcher.
+    ImageRGB32 m_storage;
+    ImageViewRGB32 m_image;
     ImageStats m_stats;
 };
 
@@ -83,6 +99,14 @@ public:
 
     WeightedExactImageMatcher(ImageRGB32 image_template, const InverseStddevWeight& weight);
 
+    //  Use "image_template" in place without copying it. It must outlive this
+    //  matcher. "stats" must be template_stats(image_template).
+    WeightedExactImageMatcher(
+        const ImageViewRGB32& image_template,
+        const TemplateStats& stats,
+        const InverseStddevWeight& weight
+    );
+
     // Like ExactImageMatcher::rmsd(image) but scale based on template stddev.
     double diff(const ImageViewRGB32& image) const;
     // Like ExactImageMatcher::rmsd(image, background) but scale based on template stddev.
@@ -90,8 +114,17 @@ public:
     // Like ExactImageMatcher::rmsd_masked(image) but scale based on template stddev.
     double diff_masked(const ImageViewRGB32& image) const;
 
+    // Same as diff(image), but gives up early once the result is known to be
+    // larger than `max_diff`. In that case it returns some value larger than
+    // `max_diff`. Otherwise the result is bit-identical to diff(image).
+    double diff_bounded(const ImageViewRGB32& image, double max_diff) const;
+
 public:
     double m_multiplier;
+
+private:
+    // # of pixels in the template with non-zero alpha.
+    uint64_t m_opaque_pixels;
 };
 
 
@@ -83,7 +83,7 @@ public:
     ) const;
 
     //  Return the image template mesh
-    const ImageRGB32& image_template() const { return m_matcher->image_template(); }
+    const ImageViewRGB32& image_template() const { return m_matcher->image_template(); }
 
 protected:
     // This function is called inside each rmsd...() function before the actual RMSD computation.
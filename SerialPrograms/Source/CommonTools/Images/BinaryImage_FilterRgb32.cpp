@@ -193,6 +193,20 @@ PackedBinaryMatrix compress_rgb32_to_binary_multirange(
 
 
 
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+){
+    PackedBinaryMatrix ret(image.width(), image.height());
+    Kernels::compress_rgb32_to_binary_hsv_range(
+        image.data(), image.bytes_per_row(),
+        ret, mins, maxs
+    );
+    return ret;
+}
+
+
+
 PackedBinaryMatrix compress_rgb32_to_binary_euclidean(
     const ImageViewRGB32& image,
     uint32_t expected, double max_euclidean_distance
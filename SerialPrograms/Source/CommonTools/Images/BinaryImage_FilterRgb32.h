@@ -98,6 +98,20 @@ PackedBinaryMatrix compress_rgb32_to_binary_multirange(
 
 
 
+//  Convert each pixel to HSV32 and filter on the HSV ranges. `mins` and `maxs`
+//  are HSV32 pixels. (see ImageHSV32)
+//  If the min hue is greater than the max hue, the hue range wraps around
+//  through zero.
+//  Same as filtering ImageHSV32(image), but without the intermediate image.
+PackedBinaryMatrix compress_rgb32_to_binary_hsv_range(
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs
+);
+
+
+
+
+
 PackedBinaryMatrix compress_rgb32_to_binary_euclidean(
     const ImageViewRGB32& image,
     uint32_t expected, double max_euclidean_distance
@@ -0,0 +1,74 @@
+/*  Snapshot Cached Filters
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "CommonFramework/VideoPipeline/VideoSnapshotCache.h"
+#include "BinaryImage_FilterRgb32.h"
+#include "SnapshotCachedFilters.h"
+
+namespace PokemonAutomation{
+
+
+
+//  The pixels extract_box_reference(image, box) would give. Note that this
+//  rounds the size, not the far edge, so it can differ from
+//  floatbox_to_pixelbox() by a pixel.
+static ImagePixelBox snapshot_pixel_box(const VideoSnapshot& snapshot, const ImageFloatBox& box){
+    const ImageRGB32& image = *snapshot.frame;
+    size_t min_x = (size_t)(image.width() * box.x + 0.5);
+    size_t min_y = (size_t)(image.height() * box.y + 0.5);
+    size_t width = (size_t)(image.width() * box.width + 0.5);
+    size_t height = (size_t)(image.height() * box.height + 0.5);
+    return ImagePixelBox(min_x, min_y, min_x + width, min_y + height);
+}
+
+
+template <typename Type, typename Lambda>
+std::shared_ptr<const Type> get_or_compute_cached(
+    const VideoSnapshot& snapshot,
+    const VideoSnapshotCache::Key& key,
+    Lambda&& compute
+){
+    if (snapshot.cache){
+        return snapshot.cache->get_or_compute<Type>(key, std::forward<Lambda>(compute));
+    }
+    return std::make_shared<const Type>(compute());
+}
+
+
+
+std::shared_ptr<const ImageRGB32> cached_scale_to(
+    const VideoSnapshot& snapshot, const ImageFloatBox& box,
+    size_t width, size_t height
+){
+    ImagePixelBox pixel_box = snapshot_pixel_box(snapshot, box);
+    return get_or_compute_cached<ImageRGB32>(
+        snapshot,
+        VideoSnapshotCache::Key(VideoSnapshotCache::Operation::SCALE_TO, pixel_box, width, height),
+        [&]{
+            return extract_box_reference(*snapshot.frame, pixel_box).scale_to(width, height);
+        }
+    );
+}
+std::shared_ptr<const PackedBinaryMatrix> cached_compress_rgb32_to_binary_range(
+    const VideoSnapshot& snapshot, const ImageFloatBox& box,
+    uint32_t mins, uint32_t maxs
+){
+    ImagePixelBox pixel_box = snapshot_pixel_box(snapshot, box);
+    return get_or_compute_cached<PackedBinaryMatrix>(
+        snapshot,
+        VideoSnapshotCache::Key(VideoSnapshotCache::Operation::BINARY_RGB32_RANGE, pixel_box, mins, maxs),
+        [&]{
+            return compress_rgb32_to_binary_range(
+                extract_box_reference(*snapshot.frame, pixel_box),
+                mins, maxs
+            );
+        }
+    );
+}
+
+
+
+}
@@ -0,0 +1,44 @@
+/*  Snapshot Cached Filters
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Versions of common image operations that are memoized in the frame's
+ *      VideoSnapshotCache. Use these from process_frame(const VideoSnapshot&)
+ *      or StaticScreenDetector::detect_snapshot() when several detectors are
+ *      likely to ask for the same region.
+ *
+ *      The results are shared. Copy them before modifying them.
+ *
+ *      If the snapshot has no cache, these fall back to computing directly.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_SnapshotCachedFilters_H
+#define PokemonAutomation_CommonTools_SnapshotCachedFilters_H
+
+#include <stdint.h>
+#include <memory>
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
+
+namespace PokemonAutomation{
+
+
+//  extract_box_reference(snapshot, box).scale_to(width, height)
+std::shared_ptr<const ImageRGB32> cached_scale_to(
+    const VideoSnapshot& snapshot, const ImageFloatBox& box,
+    size_t width, size_t height
+);
+
+//  compress_rgb32_to_binary_range(extract_box_reference(snapshot, box), mins, maxs)
+std::shared_ptr<const PackedBinaryMatrix> cached_compress_rgb32_to_binary_range(
+    const VideoSnapshot& snapshot, const ImageFloatBox& box,
+    uint32_t mins, uint32_t maxs
+);
+
+
+
+}
+#endif
@@ -8,7 +8,9 @@
 #define PokemonAutomation_CommonTools_VisualInferenceCallback_H
 
 #include <string>
+#include <vector>
 #include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "InferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -40,6 +42,29 @@ public:
     //  The base class's implementation throws `InternalProgramError`.
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp);
 
+    //  The boxes passed to skip_unchanged_frames(). Empty if this callback
+    //  hasn't opted in.
+    const std::vector<ImageFloatBox>& unchanged_skip_boxes() const{
+        return m_unchanged_skip_boxes;
+    }
+
+protected:
+    //  Opt in to frame skipping. If none of the pixels in "boxes" have changed
+    //  since the last frame this callback processed, the inference pivot will
+    //  not call process_frame() on the new frame.
+    //
+    //  Only do this if process_frame() looks at nothing outside these boxes
+    //  and returns false again on the same pixels. Callbacks that depend on
+    //  time or on earlier frames (hold durations, frozen screen checks) must
+    //  not opt in.
+    //
+    //  Call this from the constructor.
+    void skip_unchanged_frames(std::vector<ImageFloatBox> boxes){
+        m_unchanged_skip_boxes = std::move(boxes);
+    }
+
+private:
+    std::vector<ImageFloatBox> m_unchanged_skip_boxes;
 };
 
 
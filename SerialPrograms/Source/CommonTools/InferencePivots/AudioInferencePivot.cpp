@@ -26,6 +26,9 @@ struct AudioInferencePivot::PeriodicCallback{
 
     uint64_t last_seqnum = ~(uint64_t)0;
 
+    //  Reused on every poll so that polling doesn't allocate.
+    std::vector<AudioSpectrum> spectrums;
+
     StatAccumulatorI32 stats;
 
     PeriodicCallback(
@@ -92,22 +95,26 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        std::vector<AudioSpectrum> spectrums;
+        AudioSpectrumView view;
 
         if (callback.last_seqnum == ~(uint64_t)0){
 //            cout << "m_last_timestamp == SIZE_MAX" << endl;
-            spectrums = m_feed.spectrums_latest(1);
+            view = m_feed.spectrum_view_latest(1);
         }else{
 //            cout << "(m_last_timestamp != SIZE_MAX" << endl;
             //  Note: in this file we never consider the case that stamp may overflow.
             //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
-            spectrums = m_feed.spectrums_since(callback.last_seqnum + 1);
+            view = m_feed.spectrum_view_since(callback.last_seqnum + 1);
         }
-        if (spectrums.size() > 0){
-            //  spectrums[0] has the newest spectrum with the largest stamp:
-            callback.last_seqnum = spectrums[0].stamp;
+        if (!view.empty()){
+            callback.last_seqnum = view.end_stamp() - 1;
         }
 
+        //  Callbacks take a vector. If this callback fell so far behind that
+        //  the ring lapped it, the spectrums it missed are dropped here.
+        std::vector<AudioSpectrum>& spectrums = callback.spectrums;
+        view.copy_to(spectrums);
+
         WallClock time0 = current_time();
         bool stop = callback.callback.process_spectrums(spectrums, m_feed);
         WallClock time1 = current_time();
@@ -5,8 +5,11 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Options/Environment/PerformanceOptions.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "CommonFramework/VideoPipeline/VideoTileMap.h"
 #include "VisualInferencePivot.h"
 
 //#include <iostream>
@@ -25,6 +28,15 @@ struct VisualInferencePivot::PeriodicCallback{
     WallClock last_timestamp;
     StatAccumulatorI32 stats;
 
+    //  Frame skipping only: The tile map of the last frame that was processed.
+    std::shared_ptr<const VideoTileMap> last_tiles;
+    uint64_t skipped = 0;
+
+    //  Parallel mode only: The invocation that is currently in flight and the
+    //  # of invocations that were dropped because they started too late.
+    AsyncTask task;
+    uint64_t dropped = 0;
+
     PeriodicCallback(
         Cancellable& p_scope,
         std::atomic<InferenceCallback*>* p_set_when_triggered,
@@ -45,12 +57,19 @@ struct VisualInferencePivot::PeriodicCallback{
 VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed)
     : BusyPeriodicRunner(GlobalThreadPools::unlimited_pivot())
     , m_feed(feed)
+    , m_parallel(GlobalSettings::instance().PERFORMANCE->PARALLEL_VISUAL_INFERENCE)
 {
     attach(scope);
 }
 VisualInferencePivot::~VisualInferencePivot(){
     detach();
     stop_thread();
+
+    //  The runner thread is gone so nothing new can be dispatched.
+    //  Drain anything that is still in flight.
+    for (auto& item : m_map){
+        item.second.task.wait_and_ignore_exceptions();
+    }
 }
 void VisualInferencePivot::add_callback(
     Cancellable& scope,
@@ -76,20 +95,40 @@ void VisualInferencePivot::add_callback(
         throw;
     }
 }
-StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback& callback){
-    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
-    auto iter = m_map.find(&callback);
-    if (iter == m_map.end()){
-        return StatAccumulatorI32();
+VisualInferencePivot::CallbackStats VisualInferencePivot::remove_callback(VisualInferenceCallback& callback){
+    PeriodicCallback* entry;
+    {
+        WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+        auto iter = m_map.find(&callback);
+        if (iter == m_map.end()){
+            return CallbackStats();
+        }
+        entry = &iter->second;
     }
-    StatAccumulatorI32 stats = iter->second.stats;
-    BusyPeriodicRunner::remove_event(&iter->second);
-    m_map.erase(iter);
+
+    //  Once this returns, the runner will never touch this entry again.
+    BusyPeriodicRunner::remove_event(entry);
+
+    //  But there may still be an invocation in flight on the thread pool.
+    //  Don't hold the lock for this since it can take a while.
+    entry->task.wait_and_ignore_exceptions();
+
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    CallbackStats stats;
+    stats.latency = entry->stats;
+    stats.skipped_frames = entry->skipped;
+    stats.dropped_frames = entry->dropped;
+    m_map.erase(&callback);
     return stats;
 }
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
+        //  The previous invocation is still running. Skip this period.
+        if (callback.task && !callback.task.is_finished()){
+            return;
+        }
+
         //  Reuse the cached screenshot.
         if (!is_back_to_back || callback.last_timestamp == m_last.timestamp){
             m_last = m_feed.snapshot_recent_nonblocking(callback.last_timestamp);
@@ -99,13 +138,71 @@ void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
             return;
         }
 
+        //  Nothing this callback looks at has changed since it last ran.
+        if (is_unchanged(callback, m_last)){
+            callback.last_timestamp = m_last.timestamp;
+            callback.skipped++;
+            return;
+        }
+
+        if (!m_parallel){
+            run_callback(callback, m_last);
+            return;
+        }
+
+        //  Reap the previous invocation before reusing the slot.
+        callback.task.wait_and_ignore_exceptions();
+
+        //  If the task doesn't start before its next period is due, the frame
+        //  is stale. Drop it and let the next period dispatch a fresher one.
+        //  "last_timestamp" is left alone so the next period doesn't wait for
+        //  a newer frame than the one that was never looked at.
+        //
+        //  The task is the only thing that touches "dropped", "stats",
+        //  "last_timestamp" and "last_tiles" while it's in flight. This thread
+        //  only reads them once it has seen the task finish.
+        WallClock deadline = current_time() + callback.period;
+        callback.task = GlobalThreadPools::computation_realtime().dispatch(
+            [this, &callback, frame = m_last, deadline]{
+                if (current_time() > deadline){
+                    callback.dropped++;
+                    return;
+                }
+                run_callback(callback, frame);
+            }
+        );
+    }catch (...){
+        callback.scope.cancel(std::current_exception());
+    }
+}
+bool VisualInferencePivot::is_unchanged(const PeriodicCallback& callback, const VideoSnapshot& frame){
+    const std::vector<ImageFloatBox>& boxes = callback.callback.unchanged_skip_boxes();
+    if (boxes.empty() || !callback.last_tiles){
+        return false;
+    }
+    std::shared_ptr<const VideoTileMap> tiles = get_tile_map(frame);
+    for (const ImageFloatBox& box : boxes){
+        if (!tiles->unchanged(*callback.last_tiles, box)){
+            return false;
+        }
+    }
+    return true;
+}
+void VisualInferencePivot::run_callback(PeriodicCallback& callback, const VideoSnapshot& frame) noexcept{
+    try{
         WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
+        bool stop = callback.callback.process_frame(frame);
         WallClock time1 = current_time();
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
-        callback.last_timestamp = m_last.timestamp;
+        callback.last_timestamp = frame.timestamp;
+
+        if (!callback.callback.unchanged_skip_boxes().empty()){
+            callback.last_tiles = get_tile_map(frame);
+        }
 
         if (stop){
+            //  First callback to trigger wins. This is atomic so it also holds
+            //  when several callbacks are running in parallel.
             if (callback.set_when_triggered){
                 InferenceCallback* expected = nullptr;
                 callback.set_when_triggered->compare_exchange_strong(expected, &callback.callback);
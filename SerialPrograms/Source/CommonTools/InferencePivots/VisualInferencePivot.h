@@ -22,6 +22,16 @@ class VideoFeed;
 
 class VisualInferencePivot final : public BusyPeriodicRunner, public OverlayStat{
 public:
+    //  If "Parallel Visual Inference" is enabled in the performance settings,
+    //  each due callback is dispatched to the real-time thread pool instead of
+    //  running on the pivot thread. A callback never has more than one
+    //  invocation in flight. An invocation that cannot start before its next
+    //  period is due is dropped. Its frame is then offered again on the next
+    //  period and the drop is counted in the callback's stats.
+    //
+    //  Callbacks that opt in with skip_unchanged_frames() are not called on
+    //  frames where none of their boxes have changed since the last frame they
+    //  processed.
     VisualInferencePivot(CancellableScope& scope, VideoFeed& feed);
     virtual ~VisualInferencePivot();
 
@@ -37,8 +47,14 @@ public:
         WallClock start_time
     );
 
-    //  Returns the latency stats for the callback. Units are microseconds.
-    StatAccumulatorI32 remove_callback(VisualInferenceCallback& callback);
+    struct CallbackStats{
+        StatAccumulatorI32 latency;     //  Microseconds
+        uint64_t skipped_frames = 0;    //  Frames skipped because nothing changed.
+        uint64_t dropped_frames = 0;    //  Parallel mode: Invocations that started too late.
+    };
+
+    //  Returns the stats for the callback.
+    CallbackStats remove_callback(VisualInferenceCallback& callback);
 
 private:
     virtual void run(void* event, bool is_back_to_back) noexcept override;
@@ -47,7 +63,11 @@ private:
 private:
     struct PeriodicCallback;
 
+    bool is_unchanged(const PeriodicCallback& callback, const VideoSnapshot& frame);
+    void run_callback(PeriodicCallback& callback, const VideoSnapshot& frame) noexcept;
+
     VideoFeed& m_feed;
+    const bool m_parallel;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
@@ -8,6 +8,8 @@
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonBinary.h"
+#include "CommonFramework/Globals.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "OCR_StringNormalization.h"
 #include "OCR_TextMatcher.h"
@@ -39,8 +41,11 @@ DictionaryOCR::DictionaryOCR(
         for (const auto& item1 : item0.second.to_array_throw()){
             const std::string& candidate = item1.to_string_throw();
             std::u32string normalized = normalize_utf32(candidate);
-            std::set<std::string>& set = m_candidate_to_token[normalized];
-            if (!set.empty()){
+            MatchCandidate& entry = m_candidate_to_token[normalized];
+            std::set<std::string>& set = entry.tokens;
+            if (set.empty()){
+                entry.pattern = LevenshteinPattern(normalized);
+            }else{
                 global_logger_tagged().log(
                     "DictionaryOCR - Duplicate Candidate: " + token + " (" + utf32_to_str(normalized) + ")"
                 );
@@ -66,7 +71,7 @@ DictionaryOCR::DictionaryOCR(
     bool first_only
 )
     : DictionaryOCR(
-        load_json_file(json_path).to_object_throw(json_path),
+        load_json_file_cached(json_path, RESOURCE_CACHE_PATH()).to_object_throw(json_path),
         subset,
         random_match_chance,
         first_only
@@ -110,12 +115,14 @@ void DictionaryOCR::add_candidate(std::string token, const std::u32string& candi
     if (iter == m_candidate_to_token.end()){
         //  New candidate. Add it to both maps.
         m_database[token].emplace_back(utf32_to_str(candidate));
-        m_candidate_to_token[candidate].insert(std::move(token));
+        MatchCandidate& entry = m_candidate_to_token[candidate];
+        entry.pattern = LevenshteinPattern(candidate);
+        entry.tokens.insert(std::move(token));
         return;
     }
 
     //  Candidate already exists in table.
-    std::set<std::string>& tokens = iter->second;
+    std::set<std::string>& tokens = iter->second.tokens;
     if (tokens.find(token) == tokens.end()){
         //  Add to database only if it isn't already there.
         m_database[token].emplace_back(utf32_to_str(candidate));
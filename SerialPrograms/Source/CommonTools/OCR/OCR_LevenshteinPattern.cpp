@@ -0,0 +1,144 @@
+/*  Levenshtein Pattern
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "OCR_TextMatcher.h"
+#include "OCR_LevenshteinPattern.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+CharacterHistogram::CharacterHistogram(const std::u32string& str){
+    std::u32string sorted = str;
+    std::sort(sorted.begin(), sorted.end());
+    for (char32_t ch : sorted){
+        if (m_counts.empty() || m_counts.back().first != ch){
+            m_counts.emplace_back(ch, 0);
+        }
+        m_counts.back().second++;
+    }
+}
+size_t CharacterHistogram::overlap(const CharacterHistogram& x) const{
+    size_t ret = 0;
+    auto iter0 = m_counts.begin();
+    auto iter1 = x.m_counts.begin();
+    while (iter0 != m_counts.end() && iter1 != x.m_counts.end()){
+        if (iter0->first < iter1->first){
+            ++iter0;
+        }else if (iter1->first < iter0->first){
+            ++iter1;
+        }else{
+            ret += std::min(iter0->second, iter1->second);
+            ++iter0;
+            ++iter1;
+        }
+    }
+    return ret;
+}
+
+
+
+LevenshteinPattern::LevenshteinPattern(std::u32string pattern)
+    : m_pattern(std::move(pattern))
+    , m_histogram(m_pattern)
+{
+    if (m_pattern.size() > 64){
+        return;
+    }
+    for (size_t c = 0; c < m_pattern.size(); c++){
+        m_peq.emplace_back(m_pattern[c], (uint64_t)1 << c);
+    }
+    std::sort(m_peq.begin(), m_peq.end());
+
+    //  Merge duplicate characters.
+    size_t out = 0;
+    for (size_t c = 0; c < m_peq.size(); c++){
+        if (out != 0 && m_peq[out - 1].first == m_peq[c].first){
+            m_peq[out - 1].second |= m_peq[c].second;
+        }else{
+            m_peq[out++] = m_peq[c];
+        }
+    }
+    m_peq.resize(out);
+}
+uint64_t LevenshteinPattern::peq(char32_t ch) const{
+    auto iter = std::lower_bound(
+        m_peq.begin(), m_peq.end(), ch,
+        [](const std::pair<char32_t, uint64_t>& x, char32_t y){ return x.first < y; }
+    );
+    return iter != m_peq.end() && iter->first == ch ? iter->second : 0;
+}
+
+
+//  Each column of the DP matrix is stored as vertical deltas (+1/-1) in the
+//  bitmasks "pv" and "mv". "score" tracks the bottom cell of the column.
+//
+//  The only difference between the two modes is the top row of the matrix.
+//  For the full distance it increases by 1 every column. For the substring
+//  search it is all zeros so the match can start anywhere.
+template <bool substring>
+size_t LevenshteinPattern::distance_bit_parallel(const std::u32string& text) const{
+    const size_t m = m_pattern.size();
+    const uint64_t high_bit = (uint64_t)1 << (m - 1);
+
+    uint64_t pv = ~(uint64_t)0;
+    uint64_t mv = 0;
+    size_t score = m;
+    size_t min = m;
+
+    for (char32_t ch : text){
+        uint64_t eq = peq(ch);
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        if (ph & high_bit){
+            score++;
+        }else if (mh & high_bit){
+            score--;
+        }
+
+        ph <<= 1;
+        mh <<= 1;
+        if (!substring){
+            ph |= 1;
+        }
+
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        min = std::min(min, score);
+    }
+
+    return substring ? min : score;
+}
+
+
+size_t LevenshteinPattern::distance(const std::u32string& text) const{
+    if (m_pattern.empty()){
+        return text.size();
+    }
+    if (m_pattern.size() > 64){
+        return levenshtein_distance(m_pattern, text);
+    }
+    return distance_bit_parallel<false>(text);
+}
+size_t LevenshteinPattern::distance_substring(const std::u32string& text) const{
+    if (m_pattern.empty()){
+        return 0;
+    }
+    if (m_pattern.size() > 64){
+        return levenshtein_distance_substring(m_pattern, text);
+    }
+    return distance_bit_parallel<true>(text);
+}
+
+
+
+}
+}
@@ -0,0 +1,82 @@
+/*  Levenshtein Pattern
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      A dictionary string preprocessed for fast edit distance against many
+ *      different texts.
+ *
+ *      Patterns of up to 64 characters use the bit-parallel algorithm of
+ *      Myers (1999) in the formulation of Hyyrö (2001). This runs in O(n)
+ *      word operations instead of O(n*m). Longer patterns fall back to the
+ *      regular dynamic programming.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_OCR_LevenshteinPattern_H
+#define PokemonAutomation_CommonTools_OCR_LevenshteinPattern_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+//  Sorted (character, count) pairs of a string.
+class CharacterHistogram{
+public:
+    CharacterHistogram() = default;
+    explicit CharacterHistogram(const std::u32string& str);
+
+    //  # of characters the two strings have in common, counting multiplicity.
+    size_t overlap(const CharacterHistogram& x) const;
+
+private:
+    std::vector<std::pair<char32_t, uint32_t>> m_counts;
+};
+
+
+
+class LevenshteinPattern{
+public:
+    LevenshteinPattern() = default;
+    explicit LevenshteinPattern(std::u32string pattern);
+
+    const std::u32string& pattern() const{ return m_pattern; }
+    size_t size() const{ return m_pattern.size(); }
+    const CharacterHistogram& histogram() const{ return m_histogram; }
+
+    //  Same result as levenshtein_distance(pattern, text).
+    size_t distance(const std::u32string& text) const;
+
+    //  Same result as levenshtein_distance_substring(pattern, text).
+    size_t distance_substring(const std::u32string& text) const;
+
+    //  An upper bound on "size() - distance_substring(text)". Any alignment
+    //  can only match characters that both strings have.
+    size_t max_matched(const CharacterHistogram& text) const{
+        return m_histogram.overlap(text);
+    }
+
+private:
+    uint64_t peq(char32_t ch) const;
+
+    template <bool substring>
+    size_t distance_bit_parallel(const std::u32string& text) const;
+
+private:
+    std::u32string m_pattern;
+    CharacterHistogram m_histogram;
+
+    //  For each distinct character in the pattern, the bitmask of its
+    //  positions. Sorted by character. Only used if the pattern fits in 64.
+    std::vector<std::pair<char32_t, uint64_t>> m_peq;
+};
+
+
+
+
+}
+}
+#endif
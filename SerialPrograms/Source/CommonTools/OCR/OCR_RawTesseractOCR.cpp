@@ -4,16 +4,25 @@
  *
  */
 
+#include <string.h>
 #include <memory>
+#include <list>
 #include <deque>
 #include <QFile>
 #include <QDir>
 #include "3rdParty/TesseractPA/TesseractPA.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/Watchdog.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalServices.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Options/Environment/PerformanceOptions.h"
 #include "CommonFramework/Logging/Logger.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "OCR_RawTesseractOCR.h"
 
 #include <iostream>
@@ -34,37 +43,141 @@ bool tesseract_language_available(Language language){
 }
 
 
+//  Hash of the pixels. Padding at the end of each row is ignored.
+static uint64_t hash_image(const ImageViewRGB32& image){
+    uint64_t hash = 0xcbf29ce484222325;
+    hash = (hash ^ image.width()) * 0x100000001b3;
+    hash = (hash ^ image.height()) * 0x100000001b3;
+    for (size_t r = 0; r < image.height(); r++){
+        const uint32_t* row = (const uint32_t*)((const char*)image.data() + r * image.bytes_per_row());
+        for (size_t c = 0; c < image.width(); c++){
+            hash = (hash ^ row[c]) * 0x100000001b3;
+        }
+    }
+    return hash;
+}
+static bool image_equals(const ImageViewRGB32& x, const ImageViewRGB32& y){
+    if (x.width() != y.width() || x.height() != y.height()){
+        return false;
+    }
+    size_t bytes = x.width() * sizeof(uint32_t);
+    for (size_t r = 0; r < x.height(); r++){
+        const char* row_x = (const char*)x.data() + r * x.bytes_per_row();
+        const char* row_y = (const char*)y.data() + r * y.bytes_per_row();
+        if (memcmp(row_x, row_y, bytes) != 0){
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//  Recent OCR results of one language keyed by (image, psm).
+//  Programs often read the same static dialog over and over. Those reads
+//  don't need to go through Tesseract again.
+class TesseractResultCache{
+public:
+    TesseractResultCache(size_t capacity)
+        : m_capacity(capacity)
+    {}
+
+    bool enabled() const{
+        return m_capacity != 0;
+    }
+
+    bool lookup(std::string& text, uint64_t hash, const ImageViewRGB32& image, int psm){
+        WriteSpinLock lg(m_lock, "TesseractResultCache::lookup()");
+        for (auto iter = m_entries.begin(); iter != m_entries.end(); ++iter){
+            if (iter->hash != hash || iter->psm != psm || !image_equals(iter->image, image)){
+                continue;
+            }
+            text = iter->text;
+
+            //  Move to front.
+            m_entries.splice(m_entries.begin(), m_entries, iter);
+            return true;
+        }
+        return false;
+    }
+    void insert(uint64_t hash, const ImageViewRGB32& image, int psm, std::string text){
+        Entry entry{hash, psm, image.copy(), std::move(text)};
+
+        std::list<Entry> evicted;
+        {
+            WriteSpinLock lg(m_lock, "TesseractResultCache::insert()");
+            m_entries.emplace_front(std::move(entry));
+            while (m_entries.size() > m_capacity){
+                evicted.splice(evicted.end(), m_entries, std::prev(m_entries.end()));
+            }
+        }
+    }
+
+private:
+    struct Entry{
+        uint64_t hash;
+        int psm;
+        ImageRGB32 image;
+        std::string text;
+    };
+
+    const size_t m_capacity;
+    SpinLock m_lock;
+    std::list<Entry> m_entries;     //  Most recently used first.
+};
+
+
+
 // Thread-safe object pool for TesseractAPI instances for a specific language.
 // Allows concurrent OCR operations by maintaining multiple Tesseract instances that can be
-// checked out, used, and returned. Instances are created lazily on demand.
-class TesseractPool{
+// checked out, used, and returned. Instances are created lazily on demand up to
+// TESSERACT_MAX_INSTANCES. Beyond that, callers block until an instance is returned.
+// Instances that sit idle for longer than TESSERACT_IDLE_TIMEOUT are freed.
+// This is checked on checkout, checkin and periodically from the global
+// watchdog so that a pool that stops being used still releases its instances.
+class TesseractPool : public WatchdogCallback{
 public:
     TesseractPool(Language language)
         : m_language_code(language_data(language).code)
         , m_training_data_path(
             QDir::current().relativeFilePath(QString::fromStdString(RESOURCE_PATH() + "Tesseract/")).toStdString()
         )
-    {}
+        , m_max_instances(GlobalSettings::instance().PERFORMANCE->TESSERACT_MAX_INSTANCES)
+        , m_idle_timeout(GlobalSettings::instance().PERFORMANCE->TESSERACT_IDLE_TIMEOUT)
+        , m_min_instances(1)
+        , m_instances(0)
+        , m_cache(GlobalSettings::instance().PERFORMANCE->OCR_CACHE_SIZE)
+    {
+        if (m_idle_timeout != std::chrono::milliseconds::zero()){
+            global_watchdog().add(*this, m_idle_timeout);
+        }
+    }
+    ~TesseractPool(){
+        global_watchdog().remove(*this);
+#ifdef __APPLE__
+#ifdef UNIX_LINK_TESSERACT
+        for (auto& item : m_idle){
+            item.api.release();
+        }
+#endif
+#endif
+    }
 
     // Perform OCR on the given image. Thread-safe - can be called concurrently.
-    // Checkout pattern: (1) acquire idle instance from pool (or create new one if none available),
-    // (2) configure PSM, (3) run OCR without holding lock, (4) return instance to idle pool.
+    // Checkout pattern: (1) acquire idle instance from pool (or create new one if allowed,
+    // otherwise wait for one), (2) configure PSM, (3) run OCR without holding lock,
+    // (4) return instance to idle pool.
     std::string run(const ImageViewRGB32& image, int psm){
-        TesseractAPI* instance;
-        // Checkout: Try to get an idle instance, create new one if the idle pool is empty.
-        while (true){
-            {
-                WriteSpinLock lg(m_lock, "TesseractPool::run()");
-                if (!m_idle.empty()){
-                    instance = m_idle.back();
-                    m_idle.pop_back();
-                    break;
-                }
+        uint64_t hash = 0;
+        if (m_cache.enabled()){
+            hash = hash_image(image);
+            std::string cached;
+            if (m_cache.lookup(cached, hash, image, psm)){
+                return cached;
             }
-            // No idle instance available - create a new one.
-            add_instance();
         }
 
+        std::unique_ptr<TesseractAPI> instance = checkout();
+
         // Configure PSM before OCR (safe to call between images on same instance).
         // PSM is page segmentation mode for Tessearct.
         instance->set_page_seg_mode(psm);
@@ -80,19 +193,131 @@ public:
 //        auto end = current_time();
 //        cout << std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count() << endl;
         // Checkin: Return instance to the idle pool.
-        {
-            WriteSpinLock lg(m_lock, "TesseractPool::run()");
-            m_idle.emplace_back(instance);
-        }
+        checkin(std::move(instance));
 
-        return str.c_str() == nullptr
+        std::string ret = str.c_str() == nullptr
             ? std::string()
             : str.c_str();
+
+        if (m_cache.enabled()){
+            m_cache.insert(hash, image, psm, ret);
+        }
+
+        return ret;
     }
 
-    // Create a new TesseractAPI instance and add it to the pool.
-    // Thread-safe - can be called concurrently (using `m_lock` when modifying the pool).
-    void add_instance(){
+    // Pre-allocate a minimum number of instances to avoid lazy initialization during runtime.
+    // Useful for warming up the pool before heavy OCR workloads.
+    // Pre-allocated instances are exempt from idle eviction.
+    void ensure_instances(size_t instances){
+        if (m_max_instances != 0){
+            instances = std::min(instances, m_max_instances);
+        }
+        {
+            std::lock_guard<Mutex> lg(m_lock);
+            m_min_instances = std::max(m_min_instances, instances);
+        }
+        while (true){
+            {
+                std::lock_guard<Mutex> lg(m_lock);
+                if (m_instances >= instances){
+                    break;
+                }
+                m_instances++;
+            }
+            checkin(create_instance_reserved());
+        }
+    }
+
+private:
+    virtual void on_watchdog_timeout() override{
+        std::vector<std::unique_ptr<TesseractAPI>> evicted;
+        {
+            std::lock_guard<Mutex> lg(m_lock);
+            evict_expired(evicted, current_time());
+        }
+        report_evicted(evicted);
+    }
+
+    std::unique_ptr<TesseractAPI> checkout(){
+        std::vector<std::unique_ptr<TesseractAPI>> evicted;
+        {
+            std::unique_lock<Mutex> lg(m_lock);
+            evict_expired(evicted, current_time());
+            while (true){
+                if (!m_idle.empty()){
+                    std::unique_ptr<TesseractAPI> instance = std::move(m_idle.back().api);
+                    m_idle.pop_back();
+                    lg.unlock();
+                    report_evicted(evicted);
+                    return instance;
+                }
+
+                // No idle instance available - create a new one if we're allowed to.
+                if (m_max_instances == 0 || m_instances < m_max_instances){
+                    m_instances++;
+                    break;
+                }
+
+                m_cv.wait(lg);
+            }
+        }
+        report_evicted(evicted);
+        return create_instance_reserved();
+    }
+    void checkin(std::unique_ptr<TesseractAPI> instance){
+        std::vector<std::unique_ptr<TesseractAPI>> evicted;
+        {
+            std::lock_guard<Mutex> lg(m_lock);
+            WallClock now = current_time();
+            m_idle.emplace_back(IdleInstance{std::move(instance), now});
+            evict_expired(evicted, now);
+        }
+        m_cv.notify_one();
+        report_evicted(evicted);
+    }
+
+    // The idle list is in order of last use. Move the oldest ones that have
+    // expired into "evicted". Must be called under `m_lock`. The caller frees
+    // them after releasing the lock.
+    void evict_expired(std::vector<std::unique_ptr<TesseractAPI>>& evicted, WallClock now){
+        if (m_idle_timeout == std::chrono::milliseconds::zero()){
+            return;
+        }
+        while (m_instances > m_min_instances &&
+            !m_idle.empty() &&
+            m_idle.front().last_used + m_idle_timeout < now
+        ){
+            evicted.emplace_back(std::move(m_idle.front().api));
+            m_idle.pop_front();
+            m_instances--;
+        }
+    }
+    void report_evicted(const std::vector<std::unique_ptr<TesseractAPI>>& evicted){
+        if (evicted.empty()){
+            return;
+        }
+        global_logger_tagged().log(
+            "Freeing " + std::to_string(evicted.size()) +
+            " idle TesseractAPI instance(s) (" + m_language_code + ")."
+        );
+    }
+
+    // Create a new TesseractAPI instance. The caller must have already counted
+    // it in `m_instances`. If this fails, the slot is released.
+    std::unique_ptr<TesseractAPI> create_instance_reserved(){
+        try{
+            return create_instance();
+        }catch (...){
+            {
+                std::lock_guard<Mutex> lg(m_lock);
+                m_instances--;
+            }
+            m_cv.notify_one();
+            throw;
+        }
+    }
+    std::unique_ptr<TesseractAPI> create_instance(){
         //  Check for non-ascii characters in path.
         for (char ch : m_training_data_path){
             if (ch < 0){
@@ -113,55 +338,31 @@ public:
         if (!api->valid()){
             throw InternalSystemError(nullptr, PA_CURRENT_FUNCTION, "Could not initialize TesseractAPI.");
         }
-
-        // Add to pool under lock.
-        WriteSpinLock lg(m_lock, "TesseractPool::run()");
-
-        m_instances.emplace_back(std::move(api));
-        try{
-            m_idle.emplace_back(m_instances.back().get());
-        }catch (...){
-            m_instances.pop_back();
-            throw;
-        }
-    }
-
-    // Pre-allocate a minimum number of instances to avoid lazy initialization during runtime.
-    // Useful for warming up the pool before heavy OCR workloads.
-    void ensure_instances(size_t instances){
-        size_t current_instances;
-        while (true){
-            {
-                ReadSpinLock lg(m_lock, "TesseractPool::run()");
-                current_instances = m_instances.size();
-            }
-            if (current_instances >= instances){
-                break;
-            }
-            add_instance();
-        }
+        return api;
     }
 
-#ifdef __APPLE__
-#ifdef UNIX_LINK_TESSERACT
-    ~TesseractPool(){
-        for (auto& api : m_instances){
-            api.release();
-        }
-    }
-#endif
-#endif
-
 private:
+    struct IdleInstance{
+        std::unique_ptr<TesseractAPI> api;
+        WallClock last_used;
+    };
+
     const std::string& m_language_code;
     const std::string m_training_data_path;
-
-    // Concurrency: m_lock protects both m_instances and m_idle vectors.
-    SpinLock m_lock;
-    // Owns all created Tesseract instances.
-    std::vector<std::unique_ptr<TesseractAPI>> m_instances;
-    // Current idle Tesseract instances in `m_instances`.
-    std::vector<TesseractAPI*> m_idle;
+    const size_t m_max_instances;
+    const std::chrono::milliseconds m_idle_timeout;
+
+    // Concurrency: m_lock protects m_min_instances, m_instances and m_idle.
+    Mutex m_lock;
+    ConditionVariable m_cv;
+    // Never evict below this many instances.
+    size_t m_min_instances;
+    // Total # of instances. Includes checked out ones and ones being created.
+    size_t m_instances;
+    // Current idle Tesseract instances. Least recently used first.
+    std::deque<IdleInstance> m_idle;
+
+    TesseractResultCache m_cache;
 };
 
 // Global singleton managing TesseractPools for all languages.
@@ -172,6 +373,12 @@ struct OcrGlobals{
     SpinLock ocr_pool_lock;                       // Protects ocr_pool map.
     std::map<Language, TesseractPool> ocr_pool;   // One pool per language.
 
+    // The pools register with the watchdog. Construct it first so that it
+    // outlives them during static destruction.
+    OcrGlobals(){
+        global_watchdog();
+    }
+
     static OcrGlobals& instance(){
         static OcrGlobals globals;
         return globals;
@@ -229,6 +436,40 @@ void ensure_tesseract_instances(Language language, size_t instances){
     iter->second.ensure_instances(instances);
 }
 
+void preload_tesseract_instances(){
+    const PerformanceOptions& settings = *GlobalSettings::instance().PERFORMANCE;
+    std::string codes = settings.TESSERACT_PRELOAD_LANGUAGES;
+    size_t instances = settings.TESSERACT_PRELOAD_INSTANCES;
+
+    size_t start = 0;
+    while (start < codes.size()){
+        size_t end = codes.find(',', start);
+        if (end == std::string::npos){
+            end = codes.size();
+        }
+        std::string code = codes.substr(start, end - start);
+        start = end + 1;
+
+        //  Trim whitespace.
+        code.erase(0, code.find_first_not_of(" \t"));
+        code.erase(code.find_last_not_of(" \t") + 1);
+        if (code.empty()){
+            continue;
+        }
+
+        try{
+            Language language = language_code_to_enum(code);
+            if (!tesseract_language_available(language)){
+                global_logger_tagged().log("Tesseract language is not installed: " + code, COLOR_RED);
+                continue;
+            }
+            ensure_tesseract_instances(language, instances);
+        }catch (Exception& e){
+            global_logger_tagged().log("Unable to preload Tesseract: " + e.to_str(), COLOR_RED);
+        }
+    }
+}
+
 void clear_tesseract_cache(){
     OcrGlobals& globals = OcrGlobals::instance();
     std::map<Language, TesseractPool>& ocr_pool = globals.ocr_pool;
@@ -49,9 +49,13 @@ bool tesseract_language_available(Language language);
 //  OCR the image in the specified language.
 //  Main OCR entry point. Performs OCR on the image using the specified language.
 //  Thread-safe: internally uses a pool of Tesseract API instances, able to accept
-//  multiple concurrent calls without delay or queueing.
-//  It creates a new Tesseract instances if no available idle instance. You can
-//  call `ensure_tesseract_instances()` to pre-warm to pool with a given number of instances.
+//  multiple concurrent calls.
+//  It creates a new Tesseract instances if no available idle instance, up to the
+//  "Max Tesseract Instances" setting. Beyond that, calls wait for an instance to
+//  free up. You can call `ensure_tesseract_instances()` to pre-warm to pool with
+//  a given number of instances.
+//  Recent results are cached by image content and psm. Reading the exact same
+//  image again returns the cached text without running Tesseract.
 //
 //  psm: Page segmentation mode - controls how Tesseract interprets the image layout.
 //       Defaults to SINGLE_BLOCK (Tesseract C++ API's default) for best performance.
@@ -69,6 +73,11 @@ std::string tesseract_ocr_read(
 //  want to preload the OCR instances.
 void ensure_tesseract_instances(Language language, size_t instances);
 
+//  Load the languages and # of instances requested by the Tesseract preload
+//  settings. Blocks until they are loaded. Errors are logged, not thrown.
+//  Call this at program start from a background thread.
+void preload_tesseract_instances();
+
 //  Clear all TesseractAPI instances for all languages. Used for cleanup or
 //  forcing re-initialization.
 //  This is not safe to call while in any OCR is still running!
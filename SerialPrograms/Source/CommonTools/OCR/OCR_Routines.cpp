@@ -60,6 +60,12 @@ void ensure_ocr_instances(Language language, size_t instances){
     }
 }
 
+void preload_ocr_instances(){
+    if (!use_paddle_ocr()){
+        OCR::preload_tesseract_instances();
+    }
+}
+
 void clear_ocr_cache(){
     if (use_paddle_ocr()){
         OCR::clear_paddle_ocr_cache();
@@ -36,6 +36,9 @@ std::string ocr_read(Language language, const ImageViewRGB32& image, PageSegMode
 
 void ensure_ocr_instances(Language language, size_t instances = 1);
 
+//  Load the OCR instances requested in the performance settings. Blocking.
+void preload_ocr_instances();
+
 void clear_ocr_cache();
 
 // psm: Tesseract Page Segmentation mode. See
@@ -7,6 +7,7 @@
 #include <QtGlobal>
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonBinary.h"
 #include "CommonFramework/Globals.h"
 #include "OCR_StringNormalization.h"
 #include "OCR_TextMatcher.h"
@@ -19,7 +20,7 @@ namespace OCR{
 
 SmallDictionaryMatcher::SmallDictionaryMatcher(const std::string& json_path, bool first_only)
     : SmallDictionaryMatcher(
-        load_json_file(RESOURCE_PATH() + json_path).to_object_throw(),
+        load_json_file_cached(RESOURCE_PATH() + json_path, RESOURCE_CACHE_PATH()).to_object_throw(),
         first_only
     )
 {}
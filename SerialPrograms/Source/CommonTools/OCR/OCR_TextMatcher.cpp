@@ -5,7 +5,9 @@
  */
 
 #include <cmath>
+#include <limits>
 #include <vector>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Qt/StringToolsQt.h"
@@ -255,12 +257,10 @@ double random_match_probability(size_t total, size_t matched, double random_matc
 
 
 StringMatchResult match_substring(
-    const std::map<std::u32string, std::set<std::string>>& database, double random_match_chance,
+    const std::map<std::u32string, MatchCandidate>& database, double random_match_chance,
     const std::string& text, double log10p_spread
 ){
     StringMatchResult results;
-//    result.original_text = text;
-//    result.normalized_text = normalize(text);
 
     std::u32string normalized = normalize_utf32(text);
 
@@ -270,7 +270,7 @@ StringMatchResult match_substring(
         results.exact_match = true;
         double probability = random_match_probability(normalized.size(), normalized.size(), random_match_chance);
         double log10p = std::log10(probability);
-        for (const auto& target : iter->second){
+        for (const auto& target : iter->second.tokens){
             results.add(
                 log10p,
                 StringMatchData{text, normalized, normalized, target}
@@ -279,11 +279,55 @@ StringMatchResult match_substring(
         return results;
     }
 
-
+    struct Entry{
+        const std::pair<const std::u32string, MatchCandidate>* item;
+        double log10p;      //  Lower bound until "computed" is set.
+        bool can_be_exact;
+        bool computed;
+    };
+
+    //  Since the probability decreases with the # of matched characters, the
+    //  character overlap gives a lower bound on log10(p).
+    CharacterHistogram histogram(normalized);
+    std::vector<Entry> entries;
+    entries.reserve(database.size());
     for (const auto& item : database){
+        size_t token_length = item.first.size();
+        size_t max_matched = item.second.pattern.max_matched(histogram);
+        if (max_matched == 0){
+            continue;
+        }
+        double probability = random_match_probability(token_length, max_matched, random_match_chance);
+        entries.emplace_back(Entry{
+            &item,
+            std::log10(probability),
+            max_matched == token_length,
+            false
+        });
+    }
+
+    std::vector<Entry*> order;
+    order.reserve(entries.size());
+    for (Entry& entry : entries){
+        order.emplace_back(&entry);
+    }
+    std::stable_sort(
+        order.begin(), order.end(),
+        [](const Entry* x, const Entry* y){ return x->log10p < y->log10p; }
+    );
+
+    double best = std::numeric_limits<double>::infinity();
+    for (Entry* entry : order){
+        //  Entries that cannot be exact are skipped once they cannot make the
+        //  spread. The rest are still needed to set "exact_match".
+        if (!entry->can_be_exact && entry->log10p > best + log10p_spread){
+            continue;
+        }
+
+        const auto& item = *entry->item;
         double token_length = item.first.size();
 
-        size_t distance = levenshtein_distance_substring(item.first, normalized);
+        size_t distance = item.second.pattern.distance_substring(normalized);
 
         size_t matched = token_length - distance;
         if (matched == 0){
@@ -297,8 +341,18 @@ StringMatchResult match_substring(
             results.exact_match = true;
         }
 
-        for (const auto& slug : item.second){
-            results.add(log10p, StringMatchData{text, normalized, item.first, slug});
+        entry->log10p = log10p;
+        entry->computed = true;
+        best = std::min(best, log10p);
+    }
+
+    for (const Entry& entry : entries){
+        if (!entry.computed){
+            continue;
+        }
+        const auto& item = *entry.item;
+        for (const auto& slug : item.second.tokens){
+            results.add(entry.log10p, StringMatchData{text, normalized, item.first, slug});
             results.clear_beyond_spread(log10p_spread);
         }
     }
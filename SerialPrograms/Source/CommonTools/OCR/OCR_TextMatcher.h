@@ -12,6 +12,7 @@
 #include <map>
 #include <QString>
 #include "OCR_StringMatchResult.h"
+#include "OCR_LevenshteinPattern.h"
 
 namespace PokemonAutomation{
 namespace OCR{
@@ -80,12 +81,19 @@ size_t levenshtein_distance_substring(const StringType& substring, const StringT
 double random_match_probability(size_t total, size_t matched, double random_match_chance);
 
 
+// A dictionary entry with its pattern preprocessed for matching.
+struct MatchCandidate{
+    LevenshteinPattern pattern;
+    std::set<std::string> tokens;
+};
+
 // Core proximity matching algorithm for OCR results against a dictionary.
 // This function matches OCR'd text against a database of known strings, handling OCR errors
 // using Levenshtein edit distance and statistical probability scoring.
 //
 // Parameters:
-//   database: Map of normalized UTF-32 strings to their token identifiers (slugs)
+//   database: Map of normalized UTF-32 strings to their preprocessed patterns and token
+//             identifiers (slugs)
 //   random_match_chance: Probability that a character matches by pure chance (language-dependent)
 //   text: Raw OCR text to match
 //   log10p_spread: Maximum log10(probability) difference to keep multiple candidates
@@ -106,8 +114,16 @@ double random_match_probability(size_t total, size_t matched, double random_matc
 // The Levenshtein distance treats all character substitutions equally (cost = 1) regardless
 // of different character complexity (e.g. 霹 is very close to 霸 but different from 火, but
 // get the same cost).
+//
+// PRUNING:
+// The edit distance is computed with the bit-parallel pattern. Before that,
+// every entry gets a lower bound on its log10(p) from the characters it has in
+// common with the text. Entries are visited best bound first and any entry
+// whose bound is already beyond the spread of the best match so far is skipped.
+// The survivors are then added in dictionary order so that the result is the
+// same as scoring every entry.
 StringMatchResult match_substring(
-    const std::map<std::u32string, std::set<std::string>>& database, double random_match_chance,
+    const std::map<std::u32string, MatchCandidate>& database, double random_match_chance,
     const std::string& text, double log10p_spread
 );
 
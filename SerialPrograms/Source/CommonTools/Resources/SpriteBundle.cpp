@@ -0,0 +1,316 @@
+/*  Sprite Bundle
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <vector>
+#include <QFile>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonTools/ImageMatch/ImageCropper.h"
+#include "SpriteBundle.h"
+
+namespace PokemonAutomation{
+
+
+
+//
+//  File Layout:
+//
+//      BundleHeader
+//      BundleEntry[sprite_count]
+//      Slug names. (concatenated, not null-terminated)
+//      Atlas pixels. (ARGB32, tightly packed rows, 64-byte aligned)
+//
+//  Everything is in native byte order. A bundle is a local cache of the
+//  sources. It is not meant to be moved between machines.
+//
+
+namespace{
+
+const char BUNDLE_MAGIC[8] = {'P', 'A', 'S', 'P', 'R', 'I', 'T', 'E'};
+const uint32_t BUNDLE_VERSION = 1;
+const size_t PIXEL_ALIGNMENT = 64;
+
+struct BundleHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t sprite_count;
+    uint64_t image_size;
+    uint64_t image_hash;
+    uint64_t json_size;
+    uint64_t json_hash;
+    uint32_t atlas_width;
+    uint32_t atlas_height;
+    uint64_t total_bytes;
+    uint64_t entries_offset;
+    uint64_t names_offset;
+    uint64_t names_bytes;
+    uint64_t pixels_offset;
+};
+struct BundleBox{
+    uint32_t min_x;
+    uint32_t min_y;
+    uint32_t max_x;
+    uint32_t max_y;
+};
+struct BundleStats{
+    double average[3];
+    double stddev[3];
+    uint64_t count;
+    uint64_t opaque_pixels;
+};
+struct BundleEntry{
+    uint32_t name_offset;
+    uint32_t name_length;
+    BundleBox sprite;
+    BundleBox icon;
+    BundleStats sprite_stats;
+    BundleStats icon_stats;
+};
+static_assert(sizeof(BundleHeader) == 96, "Unexpected padding.");
+static_assert(sizeof(BundleEntry) == 168, "Unexpected padding.");
+
+
+BundleBox to_bundle(const ImagePixelBox& box){
+    return BundleBox{(uint32_t)box.min_x, (uint32_t)box.min_y, (uint32_t)box.max_x, (uint32_t)box.max_y};
+}
+ImagePixelBox from_bundle(const BundleBox& box){
+    return ImagePixelBox(box.min_x, box.min_y, box.max_x, box.max_y);
+}
+BundleStats to_bundle(const ImageMatch::TemplateStats& stats){
+    BundleStats ret;
+    ret.average[0] = stats.stats.average.r;
+    ret.average[1] = stats.stats.average.g;
+    ret.average[2] = stats.stats.average.b;
+    ret.stddev[0] = stats.stats.stddev.r;
+    ret.stddev[1] = stats.stats.stddev.g;
+    ret.stddev[2] = stats.stats.stddev.b;
+    ret.count = stats.stats.count;
+    ret.opaque_pixels = stats.opaque_pixels;
+    return ret;
+}
+ImageMatch::TemplateStats from_bundle(const BundleStats& stats){
+    ImageMatch::TemplateStats ret;
+    ret.stats = ImageStats(
+        FloatPixel(stats.average[0], stats.average[1], stats.average[2]),
+        FloatPixel(stats.stddev[0], stats.stddev[1], stats.stddev[2]),
+        stats.count
+    );
+    ret.opaque_pixels = stats.opaque_pixels;
+    return ret;
+}
+
+bool box_within(const BundleBox& box, size_t width, size_t height){
+    return box.min_x <= box.max_x && box.max_x <= width &&
+           box.min_y <= box.max_y && box.max_y <= height;
+}
+
+}
+
+
+
+SpriteBundle::~SpriteBundle() = default;
+
+
+std::unique_ptr<SpriteBundle> SpriteBundle::open(const std::string& path, const Sources& sources){
+    std::unique_ptr<SpriteBundle> ret(new SpriteBundle());
+    ret->m_file.reset(new QFile(QString::fromStdString(path)));
+    QFile& file = *ret->m_file;
+    if (!file.open(QFile::ReadOnly)){
+        return nullptr;
+    }
+    qint64 bytes = file.size();
+    if (bytes <= 0){
+        return nullptr;
+    }
+
+    //  The mapping stays valid until the QFile is destroyed.
+    const uchar* data = file.map(0, bytes);
+    if (data == nullptr){
+        return nullptr;
+    }
+    if (!ret->load(data, (size_t)bytes, sources)){
+        return nullptr;
+    }
+    return ret;
+}
+bool SpriteBundle::load(const void* data, size_t bytes, const Sources& sources){
+    BundleHeader header;
+    if (bytes < sizeof(header)){
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (memcmp(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0 ||
+        header.version != BUNDLE_VERSION ||
+        header.total_bytes != bytes
+    ){
+        return false;
+    }
+    if (SourceFingerprint{header.image_size, header.image_hash} != sources.image ||
+        SourceFingerprint{header.json_size, header.json_hash} != sources.json
+    ){
+        return false;
+    }
+
+    //  Everything below only guards against a corrupted file.
+    const uint64_t width = header.atlas_width;
+    const uint64_t height = header.atlas_height;
+    if (header.entries_offset % alignof(BundleEntry) != 0 ||
+        header.entries_offset > bytes ||
+        (bytes - header.entries_offset) / sizeof(BundleEntry) < header.sprite_count ||
+        header.names_offset > bytes ||
+        bytes - header.names_offset < header.names_bytes ||
+        header.pixels_offset % PIXEL_ALIGNMENT != 0 ||
+        header.pixels_offset > bytes ||
+        (bytes - header.pixels_offset) / 4 / (width == 0 ? 1 : width) < height
+    ){
+        return false;
+    }
+
+    const char* ptr = (const char*)data;
+    for (size_t c = 0; c < header.sprite_count; c++){
+        BundleEntry entry;
+        memcpy(&entry, ptr + header.entries_offset + c * sizeof(BundleEntry), sizeof(entry));
+        if ((uint64_t)entry.name_offset + entry.name_length > header.names_bytes ||
+            !box_within(entry.sprite, width, height) ||
+            !box_within(entry.icon, entry.sprite.max_x - entry.sprite.min_x, entry.sprite.max_y - entry.sprite.min_y)
+        ){
+            return false;
+        }
+    }
+
+    m_data = ptr;
+    m_bytes = bytes;
+
+    //  The atlas is never written through this view.
+    m_atlas = ImageViewRGB32(
+        (uint32_t*)const_cast<char*>(ptr + header.pixels_offset),
+        width * sizeof(uint32_t),
+        width, height
+    );
+    return true;
+}
+
+
+std::unique_ptr<SpriteBundle> SpriteBundle::build(
+    const ImageViewRGB32& atlas,
+    const JsonValue& json, const std::string& json_path,
+    const Sources& sources
+){
+    const JsonObject& root = json.to_object_throw(json_path);
+
+    int64_t width = root.get_integer_throw("spriteWidth", json_path);
+    int64_t height = root.get_integer_throw("spriteHeight", json_path);
+    if (width <= 0){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid width.", json_path);
+    }
+    if (height <= 0){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid height.", json_path);
+    }
+    if (atlas.width() > UINT32_MAX || atlas.height() > UINT32_MAX){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Sprite sheet is too large.", json_path);
+    }
+
+    std::vector<BundleEntry> entries;
+    std::string names;
+
+    const JsonObject& locations = root.get_object_throw("spriteLocations", json_path);
+    for (const auto& item : locations){
+        const std::string& slug = item.first;
+        const JsonObject& obj = item.second.to_object_throw(json_path);
+        int64_t y = obj.get_integer_throw("top", json_path);
+        int64_t x = obj.get_integer_throw("left", json_path);
+        if (x < 0 || y < 0 || (uint64_t)x >= atlas.width() || (uint64_t)y >= atlas.height()){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Sprite is outside the sprite sheet: " + slug, json_path);
+        }
+
+        //  Sprites that hang over the edge are clipped. Same as extract_box_reference().
+        ImageViewRGB32 sprite = extract_box_reference(atlas, ImagePixelBox(x, y, x + width, y + height));
+        ImagePixelBox sprite_box(x, y, x + sprite.width(), y + sprite.height());
+        ImagePixelBox icon_box = ImageMatch::trim_image_alpha_box(sprite);
+        ImageViewRGB32 icon = extract_box_reference(sprite, icon_box);
+
+        BundleEntry entry;
+        entry.name_offset = (uint32_t)names.size();
+        entry.name_length = (uint32_t)slug.size();
+        entry.sprite = to_bundle(sprite_box);
+        entry.icon = to_bundle(icon_box);
+        entry.sprite_stats = to_bundle(ImageMatch::template_stats(sprite));
+        entry.icon_stats = to_bundle(ImageMatch::template_stats(icon));
+        entries.emplace_back(entry);
+        names += slug;
+    }
+
+    BundleHeader header;
+    memcpy(header.magic, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC));
+    header.version = BUNDLE_VERSION;
+    header.sprite_count = (uint32_t)entries.size();
+    header.image_size = sources.image.size;
+    header.image_hash = sources.image.hash;
+    header.json_size = sources.json.size;
+    header.json_hash = sources.json.hash;
+    header.atlas_width = (uint32_t)atlas.width();
+    header.atlas_height = (uint32_t)atlas.height();
+    header.entries_offset = sizeof(BundleHeader);
+    header.names_offset = header.entries_offset + entries.size() * sizeof(BundleEntry);
+    header.names_bytes = names.size();
+    header.pixels_offset = (header.names_offset + names.size() + PIXEL_ALIGNMENT - 1) / PIXEL_ALIGNMENT * PIXEL_ALIGNMENT;
+
+    const size_t row_bytes = atlas.width() * sizeof(uint32_t);
+    header.total_bytes = header.pixels_offset + row_bytes * atlas.height();
+
+    std::unique_ptr<SpriteBundle> ret(new SpriteBundle());
+    std::string& buffer = ret->m_buffer;
+    buffer.resize(header.total_bytes);
+    memcpy(&buffer[0], &header, sizeof(header));
+    if (!entries.empty()){
+        memcpy(&buffer[header.entries_offset], entries.data(), entries.size() * sizeof(BundleEntry));
+    }
+    if (!names.empty()){
+        memcpy(&buffer[header.names_offset], names.data(), names.size());
+    }
+    for (size_t r = 0; r < atlas.height(); r++){
+        memcpy(
+            &buffer[header.pixels_offset + r * row_bytes],
+            (const char*)atlas.data() + r * atlas.bytes_per_row(),
+            row_bytes
+        );
+    }
+
+    if (!ret->load(buffer.data(), buffer.size(), sources)){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Built an invalid sprite bundle: " + json_path);
+    }
+    return ret;
+}
+bool SpriteBundle::save(const std::string& path) const{
+    return write_source_cache(path, m_data, m_bytes);
+}
+
+
+size_t SpriteBundle::size() const{
+    BundleHeader header;
+    memcpy(&header, m_data, sizeof(header));
+    return header.sprite_count;
+}
+SpriteBundle::Sprite SpriteBundle::operator[](size_t index) const{
+    BundleHeader header;
+    memcpy(&header, m_data, sizeof(header));
+    BundleEntry entry;
+    memcpy(&entry, m_data + header.entries_offset + index * sizeof(BundleEntry), sizeof(entry));
+
+    Sprite ret;
+    ret.slug = std::string_view(m_data + header.names_offset + entry.name_offset, entry.name_length);
+    ret.sprite = from_bundle(entry.sprite);
+    ret.icon = from_bundle(entry.icon);
+    ret.sprite_stats = from_bundle(entry.sprite_stats);
+    ret.icon_stats = from_bundle(entry.icon_stats);
+    return ret;
+}
+
+
+
+}
@@ -0,0 +1,95 @@
+/*  Sprite Bundle
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Precompiled form of a SpriteDatabase. A single file holds the decoded
+ *      ARGB32 atlas, the slug table and the matcher stats of every sprite.
+ *      Loading a database from it is just a memory map. No PNG decoding, no
+ *      JSON parsing and no per-template stats.
+ *
+ *      A bundle is tied to the exact image and json it was built from and is
+ *      ignored (and rebuilt) as soon as either of them changes. Like other
+ *      derived files, it lives in the resource cache. (See SourceFileCache.h)
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_Resources_SpriteBundle_H
+#define PokemonAutomation_CommonTools_Resources_SpriteBundle_H
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include "Common/Cpp/SourceFileCache.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonTools/ImageMatch/ExactImageMatcher.h"
+
+class QFile;
+
+namespace PokemonAutomation{
+
+class JsonValue;
+
+
+class SpriteBundle{
+public:
+    //  Identifies the files a bundle was built from.
+    struct Sources{
+        SourceFingerprint image;
+        SourceFingerprint json;
+    };
+
+    struct Sprite{
+        std::string_view slug;
+        ImagePixelBox sprite;   //  Location on the atlas.
+        ImagePixelBox icon;     //  Location of the alpha-trimmed icon within "sprite".
+        ImageMatch::TemplateStats sprite_stats;
+        ImageMatch::TemplateStats icon_stats;
+    };
+
+public:
+    ~SpriteBundle();
+    SpriteBundle(const SpriteBundle&) = delete;
+    void operator=(const SpriteBundle&) = delete;
+
+    //  Map an existing bundle file. Returns null if it is missing, malformed,
+    //  from a different version, or was built from different sources.
+    static std::unique_ptr<SpriteBundle> open(const std::string& path, const Sources& sources);
+
+    //  Build a bundle in memory from a decoded atlas and its sprite location
+    //  json. (See SpriteDatabase for the json format.)
+    static std::unique_ptr<SpriteBundle> build(
+        const ImageViewRGB32& atlas,
+        const JsonValue& json, const std::string& json_path,
+        const Sources& sources
+    );
+
+    //  Atomically write this bundle to "path", creating its folder if
+    //  needed. Returns false on failure.
+    bool save(const std::string& path) const;
+
+public:
+    ImageViewRGB32 atlas() const{ return m_atlas; }
+
+    size_t size() const;
+    Sprite operator[](size_t index) const;
+
+private:
+    SpriteBundle() = default;
+    bool load(const void* data, size_t bytes, const Sources& sources);
+
+private:
+    //  Exactly one of these backs the data.
+    std::unique_ptr<QFile> m_file;
+    std::string m_buffer;
+
+    const char* m_data = nullptr;
+    size_t m_bytes = 0;
+    ImageViewRGB32 m_atlas;
+};
+
+
+
+}
+#endif
@@ -4,44 +4,75 @@
  *
  */
 
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
-#include "Common/Cpp/Json/JsonObject.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
-#include "CommonTools/ImageMatch/ImageCropper.h"
+#include "SpriteBundle.h"
 #include "SpriteDatabase.h"
 
 namespace PokemonAutomation{
 
 
 
-SpriteDatabase::SpriteDatabase(const char* sprite_path, const char* json_path)
-    : m_backing_image(RESOURCE_PATH() + sprite_path)
-{
-    std::string path = RESOURCE_PATH() + json_path;
-    JsonValue json = load_json_file(path);
-    JsonObject& root = json.to_object_throw(path);
+static SpriteBundle::Sources hash_sources(const std::string& sprite_path, const std::string& json_path){
+    SpriteBundle::Sources sources;
+    sources.image = fingerprint_source_file(sprite_path);
+    sources.json = fingerprint_source_file(json_path);
+    return sources;
+}
+static std::string bundle_path(const std::string& sprite_path){
+    return source_cache_path(RESOURCE_CACHE_PATH(), sprite_path, ".bundle");
+}
+static std::unique_ptr<SpriteBundle> build_sprite_bundle(
+    const std::string& sprite_path, const std::string& json_path,
+    const SpriteBundle::Sources& sources
+){
+    ImageRGB32 atlas(sprite_path);
+    JsonValue json = load_json_file(json_path);
+    return SpriteBundle::build(atlas, json, json_path, sources);
+}
 
-    int64_t width = root.get_integer_throw("spriteWidth", path);
-    int64_t height = root.get_integer_throw("spriteHeight", path);
-    if (width <= 0){
-        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid width.", path);
-    }
-    if (height <= 0){
-        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Invalid height.", path);
+
+void SpriteDatabase::build_bundle(const char* sprite_path, const char* json_path){
+    std::string image_file = RESOURCE_PATH() + sprite_path;
+    std::string json_file = RESOURCE_PATH() + json_path;
+    std::string bundle_file = bundle_path(image_file);
+    SpriteBundle::Sources sources = hash_sources(image_file, json_file);
+    std::unique_ptr<SpriteBundle> bundle = build_sprite_bundle(image_file, json_file, sources);
+    if (!bundle->save(bundle_file)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write sprite bundle.", bundle_file);
     }
+}
+
 
-    JsonObject& locations = root.get_object_throw("spriteLocations", path);
-    for (auto& item : locations){
-        const std::string& slug = item.first;
-        JsonObject& obj = item.second.to_object_throw(path);
-        int y = (int)obj.get_integer_throw("top", path);
-        int x = (int)obj.get_integer_throw("left", path);
+SpriteDatabase::~SpriteDatabase() = default;
+SpriteDatabase::SpriteDatabase(const char* sprite_path, const char* json_path){
+    std::string image_file = RESOURCE_PATH() + sprite_path;
+    std::string json_file = RESOURCE_PATH() + json_path;
+    std::string bundle_file = bundle_path(image_file);
+    SpriteBundle::Sources sources = hash_sources(image_file, json_file);
+
+    m_bundle = SpriteBundle::open(bundle_file, sources);
+    if (!m_bundle){
+        //  Slow path: Decode everything and save it for next time. If the
+        //  cache folder isn't writable, we just do this on every launch.
+        m_bundle = build_sprite_bundle(image_file, json_file, sources);
+        m_bundle->save(bundle_file);
+    }
 
-        ImageViewRGB32 sprite = extract_box_reference(m_backing_image, ImagePixelBox(x, y, x + width, y + height));
+    ImageViewRGB32 atlas = m_bundle->atlas();
+    size_t count = m_bundle->size();
+    for (size_t c = 0; c < count; c++){
+        SpriteBundle::Sprite item = (*m_bundle)[c];
+        ImageViewRGB32 sprite = extract_box_reference(atlas, item.sprite);
         m_database.emplace(
-            slug,
-            Sprite{sprite, ImageMatch::trim_image_alpha(sprite)}
+            std::string(item.slug),
+            Sprite{
+                sprite, extract_box_reference(sprite, item.icon),
+                item.sprite_stats, item.icon_stats
+            }
         );
     }
 }
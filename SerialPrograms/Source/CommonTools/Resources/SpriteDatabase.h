@@ -8,10 +8,14 @@
 #define PokemonAutomation_CommonTools_Resources_SpriteCompositeImage_H
 
 #include <map>
-#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include <memory>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonTools/ImageMatch/ExactImageMatcher.h"
 
 namespace PokemonAutomation{
 
+class SpriteBundle;
+
 
 class SpriteDatabase{
 public:
@@ -32,12 +36,26 @@ public:
     //          (next pokemon) ...
     //      }
     //  }
+    //
+    //  The decoded sprites and their matcher stats are kept in a precompiled
+    //  bundle in the resource cache. (RESOURCE_CACHE_PATH()) If it is missing
+    //  or out-of-date, it is rebuilt here from the image and json.
     SpriteDatabase(const char* sprite_path, const char* json_path);
+    ~SpriteDatabase();
+
+    //  Offline build step: (Re)build the bundle for these sources.
+    //  Throws if it can't be written.
+    static void build_bundle(const char* sprite_path, const char* json_path);
 
 public:
     struct Sprite{
         ImageViewRGB32 sprite;  //  The original sprite.
         ImageViewRGB32 icon;    //  Sprite with 0-alpha boundaries cropped for better viewing.
+
+        //  Precomputed ImageMatch::template_stats() of the above. Pass these to
+        //  the zero-copy add() functions of the image matchers.
+        ImageMatch::TemplateStats sprite_stats;
+        ImageMatch::TemplateStats icon_stats;
     };
     const Sprite& get_throw(const std::string& slug) const;
     const Sprite* get_nothrow(const std::string& slug) const;
@@ -55,7 +73,7 @@ public:
 
 private:
     std::map<std::string, Sprite> m_database;
-    ImageRGB32 m_backing_image;
+    std::unique_ptr<SpriteBundle> m_bundle;
 };
 
 
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_CommonTools_VisualDetector_H
 #define PokemonAutomation_CommonTools_VisualDetector_H
 
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonTools/InferenceCallbacks/VisualInferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -23,6 +24,13 @@ public:
 
     //  This is not const so that detectors can save/cache state.
     virtual bool detect(const ImageViewRGB32& screen) = 0;
+
+    //  Same as detect(), but with the whole snapshot so the detector can use
+    //  the derived images cached on it. (see SnapshotCachedFilters.h)
+    //  Override this only if the result is always the same as detect().
+    virtual bool detect_snapshot(const VideoSnapshot& snapshot){
+        return detect(*snapshot.frame);
+    }
     //  Called this to lock in the detected state in the detector, if
     //  needed. Leave this function empty if you don't wish the derived
     //  class to "remember" past detection.
@@ -98,6 +106,21 @@ public:
     // `process_frame()` defined below.
     using VisualInferenceCallback::process_frame;
 
+    //  Keep the snapshot around so that detect_snapshot() can be used. This
+    //  still goes through the other process_frame() so that derived watchers
+    //  that override it keep working.
+    virtual bool process_frame(const VideoSnapshot& frame) override{
+        m_snapshot = &frame;
+        try{
+            bool ret = process_frame(*frame.frame, frame.timestamp);
+            m_snapshot = nullptr;
+            return ret;
+        }catch (...){
+            m_snapshot = nullptr;
+            throw;
+        }
+    }
+
     //  If m_finder_type is PRESENT, return true only when it is consecutively detected for the duration.
     //  If m_finder_type is GONE, return true only when it is consecutively not detected for the duration.
     //  If m_finder_type is CONSISTENT, return true when it is consecutively detected, or consecutively not detected
@@ -108,7 +131,7 @@ public:
         switch (m_finder_type){
         case FinderType::PRESENT:
         case FinderType::GONE:
-            if (this->detect(frame) == (m_finder_type == FinderType::GONE)){
+            if (detect_frame(frame) == (m_finder_type == FinderType::GONE)){
                 m_start_of_detection = WallClock::min();
                 return false;
             }
@@ -123,7 +146,7 @@ public:
                 return false;
             }
         case FinderType::CONSISTENT:{
-            const bool result = this->detect(frame);
+            const bool result = detect_frame(frame);
             const bool result_changed = (result && m_last_detected < 0) || (!result && m_last_detected > 0);
 
             m_last_detected = (result ? 1 : -1);
@@ -164,12 +187,26 @@ public:
         m_consistent_result = false;
     }
 
+private:
+    bool detect_frame(const ImageViewRGB32& frame){
+        //  Derived watchers may pass in something other than the snapshot.
+        if (m_snapshot != nullptr &&
+            m_snapshot->frame->data() == frame.data() &&
+            m_snapshot->frame->width() == frame.width() &&
+            m_snapshot->frame->height() == frame.height()
+        ){
+            return this->detect_snapshot(*m_snapshot);
+        }
+        return this->detect(frame);
+    }
+
 private:
     std::chrono::milliseconds m_duration;  // duration of frames to decide detection outcome
     FinderType m_finder_type;
     WallClock m_start_of_detection = WallClock::min();
     int8_t m_last_detected = 0; // 0: no prior detection, 1: last detected positive, -1: last detected negative
     bool m_consistent_result = false;
+    const VideoSnapshot* m_snapshot = nullptr;
 };
 
 
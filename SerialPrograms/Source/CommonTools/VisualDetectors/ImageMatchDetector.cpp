@@ -10,6 +10,7 @@
 #include "CommonFramework/ImageTools/ImageDiff.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonFramework/Tools/ErrorDumper.h"
+#include "CommonTools/Images/SnapshotCachedFilters.h"
 #include "ImageMatchDetector.h"
 
 //#include <iostream>
@@ -49,13 +50,7 @@ double ImageMatchDetector::rmsd(const ImageViewRGB32& frame) const{
 #endif
 
     if (m_scale_brightness){
-        FloatPixel image_brightness = ImageMatch::pixel_average(scaled, m_reference_image_cropped);
-        FloatPixel scale = m_average_brightness / image_brightness;
-        if (std::isnan(scale.r)) scale.r = 1.0;
-        if (std::isnan(scale.g)) scale.g = 1.0;
-        if (std::isnan(scale.b)) scale.b = 1.0;
-        scale.bound(0.8, 1.2);
-        ImageMatch::scale_brightness(scaled, scale);
+        return rmsd_brightness_scaled(std::move(scaled));
     }
 
 //    cout << "asdf" << endl;
@@ -63,6 +58,31 @@ double ImageMatchDetector::rmsd(const ImageViewRGB32& frame) const{
 //    cout << "rmsd = " << ret << endl;
     return ret;
 }
+double ImageMatchDetector::rmsd(const VideoSnapshot& snapshot) const{
+    if (!snapshot){
+        return 1000;
+    }
+    std::shared_ptr<const ImageRGB32> scaled = cached_scale_to(
+        snapshot, m_box,
+        m_reference_image_cropped.width(), m_reference_image_cropped.height()
+    );
+
+    //  The cached image is shared. Brightness scaling needs its own copy.
+    if (m_scale_brightness){
+        return rmsd_brightness_scaled(scaled->copy());
+    }
+    return ImageMatch::pixel_RMSD(m_reference_image_cropped, *scaled);
+}
+double ImageMatchDetector::rmsd_brightness_scaled(ImageRGB32 scaled) const{
+    FloatPixel image_brightness = ImageMatch::pixel_average(scaled, m_reference_image_cropped);
+    FloatPixel scale = m_average_brightness / image_brightness;
+    if (std::isnan(scale.r)) scale.r = 1.0;
+    if (std::isnan(scale.g)) scale.g = 1.0;
+    if (std::isnan(scale.b)) scale.b = 1.0;
+    scale.bound(0.8, 1.2);
+    ImageMatch::scale_brightness(scaled, scale);
+    return ImageMatch::pixel_RMSD(m_reference_image_cropped, scaled);
+}
 
 void ImageMatchDetector::make_overlays(VideoOverlaySet& items) const{
     items.add(m_color, m_box);
@@ -70,6 +90,9 @@ void ImageMatchDetector::make_overlays(VideoOverlaySet& items) const{
 bool ImageMatchDetector::detect(const ImageViewRGB32& screen){
     return rmsd(screen) <= m_max_rmsd;
 }
+bool ImageMatchDetector::detect_snapshot(const VideoSnapshot& snapshot){
+    return rmsd(snapshot) <= m_max_rmsd;
+}
 
 
 
@@ -89,8 +112,14 @@ ImageMatchWatcher::ImageMatchWatcher(
 void ImageMatchWatcher::make_overlays(VideoOverlaySet& items) const{
     ImageMatchDetector::make_overlays(items);
 }
+bool ImageMatchWatcher::process_frame(const VideoSnapshot& frame){
+    return process_result(detect_snapshot(frame));
+}
 bool ImageMatchWatcher::process_frame(const ImageViewRGB32& frame, WallClock){
-    if (!detect(frame)){
+    return process_result(detect(frame));
+}
+bool ImageMatchWatcher::process_result(bool detected){
+    if (!detected){
         m_last_match = false;
         return false;
     }
@@ -26,9 +26,14 @@ public:
     );
 
     double rmsd(const ImageViewRGB32& frame) const;
+    double rmsd(const VideoSnapshot& snapshot) const;
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
+    virtual bool detect_snapshot(const VideoSnapshot& snapshot) override;
+
+private:
+    double rmsd_brightness_scaled(ImageRGB32 scaled) const;
 
 private:
     std::shared_ptr<const ImageRGB32> m_reference_image;
@@ -53,8 +58,12 @@ public:
     );
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
+    virtual bool process_frame(const VideoSnapshot& frame) override;
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
 
+private:
+    bool process_result(bool detected);
+
 private:
     std::chrono::milliseconds m_hold_duration;
 
@@ -4,7 +4,8 @@
  *
  */
 
-//#include "Common/Cpp/Exceptions.h"
+#include <bit>
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Time.h"
 #include "SuperscalarScheduler.h"
 
@@ -35,56 +36,105 @@ void SuperscalarScheduler::clear() noexcept{
     m_device_issue_time = now;
     m_device_sent_time = now;
     m_max_free_time = now;
+    m_state_changes_begin = 0;
     m_state_changes.clear();
-    m_live_commands.clear();
+    for (size_t c = 0; c < m_live.size(); c++){
+        uint64_t live = m_live[c];
+        while (live){
+            size_t index = c * 64 + std::countr_zero(live);
+            live &= live - 1;
+            m_commands[index].command = nullptr;
+        }
+        m_live[c] = 0;
+    }
     m_pending_clear = false;
 }
 
-SuperscalarScheduler::State SuperscalarScheduler::current_live_commands(){
+void SuperscalarScheduler::add_state_change(WallClock timestamp){
+    //  New timestamps are almost always the latest. So search from the back.
+    size_t index = m_state_changes.size();
+    while (index > m_state_changes_begin && m_state_changes[index - 1] > timestamp){
+        index--;
+    }
+    if (index > m_state_changes_begin && m_state_changes[index - 1] == timestamp){
+        return;
+    }
+
+    //  Out of room. Reclaim the ones that have already been sent before
+    //  growing the buffer.
+    if (m_state_changes.size() == m_state_changes.capacity() && m_state_changes_begin > 0){
+        std::move(
+            m_state_changes.begin() + m_state_changes_begin,
+            m_state_changes.end(),
+            m_state_changes.begin()
+        );
+        index -= m_state_changes_begin;
+        for (size_t c = 0; c < m_state_changes_begin; c++){
+            m_state_changes.pop_back();
+        }
+        m_state_changes_begin = 0;
+    }
+
+    m_state_changes.emplace_back(timestamp);
+    std::move_backward(
+        m_state_changes.begin() + index,
+        m_state_changes.end() - 1,
+        m_state_changes.end()
+    );
+    m_state_changes[index] = timestamp;
+}
+
+void SuperscalarScheduler::current_live_commands(State& state) const{
     WallClock device_sent_time = m_device_sent_time;
-    State ret;
 //    cout << "device_sent_time = " << std::chrono::duration_cast<Milliseconds>(device_sent_time - m_local_start).count() << endl;
-    for (auto& item : m_live_commands){
-//        cout << "busy = " << std::chrono::duration_cast<Milliseconds>(item.second.busy_time - m_local_start).count()
-//             << ", done = " << std::chrono::duration_cast<Milliseconds>(item.second.done_time - m_local_start).count() << endl;
-        if (item.second.busy_time <= device_sent_time && device_sent_time < item.second.done_time){
-            ret.emplace_back(item.second.command);
+    for (size_t c = 0; c < m_live.size(); c++){
+        uint64_t live = m_live[c];
+        while (live){
+            const Command& command = m_commands[c * 64 + std::countr_zero(live)];
+            live &= live - 1;
+//            cout << "busy = " << std::chrono::duration_cast<Milliseconds>(command.busy_time - m_local_start).count()
+//                 << ", done = " << std::chrono::duration_cast<Milliseconds>(command.done_time - m_local_start).count() << endl;
+            if (command.busy_time <= device_sent_time && device_sent_time < command.done_time){
+                state.emplace_back(command.command);
+            }
         }
     }
-    return ret;
 }
 void SuperscalarScheduler::clear_finished_commands(){
     WallClock device_sent_time = m_device_sent_time;
-    for (auto iter = m_live_commands.begin(); iter != m_live_commands.end();){
-//        cout << "device_sent_time = " << device_sent_time << ", free_time = " << iter->second.free_time << endl;
-        if (device_sent_time >= iter->second.free_time){
-            iter = m_live_commands.erase(iter);
-        }else{
-            ++iter;
+    for (size_t c = 0; c < m_live.size(); c++){
+        uint64_t live = m_live[c];
+        while (live){
+            size_t index = c * 64 + std::countr_zero(live);
+            live &= live - 1;
+            Command& command = m_commands[index];
+//            cout << "device_sent_time = " << device_sent_time << ", free_time = " << command.free_time << endl;
+            if (device_sent_time >= command.free_time){
+                command.command = nullptr;
+                m_live[c] &= ~((uint64_t)1 << (index % 64));
+            }
         }
     }
 }
 bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
-//    cout << "----------------------------> " << m_state_changes.size() << endl;
+//    cout << "----------------------------> " << m_state_changes.size() - m_state_changes_begin << endl;
 //    cout << "m_device_sent_time = " << std::chrono::duration_cast<Milliseconds>(m_device_sent_time - m_local_start) << endl;
 
-    if (m_state_changes.empty()){
+    if (m_state_changes_begin == m_state_changes.size()){
 //        cout << "State is empty." << endl;
         m_device_sent_time = m_device_issue_time;
         return false;
     }
 
-    auto iter = m_state_changes.begin();
+    WallClock first_state_change = m_state_changes[m_state_changes_begin];
 
     WallClock next_state_change;
-    if (m_device_sent_time < *iter){
-        next_state_change = *iter;
+    if (m_device_sent_time < first_state_change){
+        next_state_change = first_state_change;
     }else{
-        auto next = iter;
-        ++next;
-        next_state_change = next == m_state_changes.end()
+        next_state_change = m_state_changes_begin + 1 == m_state_changes.size()
             ? m_device_issue_time
-            : *next;
+            : m_state_changes[m_state_changes_begin + 1];
     }
 
     //  Things get complicated if we overshoot the issue time.
@@ -104,18 +154,20 @@ bool SuperscalarScheduler::iterate_schedule(Schedule& schedule){
     }
 
     //  Compute the resource state at this timestamp.
-    std::vector<std::shared_ptr<const SchedulerResource>> state = current_live_commands();
+    ScheduleEntry& entry = schedule.emplace_back();
+    entry.duration = duration;
+    current_live_commands(entry.state);
     clear_finished_commands();
 
     m_device_sent_time = next_state_change;
-    if (next_state_change > *iter){
-        m_state_changes.erase(iter);
+    if (next_state_change > first_state_change){
+        m_state_changes_begin++;
+        if (m_state_changes_begin == m_state_changes.size()){
+            m_state_changes_begin = 0;
+            m_state_changes.clear();
+        }
     }
 
-    ScheduleEntry& entry = schedule.emplace_back();
-    entry.duration = duration;
-    entry.state = std::move(state);
-
 //    WriteSpinLock lg(m_lock);
 
     WallClock now = current_time();
@@ -170,8 +222,8 @@ void SuperscalarScheduler::issue_wait_for_all(Schedule& schedule){
         clear();
         return;
     }
-//    m_logger.log("issue_wait_for_all(): states = " + std::to_string(m_state_changes.size()), COLOR_DARKGREEN);
-//    cout << "issue_wait_for_all(): " << m_state_changes.size() << endl;
+//    m_logger.log("issue_wait_for_all(): states = " + std::to_string(m_state_changes.size() - m_state_changes_begin), COLOR_DARKGREEN);
+//    cout << "issue_wait_for_all(): " << m_state_changes.size() - m_state_changes_begin << endl;
 //    cout << "issue_time = " << std::chrono::duration_cast<Milliseconds>((m_device_issue_time - m_local_start)).count()
 //         << ", sent_time = " << std::chrono::duration_cast<Milliseconds>((m_device_sent_time - m_local_start)).count()
 //         << ", max_free_time = " << std::chrono::duration_cast<Milliseconds>((m_max_free_time - m_local_start)).count()
@@ -187,13 +239,13 @@ void SuperscalarScheduler::issue_nop(Schedule& schedule, WallDuration delay){
     if (m_pending_clear){
         clear();
     }
-//    cout << "issue_nop(): " << m_state_changes.size() << endl;
+//    cout << "issue_nop(): " << m_state_changes.size() - m_state_changes_begin << endl;
 //    cout << "issue_time = " << std::chrono::duration_cast<Milliseconds>((m_device_issue_time - m_local_start)).count()
 //         << ", sent_time = " << std::chrono::duration_cast<Milliseconds>((m_device_sent_time - m_local_start)).count()
 //         << ", max_free_time = " << std::chrono::duration_cast<Milliseconds>((m_max_free_time - m_local_start)).count()
 //         << endl;
     WallClock next_issue_time = m_device_issue_time + delay;
-    m_state_changes.insert(next_issue_time);
+    add_state_change(next_issue_time);
     m_device_issue_time = next_issue_time;
     m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
     m_local_last_activity = current_time();
@@ -211,9 +263,8 @@ void SuperscalarScheduler::issue_wait_for_resource(Schedule& schedule, size_t re
 //         << endl;
 
     //  Resource is not ready yet. Stall until it is.
-    auto iter = m_live_commands.find(resource_id);
-    if (iter != m_live_commands.end() && m_device_sent_time < iter->second.free_time){
-        m_device_issue_time = iter->second.free_time;
+    if (is_live(resource_id) && m_device_sent_time < m_commands[resource_id].free_time){
+        m_device_issue_time = m_commands[resource_id].free_time;
         m_local_last_activity = current_time();
     }
 
@@ -221,21 +272,28 @@ void SuperscalarScheduler::issue_wait_for_resource(Schedule& schedule, size_t re
 }
 void SuperscalarScheduler::issue_to_resource(
     Schedule& schedule,
-    std::shared_ptr<const SchedulerResource> resource,
+    SchedulerResourcePtr resource,
     WallDuration delay, WallDuration hold, WallDuration cooldown
 ){
     if (m_pending_clear){
         clear();
     }
 
+    size_t resource_id = resource->id;
+    if (resource_id >= MAX_RESOURCES){
+        throw InternalProgramError(
+            &m_logger, PA_CURRENT_FUNCTION,
+            "SuperscalarScheduler: Resource ID out of range: " + std::to_string(resource_id)
+        );
+    }
+
     //  Resource is busy. Stall until it is free.
-    auto ret = m_live_commands.try_emplace(resource->id);
-    if (!ret.second){
-//        cout << m_device_sent_time << " : " << ret.first->second.free_time << endl;
-        m_device_issue_time = std::max(m_device_issue_time, ret.first->second.free_time);
+    if (is_live(resource_id)){
+//        cout << m_device_sent_time << " : " << m_commands[resource_id].free_time << endl;
+        m_device_issue_time = std::max(m_device_issue_time, m_commands[resource_id].free_time);
         process_schedule(schedule);
     }
-    Command& command = ret.first->second;
+    Command& command = m_commands[resource_id];
 
     delay    = std::max(delay, WallDuration::zero());
     hold     = std::max(hold, WallDuration::zero());
@@ -254,10 +312,11 @@ void SuperscalarScheduler::issue_to_resource(
     WallClock release_time = m_device_issue_time + hold;
     WallClock free_time = release_time + cooldown;
 
-    m_state_changes.insert(m_device_issue_time);
-    m_state_changes.insert(release_time);
+    add_state_change(m_device_issue_time);
+    add_state_change(release_time);
 
     command.command = std::move(resource);
+    set_live(resource_id);
     command.busy_time = m_device_issue_time;
     command.done_time = release_time;
     command.free_time = free_time;
@@ -7,21 +7,26 @@
 #ifndef PokemonAutomation_Controllers_SuperscalarScheduler_H
 #define PokemonAutomation_Controllers_SuperscalarScheduler_H
 
+#include <stdint.h>
+#include <array>
+#include <atomic>
 #include <memory>
-#include <set>
-#include <map>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/Logging/AbstractLogger.h"
+#include "Common/Cpp/Containers/SmallVector.h"
 //#include "Common/Cpp/CancellableScope.h"
 
 namespace PokemonAutomation{
 
 class SuperscalarScheduler;
+class SchedulerResourcePtr;
 
 
 
 
+//  A command for one resource. Once issued, it is immutable and shared by the
+//  scheduler and every schedule entry it is active in.
 class SchedulerResource{
 public:
     const size_t id;
@@ -31,6 +36,71 @@ public:
     {}
 
     virtual ~SchedulerResource() = default;
+
+private:
+    friend class SchedulerResourcePtr;
+    mutable std::atomic<size_t> m_refcount{0};
+};
+
+
+//  Intrusively reference-counted pointer to a SchedulerResource.
+//  Unlike std::shared_ptr, taking ownership of a resource does not allocate.
+class SchedulerResourcePtr{
+public:
+    SchedulerResourcePtr() = default;
+    SchedulerResourcePtr(std::nullptr_t){}
+    explicit SchedulerResourcePtr(const SchedulerResource* ptr)
+        : m_ptr(ptr)
+    {
+        acquire();
+    }
+    template <typename Resource>
+    SchedulerResourcePtr(std::unique_ptr<Resource>&& resource)
+        : SchedulerResourcePtr(static_cast<const SchedulerResource*>(resource.release()))
+    {}
+
+    ~SchedulerResourcePtr(){
+        release();
+    }
+    SchedulerResourcePtr(const SchedulerResourcePtr& x)
+        : m_ptr(x.m_ptr)
+    {
+        acquire();
+    }
+    SchedulerResourcePtr(SchedulerResourcePtr&& x) noexcept
+        : m_ptr(x.m_ptr)
+    {
+        x.m_ptr = nullptr;
+    }
+    SchedulerResourcePtr& operator=(const SchedulerResourcePtr& x){
+        SchedulerResourcePtr tmp(x);
+        std::swap(m_ptr, tmp.m_ptr);
+        return *this;
+    }
+    SchedulerResourcePtr& operator=(SchedulerResourcePtr&& x) noexcept{
+        std::swap(m_ptr, x.m_ptr);
+        return *this;
+    }
+
+    explicit operator bool() const{ return m_ptr != nullptr; }
+    const SchedulerResource* get() const{ return m_ptr; }
+    const SchedulerResource& operator*() const{ return *m_ptr; }
+    const SchedulerResource* operator->() const{ return m_ptr; }
+
+private:
+    void acquire(){
+        if (m_ptr){
+            m_ptr->m_refcount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    void release(){
+        if (m_ptr && m_ptr->m_refcount.fetch_sub(1, std::memory_order_acq_rel) == 1){
+            delete m_ptr;
+        }
+    }
+
+private:
+    const SchedulerResource* m_ptr = nullptr;
 };
 
 
@@ -39,12 +109,17 @@ public:
 
 class SuperscalarScheduler{
 public:
-    using State = std::vector<std::shared_ptr<const SchedulerResource>>;
+    //  Resource IDs must be less than this.
+    static constexpr size_t MAX_RESOURCES = 256;
+
+    //  The inline sizes cover the common cases. Larger states and schedules
+    //  still work, but will allocate.
+    using State = SmallVector<SchedulerResourcePtr, 8>;
     struct ScheduleEntry{
         WallDuration duration;
         State state;
     };
-    using Schedule = std::vector<ScheduleEntry>;
+    using Schedule = SmallVector<ScheduleEntry, 4>;
 
 public:
     SuperscalarScheduler(Logger& logger, WallDuration flush_threshold);
@@ -64,9 +139,8 @@ public:
     //
 
     WallClock busy_until(size_t resource_id) const{
-        auto iter = m_live_commands.find(resource_id);
-        return iter != m_live_commands.end()
-            ? iter->second.free_time
+        return is_live(resource_id)
+            ? m_commands[resource_id].free_time
             : WallClock::min();
     }
 
@@ -85,18 +159,28 @@ public:
     //  Issue a resource with the specified timing parameters.
     void issue_to_resource(
         Schedule& schedule,
-        std::shared_ptr<const SchedulerResource> resource,
+        SchedulerResourcePtr resource,
         WallDuration delay, WallDuration hold, WallDuration cooldown
     );
 
 
 private:
     void clear() noexcept;
-    State current_live_commands();
+    void current_live_commands(State& state) const;
     void clear_finished_commands();
     bool iterate_schedule(Schedule& schedule);
     void process_schedule(Schedule& schedule);
 
+    bool is_live(size_t resource_id) const{
+        return resource_id < MAX_RESOURCES &&
+            (m_live[resource_id / 64] >> (resource_id % 64)) & 1;
+    }
+    void set_live(size_t resource_id){
+        m_live[resource_id / 64] |= (uint64_t)1 << (resource_id % 64);
+    }
+
+    void add_state_change(WallClock timestamp);
+
 
 private:
     Logger& m_logger;
@@ -121,20 +205,30 @@ private:
     //  The current timestamp of what has been sent to the device.
     WallClock m_device_sent_time;
 
-    //  Maximum of: m_live_commands[]->second.free_time
+    //  Maximum of: m_commands[]->free_time over all live commands.
     WallClock m_max_free_time;
 
-    //  A set of all the scheduled state changes that will happen. Between
-    //  timestamps in this set, the state is constant.
-    std::set<WallClock> m_state_changes;
+    //  All the scheduled state changes that will happen, sorted and unique.
+    //  Between timestamps in this list, the state is constant. The pending
+    //  ones are [m_state_changes_begin, size()). The ones before that have
+    //  already been sent.
+    //
+    //  Most pending state changes are the start or the release of a live
+    //  command, so this rarely leaves the inline buffer. But it can, so it
+    //  grows instead of failing.
+    SmallVector<WallClock, 2 * MAX_RESOURCES + 2> m_state_changes;
+    size_t m_state_changes_begin;
 
     struct Command{
-        std::shared_ptr<const SchedulerResource> command;
+        SchedulerResourcePtr command;
         WallClock busy_time;    //  Timestamp of when resource will be become busy.
         WallClock done_time;    //  Timestamp of when resource will be done being busy.
         WallClock free_time;    //  Timestamp of when resource can be used again.
     };
-    std::map<size_t, Command> m_live_commands;
+
+    //  Indexed by resource ID. Only the ones set in "m_live" are meaningful.
+    std::array<Command, MAX_RESOURCES> m_commands;
+    std::array<uint64_t, MAX_RESOURCES / 64> m_live{};
 };
 
 
@@ -4,10 +4,16 @@
  *
  */
 
+#include <algorithm>
+#include <deque>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
 #include "Common/Cpp/Concurrency/Mutex.h"
 #include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "Common/Cpp/Logging/TaggedLogger.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "Controllers/ControllerConnection.h"
 #include "Controllers/PABotBase2/SerialPABotBase2_Descriptor.h"
 #include "NintendoSwitch/Controllers/Procon/NintendoSwitch_ProController.h"
@@ -22,6 +28,67 @@ namespace NintendoSwitch{
 
 
 
+struct PybindCommandBatchState{
+    std::vector<PybindControllerState> states;
+
+    mutable Mutex lock;
+    mutable ConditionVariable cv;
+    bool submitted = false;
+    bool finished = false;
+    std::string error;
+
+    void set_submitted(){
+        {
+            std::lock_guard<Mutex> lg(lock);
+            submitted = true;
+        }
+        cv.notify_all();
+    }
+    void set_finished(std::string p_error){
+        {
+            std::lock_guard<Mutex> lg(lock);
+            submitted = true;
+            finished = true;
+            error = std::move(p_error);
+        }
+        cv.notify_all();
+    }
+};
+
+
+PybindCommandBatch::PybindCommandBatch(std::shared_ptr<PybindCommandBatchState> state)
+    : m_state(std::move(state))
+{}
+size_t PybindCommandBatch::size() const{
+    return m_state->states.size();
+}
+bool PybindCommandBatch::is_submitted() const{
+    std::lock_guard<Mutex> lg(m_state->lock);
+    return m_state->submitted;
+}
+bool PybindCommandBatch::is_finished() const{
+    std::lock_guard<Mutex> lg(m_state->lock);
+    return m_state->finished;
+}
+bool PybindCommandBatch::wait_for_submitted(uint64_t timeout_millis) const{
+    std::unique_lock<Mutex> lg(m_state->lock);
+    return m_state->cv.wait_for(lg, Milliseconds(timeout_millis), [this]{
+        return m_state->submitted;
+    });
+}
+bool PybindCommandBatch::wait_for_finished(uint64_t timeout_millis) const{
+    std::unique_lock<Mutex> lg(m_state->lock);
+    return m_state->cv.wait_for(lg, Milliseconds(timeout_millis), [this]{
+        return m_state->finished;
+    });
+}
+std::string PybindCommandBatch::error() const{
+    std::lock_guard<Mutex> lg(m_state->lock);
+    return m_state->error;
+}
+
+
+
 class PybindSwitchProControllerInternal final : public ControllerConnection::StatusListener{
 public:
     PybindSwitchProControllerInternal(const std::string& name)
@@ -32,6 +99,7 @@ public:
         m_connection->add_status_listener(*this);
     }
     ~PybindSwitchProControllerInternal(){
+        stop_batches();
         m_connection->remove_status_listener(*this);
     }
 
@@ -72,6 +140,185 @@ public:
         return m_procon.load(std::memory_order_acquire);
     }
 
+    PybindCommandBatch submit_batch(std::vector<PybindControllerState> states){
+        auto batch = std::make_shared<PybindCommandBatchState>();
+        batch->states = std::move(states);
+        {
+            std::lock_guard<Mutex> lg(m_batch_lock);
+            if (m_stopping.load(std::memory_order_relaxed)){
+                batch->set_finished("Controller was closed.");
+                return PybindCommandBatch(std::move(batch));
+            }
+            m_batches.emplace_back(batch);
+            if (!m_batch_thread){
+                m_batch_thread = GlobalThreadPools::unlimited_normal().dispatch_now_blocking([this]{
+                    run_batches();
+                });
+            }
+        }
+        m_batch_cv.notify_all();
+        return PybindCommandBatch(std::move(batch));
+    }
+
+
+private:
+    //  Called from the destructor. Must not throw.
+    void stop_batches(){
+        bool batch_thread_running;
+        {
+            std::lock_guard<Mutex> lg(m_batch_lock);
+            m_stopping.store(true);
+            batch_thread_running = m_batch_thread && !m_batch_thread.is_finished();
+        }
+        m_batch_cv.notify_all();
+
+        //  Unblock the batch thread if it is stuck on a full queue or waiting
+        //  for the controller to drain. If no batch is in the controller, leave
+        //  the user's own commands alone. If the connection is gone, there is
+        //  nothing to cancel and the batch thread will fail out by itself.
+        //
+        //  "m_stopping" is set before reading "m_batch_in_controller" and the
+        //  batch thread does the reverse. So at least one of us sees the other.
+        ProController* procon = controller();
+        if (batch_thread_running &&
+            m_batch_in_controller.load() &&
+            procon != nullptr && procon->is_ready()
+        ){
+            try{
+                procon->cancel_all_commands();
+            }catch (const Exception& e){
+                m_logger.log("Unable to cancel batched commands: " + e.message(), COLOR_RED);
+            }catch (const std::exception& e){
+                m_logger.log("Unable to cancel batched commands: " + std::string(e.what()), COLOR_RED);
+            }
+        }
+        m_batch_thread.wait_and_ignore_exceptions();
+    }
+
+    //  Returns an empty string on success. Otherwise the reason for failing.
+    //  "expected_idle" is pushed back by the duration of every state issued so
+    //  the batch thread knows roughly when the controller will run dry.
+    std::string issue_batch(const PybindCommandBatchState& batch, WallClock& expected_idle){
+        ProController* procon = controller();
+        if (procon == nullptr){
+            return "Controller is not ready.";
+        }
+        std::lock_guard<Mutex> lg(m_command_lock);
+        try{
+            for (const PybindControllerState& state : batch.states){
+                if (m_stopping.load(std::memory_order_relaxed)){
+                    return "Controller was closed.";
+                }
+                expected_idle = std::max(expected_idle, current_time()) + Milliseconds(state.duration);
+                procon->issue_full_controller_state(
+                    nullptr,
+                    false,
+                    Milliseconds(state.duration),
+                    (Button)state.button_bitfield,
+                    (DpadPosition)state.dpad_position,
+                    {state.left_x, state.left_y},
+                    {state.right_x, state.right_y}
+                );
+            }
+        }catch (const Exception& e){
+            return e.message();
+        }catch (const std::exception& e){
+            return e.what();
+        }
+        return "";
+    }
+    //  Only called once the issued states should have run out. So this only
+    //  waits out the tail of the queue. This does not take "m_command_lock".
+    //  The controller serializes this against other commands by itself and
+    //  "stop_batches()" can still break out of it with "cancel_all_commands()".
+    std::string wait_for_controller(){
+        ProController* procon = controller();
+        if (procon == nullptr){
+            return "Controller is not ready.";
+        }
+        try{
+            procon->wait_for_all(nullptr);
+        }catch (const Exception& e){
+            return e.message();
+        }catch (const std::exception& e){
+            return e.what();
+        }
+        return "";
+    }
+
+    void run_batches(){
+        //  Batches that have been fully issued, but may still be running.
+        std::vector<std::shared_ptr<PybindCommandBatchState>> unfinished;
+
+        //  When the states issued so far are expected to finish running.
+        WallClock expected_idle = WallClock::min();
+
+        while (true){
+            std::shared_ptr<PybindCommandBatchState> batch;
+            {
+                std::unique_lock<Mutex> lg(m_batch_lock);
+                if (m_stopping.load(std::memory_order_relaxed)){
+                    break;
+                }
+                if (!m_batches.empty()){
+                    batch = std::move(m_batches.front());
+                    m_batches.pop_front();
+                }else if (unfinished.empty()){
+                    m_batch_cv.wait(lg, [this]{
+                        return m_stopping.load(std::memory_order_relaxed) || !m_batches.empty();
+                    });
+                    continue;
+                }else if (current_time() < expected_idle){
+                    //  The controller is still busy with what was issued. Wait
+                    //  for it to run out, but issue any new batch right away.
+                    m_batch_cv.wait_until(lg, expected_idle, [this]{
+                        return m_stopping.load(std::memory_order_relaxed) || !m_batches.empty();
+                    });
+                    continue;
+                }
+            }
+
+            //  Nothing else is queued and the controller should be done. Wait
+            //  out whatever is left and report everything that was issued.
+            if (!batch){
+                m_batch_in_controller.store(true);
+                std::string error = m_stopping.load()
+                    ? "Controller was closed."
+                    : wait_for_controller();
+                m_batch_in_controller.store(false);
+                for (const auto& item : unfinished){
+                    item->set_finished(error);
+                }
+                unfinished.clear();
+                continue;
+            }
+
+            m_batch_in_controller.store(true);
+            std::string error = m_stopping.load()
+                ? "Controller was closed."
+                : issue_batch(*batch, expected_idle);
+            m_batch_in_controller.store(false);
+            if (!error.empty()){
+                batch->set_finished(std::move(error));
+                continue;
+            }
+            batch->set_submitted();
+            unfinished.emplace_back(std::move(batch));
+        }
+
+        std::deque<std::shared_ptr<PybindCommandBatchState>> batches;
+        {
+            std::lock_guard<Mutex> lg(m_batch_lock);
+            batches = std::move(m_batches);
+        }
+        for (const auto& item : unfinished){
+            item->set_finished("Controller was closed.");
+        }
+        for (const auto& item : batches){
+            item->set_finished("Controller was closed.");
+        }
+    }
+
 
 public:
     TaggedLogger m_logger;
@@ -83,6 +330,19 @@ public:
     bool m_connected = false;
     Mutex m_lock;
     ConditionVariable m_cv;
+
+    //  Commands are not thread-safe with each other. This serializes the
+    //  individual calls with the batch thread.
+    Mutex m_command_lock;
+
+private:
+    Mutex m_batch_lock;
+    ConditionVariable m_batch_cv;
+    std::atomic<bool> m_stopping{false};
+    //  The batch thread is issuing into or waiting on the controller.
+    std::atomic<bool> m_batch_in_controller{false};
+    std::deque<std::shared_ptr<PybindCommandBatchState>> m_batches;
+    AsyncTask m_batch_thread;
 };
 
 
@@ -122,6 +382,7 @@ void PybindSwitchProController::wait_for_all_requests(){
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->wait_for_all(nullptr);
 }
 void PybindSwitchProController::wait(uint64_t duration){
@@ -131,6 +392,7 @@ void PybindSwitchProController::wait(uint64_t duration){
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->issue_nop(nullptr, Milliseconds(duration));
 }
 void PybindSwitchProController::push_button(uint64_t delay, uint64_t hold, uint64_t release, uint32_t bitfield){
@@ -140,6 +402,7 @@ void PybindSwitchProController::push_button(uint64_t delay, uint64_t hold, uint6
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->issue_buttons(
         nullptr,
         Milliseconds(delay),
@@ -155,6 +418,7 @@ void PybindSwitchProController::push_dpad(uint64_t delay, uint64_t hold, uint64_
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->issue_dpad(
         nullptr,
         Milliseconds(delay),
@@ -170,6 +434,7 @@ void PybindSwitchProController::push_left_joystick(uint64_t delay, uint64_t hold
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->issue_left_joystick(
         nullptr,
         Milliseconds(delay),
@@ -185,6 +450,7 @@ void PybindSwitchProController::push_right_joystick(uint64_t delay, uint64_t hol
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->issue_right_joystick(
         nullptr,
         Milliseconds(delay),
@@ -206,6 +472,7 @@ void PybindSwitchProController::controller_state(
         internal->m_logger.log("Controller is not ready.", COLOR_RED);
         return;
     }
+    std::lock_guard<Mutex> lg(internal->m_command_lock);
     controller->issue_full_controller_state(
         nullptr,
         true,
@@ -216,6 +483,10 @@ void PybindSwitchProController::controller_state(
         {right_x, right_y}
     );
 }
+PybindCommandBatch PybindSwitchProController::controller_state_batch(const PybindControllerState* states, size_t count){
+    PybindSwitchProControllerInternal* internal = (PybindSwitchProControllerInternal*)m_internals;
+    return internal->submit_batch(std::vector<PybindControllerState>(states, states + count));
+}
 
 
 
@@ -9,12 +9,65 @@
 
 #include <stdint.h>
 #include <string>
+#include <memory>
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
 
 
 
+//  One entry of a batched controller state sequence.
+//
+//  This is a fixed 48-byte layout so that Python can hand over a contiguous
+//  buffer of these (a numpy structured array, array.array or bytes) without
+//  any per-entry conversion. The equivalent struct format is "=QIB3xdddd".
+struct PybindControllerState{
+    uint64_t duration;          //  milliseconds
+    uint32_t button_bitfield;
+    uint8_t dpad_position;
+    uint8_t reserved[3];
+    double left_x;
+    double left_y;
+    double right_x;
+    double right_y;
+};
+static_assert(sizeof(PybindControllerState) == 48);
+
+
+//  Completion handle for a batch of controller states.
+//
+//  A batch is "submitted" once all of its states have been enqueued into the
+//  controller and "finished" once the controller has run all of them. Since
+//  the controller only reports when its entire queue has drained, a batch that
+//  is followed by more batches is reported finished when the queue next
+//  becomes empty.
+//
+//  None of these touch Python objects. The bindings should release the GIL
+//  around the waits.
+struct PybindCommandBatchState;
+class PybindCommandBatch{
+public:
+    PybindCommandBatch(std::shared_ptr<PybindCommandBatchState> state);
+
+    size_t size() const;
+
+    bool is_submitted() const;
+    bool is_finished() const;
+
+    //  Returns true if the batch finished (or failed) within the timeout.
+    bool wait_for_submitted(uint64_t timeout_millis) const;
+    bool wait_for_finished(uint64_t timeout_millis) const;
+
+    //  Empty if the batch was submitted and ran normally. Otherwise the reason
+    //  it was dropped. A failed batch counts as finished.
+    std::string error() const;
+
+private:
+    std::shared_ptr<PybindCommandBatchState> m_state;
+};
+
+
+
 class PybindSwitchProController{
     PybindSwitchProController(const PybindSwitchProController&) = delete;
     void operator=(const PybindSwitchProController&) = delete;
@@ -45,6 +98,18 @@ public:
         double right_x, double right_y
     );
 
+    //  Schedule a whole sequence of controller states in one call and return
+    //  immediately. The states are copied so the caller's buffer can be
+    //  released as soon as this returns.
+    //
+    //  The states are issued in order on a background thread. Batches run in
+    //  the order they are submitted and are serialized with the individual
+    //  calls above.
+    //
+    //  This does not touch Python objects. The bindings should release the GIL
+    //  for this call.
+    PybindCommandBatch controller_state_batch(const PybindControllerState* states, size_t count);
+
 private:
     void* m_internals;
 };
@@ -0,0 +1,71 @@
+/*  Pybind Video Snapshot
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "PybindVideoSnapshot.h"
+
+namespace PokemonAutomation{
+
+
+
+PybindVideoSnapshot::PybindVideoSnapshot(VideoSnapshot snapshot)
+    : m_snapshot(std::move(snapshot))
+{}
+PybindVideoSnapshot PybindVideoSnapshot::latest(VideoFeed& feed){
+    return PybindVideoSnapshot(feed.snapshot_latest_blocking());
+}
+
+size_t PybindVideoSnapshot::width() const{
+    return m_snapshot ? m_snapshot->width() : 0;
+}
+size_t PybindVideoSnapshot::height() const{
+    return m_snapshot ? m_snapshot->height() : 0;
+}
+int64_t PybindVideoSnapshot::timestamp() const{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        m_snapshot.timestamp.time_since_epoch()
+    ).count();
+}
+
+PybindBufferInfo PybindVideoSnapshot::pixels_bgra() const{
+    //  ARGB32 pixels are stored native-endian (little-endian on everything we
+    //  run on). So the bytes in memory are B, G, R, A.
+    PybindBufferInfo info;
+    info.itemsize = sizeof(uint8_t);
+    info.format = "B";
+    info.ndim = 3;
+    info.shape[2] = sizeof(uint32_t);
+    info.strides[2] = sizeof(uint8_t);
+    info.strides[1] = sizeof(uint32_t);
+    if (!m_snapshot){
+        return info;
+    }
+    const ImageRGB32& frame = *m_snapshot.frame;
+    info.ptr = frame.data();
+    info.shape[0] = frame.height();
+    info.shape[1] = frame.width();
+    info.strides[0] = frame.bytes_per_row();
+    return info;
+}
+PybindBufferInfo PybindVideoSnapshot::pixels_argb32() const{
+    PybindBufferInfo info;
+    info.itemsize = sizeof(uint32_t);
+    info.format = "I";
+    info.ndim = 2;
+    info.strides[1] = sizeof(uint32_t);
+    if (!m_snapshot){
+        return info;
+    }
+    const ImageRGB32& frame = *m_snapshot.frame;
+    info.ptr = frame.data();
+    info.shape[0] = frame.height();
+    info.shape[1] = frame.width();
+    info.strides[0] = frame.bytes_per_row();
+    return info;
+}
+
+
+
+}
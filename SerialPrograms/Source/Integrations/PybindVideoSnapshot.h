@@ -0,0 +1,66 @@
+/*  Pybind Video Snapshot
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Integrations_PybindVideoSnapshot_H
+#define PokemonAutomation_Integrations_PybindVideoSnapshot_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
+
+namespace PokemonAutomation{
+
+
+
+//  The fields of a Python buffer-protocol view (Py_buffer) without depending
+//  on Python. The bindings forward these to py::buffer_info as is.
+struct PybindBufferInfo{
+    const void* ptr = nullptr;
+    size_t itemsize = 0;
+    const char* format = "";
+    size_t ndim = 0;
+    size_t shape[3] = {};
+    size_t strides[3] = {};
+    bool readonly = true;
+};
+
+
+//  A read-only view of the pixels of a video frame that Python can wrap
+//  without copying. The snapshot holds a reference to the frame, so the
+//  pixels stay valid for as long as this object (and anything that Python
+//  derived from its buffer) is alive.
+class PybindVideoSnapshot{
+public:
+    PybindVideoSnapshot() = default;
+    PybindVideoSnapshot(VideoSnapshot snapshot);
+
+    //  Returns the latest frame of the feed. Blocks if it hasn't been
+    //  converted yet. The bindings should release the GIL for this call.
+    static PybindVideoSnapshot latest(VideoFeed& feed);
+
+    explicit operator bool() const{ return (bool)m_snapshot; }
+
+    size_t width() const;
+    size_t height() const;
+
+    //  Milliseconds since the epoch of the wall clock.
+    int64_t timestamp() const;
+
+    //  The frame as a (height, width, 4) array of bytes in BGRA order. The
+    //  rows may be padded so the row stride can be larger than width * 4.
+    PybindBufferInfo pixels_bgra() const;
+
+    //  The frame as a (height, width) array of 32-bit ARGB pixels.
+    PybindBufferInfo pixels_argb32() const;
+
+private:
+    VideoSnapshot m_snapshot;
+};
+
+
+
+}
+#endif
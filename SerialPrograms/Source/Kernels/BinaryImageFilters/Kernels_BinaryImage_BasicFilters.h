@@ -80,6 +80,22 @@ void compress_rgb32_to_binary_range(
 
 
 
+//  Same as the single-filter overload of `compress_rgb32_to_binary_range()`, but
+//  each pixel is converted to HSV32 first. `mins` and `maxs` are HSV32 pixels.
+//  (see Kernels_ImageFilter_RGB32_HSV.h)
+//  If the min hue is greater than the max hue, the hue range wraps around through
+//  zero. (for reds)
+//  This is the same as converting the image to HSV32 and then filtering it, but
+//  it does not need the intermediate image.
+void compress_rgb32_to_binary_hsv_range(
+    const uint32_t* image, size_t bytes_per_row,
+    PackedBinaryMatrix_IB& matrix,
+    uint32_t mins, uint32_t maxs
+);
+
+
+
+
 //  Compress (image, bytes_per_row) into a binary_image.
 //  For each pixel, set to 1 if the Euclidean distance of the pixel color to the expected color <= max distance.
 void compress_rgb32_to_binary_euclidean(
@@ -45,6 +45,18 @@ void compress_rgb32_to_binary_range_64x4_Default(
 
 
 
+void compress_rgb32_to_binary_hsv_range_64x4_Default(
+    const uint32_t* image, size_t bytes_per_row,
+    PackedBinaryMatrix_IB& matrix, uint32_t mins, uint32_t maxs
+){
+    Compressor_HsvRange_Default compressor(mins, maxs);
+    compress_rgb32_to_binary(
+        image, bytes_per_row,
+        static_cast<PackedBinaryMatrix_64x4_Default&>(matrix).get(), compressor
+    );
+}
+
+
 void compress_rgb32_to_binary_euclidean_64x4_Default(
     const uint32_t* image, size_t bytes_per_row,
     PackedBinaryMatrix_IB& matrix,
@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <cstddef>
 #include "Common/Compiler.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines.h"
 
 #include <iostream>
 using std::cout;
@@ -110,6 +111,78 @@ private:
 
 
 
+//  Same as Compressor_RgbRange_Default, but the pixels are converted to HSV32
+//  first. If the min hue is greater than the max hue, the hue range wraps
+//  around through zero.
+class Compressor_HsvRange_Default{
+public:
+    Compressor_HsvRange_Default(uint32_t mins, uint32_t maxs)
+        : m_minV(mins & 0x000000ff)
+        , m_maxV(maxs & 0x000000ff)
+        , m_minS(mins & 0x0000ff00)
+        , m_maxS(maxs & 0x0000ff00)
+        , m_minH(mins & 0x00ff0000)
+        , m_maxH(maxs & 0x00ff0000)
+        , m_minA(mins & 0xff000000)
+        , m_maxA(maxs & 0xff000000)
+        , m_hue_wrap(m_minH > m_maxH)
+    {}
+
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count = 64) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        while (c < count){
+            bits |= convert1(pixels[c]) << c;
+            c++;
+        }
+        return bits;
+    }
+
+private:
+    PA_FORCE_INLINE uint64_t convert1(uint32_t pixel) const{
+        pixel = rgb32_to_hsv32_Default(pixel);
+        uint64_t ret = 1;
+        {
+            uint32_t p = pixel & 0xff000000;
+            ret &= p >= m_minA;
+            ret &= p <= m_maxA;
+        }
+        {
+            uint32_t p = pixel & 0x00ff0000;
+            if (m_hue_wrap){
+                ret &= p >= m_minH || p <= m_maxH;
+            }else{
+                ret &= p >= m_minH;
+                ret &= p <= m_maxH;
+            }
+        }
+        {
+            uint32_t p = pixel & 0x0000ff00;
+            ret &= p >= m_minS;
+            ret &= p <= m_maxS;
+        }
+        {
+            uint32_t p = pixel & 0x000000ff;
+            ret &= p >= m_minV;
+            ret &= p <= m_maxV;
+        }
+        return ret;
+    }
+
+private:
+    uint32_t m_minV;
+    uint32_t m_maxV;
+    uint32_t m_minS;
+    uint32_t m_maxS;
+    uint32_t m_minH;
+    uint32_t m_maxH;
+    uint32_t m_minA;
+    uint32_t m_maxA;
+    bool m_hue_wrap;
+};
+
+
+
 class Compressor_RgbEuclidean_Default{
 public:
     Compressor_RgbEuclidean_Default(uint32_t expected, double max_euclidean_distance)
@@ -8,6 +8,7 @@
 #define PokemonAutomation_Kernels_BinaryImage_BasicFilters_arm64_NEON_H
 
 #include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_arm64_NEON.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_ARM64_NEON.h"
 
 // #include <iostream>
 // using std::cout;
@@ -251,6 +252,68 @@ private:
 };
 
 
+// Same as Compressor_RgbRange_arm64_NEON, but the pixels are converted to HSV32
+// first. If the min hue is greater than the max hue, the hue range wraps
+// around through zero.
+class Compressor_HsvRange_arm64_NEON{
+public:
+    Compressor_HsvRange_arm64_NEON(uint32_t mins, uint32_t maxs)
+        : m_mins_u8(vreinterpretq_u8_u32(vdupq_n_u32(mins)))
+        , m_maxs_u8(vreinterpretq_u8_u32(vdupq_n_u32(maxs)))
+        , m_hue_wrap_u8(vreinterpretq_u8_u32(vdupq_n_u32((mins & 0x00ff0000) > (maxs & 0x00ff0000) ? 0x00ff0000 : 0)))
+        , m_zeros(vreinterpretq_u32_u8(vdupq_n_u8(0)))
+    {}
+
+    // Convert a row of 64 pixels to bit map fit into uint64_t
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels) const{
+        uint64_t bits = 0;
+        for (size_t c = 0; c < 64; c += 4){
+            bits |= convert4(vld1q_u32(pixels + c)) << c;
+        }
+        return bits;
+    }
+    // Convert a row of `count` pixels to bit map fit into uint64_t
+    // count <= 64
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        for (size_t i = 0; i < count / 4; i++, c += 4){
+            bits |= convert4(vld1q_u32(pixels + c)) << c;
+        }
+        count %= 4;
+        if (count){
+            PartialWordAccess_arm64_NEON loader(count * sizeof(uint32_t));
+            const uint32x4_t pixel = vreinterpretq_u32_u8(loader.load(pixels + c));
+            const uint64_t mask = ((uint64_t)1 << count) - 1;
+            bits |= (convert4(pixel) & mask) << c;
+        }
+        return bits;
+    }
+
+private:
+    // Convert four pixels to four 0/1 bits according to HSV color range
+    // Return a uint64_t where the lowest four bits contain the converted bits for each pixel.
+    PA_FORCE_INLINE uint64_t convert4(uint32x4_t pixel) const{
+        uint8x16_t hsv = vreinterpretq_u8_u32(rgb32_to_hsv32_ARM64_NEON(pixel));
+        // Check if mins > pixel per color channel
+        uint8x16_t cmp0 = vcgtq_u8(m_mins_u8, hsv);
+        // Check if pixel > maxs per color channel
+        uint8x16_t cmp1 = vcgtq_u8(hsv, m_maxs_u8);
+        // A wrapped hue is only out of range if it is both below the min and above the max.
+        uint8x16_t cmp = vbslq_u8(m_hue_wrap_u8, vandq_u8(cmp0, cmp1), vorrq_u8(cmp0, cmp1));
+        // If a pixel is within range, its uint32_t in `cmp_32x4` is all 1 bits, otherwise, all 0 bits
+        uint32x4_t cmp_32x4 = vceqq_u32(vreinterpretq_u32_u8(cmp), m_zeros);
+        return (cmp_32x4[0] & 0x1) | (cmp_32x4[1] & 0x2) | (cmp_32x4[2] & 0x4) | (cmp_32x4[3] & 0x8);
+    }
+
+private:
+    uint8x16_t m_mins_u8;
+    uint8x16_t m_maxs_u8;
+    uint8x16_t m_hue_wrap_u8;
+    const uint32x4_t m_zeros;
+};
+
+
 class Compressor_RgbEuclidean_arm64_NEON{
 public:
     Compressor_RgbEuclidean_arm64_NEON(uint32_t expected_color, double max_euclidean_distance)
@@ -9,6 +9,7 @@
 
 #include <stdint.h>
 #include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_AVX2.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX2.h"
 
 namespace PokemonAutomation{
 namespace Kernels{
@@ -113,6 +114,72 @@ private:
 
 
 
+//  Same as Compressor_RgbRange_x64_AVX2, but the pixels are converted to HSV32
+//  first. If the min hue is greater than the max hue, the hue range wraps
+//  around through zero.
+class Compressor_HsvRange_x64_AVX2{
+public:
+    Compressor_HsvRange_x64_AVX2(uint32_t mins, uint32_t maxs)
+        : m_mins(_mm256_set1_epi32(mins ^ 0x80808080))
+        , m_maxs(_mm256_set1_epi32(maxs ^ 0x80808080))
+        , m_hue_wrap(_mm256_set1_epi32((mins & 0x00ff0000) > (maxs & 0x00ff0000) ? 0x00ff0000 : 0))
+    {}
+
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels) const{
+        uint64_t bits = 0;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels +  0))) <<  0;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels +  8))) <<  8;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels + 16))) << 16;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels + 24))) << 24;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels + 32))) << 32;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels + 40))) << 40;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels + 48))) << 48;
+        bits |= convert8(_mm256_loadu_si256((const __m256i*)(pixels + 56))) << 56;
+        return bits;
+    }
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        size_t lc = count / 8;
+        while (lc--){
+            __m256i pixel = _mm256_loadu_si256((const __m256i*)pixels);
+            bits |= convert8(pixel) << c;
+            pixels += 8;
+            c += 8;
+        }
+        count %= 8;
+        if (count){
+            PartialWordAccess32_x64_AVX2 loader(count);
+            __m256i pixel = loader.load_i32(pixels);
+            uint64_t mask = ((uint64_t)1 << count) - 1;
+            bits |= (convert8(pixel) & mask) << c;
+        }
+        return bits;
+    }
+
+private:
+    PA_FORCE_INLINE uint64_t convert8(__m256i pixel) const{
+        pixel = rgb32_to_hsv32_x64_AVX2(pixel);
+        pixel = _mm256_xor_si256(pixel, _mm256_set1_epi8((uint8_t)0x80));
+        __m256i cmp0 = _mm256_cmpgt_epi8(m_mins, pixel);
+        __m256i cmp1 = _mm256_cmpgt_epi8(pixel, m_maxs);
+        cmp0 = _mm256_blendv_epi8(
+            _mm256_or_si256(cmp0, cmp1),
+            _mm256_and_si256(cmp0, cmp1),
+            m_hue_wrap
+        );
+        cmp0 = _mm256_cmpeq_epi32(cmp0, _mm256_setzero_si256());
+        return _mm256_movemask_ps(_mm256_castsi256_ps(cmp0));
+    }
+
+private:
+    __m256i m_mins;
+    __m256i m_maxs;
+    __m256i m_hue_wrap;
+};
+
+
+
 class Compressor_RgbEuclidean_x64_AVX2{
 public:
     Compressor_RgbEuclidean_x64_AVX2(uint32_t expected, double max_euclidean_distance)
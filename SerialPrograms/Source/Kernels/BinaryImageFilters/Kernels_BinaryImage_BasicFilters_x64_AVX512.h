@@ -10,6 +10,7 @@
 #include <stdint.h>
 #include <immintrin.h>
 #include "Common/Compiler.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX512.h"
 
 //#include <iostream>
 //using std::cout;
@@ -116,6 +117,63 @@ private:
 
 
 
+//  Same as Compressor_RgbRange_x64_AVX512, but the pixels are converted to HSV32
+//  first. If the min hue is greater than the max hue, the hue range wraps
+//  around through zero.
+class Compressor_HsvRange_x64_AVX512{
+public:
+    Compressor_HsvRange_x64_AVX512(uint32_t mins, uint32_t maxs)
+        : m_mins(_mm512_set1_epi32(mins))
+        , m_maxs(_mm512_set1_epi32(maxs))
+        , m_hue_wrap((mins & 0x00ff0000) > (maxs & 0x00ff0000) ? 0x4444444444444444 : 0)
+    {}
+
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels) const{
+        uint64_t bits = 0;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels +  0))) <<  0;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels + 16))) << 16;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels + 32))) << 32;
+        bits |= convert16(_mm512_loadu_si512((const __m512i*)(pixels + 48))) << 48;
+        return bits;
+    }
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        size_t lc = count / 16;
+        while (lc--){
+            __m512i pixel = _mm512_loadu_si512((const __m512i*)pixels);
+            bits |= convert16(pixel) << c;
+            pixels += 16;
+            c += 16;
+        }
+        count %= 16;
+        if (count){
+            uint64_t mask = ((uint64_t)1 << count) - 1;
+            __m512i pixel = _mm512_maskz_loadu_epi32((__mmask16)mask, pixels);
+            bits |= (convert16(pixel) & mask) << c;
+        }
+        return bits;
+    }
+
+private:
+    PA_FORCE_INLINE uint64_t convert16(__m512i pixel) const{
+        pixel = rgb32_to_hsv32_x64_AVX512(pixel);
+        __mmask64 cmp64A = _mm512_cmple_epu8_mask(m_mins, pixel);
+        __mmask64 cmp64B = _mm512_cmple_epu8_mask(pixel, m_maxs);
+        __mmask64 in_range = (cmp64A & cmp64B) | ((cmp64A | cmp64B) & m_hue_wrap);
+        pixel = _mm512_movm_epi8(in_range);
+        __mmask16 cmp16 = _mm512_cmpeq_epi32_mask(pixel, _mm512_set1_epi32(-1));
+        return cmp16;
+    }
+
+private:
+    __m512i m_mins;
+    __m512i m_maxs;
+    __mmask64 m_hue_wrap;
+};
+
+
+
 class Compressor_RgbEuclidean_x64_AVX512{
 public:
     Compressor_RgbEuclidean_x64_AVX512(uint32_t expected, double max_euclidean_distance)
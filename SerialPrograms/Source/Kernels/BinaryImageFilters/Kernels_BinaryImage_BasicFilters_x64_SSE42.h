@@ -8,6 +8,7 @@
 #define PokemonAutomation_Kernels_BinaryImage_BasicFilters_x64_SSE41_H
 
 #include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_SSE41.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_x64_SSE42.h"
 
 namespace PokemonAutomation{
 namespace Kernels{
@@ -134,6 +135,70 @@ private:
 
 
 
+//  Same as Compressor_RgbRange_x64_SSE41, but the pixels are converted to HSV32
+//  first. If the min hue is greater than the max hue, the hue range wraps
+//  around through zero.
+class Compressor_HsvRange_x64_SSE41{
+public:
+    Compressor_HsvRange_x64_SSE41(uint32_t mins, uint32_t maxs)
+        : m_mins(_mm_set1_epi32(mins ^ 0x80808080))
+        , m_maxs(_mm_set1_epi32(maxs ^ 0x80808080))
+        , m_hue_wrap(_mm_set1_epi32((mins & 0x00ff0000) > (maxs & 0x00ff0000) ? 0x00ff0000 : 0))
+    {}
+
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        do{
+            __m128i pixel = _mm_loadu_si128((const __m128i*)(pixels + c));
+            bits |= convert4(pixel) << c;
+            c += 4;
+        }while (c < 64);
+        return bits;
+    }
+    PA_FORCE_INLINE uint64_t convert64(const uint32_t* pixels, size_t count) const{
+        uint64_t bits = 0;
+        size_t c = 0;
+        size_t lc = count / 4;
+        while (lc--){
+            __m128i pixel = _mm_loadu_si128((const __m128i*)pixels);
+            bits |= convert4(pixel) << c;
+            pixels += 4;
+            c += 4;
+        }
+        count %= 4;
+        if (count){
+            PartialWordAccess_x64_SSE41 loader(count * sizeof(uint32_t));
+            __m128i pixel = loader.load(pixels);
+            uint64_t mask = ((uint64_t)1 << count) - 1;
+            bits |= (convert4(pixel) & mask) << c;
+        }
+        return bits;
+    }
+
+private:
+    PA_FORCE_INLINE uint64_t convert4(__m128i pixel) const{
+        pixel = rgb32_to_hsv32_x64_SSE42(pixel);
+        pixel = _mm_xor_si128(pixel, _mm_set1_epi8((uint8_t)0x80));
+        __m128i cmp0 = _mm_cmpgt_epi8(m_mins, pixel);
+        __m128i cmp1 = _mm_cmpgt_epi8(pixel, m_maxs);
+        cmp0 = _mm_blendv_epi8(
+            _mm_or_si128(cmp0, cmp1),
+            _mm_and_si128(cmp0, cmp1),
+            m_hue_wrap
+        );
+        cmp0 = _mm_cmpeq_epi32(cmp0, _mm_setzero_si128());
+        return _mm_movemask_ps(_mm_castsi128_ps(cmp0));
+    }
+
+private:
+    __m128i m_mins;
+    __m128i m_maxs;
+    __m128i m_hue_wrap;
+};
+
+
+
 class Compressor_RgbEuclidean_x64_SSE41{
 public:
     Compressor_RgbEuclidean_x64_SSE41(uint32_t expected, double max_euclidean_distance)
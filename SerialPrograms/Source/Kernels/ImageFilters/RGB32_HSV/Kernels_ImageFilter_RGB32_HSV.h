@@ -0,0 +1,39 @@
+/*  Image Filters RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Convert an RGB32 image into HSV32.
+ *
+ *  Each output pixel keeps the alpha of the input pixel and stores
+ *  H, S and V where R, G and B were:
+ *
+ *      [A][H][S][V]
+ *
+ *  H is the hue scaled from [0, 360) to [0, 256) and rounded.
+ *  S is the saturation scaled to [0, 255].
+ *  V is max(R, G, B).
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert (image_in, image_in_bytes_per_row) to HSV32 and save the output to `image_out`.
+//  The output may be the same as the input.
+void convert_rgb32_to_hsv32(
+    const uint32_t* image_in, size_t image_in_bytes_per_row, size_t width, size_t height,
+    uint32_t* image_out, size_t image_out_bytes_per_row
+);
+
+
+
+}
+}
+#endif
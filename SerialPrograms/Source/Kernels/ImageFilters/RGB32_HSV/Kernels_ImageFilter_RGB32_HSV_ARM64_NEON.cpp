@@ -0,0 +1,52 @@
+/*  Image Filters RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <string.h>
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels_ImageFilter_RGB32_HSV_Routines_ARM64_NEON.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+class Rgb32ToHsv32_ARM64_NEON{
+public:
+    static const size_t VECTOR_SIZE = 4;
+    using Mask = size_t;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        uint32x4_t pixel = vld1q_u32(in);
+        vst1q_u32(out, rgb32_to_hsv32_ARM64_NEON(pixel));
+    }
+    //  Same as `process_full()` but only process `left` (< 4) pixels
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, size_t left){
+        uint32_t buffer_in[4] = {}, buffer_out[4];
+        memcpy(buffer_in, in, sizeof(uint32_t) * left);
+        process_full(buffer_out, buffer_in);
+        memcpy(out, buffer_out, sizeof(uint32_t) * left);
+    }
+};
+
+
+
+void convert_rgb32_to_hsv32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    Rgb32ToHsv32_ARM64_NEON converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
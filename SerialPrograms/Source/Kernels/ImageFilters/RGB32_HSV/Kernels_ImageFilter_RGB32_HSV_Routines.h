@@ -0,0 +1,71 @@
+/*  Image Filters RGB32 to HSV32 Routines
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  All the vectorized versions do the same integer math as the scalar
+ *  version below and are bit-exact with it.
+ *
+ *      H = round(256 * X / (6 * delta))  (mod 256)
+ *
+ *  where X is the hue in units of delta:
+ *
+ *      max = R:    X = G - B               (+ 6 * delta if negative)
+ *      max = G:    X = B - R + 2 * delta
+ *      max = B:    X = R - G + 4 * delta
+ *
+ *  The vector versions do both divisions in single-precision float. The
+ *  dividends and divisors are small enough that the truncated quotient is
+ *  always exact.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_H
+
+#include <stdint.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint32_t rgb32_to_hsv32_Default(uint32_t pixel){
+    int r = (pixel >> 16) & 0xff;
+    int g = (pixel >>  8) & 0xff;
+    int b = pixel & 0xff;
+
+    int max = r > g ? r : g;
+    max = max > b ? max : b;
+    int min = r < g ? r : g;
+    min = min < b ? min : b;
+    int delta = max - min;
+
+    int s = 0;
+    if (max > 0){
+        s = 255 - (min * 255 + max / 2) / max;
+    }
+
+    int h = 0;
+    if (delta > 0){
+        int x;
+        if (max == r){
+            x = g - b;
+            if (x < 0){
+                x += 6 * delta;
+            }
+        }else if (max == g){
+            x = b - r + 2 * delta;
+        }else{
+            x = r - g + 4 * delta;
+        }
+        h = ((256 * x + 3 * delta) / (6 * delta)) & 0xff;
+    }
+
+    return (pixel & 0xff000000) | ((uint32_t)h << 16) | ((uint32_t)s << 8) | (uint32_t)max;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,74 @@
+/*  Image Filters RGB32 to HSV32 Routines (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_ARM64_NEON_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_ARM64_NEON_H
+
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert 4 RGB32 pixels to HSV32.
+//  Bit-exact with rgb32_to_hsv32_Default().
+PA_FORCE_INLINE uint32x4_t rgb32_to_hsv32_ARM64_NEON(uint32x4_t pixel){
+    const uint32x4_t BYTE = vdupq_n_u32(0x000000ff);
+    const uint32x4_t ONE = vdupq_n_u32(1);
+
+    uint32x4_t r = vandq_u32(vshrq_n_u32(pixel, 16), BYTE);
+    uint32x4_t g = vandq_u32(vshrq_n_u32(pixel, 8), BYTE);
+    uint32x4_t b = vandq_u32(pixel, BYTE);
+
+    uint32x4_t max = vmaxq_u32(vmaxq_u32(r, g), b);
+    uint32x4_t min = vminq_u32(vminq_u32(r, g), b);
+    uint32x4_t delta = vsubq_u32(max, min);
+    uint32x4_t delta2 = vaddq_u32(delta, delta);
+
+    //  s = 255 - (min * 255 + max / 2) / max
+    uint32x4_t s = vsubq_u32(vshlq_n_u32(min, 8), min);
+    s = vaddq_u32(s, vshrq_n_u32(max, 1));
+    s = vcvtq_u32_f32(vdivq_f32(
+        vcvtq_f32_u32(s),
+        vcvtq_f32_u32(vmaxq_u32(max, ONE))
+    ));
+    s = vsubq_u32(BYTE, s);
+    s = vandq_u32(s, vtstq_u32(max, max));
+
+    //  Hue in units of delta. Everything here is small so the signed
+    //  intermediates wrap correctly in unsigned arithmetic.
+    uint32x4_t delta6 = vaddq_u32(delta2, vaddq_u32(delta2, delta2));
+    int32x4_t xr_s32 = vsubq_s32(vreinterpretq_s32_u32(g), vreinterpretq_s32_u32(b));
+    uint32x4_t xr = vreinterpretq_u32_s32(xr_s32);
+    xr = vaddq_u32(xr, vandq_u32(vcltzq_s32(xr_s32), delta6));
+    uint32x4_t xg = vaddq_u32(vsubq_u32(b, r), delta2);
+    uint32x4_t xb = vaddq_u32(vsubq_u32(r, g), vaddq_u32(delta2, delta2));
+    //  vbslq_u32(a, b, c): for 1 bits in a, choose b; for 0 bits in a, choose c
+    uint32x4_t x = vbslq_u32(vceqq_u32(max, g), xg, xb);
+    x = vbslq_u32(vceqq_u32(max, r), xr, x);
+
+    //  h = (256 * x + 3 * delta) / (6 * delta)
+    //  When delta is zero, so is x. Divide by 1 instead.
+    uint32x4_t h = vaddq_u32(vshlq_n_u32(x, 8), vaddq_u32(delta, delta2));
+    h = vcvtq_u32_f32(vdivq_f32(
+        vcvtq_f32_u32(h),
+        vcvtq_f32_u32(vmaxq_u32(delta6, ONE))
+    ));
+    h = vandq_u32(h, BYTE);
+
+    pixel = vandq_u32(pixel, vdupq_n_u32(0xff000000));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(h, 16));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(s, 8));
+    pixel = vorrq_u32(pixel, max);
+    return pixel;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,70 @@
+/*  Image Filters RGB32 to HSV32 Routines (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX2_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX2_H
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert 8 RGB32 pixels to HSV32.
+//  Bit-exact with rgb32_to_hsv32_Default().
+PA_FORCE_INLINE __m256i rgb32_to_hsv32_x64_AVX2(__m256i pixel){
+    const __m256i BYTE = _mm256_set1_epi32(0x000000ff);
+
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), BYTE);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), BYTE);
+    __m256i b = _mm256_and_si256(pixel, BYTE);
+
+    __m256i max = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+    __m256i min = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+    __m256i delta = _mm256_sub_epi32(max, min);
+    __m256i delta2 = _mm256_add_epi32(delta, delta);
+
+    //  s = 255 - (min * 255 + max / 2) / max
+    __m256i s = _mm256_sub_epi32(_mm256_slli_epi32(min, 8), min);
+    s = _mm256_add_epi32(s, _mm256_srli_epi32(max, 1));
+    s = _mm256_cvttps_epi32(_mm256_div_ps(
+        _mm256_cvtepi32_ps(s),
+        _mm256_cvtepi32_ps(_mm256_max_epi32(max, _mm256_set1_epi32(1)))
+    ));
+    s = _mm256_sub_epi32(BYTE, s);
+    s = _mm256_andnot_si256(_mm256_cmpeq_epi32(max, _mm256_setzero_si256()), s);
+
+    //  Hue in units of delta.
+    __m256i delta6 = _mm256_add_epi32(delta2, _mm256_add_epi32(delta2, delta2));
+    __m256i xr = _mm256_sub_epi32(g, b);
+    xr = _mm256_add_epi32(xr, _mm256_and_si256(_mm256_srai_epi32(xr, 31), delta6));
+    __m256i xg = _mm256_add_epi32(_mm256_sub_epi32(b, r), delta2);
+    __m256i xb = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_add_epi32(delta2, delta2));
+    __m256i x = _mm256_blendv_epi8(xb, xg, _mm256_cmpeq_epi32(max, g));
+    x = _mm256_blendv_epi8(x, xr, _mm256_cmpeq_epi32(max, r));
+
+    //  h = (256 * x + 3 * delta) / (6 * delta)
+    //  When delta is zero, so is x. Divide by 1 instead.
+    __m256i h = _mm256_add_epi32(_mm256_slli_epi32(x, 8), _mm256_add_epi32(delta, delta2));
+    h = _mm256_cvttps_epi32(_mm256_div_ps(
+        _mm256_cvtepi32_ps(h),
+        _mm256_cvtepi32_ps(_mm256_max_epi32(delta6, _mm256_set1_epi32(1)))
+    ));
+    h = _mm256_and_si256(h, BYTE);
+
+    pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(h, 16));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(s, 8));
+    pixel = _mm256_or_si256(pixel, max);
+    return pixel;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,67 @@
+/*  Image Filters RGB32 to HSV32 Routines (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX512_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX512_H
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert 16 RGB32 pixels to HSV32.
+//  Bit-exact with rgb32_to_hsv32_Default().
+PA_FORCE_INLINE __m512i rgb32_to_hsv32_x64_AVX512(__m512i pixel){
+    const __m512i BYTE = _mm512_set1_epi32(0x000000ff);
+
+    __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), BYTE);
+    __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), BYTE);
+    __m512i b = _mm512_and_si512(pixel, BYTE);
+
+    __m512i max = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+    __m512i min = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+    __m512i delta = _mm512_sub_epi32(max, min);
+    __m512i delta2 = _mm512_add_epi32(delta, delta);
+
+    //  s = 255 - (min * 255 + max / 2) / max
+    __m512i s = _mm512_sub_epi32(_mm512_slli_epi32(min, 8), min);
+    s = _mm512_add_epi32(s, _mm512_srli_epi32(max, 1));
+    s = _mm512_cvttps_epi32(_mm512_div_ps(
+        _mm512_cvtepi32_ps(s),
+        _mm512_cvtepi32_ps(_mm512_max_epi32(max, _mm512_set1_epi32(1)))
+    ));
+    s = _mm512_maskz_sub_epi32(_mm512_test_epi32_mask(max, max), BYTE, s);
+
+    //  Hue in units of delta.
+    __m512i delta6 = _mm512_add_epi32(delta2, _mm512_add_epi32(delta2, delta2));
+    __m512i xr = _mm512_sub_epi32(g, b);
+    xr = _mm512_mask_add_epi32(xr, _mm512_cmplt_epi32_mask(xr, _mm512_setzero_si512()), xr, delta6);
+    __m512i xg = _mm512_add_epi32(_mm512_sub_epi32(b, r), delta2);
+    __m512i xb = _mm512_add_epi32(_mm512_sub_epi32(r, g), _mm512_add_epi32(delta2, delta2));
+    __m512i x = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(max, g), xb, xg);
+    x = _mm512_mask_blend_epi32(_mm512_cmpeq_epi32_mask(max, r), x, xr);
+
+    //  h = (256 * x + 3 * delta) / (6 * delta)
+    //  When delta is zero, so is x. Divide by 1 instead.
+    __m512i h = _mm512_add_epi32(_mm512_slli_epi32(x, 8), _mm512_add_epi32(delta, delta2));
+    h = _mm512_cvttps_epi32(_mm512_div_ps(
+        _mm512_cvtepi32_ps(h),
+        _mm512_cvtepi32_ps(_mm512_max_epi32(delta6, _mm512_set1_epi32(1)))
+    ));
+
+    //  [A][H][S][V] = (pixel & 0xff000000) | (h & 0xff) << 16 | s << 8 | max
+    __m512i hsv = _mm512_or_si512(_mm512_slli_epi32(s, 8), max);
+    hsv = _mm512_ternarylogic_epi32(_mm512_slli_epi32(h, 16), _mm512_set1_epi32(0x00ff0000), hsv, 0xea);
+    return _mm512_ternarylogic_epi32(pixel, _mm512_set1_epi32(0xff000000), hsv, 0xea);
+}
+
+
+
+}
+}
+#endif
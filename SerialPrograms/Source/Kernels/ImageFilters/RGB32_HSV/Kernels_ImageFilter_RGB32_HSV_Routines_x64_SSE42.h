@@ -0,0 +1,70 @@
+/*  Image Filters RGB32 to HSV32 Routines (x64 SSE4.2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_x64_SSE42_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_x64_SSE42_H
+
+#include <smmintrin.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert 4 RGB32 pixels to HSV32.
+//  Bit-exact with rgb32_to_hsv32_Default().
+PA_FORCE_INLINE __m128i rgb32_to_hsv32_x64_SSE42(__m128i pixel){
+    const __m128i BYTE = _mm_set1_epi32(0x000000ff);
+
+    __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), BYTE);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), BYTE);
+    __m128i b = _mm_and_si128(pixel, BYTE);
+
+    __m128i max = _mm_max_epi32(_mm_max_epi32(r, g), b);
+    __m128i min = _mm_min_epi32(_mm_min_epi32(r, g), b);
+    __m128i delta = _mm_sub_epi32(max, min);
+    __m128i delta2 = _mm_add_epi32(delta, delta);
+
+    //  s = 255 - (min * 255 + max / 2) / max
+    __m128i s = _mm_sub_epi32(_mm_slli_epi32(min, 8), min);
+    s = _mm_add_epi32(s, _mm_srli_epi32(max, 1));
+    s = _mm_cvttps_epi32(_mm_div_ps(
+        _mm_cvtepi32_ps(s),
+        _mm_cvtepi32_ps(_mm_max_epi32(max, _mm_set1_epi32(1)))
+    ));
+    s = _mm_sub_epi32(BYTE, s);
+    s = _mm_andnot_si128(_mm_cmpeq_epi32(max, _mm_setzero_si128()), s);
+
+    //  Hue in units of delta.
+    __m128i delta6 = _mm_add_epi32(delta2, _mm_add_epi32(delta2, delta2));
+    __m128i xr = _mm_sub_epi32(g, b);
+    xr = _mm_add_epi32(xr, _mm_and_si128(_mm_srai_epi32(xr, 31), delta6));
+    __m128i xg = _mm_add_epi32(_mm_sub_epi32(b, r), delta2);
+    __m128i xb = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_add_epi32(delta2, delta2));
+    __m128i x = _mm_blendv_epi8(xb, xg, _mm_cmpeq_epi32(max, g));
+    x = _mm_blendv_epi8(x, xr, _mm_cmpeq_epi32(max, r));
+
+    //  h = (256 * x + 3 * delta) / (6 * delta)
+    //  When delta is zero, so is x. Divide by 1 instead.
+    __m128i h = _mm_add_epi32(_mm_slli_epi32(x, 8), _mm_add_epi32(delta, delta2));
+    h = _mm_cvttps_epi32(_mm_div_ps(
+        _mm_cvtepi32_ps(h),
+        _mm_cvtepi32_ps(_mm_max_epi32(delta6, _mm_set1_epi32(1)))
+    ));
+    h = _mm_and_si128(h, BYTE);
+
+    pixel = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(h, 16));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(s, 8));
+    pixel = _mm_or_si128(pixel, max);
+    return pixel;
+}
+
+
+
+}
+}
+#endif
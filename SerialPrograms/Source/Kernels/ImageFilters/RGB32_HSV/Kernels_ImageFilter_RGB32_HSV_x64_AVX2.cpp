@@ -0,0 +1,50 @@
+/*  Image Filters RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels/PartialWordAccess/Kernels_PartialWordAccess_x64_AVX2.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX2.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+class Rgb32ToHsv32_x64_AVX2{
+public:
+    static const size_t VECTOR_SIZE = 8;
+    using Mask = PartialWordAccess32_x64_AVX2;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m256i pixel = _mm256_loadu_si256((const __m256i*)in);
+        _mm256_storeu_si256((__m256i*)out, rgb32_to_hsv32_x64_AVX2(pixel));
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, const Mask& mask){
+        __m256i pixel = mask.load_i32(in);
+        mask.store(out, rgb32_to_hsv32_x64_AVX2(pixel));
+    }
+};
+
+
+
+void convert_rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    Rgb32ToHsv32_x64_AVX2 converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
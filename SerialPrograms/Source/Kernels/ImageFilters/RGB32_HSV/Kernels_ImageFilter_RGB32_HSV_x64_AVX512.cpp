@@ -0,0 +1,50 @@
+/*  Image Filters RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines_x64_AVX512.h"
+#include "Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX512.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+class Rgb32ToHsv32_x64_AVX512{
+public:
+    static const size_t VECTOR_SIZE = 16;
+    using Mask = PartialWordMask_x64_AVX512;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m512i pixel = _mm512_loadu_si512((const __m512i*)in);
+        _mm512_storeu_si512((__m512i*)out, rgb32_to_hsv32_x64_AVX512(pixel));
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, const Mask& mask){
+        __m512i pixel = _mm512_maskz_loadu_epi32(mask.m, in);
+        _mm512_mask_storeu_epi32(out, mask.m, rgb32_to_hsv32_x64_AVX512(pixel));
+    }
+};
+
+
+
+void convert_rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    Rgb32ToHsv32_x64_AVX512 converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,55 @@
+/*  Image Filters RGB32 to HSV32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <immintrin.h>
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines_x64_SSE42.h"
+#include "Kernels_ImageFilter_RGB32_HSV_Routines_x64_SSE42.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+class Rgb32ToHsv32_x64_SSE42{
+public:
+    static const size_t VECTOR_SIZE = 4;
+    using Mask = PartialWordMask_x64_SSE42;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m128i pixel = _mm_loadu_si128((const __m128i*)in);
+        _mm_storeu_si128((__m128i*)out, rgb32_to_hsv32_x64_SSE42(pixel));
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, const Mask& mask){
+        __m128i pixel = rgb32_to_hsv32_x64_SSE42(mask.loader.load(in));
+        size_t left = mask.left;
+        do{
+            out[0] = _mm_cvtsi128_si32(pixel);
+            pixel = _mm_srli_si128(pixel, 4);
+            out++;
+        }while(--left);
+    }
+};
+
+
+
+void convert_rgb32_to_hsv32_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    Rgb32ToHsv32_x64_SSE42 converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+
+
+
+}
+}
+#endif
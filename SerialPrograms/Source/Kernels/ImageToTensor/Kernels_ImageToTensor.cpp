@@ -0,0 +1,114 @@
+/*  Image To Tensor
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageToTensor.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void BilinearAxis::build(size_t in, size_t out){
+    index0.resize(out);
+    index1.resize(out);
+    weight.resize(out);
+    double ratio = (double)in / out;
+    for (size_t c = 0; c < out; c++){
+        double src = (c + 0.5) * ratio - 0.5;
+        if (src < 0){
+            src = 0;
+        }
+        size_t i0 = (size_t)src;
+        float w = (float)(src - i0);
+        if (i0 >= in - 1){
+            i0 = in - 1;
+            w = 0;
+        }
+        index0[c] = (uint32_t)i0;
+        index1[c] = (uint32_t)(i0 + 1 < in ? i0 + 1 : i0);
+        weight[c] = w;
+    }
+}
+void ImageToTensorPlan::prepare(size_t p_width, size_t p_height, size_t p_out_width, size_t p_out_height){
+    if (width == p_width && height == p_height && out_width == p_out_width && out_height == p_out_height){
+        return;
+    }
+    x_axis.build(p_width, p_out_width);
+    y_axis.build(p_height, p_out_height);
+    rows.resize(6 * p_out_width);
+    width = p_width;
+    height = p_height;
+    out_width = p_out_width;
+    out_height = p_out_height;
+}
+
+
+
+void resize_rgb32_to_planar_f32_Default(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    float scale
+);
+void resize_rgb32_to_planar_f32_x64_AVX2(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    float scale
+);
+
+
+
+void resize_rgb32_to_planar_f32(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    size_t width, size_t height,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    size_t out_width, size_t out_height,
+    float scale
+){
+    if (width == 0 || height == 0 || out_width == 0 || out_height == 0){
+        return;
+    }
+    plan.prepare(width, height, out_width, out_height);
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        resize_rgb32_to_planar_f32_x64_AVX2(
+            plan, image, bytes_per_row,
+            r_plane, g_plane, b_plane, plane_stride,
+            scale
+        );
+        return;
+    }
+#endif
+    resize_rgb32_to_planar_f32_Default(
+        plan, image, bytes_per_row,
+        r_plane, g_plane, b_plane, plane_stride,
+        scale
+    );
+}
+void resize_rgb32_to_planar_f32(
+    const uint32_t* image, size_t bytes_per_row,
+    size_t width, size_t height,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    size_t out_width, size_t out_height,
+    float scale
+){
+    ImageToTensorPlan plan;
+    resize_rgb32_to_planar_f32(
+        plan, image, bytes_per_row, width, height,
+        r_plane, g_plane, b_plane, plane_stride,
+        out_width, out_height,
+        scale
+    );
+}
+
+
+
+
+}
+}
@@ -0,0 +1,85 @@
+/*  Image To Tensor
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Resize an image and write it into a planar float tensor in one pass.
+ *  This is the preprocessing step of the image-based ML models.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageToTensor_H
+#define PokemonAutomation_Kernels_ImageToTensor_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Source sample positions for one axis of a bilinear resize.
+struct BilinearAxis{
+    std::vector<uint32_t> index0;
+    std::vector<uint32_t> index1;
+    std::vector<float> weight;  //  Weight of the sample at "index1".
+
+    void build(size_t in, size_t out);
+};
+
+//  The sample positions and row buffers of a resize. They only depend on the
+//  input and output sizes. Callers that resize many frames of the same size
+//  should keep one of these around and pass it to every call.
+struct ImageToTensorPlan{
+    size_t width = 0;
+    size_t height = 0;
+    size_t out_width = 0;
+    size_t out_height = 0;
+
+    BilinearAxis x_axis;
+    BilinearAxis y_axis;
+
+    //  Two horizontally resized rows. Each is 3 * out_width floats.
+    std::vector<float> rows;
+
+    //  Rebuild the plan for these sizes. Does nothing if they are unchanged.
+    void prepare(size_t width, size_t height, size_t out_width, size_t out_height);
+};
+
+
+//  Resize "image" to "out_width" x "out_height" with bilinear interpolation
+//  (same sampling grid as cv::INTER_LINEAR), multiply every channel by "scale"
+//  and write the R, G and B channels into the separate float planes
+//  "r_plane", "g_plane" and "b_plane". The alpha channel is ignored.
+//
+//  image: each pixel is represented as uint32_t, where each of the 8 bit is
+//  used as alpha (highest bits), r, g, b (lowest bits). It is row-major;
+//  advance to next row by a step size of `bytes_per_row`.
+//
+//  The planes are row-major with "plane_stride" floats per row. They may point
+//  into the middle of a larger tensor. Only the "out_width" x "out_height"
+//  rectangle is written.
+//
+//  "plan" is rebuilt only when the sizes differ from the previous call.
+void resize_rgb32_to_planar_f32(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    size_t width, size_t height,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    size_t out_width, size_t out_height,
+    float scale
+);
+
+//  Same as above with a temporary plan.
+void resize_rgb32_to_planar_f32(
+    const uint32_t* image, size_t bytes_per_row,
+    size_t width, size_t height,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    size_t out_width, size_t out_height,
+    float scale
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,62 @@
+/*  Image To Tensor (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Kernels_ImageToTensor_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageToTensor_Default{
+    static void horizontal(float* rgb, const uint32_t* row, const BilinearAxis& axis, size_t width){
+        float* r = rgb;
+        float* g = r + width;
+        float* b = g + width;
+        for (size_t c = 0; c < width; c++){
+            uint32_t p0 = row[axis.index0[c]];
+            uint32_t p1 = row[axis.index1[c]];
+            float w = axis.weight[c];
+            float r0 = (float)((p0 >> 16) & 0xff);
+            float g0 = (float)((p0 >>  8) & 0xff);
+            float b0 = (float)((p0 >>  0) & 0xff);
+            float r1 = (float)((p1 >> 16) & 0xff);
+            float g1 = (float)((p1 >>  8) & 0xff);
+            float b1 = (float)((p1 >>  0) & 0xff);
+            r[c] = r0 + (r1 - r0) * w;
+            g[c] = g0 + (g1 - g0) * w;
+            b[c] = b0 + (b1 - b0) * w;
+        }
+    }
+    static void vertical(float* out[3], const float* top, const float* bottom, float weight, float scale, size_t width){
+        for (size_t ch = 0; ch < 3; ch++){
+            float* dst = out[ch];
+            for (size_t c = 0; c < width; c++){
+                float t = top[c];
+                dst[c] = (t + (bottom[c] - t) * weight) * scale;
+            }
+            top += width;
+            bottom += width;
+        }
+    }
+};
+
+
+void resize_rgb32_to_planar_f32_Default(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    float scale
+){
+    resize_rgb32_to_planar_f32<ImageToTensor_Default>(
+        plan, image, bytes_per_row,
+        r_plane, g_plane, b_plane, plane_stride,
+        scale
+    );
+}
+
+
+}
+}
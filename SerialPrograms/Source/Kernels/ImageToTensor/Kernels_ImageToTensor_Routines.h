@@ -0,0 +1,83 @@
+/*  Image To Tensor Routines
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  The resize is done separably. Each source row that is needed is
+ *  interpolated horizontally into a planar float row. Each output row is then
+ *  a vertical blend of two of these rows. Consecutive output rows usually
+ *  share source rows, so the last two horizontal rows are kept around.
+ *  The sample positions and the row buffers come from an ImageToTensorPlan.
+ *
+ *  The per-arch "Resizer" implements the two row operations:
+ *
+ *      void horizontal(float* rgb, const uint32_t* row, const BilinearAxis& axis, size_t width);
+ *      void vertical(float* out[3], const float* top, const float* bottom, float weight, float scale, size_t width);
+ *
+ *  "rgb" and "top"/"bottom" hold the R, G and B rows back-to-back. Each is
+ *  "width" floats long.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageToTensor_Routines_H
+#define PokemonAutomation_Kernels_ImageToTensor_Routines_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <utility>
+#include "Kernels_ImageToTensor.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  "plan" must already be prepared for the sizes of this resize.
+template <typename Resizer>
+void resize_rgb32_to_planar_f32(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    float scale
+){
+    const size_t out_width = plan.out_width;
+    const size_t out_height = plan.out_height;
+    const BilinearAxis& x_axis = plan.x_axis;
+    const BilinearAxis& y_axis = plan.y_axis;
+
+    float* row0 = plan.rows.data();
+    float* row1 = row0 + 3 * out_width;
+    size_t cached0 = (size_t)-1;
+    size_t cached1 = (size_t)-1;
+
+    for (size_t r = 0; r < out_height; r++){
+        size_t y0 = y_axis.index0[r];
+        size_t y1 = y_axis.index1[r];
+
+        if (cached0 != y0){
+            if (cached1 == y0){
+                std::swap(row0, row1);
+                std::swap(cached0, cached1);
+            }else{
+                const uint32_t* src = (const uint32_t*)((const char*)image + y0 * bytes_per_row);
+                Resizer::horizontal(row0, src, x_axis, out_width);
+                cached0 = y0;
+            }
+        }
+        if (cached1 != y1){
+            const uint32_t* src = (const uint32_t*)((const char*)image + y1 * bytes_per_row);
+            Resizer::horizontal(row1, src, x_axis, out_width);
+            cached1 = y1;
+        }
+
+        float* out[3] = {
+            r_plane + r * plane_stride,
+            g_plane + r * plane_stride,
+            b_plane + r * plane_stride,
+        };
+        Resizer::vertical(out, row0, row1, y_axis.weight[r], scale, out_width);
+    }
+}
+
+
+}
+}
+#endif
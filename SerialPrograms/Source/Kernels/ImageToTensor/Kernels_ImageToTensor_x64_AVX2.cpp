@@ -0,0 +1,108 @@
+/*  Image To Tensor (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_ImageToTensor_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct ImageToTensor_x64_AVX2{
+    static PA_FORCE_INLINE __m256 channel(__m256i pixels, int shift){
+        __m256i v = _mm256_srli_epi32(pixels, shift);
+        v = _mm256_and_si256(v, _mm256_set1_epi32(0xff));
+        return _mm256_cvtepi32_ps(v);
+    }
+
+    static void horizontal(float* rgb, const uint32_t* row, const BilinearAxis& axis, size_t width){
+        float* r = rgb;
+        float* g = r + width;
+        float* b = g + width;
+
+        const int* pixels = (const int*)row;
+        size_t c = 0;
+        for (; c + 8 <= width; c += 8){
+            __m256i i0 = _mm256_loadu_si256((const __m256i*)(axis.index0.data() + c));
+            __m256i i1 = _mm256_loadu_si256((const __m256i*)(axis.index1.data() + c));
+            __m256 w = _mm256_loadu_ps(axis.weight.data() + c);
+
+            __m256i p0 = _mm256_i32gather_epi32(pixels, i0, 4);
+            __m256i p1 = _mm256_i32gather_epi32(pixels, i1, 4);
+
+            __m256 v0, v1;
+
+            v0 = channel(p0, 16);
+            v1 = channel(p1, 16);
+            _mm256_storeu_ps(r + c, _mm256_fmadd_ps(_mm256_sub_ps(v1, v0), w, v0));
+
+            v0 = channel(p0, 8);
+            v1 = channel(p1, 8);
+            _mm256_storeu_ps(g + c, _mm256_fmadd_ps(_mm256_sub_ps(v1, v0), w, v0));
+
+            v0 = channel(p0, 0);
+            v1 = channel(p1, 0);
+            _mm256_storeu_ps(b + c, _mm256_fmadd_ps(_mm256_sub_ps(v1, v0), w, v0));
+        }
+        for (; c < width; c++){
+            uint32_t p0 = row[axis.index0[c]];
+            uint32_t p1 = row[axis.index1[c]];
+            float w = axis.weight[c];
+            float r0 = (float)((p0 >> 16) & 0xff);
+            float g0 = (float)((p0 >>  8) & 0xff);
+            float b0 = (float)((p0 >>  0) & 0xff);
+            float r1 = (float)((p1 >> 16) & 0xff);
+            float g1 = (float)((p1 >>  8) & 0xff);
+            float b1 = (float)((p1 >>  0) & 0xff);
+            r[c] = r0 + (r1 - r0) * w;
+            g[c] = g0 + (g1 - g0) * w;
+            b[c] = b0 + (b1 - b0) * w;
+        }
+    }
+    static void vertical(float* out[3], const float* top, const float* bottom, float weight, float scale, size_t width){
+        //  (t + (b - t) * w) * s  =  t * (1 - w) * s  +  b * w * s
+        float top_scale = (1 - weight) * scale;
+        float bottom_scale = weight * scale;
+        __m256 ts = _mm256_set1_ps(top_scale);
+        __m256 bs = _mm256_set1_ps(bottom_scale);
+        for (size_t ch = 0; ch < 3; ch++){
+            float* dst = out[ch];
+            size_t c = 0;
+            for (; c + 8 <= width; c += 8){
+                __m256 t = _mm256_loadu_ps(top + c);
+                __m256 b = _mm256_loadu_ps(bottom + c);
+                _mm256_storeu_ps(dst + c, _mm256_fmadd_ps(b, bs, _mm256_mul_ps(t, ts)));
+            }
+            for (; c < width; c++){
+                dst[c] = top[c] * top_scale + bottom[c] * bottom_scale;
+            }
+            top += width;
+            bottom += width;
+        }
+    }
+};
+
+
+void resize_rgb32_to_planar_f32_x64_AVX2(
+    ImageToTensorPlan& plan,
+    const uint32_t* image, size_t bytes_per_row,
+    float* r_plane, float* g_plane, float* b_plane, size_t plane_stride,
+    float scale
+){
+    resize_rgb32_to_planar_f32<ImageToTensor_x64_AVX2>(
+        plan, image, bytes_per_row,
+        r_plane, g_plane, b_plane, plane_stride,
+        scale
+    );
+}
+
+
+}
+}
+#endif
@@ -71,6 +71,40 @@ float compute_scale(
 
 
 
+void compute_dot_rows_Default          (size_t width, size_t height, float* AT, const float* A, float const* const* T);
+void compute_dot_rows_min4_x86_SSE     (size_t width, size_t height, float* AT, const float* A, float const* const* T);
+void compute_dot_rows_min8_x86_AVX2    (size_t width, size_t height, float* AT, const float* A, float const* const* T);
+void compute_dot_rows_min16_x86_AVX512 (size_t width, size_t height, float* AT, const float* A, float const* const* T);
+
+void compute_dot_rows(
+    size_t width, size_t height,
+    float* AT,
+    const float* A,
+    float const* const* T
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (width >= 16 && CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        compute_dot_rows_min16_x86_AVX512(width, height, AT, A, T);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (width >= 8 && CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        compute_dot_rows_min8_x86_AVX2(width, height, AT, A, T);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (width >= 4 && CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        compute_dot_rows_min4_x86_SSE(width, height, AT, A, T);
+        return;
+    }
+#endif
+    compute_dot_rows_Default(width, height, AT, A, T);
+}
+
+
+
 float compute_error_Default         (size_t width, size_t height, float scale, float const* const* A, float const* const* T);
 float compute_error_min4_x86_SSE    (size_t width, size_t height, float scale, float const* const* A, float const* const* T);
 float compute_error_min8_x86_AVX2   (size_t width, size_t height, float scale, float const* const* A, float const* const* T);
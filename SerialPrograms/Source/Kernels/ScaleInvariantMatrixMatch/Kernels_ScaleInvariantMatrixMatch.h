@@ -32,6 +32,17 @@ float compute_scale(
 
 
 
+//  For each row r: AT[r] = dot(A, T[r])
+//      All pointers must have the same alignment.
+void compute_dot_rows(
+    size_t width, size_t height,
+    float* AT,
+    const float* A,
+    float const* const* T
+);
+
+
+
 //  Compute: |s A - T|^2
 //      All pointers must have the same alignment.
 float compute_error(
@@ -91,6 +91,14 @@ float compute_scale_Default(
 ){
     return compute_scale<SumATA2<Context_x86_SSE41>>(width, height, A, TW, W);
 }
+void compute_dot_rows_Default(
+    size_t width, size_t height,
+    float* AT,
+    const float* A,
+    float const* const* T
+){
+    compute_dot_rows<SumATA2<Context_x86_SSE41>>(width, height, AT, A, T);
+}
 float compute_error_Default(
     size_t width, size_t height,
     float scale,
@@ -98,6 +98,14 @@ float compute_scale_min16_x86_AVX512(
 ){
     return compute_scale<SumATA2<Context_x86_AVX512>>(width, height, A, TW, W);
 }
+void compute_dot_rows_min16_x86_AVX512(
+    size_t width, size_t height,
+    float* AT,
+    const float* A,
+    float const* const* T
+){
+    compute_dot_rows<SumATA2<Context_x86_AVX512>>(width, height, AT, A, T);
+}
 float compute_error_min16_x86_AVX512(
     size_t width, size_t height,
     float scale,
@@ -28,6 +28,9 @@ struct SumATA2{
     PA_FORCE_INLINE float scale() const{
         return Context::vreduce(sum_AT) / Context::vreduce(sum_A2);
     }
+    PA_FORCE_INLINE float dot() const{
+        return Context::vreduce(sum_AT);
+    }
 
     PA_FORCE_INLINE void accumulate(size_t length, const float* A, const float* T){
         vtype sum_as0 = Context::vzero();
@@ -397,6 +400,26 @@ PA_FORCE_INLINE float compute_scale(
 }
 
 
+template <typename SumATA2>
+PA_FORCE_INLINE void compute_dot_rows(
+    size_t width, size_t height,
+    float* AT,
+    const float* A,
+    float const* const* T
+){
+    constexpr size_t ALIGNMENT = alignof(typename SumATA2::vtype);
+    for (size_t r = 0; r < height; r++){
+        const float* ptrT = T[r];
+        if ((size_t)A % ALIGNMENT != (size_t)ptrT % ALIGNMENT){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "A and T must have the same alignment.");
+        }
+        SumATA2 sum;
+        sum.accumulate(width, A, ptrT);
+        AT[r] = sum.dot();
+    }
+}
+
+
 template <typename SumError>
 PA_FORCE_INLINE float compute_error(
     size_t width, size_t height,
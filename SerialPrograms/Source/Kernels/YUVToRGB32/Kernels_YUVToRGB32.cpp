@@ -0,0 +1,275 @@
+/*  YUV To RGB32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_YUVToRGB32.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+YUVToRGB32Coefficients YUVToRGB32Coefficients::make(bool bt709, bool full_range){
+    const double kr = bt709 ? 0.2126 : 0.299;
+    const double kb = bt709 ? 0.0722 : 0.114;
+    const double kg = 1 - kr - kb;
+
+    const double y_scale = full_range ? 1.0 : 255. / 219;
+    const double c_scale = full_range ? 1.0 : 255. / 224;
+
+    auto fixed = [](double x){
+        return (int16_t)std::lround(x * 4096);
+    };
+
+    YUVToRGB32Coefficients ret;
+    ret.y_offset = full_range ? 0 : 16;
+    ret.y   = fixed(y_scale);
+    ret.r_v = fixed(2 * (1 - kr) * c_scale);
+    ret.g_u = fixed(-2 * (1 - kb) * kb / kg * c_scale);
+    ret.g_v = fixed(-2 * (1 - kr) * kr / kg * c_scale);
+    ret.b_u = fixed(2 * (1 - kb) * c_scale);
+    return ret;
+}
+
+
+
+void convert_nv12_to_rgb32_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_nv12_to_rgb32_x64_AVX512(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_nv12_to_rgb32_x64_AVX2(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_nv12_to_rgb32_arm64_NEON(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_nv12_to_rgb32(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_nv12_to_rgb32_x64_AVX512(
+            coefficients, width, height,
+            y_plane, y_bytes_per_row,
+            uv_plane, uv_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_nv12_to_rgb32_x64_AVX2(
+            coefficients, width, height,
+            y_plane, y_bytes_per_row,
+            uv_plane, uv_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_nv12_to_rgb32_arm64_NEON(
+            coefficients, width, height,
+            y_plane, y_bytes_per_row,
+            uv_plane, uv_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+    convert_nv12_to_rgb32_Default(
+        coefficients, width, height,
+        y_plane, y_bytes_per_row,
+        uv_plane, uv_bytes_per_row,
+        image, bytes_per_row
+    );
+}
+
+
+
+void convert_yuv420p_to_rgb32_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuv420p_to_rgb32_x64_AVX512(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuv420p_to_rgb32_x64_AVX2(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuv420p_to_rgb32_arm64_NEON(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuv420p_to_rgb32(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_yuv420p_to_rgb32_x64_AVX512(
+            coefficients, width, height,
+            y_plane, y_bytes_per_row,
+            u_plane, u_bytes_per_row,
+            v_plane, v_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_yuv420p_to_rgb32_x64_AVX2(
+            coefficients, width, height,
+            y_plane, y_bytes_per_row,
+            u_plane, u_bytes_per_row,
+            v_plane, v_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_yuv420p_to_rgb32_arm64_NEON(
+            coefficients, width, height,
+            y_plane, y_bytes_per_row,
+            u_plane, u_bytes_per_row,
+            v_plane, v_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+    convert_yuv420p_to_rgb32_Default(
+        coefficients, width, height,
+        y_plane, y_bytes_per_row,
+        u_plane, u_bytes_per_row,
+        v_plane, v_bytes_per_row,
+        image, bytes_per_row
+    );
+}
+
+
+
+void convert_yuyv_to_rgb32_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuyv_to_rgb32_x64_AVX512(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuyv_to_rgb32_x64_AVX2(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuyv_to_rgb32_arm64_NEON(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+void convert_yuyv_to_rgb32(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        convert_yuyv_to_rgb32_x64_AVX512(
+            coefficients, width, height,
+            yuyv, yuyv_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_yuyv_to_rgb32_x64_AVX2(
+            coefficients, width, height,
+            yuyv, yuyv_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        convert_yuyv_to_rgb32_arm64_NEON(
+            coefficients, width, height,
+            yuyv, yuyv_bytes_per_row,
+            image, bytes_per_row
+        );
+        return;
+    }
+#endif
+    convert_yuyv_to_rgb32_Default(
+        coefficients, width, height,
+        yuyv, yuyv_bytes_per_row,
+        image, bytes_per_row
+    );
+}
+
+
+
+
+}
+}
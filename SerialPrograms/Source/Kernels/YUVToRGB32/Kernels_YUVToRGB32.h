@@ -0,0 +1,73 @@
+/*  YUV To RGB32
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Convert the raw YUV layouts that capture cards deliver directly into an
+ *  ARGB32 image. This is the first step of every video snapshot.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_YUVToRGB32_H
+#define PokemonAutomation_Kernels_YUVToRGB32_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Fixed-point (12 fractional bits) YUV -> RGB matrix.
+//  The chroma coefficients are applied to (U - 128) and (V - 128).
+struct YUVToRGB32Coefficients{
+    int16_t y_offset;
+    int16_t y;
+    int16_t r_v;
+    int16_t g_u;
+    int16_t g_v;
+    int16_t b_u;
+
+    //  bt709 = false means BT.601.
+    //  full_range = false means the video (16 - 235) range.
+    static YUVToRGB32Coefficients make(bool bt709, bool full_range);
+};
+
+
+//  All of these write "width" x "height" ARGB32 pixels (alpha = 255) into
+//  "image", which is row-major with "bytes_per_row" bytes per row.
+//  Odd widths and heights are fine. The last chroma sample covers the last
+//  pixel.
+
+//  NV12: Full resolution Y plane. Half resolution (both directions)
+//  interleaved UV plane.
+void convert_nv12_to_rgb32(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+
+//  YUV420P: Full resolution Y plane. Half resolution (both directions)
+//  separate U and V planes.
+void convert_yuv420p_to_rgb32(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+
+//  YUYV: Single packed plane. Each pair of pixels is "Y0 U Y1 V".
+void convert_yuyv_to_rgb32(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+);
+
+
+}
+}
+#endif
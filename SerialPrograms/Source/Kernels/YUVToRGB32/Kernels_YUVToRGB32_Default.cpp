@@ -0,0 +1,64 @@
+/*  YUV To RGB32 (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Kernels_YUVToRGB32_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void convert_nv12_to_rgb32_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        convert_nv12_row_Default(
+            coefficients, 0, width,
+            y_plane + r * y_bytes_per_row,
+            uv_plane + r / 2 * uv_bytes_per_row,
+            (uint32_t*)((char*)image + r * bytes_per_row)
+        );
+    }
+}
+void convert_yuv420p_to_rgb32_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        convert_yuv420p_row_Default(
+            coefficients, 0, width,
+            y_plane + r * y_bytes_per_row,
+            u_plane + r / 2 * u_bytes_per_row,
+            v_plane + r / 2 * v_bytes_per_row,
+            (uint32_t*)((char*)image + r * bytes_per_row)
+        );
+    }
+}
+void convert_yuyv_to_rgb32_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        convert_yuyv_row_Default(
+            coefficients, 0, width,
+            yuyv + r * yuyv_bytes_per_row,
+            (uint32_t*)((char*)image + r * bytes_per_row)
+        );
+    }
+}
+
+
+}
+}
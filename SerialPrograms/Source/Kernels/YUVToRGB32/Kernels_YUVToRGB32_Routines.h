@@ -0,0 +1,80 @@
+/*  YUV To RGB32 Routines
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Scalar pieces shared by all the YUV -> RGB32 implementations. The SIMD
+ *  versions use these for the ends of rows so that every implementation
+ *  gives exactly the same output.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_YUVToRGB32_Routines_H
+#define PokemonAutomation_Kernels_YUVToRGB32_Routines_H
+
+#include "Common/Compiler.h"
+#include "Kernels_YUVToRGB32.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint32_t yuv_to_rgb32_clamp(int x){
+    return x < 0 ? 0 : x > 255 ? 255 : (uint32_t)x;
+}
+PA_FORCE_INLINE uint32_t yuv_to_rgb32_pixel(
+    const YUVToRGB32Coefficients& coefficients,
+    int y, int u, int v
+){
+    const YUVToRGB32Coefficients& c = coefficients;
+    int luma = (y - c.y_offset) * c.y + 2048;
+    u -= 128;
+    v -= 128;
+    int r = (luma + c.r_v * v) >> 12;
+    int g = (luma + c.g_u * u + c.g_v * v) >> 12;
+    int b = (luma + c.b_u * u) >> 12;
+    return 0xff000000
+        | (yuv_to_rgb32_clamp(r) << 16)
+        | (yuv_to_rgb32_clamp(g) << 8)
+        | yuv_to_rgb32_clamp(b);
+}
+
+
+//  Convert pixels [start, width) of one row.
+
+PA_FORCE_INLINE void convert_nv12_row_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t start, size_t width,
+    const uint8_t* y_row, const uint8_t* uv_row,
+    uint32_t* out
+){
+    for (size_t x = start; x < width; x++){
+        const uint8_t* uv = uv_row + (x & ~(size_t)1);
+        out[x] = yuv_to_rgb32_pixel(coefficients, y_row[x], uv[0], uv[1]);
+    }
+}
+PA_FORCE_INLINE void convert_yuv420p_row_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t start, size_t width,
+    const uint8_t* y_row, const uint8_t* u_row, const uint8_t* v_row,
+    uint32_t* out
+){
+    for (size_t x = start; x < width; x++){
+        out[x] = yuv_to_rgb32_pixel(coefficients, y_row[x], u_row[x / 2], v_row[x / 2]);
+    }
+}
+PA_FORCE_INLINE void convert_yuyv_row_Default(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t start, size_t width,
+    const uint8_t* yuyv_row,
+    uint32_t* out
+){
+    for (size_t x = start; x < width; x++){
+        const uint8_t* pair = yuyv_row + 2 * (x & ~(size_t)1);
+        out[x] = yuv_to_rgb32_pixel(coefficients, yuyv_row[2 * x], pair[1], pair[3]);
+    }
+}
+
+
+}
+}
+#endif
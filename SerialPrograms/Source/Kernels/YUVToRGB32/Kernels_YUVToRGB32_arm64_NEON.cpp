@@ -0,0 +1,162 @@
+/*  YUV To RGB32 (arm64 NEON)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <arm_neon.h>
+#include "Common/Compiler.h"
+#include "Kernels_YUVToRGB32_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//
+//  16 pixels at a time.
+//
+//  "y" is the 16 luma bytes. "u" and "v" are the 8 chroma samples for them.
+//  (one per 2 pixels) The final store interleaves the channels into B G R A
+//  bytes, so the channels never need to be packed together.
+//
+class YUVToRGB32_arm64_NEON{
+public:
+    YUVToRGB32_arm64_NEON(const YUVToRGB32Coefficients& coefficients)
+        : m_y_offset(vdupq_n_s16(coefficients.y_offset))
+        , m_uv_offset(vdupq_n_s16(128))
+        , m_round(vdupq_n_s32(2048))
+        , m_y(coefficients.y)
+        , m_r_v(coefficients.r_v)
+        , m_g_u(coefficients.g_u)
+        , m_g_v(coefficients.g_v)
+        , m_b_u(coefficients.b_u)
+    {}
+
+    PA_FORCE_INLINE void convert16(uint32_t* out, uint8x16_t y, uint8x8_t u, uint8x8_t v) const{
+        int16x8_t u16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(u)), m_uv_offset);
+        int16x8_t v16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(v)), m_uv_offset);
+
+        uint8x8_t r0, g0, b0, r1, g1, b1;
+        convert8(r0, g0, b0, vget_low_u8(y), vget_low_s16(u16), vget_low_s16(v16));
+        convert8(r1, g1, b1, vget_high_u8(y), vget_high_s16(u16), vget_high_s16(v16));
+
+        uint8x16x4_t pixels;
+        pixels.val[0] = vcombine_u8(b0, b1);
+        pixels.val[1] = vcombine_u8(g0, g1);
+        pixels.val[2] = vcombine_u8(r0, r1);
+        pixels.val[3] = vdupq_n_u8(255);
+        vst4q_u8((uint8_t*)out, pixels);
+    }
+
+private:
+    //  8 pixels with their 4 chroma samples.
+    PA_FORCE_INLINE void convert8(
+        uint8x8_t& r, uint8x8_t& g, uint8x8_t& b,
+        uint8x8_t y, int16x4_t u, int16x4_t v
+    ) const{
+        int16x8_t y16 = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(y)), m_y_offset);
+
+        //  (y - offset) * Y + rounding, as int32.
+        int32x4_t luma_lo = vmlal_n_s16(m_round, vget_low_s16(y16), m_y);
+        int32x4_t luma_hi = vmlal_n_s16(m_round, vget_high_s16(y16), m_y);
+
+        r = channel(luma_lo, luma_hi, vmull_n_s16(v, m_r_v));
+        g = channel(luma_lo, luma_hi, vmlal_n_s16(vmull_n_s16(u, m_g_u), v, m_g_v));
+        b = channel(luma_lo, luma_hi, vmull_n_s16(u, m_b_u));
+    }
+
+    //  Add the chroma term (one per 2 pixels) to the luma and narrow to 8
+    //  bytes with saturation.
+    static PA_FORCE_INLINE uint8x8_t channel(int32x4_t luma_lo, int32x4_t luma_hi, int32x4_t chroma){
+        int32x4_t lo = vaddq_s32(luma_lo, vzip1q_s32(chroma, chroma));
+        int32x4_t hi = vaddq_s32(luma_hi, vzip2q_s32(chroma, chroma));
+        return vqmovun_s16(vcombine_s16(vqshrn_n_s32(lo, 12), vqshrn_n_s32(hi, 12)));
+    }
+
+private:
+    const int16x8_t m_y_offset;
+    const int16x8_t m_uv_offset;
+    const int32x4_t m_round;
+    const int16_t m_y;
+    const int16_t m_r_v;
+    const int16_t m_g_u;
+    const int16_t m_g_v;
+    const int16_t m_b_u;
+};
+
+
+
+void convert_nv12_to_rgb32_arm64_NEON(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_arm64_NEON converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y_row = y_plane + r * y_bytes_per_row;
+        const uint8_t* uv_row = uv_plane + r / 2 * uv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 16 <= width; x += 16){
+            uint8x8x2_t uv = vld2_u8(uv_row + x);
+            converter.convert16(out + x, vld1q_u8(y_row + x), uv.val[0], uv.val[1]);
+        }
+        convert_nv12_row_Default(coefficients, x, width, y_row, uv_row, out);
+    }
+}
+void convert_yuv420p_to_rgb32_arm64_NEON(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_arm64_NEON converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y_row = y_plane + r * y_bytes_per_row;
+        const uint8_t* u_row = u_plane + r / 2 * u_bytes_per_row;
+        const uint8_t* v_row = v_plane + r / 2 * v_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 16 <= width; x += 16){
+            converter.convert16(
+                out + x, vld1q_u8(y_row + x),
+                vld1_u8(u_row + x / 2), vld1_u8(v_row + x / 2)
+            );
+        }
+        convert_yuv420p_row_Default(coefficients, x, width, y_row, u_row, v_row, out);
+    }
+}
+void convert_yuyv_to_rgb32_arm64_NEON(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_arm64_NEON converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* row = yuyv + r * yuyv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 16 <= width; x += 16){
+            //  Y0 U Y1 V -> even lumas, U, odd lumas, V.
+            uint8x8x4_t pixels = vld4_u8(row + 2 * x);
+            uint8x16_t y = vcombine_u8(
+                vzip1_u8(pixels.val[0], pixels.val[2]),
+                vzip2_u8(pixels.val[0], pixels.val[2])
+            );
+            converter.convert16(out + x, y, pixels.val[1], pixels.val[3]);
+        }
+        convert_yuyv_row_Default(coefficients, x, width, row, out);
+    }
+}
+
+
+}
+}
+#endif
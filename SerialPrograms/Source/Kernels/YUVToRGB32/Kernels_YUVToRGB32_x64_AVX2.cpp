@@ -0,0 +1,157 @@
+/*  YUV To RGB32 (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_YUVToRGB32_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//
+//  16 pixels at a time.
+//
+//  "y" is 16 x int16 luma with pixels 0-7 in the low lane and 8-15 in the high
+//  lane. "uv" is 8 interleaved (U, V) int16 pairs laid out the same way. (the
+//  4 pairs for pixels 0-7 in the low lane)
+//
+//  Everything below stays within 128-bit lanes, so the in-lane unpacks and
+//  packs line up with each other. Only the final store fixes up the lanes.
+//
+class YUVToRGB32_x64_AVX2{
+public:
+    YUVToRGB32_x64_AVX2(const YUVToRGB32Coefficients& coefficients)
+        : m_y_offset(_mm256_set1_epi16(coefficients.y_offset))
+        , m_uv_offset(_mm256_set1_epi16(128))
+        , m_y_round(_mm256_set1_epi32((2048 << 16) | (uint16_t)coefficients.y))
+        , m_r_uv(_mm256_set1_epi32((uint32_t)(uint16_t)coefficients.r_v << 16))
+        , m_g_uv(_mm256_set1_epi32(((uint32_t)(uint16_t)coefficients.g_v << 16) | (uint16_t)coefficients.g_u))
+        , m_b_uv(_mm256_set1_epi32((uint16_t)coefficients.b_u))
+    {}
+
+    PA_FORCE_INLINE void convert16(uint32_t* out, __m256i y, __m256i uv) const{
+        y = _mm256_sub_epi16(y, m_y_offset);
+        uv = _mm256_sub_epi16(uv, m_uv_offset);
+
+        //  (y - offset) * Y + rounding, as int32.
+        const __m256i ones = _mm256_set1_epi16(1);
+        __m256i luma_lo = _mm256_madd_epi16(_mm256_unpacklo_epi16(y, ones), m_y_round);
+        __m256i luma_hi = _mm256_madd_epi16(_mm256_unpackhi_epi16(y, ones), m_y_round);
+
+        __m256i r = channel(luma_lo, luma_hi, _mm256_madd_epi16(uv, m_r_uv));
+        __m256i g = channel(luma_lo, luma_hi, _mm256_madd_epi16(uv, m_g_uv));
+        __m256i b = channel(luma_lo, luma_hi, _mm256_madd_epi16(uv, m_b_uv));
+
+        //  Interleave into B G R A bytes.
+        __m256i br = _mm256_packus_epi16(b, r);
+        __m256i ga = _mm256_packus_epi16(g, _mm256_set1_epi16(255));
+        __m256i bg = _mm256_unpacklo_epi8(br, ga);
+        __m256i ra = _mm256_unpackhi_epi8(br, ga);
+        __m256i p0 = _mm256_unpacklo_epi16(bg, ra);     //  Pixels 0-3, 8-11
+        __m256i p1 = _mm256_unpackhi_epi16(bg, ra);     //  Pixels 4-7, 12-15
+
+        _mm256_storeu_si256((__m256i*)out + 0, _mm256_permute2x128_si256(p0, p1, 0x20));
+        _mm256_storeu_si256((__m256i*)out + 1, _mm256_permute2x128_si256(p0, p1, 0x31));
+    }
+
+private:
+    //  Add the chroma term (one per 2 pixels) to the luma and narrow to 16
+    //  int16 with saturation.
+    static PA_FORCE_INLINE __m256i channel(__m256i luma_lo, __m256i luma_hi, __m256i chroma){
+        __m256i lo = _mm256_add_epi32(luma_lo, _mm256_unpacklo_epi32(chroma, chroma));
+        __m256i hi = _mm256_add_epi32(luma_hi, _mm256_unpackhi_epi32(chroma, chroma));
+        lo = _mm256_srai_epi32(lo, 12);
+        hi = _mm256_srai_epi32(hi, 12);
+        return _mm256_packs_epi32(lo, hi);
+    }
+
+private:
+    const __m256i m_y_offset;
+    const __m256i m_uv_offset;
+    const __m256i m_y_round;
+    const __m256i m_r_uv;
+    const __m256i m_g_uv;
+    const __m256i m_b_uv;
+};
+
+
+
+void convert_nv12_to_rgb32_x64_AVX2(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_x64_AVX2 converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y_row = y_plane + r * y_bytes_per_row;
+        const uint8_t* uv_row = uv_plane + r / 2 * uv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 16 <= width; x += 16){
+            __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y_row + x)));
+            __m256i uv = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(uv_row + x)));
+            converter.convert16(out + x, y, uv);
+        }
+        convert_nv12_row_Default(coefficients, x, width, y_row, uv_row, out);
+    }
+}
+void convert_yuv420p_to_rgb32_x64_AVX2(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_x64_AVX2 converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y_row = y_plane + r * y_bytes_per_row;
+        const uint8_t* u_row = u_plane + r / 2 * u_bytes_per_row;
+        const uint8_t* v_row = v_plane + r / 2 * v_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 16 <= width; x += 16){
+            __m256i y = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(y_row + x)));
+            __m128i u = _mm_loadl_epi64((const __m128i*)(u_row + x / 2));
+            __m128i v = _mm_loadl_epi64((const __m128i*)(v_row + x / 2));
+            __m256i uv = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(u, v));
+            converter.convert16(out + x, y, uv);
+        }
+        convert_yuv420p_row_Default(coefficients, x, width, y_row, u_row, v_row, out);
+    }
+}
+void convert_yuyv_to_rgb32_x64_AVX2(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_x64_AVX2 converter(coefficients);
+    const __m256i low_bytes = _mm256_set1_epi16(0x00ff);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* row = yuyv + r * yuyv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 16 <= width; x += 16){
+            //  32 bytes = 16 pixels. Pixels 0-7 are already in the low lane.
+            __m256i pixels = _mm256_loadu_si256((const __m256i*)(row + 2 * x));
+            __m256i y = _mm256_and_si256(pixels, low_bytes);
+            __m256i uv = _mm256_srli_epi16(pixels, 8);
+            converter.convert16(out + x, y, uv);
+        }
+        convert_yuyv_row_Default(coefficients, x, width, row, out);
+    }
+}
+
+
+}
+}
+#endif
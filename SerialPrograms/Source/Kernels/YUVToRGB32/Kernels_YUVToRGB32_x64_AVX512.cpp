@@ -0,0 +1,157 @@
+/*  YUV To RGB32 (x64 AVX512)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Common/Compiler.h"
+#include "Kernels_YUVToRGB32_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//
+//  32 pixels at a time.
+//
+//  Same layout as the AVX2 version, but with four 128-bit lanes. Lane i of
+//  "y" holds pixels 8i to 8i+7 and lane i of "uv" holds their 4 (U, V) pairs.
+//
+class YUVToRGB32_x64_AVX512{
+public:
+    YUVToRGB32_x64_AVX512(const YUVToRGB32Coefficients& coefficients)
+        : m_y_offset(_mm512_set1_epi16(coefficients.y_offset))
+        , m_uv_offset(_mm512_set1_epi16(128))
+        , m_y_round(_mm512_set1_epi32((2048 << 16) | (uint16_t)coefficients.y))
+        , m_r_uv(_mm512_set1_epi32((uint32_t)(uint16_t)coefficients.r_v << 16))
+        , m_g_uv(_mm512_set1_epi32(((uint32_t)(uint16_t)coefficients.g_v << 16) | (uint16_t)coefficients.g_u))
+        , m_b_uv(_mm512_set1_epi32((uint16_t)coefficients.b_u))
+        , m_store0(_mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11))
+        , m_store1(_mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15))
+    {}
+
+    PA_FORCE_INLINE void convert32(uint32_t* out, __m512i y, __m512i uv) const{
+        y = _mm512_sub_epi16(y, m_y_offset);
+        uv = _mm512_sub_epi16(uv, m_uv_offset);
+
+        //  (y - offset) * Y + rounding, as int32.
+        const __m512i ones = _mm512_set1_epi16(1);
+        __m512i luma_lo = _mm512_madd_epi16(_mm512_unpacklo_epi16(y, ones), m_y_round);
+        __m512i luma_hi = _mm512_madd_epi16(_mm512_unpackhi_epi16(y, ones), m_y_round);
+
+        __m512i r = channel(luma_lo, luma_hi, _mm512_madd_epi16(uv, m_r_uv));
+        __m512i g = channel(luma_lo, luma_hi, _mm512_madd_epi16(uv, m_g_uv));
+        __m512i b = channel(luma_lo, luma_hi, _mm512_madd_epi16(uv, m_b_uv));
+
+        //  Interleave into B G R A bytes.
+        __m512i br = _mm512_packus_epi16(b, r);
+        __m512i ga = _mm512_packus_epi16(g, _mm512_set1_epi16(255));
+        __m512i bg = _mm512_unpacklo_epi8(br, ga);
+        __m512i ra = _mm512_unpackhi_epi8(br, ga);
+        __m512i p0 = _mm512_unpacklo_epi16(bg, ra);     //  Pixels 0-3, 8-11, 16-19, 24-27
+        __m512i p1 = _mm512_unpackhi_epi16(bg, ra);     //  Pixels 4-7, 12-15, 20-23, 28-31
+
+        _mm512_storeu_si512((__m512i*)out + 0, _mm512_permutex2var_epi64(p0, m_store0, p1));
+        _mm512_storeu_si512((__m512i*)out + 1, _mm512_permutex2var_epi64(p0, m_store1, p1));
+    }
+
+private:
+    //  Add the chroma term (one per 2 pixels) to the luma and narrow to 32
+    //  int16 with saturation.
+    static PA_FORCE_INLINE __m512i channel(__m512i luma_lo, __m512i luma_hi, __m512i chroma){
+        __m512i lo = _mm512_add_epi32(luma_lo, _mm512_unpacklo_epi32(chroma, chroma));
+        __m512i hi = _mm512_add_epi32(luma_hi, _mm512_unpackhi_epi32(chroma, chroma));
+        lo = _mm512_srai_epi32(lo, 12);
+        hi = _mm512_srai_epi32(hi, 12);
+        return _mm512_packs_epi32(lo, hi);
+    }
+
+private:
+    const __m512i m_y_offset;
+    const __m512i m_uv_offset;
+    const __m512i m_y_round;
+    const __m512i m_r_uv;
+    const __m512i m_g_uv;
+    const __m512i m_b_uv;
+    const __m512i m_store0;
+    const __m512i m_store1;
+};
+
+
+
+void convert_nv12_to_rgb32_x64_AVX512(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* uv_plane, size_t uv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_x64_AVX512 converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y_row = y_plane + r * y_bytes_per_row;
+        const uint8_t* uv_row = uv_plane + r / 2 * uv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 32 <= width; x += 32){
+            __m512i y = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(y_row + x)));
+            __m512i uv = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(uv_row + x)));
+            converter.convert32(out + x, y, uv);
+        }
+        convert_nv12_row_Default(coefficients, x, width, y_row, uv_row, out);
+    }
+}
+void convert_yuv420p_to_rgb32_x64_AVX512(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* y_plane, size_t y_bytes_per_row,
+    const uint8_t* u_plane, size_t u_bytes_per_row,
+    const uint8_t* v_plane, size_t v_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_x64_AVX512 converter(coefficients);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* y_row = y_plane + r * y_bytes_per_row;
+        const uint8_t* u_row = u_plane + r / 2 * u_bytes_per_row;
+        const uint8_t* v_row = v_plane + r / 2 * v_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 32 <= width; x += 32){
+            __m512i y = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i*)(y_row + x)));
+            __m128i u = _mm_loadu_si128((const __m128i*)(u_row + x / 2));
+            __m128i v = _mm_loadu_si128((const __m128i*)(v_row + x / 2));
+            __m256i uv = _mm256_set_m128i(_mm_unpackhi_epi8(u, v), _mm_unpacklo_epi8(u, v));
+            converter.convert32(out + x, y, _mm512_cvtepu8_epi16(uv));
+        }
+        convert_yuv420p_row_Default(coefficients, x, width, y_row, u_row, v_row, out);
+    }
+}
+void convert_yuyv_to_rgb32_x64_AVX512(
+    const YUVToRGB32Coefficients& coefficients,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t bytes_per_row
+){
+    YUVToRGB32_x64_AVX512 converter(coefficients);
+    const __m512i low_bytes = _mm512_set1_epi16(0x00ff);
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* row = yuyv + r * yuyv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * bytes_per_row);
+        size_t x = 0;
+        for (; x + 32 <= width; x += 32){
+            //  64 bytes = 32 pixels. Each lane already holds 8 whole pixels.
+            __m512i pixels = _mm512_loadu_si512((const __m512i*)(row + 2 * x));
+            __m512i y = _mm512_and_si512(pixels, low_bytes);
+            __m512i uv = _mm512_srli_epi16(pixels, 8);
+            converter.convert32(out + x, y, uv);
+        }
+        convert_yuyv_row_Default(coefficients, x, width, row, out);
+    }
+}
+
+
+}
+}
+#endif
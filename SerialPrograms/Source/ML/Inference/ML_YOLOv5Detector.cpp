@@ -56,23 +56,14 @@ YOLOv5Detector::YOLOv5Detector(const std::string& model_path)
     m_yolo_session = std::make_unique<YOLOv5Session>(m_model_path, m_use_gpu);
 }
 
-bool YOLOv5Detector::detect(const ImageViewRGB32& screen){
-    if (!m_yolo_session){
-        return false;
-    }
-
-    cv::Mat frame_mat_bgra = screen.to_opencv_Mat();
-    cv::Mat frame_mat_rgb;
-    cv::cvtColor(frame_mat_bgra, frame_mat_rgb, cv::COLOR_BGRA2RGB);
-
-    m_output_boxes.clear();
-
+template <typename Lambda>
+void YOLOv5Detector::run_session(Lambda&& lambda){
     // fall back to CPU if fails with GPU.
     for (size_t i = 0; i < 2; i++){
         try{
             // if (m_use_gpu){ throw Ort::Exception("Testing.", ORT_FAIL); }  // to simulate GPU/CPU failure
             // If fails with GPU, fall back to CPU.
-            m_yolo_session->run(frame_mat_rgb, m_output_boxes);
+            lambda(*m_yolo_session);
             break;
         }catch (Ort::Exception& e){
             if (m_use_gpu){
@@ -92,11 +83,36 @@ bool YOLOv5Detector::detect(const ImageViewRGB32& screen){
             throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Internal Program Error: This section of code shouldn't be reachable.");
         }
     }
+}
+
+bool YOLOv5Detector::detect(const ImageViewRGB32& screen){
+    if (!m_yolo_session){
+        return false;
+    }
+
+    run_session([&](YOLOv5Session& session){
+        m_output_boxes.clear();
+        session.run(screen, m_output_boxes);
+    });
 
     // Only lock when swapping results
     return m_output_boxes.size() > 0;
 }
 
+void YOLOv5Detector::detect(
+    const std::vector<ImageViewRGB32>& screens,
+    std::vector<std::vector<DetectionBox>>& detections
+){
+    if (!m_yolo_session){
+        detections.assign(screens.size(), {});
+        return;
+    }
+
+    run_session([&](YOLOv5Session& session){
+        session.run(screens, detections);
+    });
+}
+
 const std::string& YOLOv5Detector::label_name(size_t label_idx) const{
     return m_yolo_session->label_name(label_idx);
 }
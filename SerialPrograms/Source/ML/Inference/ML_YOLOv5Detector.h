@@ -36,6 +36,12 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override {}
     virtual bool detect(const ImageViewRGB32& screen) override;
 
+    // Run the model on several screens in one session call. Useful when
+    // watching multiple consoles with the same model.
+    // `detections[i]` is overwritten with the detections of `screens[i]`.
+    // This does not touch `detected_boxes()`.
+    void detect(const std::vector<ImageViewRGB32>& screens, std::vector<std::vector<DetectionBox>>& detections);
+
     const std::vector<DetectionBox>& detected_boxes() const { return m_output_boxes; }
     std::vector<DetectionBox>& detected_boxes(){ return m_output_boxes; }
 
@@ -44,6 +50,10 @@ public:
     const std::string& label_name(size_t label_idx) const;
     size_t label_index(const std::string& label_name) const;
 
+protected:
+    template <typename Lambda>
+    void run_session(Lambda&& lambda);
+
 protected:
     std::string m_model_path;
     bool m_use_gpu;
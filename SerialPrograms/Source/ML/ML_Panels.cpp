@@ -29,6 +29,7 @@ std::vector<PanelEntry> PanelListFactory::make_panels() const{
         ret.emplace_back(make_panel<LabelImages_Descriptor, LabelImages>());
         // ret.emplace_back(make_panel<RunYOLO_Descriptor, RunYOLO>());
         ret.emplace_back(NintendoSwitch::make_single_switch_program<RunYOLO_Descriptor, RunYOLO>());
+        ret.emplace_back(NintendoSwitch::make_multi_switch_program<RunYOLOMulti_Descriptor, RunYOLOMulti>());
         // ret.emplace_back(make_single_switch_program<ThreeSegmentDudunsparceFinder_Descriptor, ThreeSegmentDudunsparceFinder>());
     }
 
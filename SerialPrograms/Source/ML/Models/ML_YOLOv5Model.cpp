@@ -15,6 +15,7 @@
 #include "3rdParty/ONNX/OnnxToolsPA.h"
 #include "CommonFramework/Globals.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "ML/Models/ML_ONNXRuntimeHelpers.h"
 #include "ML_YOLOv5Model.h"
 
@@ -93,52 +94,12 @@ std::vector<std::string> parse_yolo_metadata_names(const std::string& metadata_v
 }
 
 
-std::tuple<int, int, double, double> resize_image_with_border(
-    const cv::Mat& input_image,
-    cv::Mat& output_image,
-    int target_width, int target_height,
-    cv::Scalar border_color = cv::Scalar(0,0,0)
-){
-    int original_width = input_image.cols;
-    int original_height = input_image.rows;
-
-    double scale_x = static_cast<double>(target_width) / original_width;
-    double scale_y = static_cast<double>(target_height) / original_height;
-    double scale = std::min(scale_x, scale_y);
-
-    int new_width = static_cast<int>(original_width * scale);
-    int new_height = static_cast<int>(original_height * scale);
-    new_width = std::min(new_width, target_width);
-    new_height = std::min(new_height, target_height);
-
-    if (new_width == 0 || new_height == 0){
-        throw std::runtime_error("Input Image too small: " + std::to_string(original_width) + " x " + std::to_string(original_height));
-    }
-
-    cv::Mat resized_image;
-    cv::resize(input_image, resized_image, cv::Size(new_width, new_height), 0, 0, cv::INTER_LINEAR); // INTER_AREA for shrinking
-
-    int border_top = (target_height - new_height) / 2;
-    int border_bottom = target_height - new_height - border_top;
-    int border_left = (target_width - new_width) / 2;
-    int border_right = target_width - new_width - border_left;
-
-    cv::copyMakeBorder(resized_image, output_image, border_top, border_bottom, border_left, border_right, cv::BORDER_CONSTANT, border_color);
-
-    return std::make_tuple(
-        border_left, border_top,
-        1.0 / new_width, 1.0 / new_height
-    );
-}
-
-
 YOLOv5Session::YOLOv5Session(const std::string& model_path, bool use_gpu)
 : m_env{create_ORT_env()}
 , m_session{create_session(m_env, model_path, ML_MODEL_CACHE_PATH() + "YOLOv5", use_gpu)}
 , m_memory_info{Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeCPU)}
 , m_input_names{m_session.GetInputNames()}
 , m_output_names{m_session.GetOutputNames()}
-, m_model_input(3*YOLO5_INPUT_IMAGE_SIZE*YOLO5_INPUT_IMAGE_SIZE)
 {
     // Extract YOLO labels from model metadata
     try{
@@ -181,103 +142,221 @@ YOLOv5Session::YOLOv5Session(const std::string& model_path, bool use_gpu)
             " output labels but YOLOv5Session was initialized with " + std::to_string(m_label_names.size()) + " labels"
         );
     }
-    m_model_output.resize(YOLO5_NUM_CANDIDATES * m_output_shape[2]);
+
+    //  Models exported with a dynamic batch dimension can run a whole batch
+    //  in one call. Otherwise we feed them one image at a time.
+    std::vector<int64_t> input_dims = m_session.GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+    m_dynamic_batch = input_dims.size() == 4 && input_dims[0] < 0;
+
+    reserve_batch(1);
+}
+
+void YOLOv5Session::reserve_batch(size_t batch_size){
+    if (m_slots.size() >= batch_size){
+        return;
+    }
+    const size_t image_size = (size_t)YOLO5_INPUT_IMAGE_SIZE * YOLO5_INPUT_IMAGE_SIZE;
+    const size_t cand_size = m_label_names.size() + 5;
+    m_model_input.resize(batch_size * 3 * image_size);
+    m_model_output.resize(batch_size * YOLO5_NUM_CANDIDATES * cand_size);
+
+    //  New slots have no border yet.
+    m_slots.resize(batch_size);
 }
 
-// input: rgb color order
-void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
-    CV_Assert(input_image.depth() == CV_8U);
-    CV_Assert(input_image.channels() == 3);
+YOLOv5Session::Letterbox YOLOv5Session::letterbox(size_t width, size_t height) const{
+    double scale_x = static_cast<double>(YOLO5_INPUT_IMAGE_SIZE) / width;
+    double scale_y = static_cast<double>(YOLO5_INPUT_IMAGE_SIZE) / height;
+    double scale = std::min(scale_x, scale_y);
+
+    size_t new_width = static_cast<size_t>(width * scale);
+    size_t new_height = static_cast<size_t>(height * scale);
+    new_width = std::min<size_t>(new_width, YOLO5_INPUT_IMAGE_SIZE);
+    new_height = std::min<size_t>(new_height, YOLO5_INPUT_IMAGE_SIZE);
 
-    cv::Mat image_resized;
+    if (new_width == 0 || new_height == 0){
+        throw std::runtime_error("Input Image too small: " + std::to_string(width) + " x " + std::to_string(height));
+    }
 
-    int x_shift = 0, y_shift = 0;
-    double x_scale = 1.0, y_scale = 1.0;
-    std::tie(x_shift, y_shift, x_scale, y_scale) = resize_image_with_border(input_image, image_resized,
-        YOLO5_INPUT_IMAGE_SIZE, YOLO5_INPUT_IMAGE_SIZE, cv::Scalar(114, 114, 114));
+    Letterbox ret;
+    ret.x = (YOLO5_INPUT_IMAGE_SIZE - new_width) / 2;
+    ret.y = (YOLO5_INPUT_IMAGE_SIZE - new_height) / 2;
+    ret.width = new_width;
+    ret.height = new_height;
+    return ret;
+}
 
-    // Declare a destination Mat for float32
-    cv::Mat image_float;
+void YOLOv5Session::preprocess(size_t slot, const ImageViewRGB32& image){
+    const size_t stride = YOLO5_INPUT_IMAGE_SIZE;
+    const size_t image_size = stride * stride;
+    float* planes = m_model_input.data() + slot * 3 * image_size;
+    InputSlot& state = m_slots[slot];
 
-    // Convert the uint8_image to image_float
-    // The third argument (alpha) is a scaling factor.
-    // For normalization to [0.0, 1.0], use 1.0 / 255.0.
-    // For retaining original values (0-255), use 1.0.
-    image_resized.convertTo(image_float, CV_32F, 1.0 / 255.0); 
+    Letterbox box = letterbox(image.width(), image.height());
 
-    for (int c = 0, i = 0; c < 3; c++){
-        for (int row = 0; row < image_float.rows; row++){
-            for (int col = 0; col < image_float.cols; col++){
-                float pixel_value = image_float.at<cv::Vec3f>(row, col)[c];
-                m_model_input[i++] = pixel_value;
-            }
-        }
+    //  The resize only writes the inside of the letterbox. Repaint the border
+    //  only if the letterbox has moved since the last image in this slot.
+    Letterbox& previous = state.letterbox;
+    if (previous.x != box.x || previous.y != box.y || previous.width != box.width || previous.height != box.height){
+        std::fill(planes, planes + 3 * image_size, 114.f / 255.f);
+        previous = box;
     }
 
-    auto input_tensor = create_tensor<float>(m_memory_info, m_model_input, m_input_shape);
-    auto output_tensor = create_tensor<float>(m_memory_info, m_model_output, m_output_shape);
+    size_t offset = box.y * stride + box.x;
+    Kernels::resize_rgb32_to_planar_f32(
+        state.resize_plan,
+        image.data(), image.bytes_per_row(), image.width(), image.height(),
+        planes + offset, planes + image_size + offset, planes + 2 * image_size + offset, stride,
+        box.width, box.height,
+        1.f / 255.f
+    );
+}
 
+void YOLOv5Session::infer(size_t batch_size){
     const char* input_name_c = m_input_names[0].data();
     const char* output_name_c = m_output_names[0].data();
-    // auto start = std::chrono::steady_clock::now();
-    m_session.Run(m_run_options, &input_name_c, &input_tensor, 1, &output_name_c, &output_tensor, 1);
-    // auto end = std::chrono::steady_clock::now();
-    // auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-    // std::cout << "Yolov5 inference time: " << milliseconds << " ms" << std::endl;
 
+    const size_t input_size = 3 * (size_t)YOLO5_INPUT_IMAGE_SIZE * YOLO5_INPUT_IMAGE_SIZE;
+    const size_t output_size = YOLO5_NUM_CANDIDATES * m_output_shape[2];
+
+    //  With a dynamic batch dimension the whole batch is one call.
+    //  Otherwise it is one call per image.
+    size_t step = m_dynamic_batch ? batch_size : 1;
+    m_input_shape[0] = step;
+    m_output_shape[0] = step;
+
+    for (size_t c = 0; c < batch_size; c += step){
+        Ort::Value input_tensor = Ort::Value::CreateTensor<float>(
+            m_memory_info, m_model_input.data() + c * input_size, step * input_size,
+            m_input_shape.data(), m_input_shape.size()
+        );
+        Ort::Value output_tensor = Ort::Value::CreateTensor<float>(
+            m_memory_info, m_model_output.data() + c * output_size, step * output_size,
+            m_output_shape.data(), m_output_shape.size()
+        );
+        m_session.Run(m_run_options, &input_name_c, &input_tensor, 1, &output_name_c, &output_tensor, 1);
+    }
+}
+
+void YOLOv5Session::postprocess(size_t slot, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
     const size_t cand_size = m_label_names.size() + 5;
+    const float* output = m_model_output.data() + slot * YOLO5_NUM_CANDIDATES * cand_size;
 
-    std::vector<cv::Rect> pixel_boxes;
-    std::vector<int> indices;
-    std::vector<float> scores;
-    std::vector<size_t> labels;
+    const float score_threshold = 0.2f;
 
+    //  Only candidates above the score threshold can survive NMS. Drop the rest
+    //  up front so NMS doesn't have to look at all 25200 of them.
+    m_nms_boxes.clear();
+    m_nms_scores.clear();
+    m_nms_labels.clear();
     for (int i = 0; i < YOLO5_NUM_CANDIDATES; i++){
-        float cx = m_model_output[cand_size*i];
-        float cy = m_model_output[cand_size*i+1];
-        float w = m_model_output[cand_size*i+2];
-        float h = m_model_output[cand_size*i+3];
-        float sc = m_model_output[cand_size*i+4];
+        const float* cand = output + cand_size*i;
+        float cx = cand[0];
+        float cy = cand[1];
+        float w = cand[2];
+        float h = cand[3];
+        float sc = cand[4];
 
         float max_score = 0.0;
         size_t pred_label = 0;  // predicted label
         for (size_t j_label = 0; j_label < m_label_names.size(); j_label++){
-            float score = m_model_output[cand_size*i+5+j_label];
+            float score = cand[5+j_label];
             if (score > max_score){
                 max_score = score;
                 pred_label = j_label;
             }
         }
-        scores.push_back(max_score * sc); // sc is like a global confidence scale?
-        pixel_boxes.emplace_back((int)(cx - w / 2 + 0.5), (int)(cy - h / 2 + 0.5), int(w + 0.5), int(h + 0.5));
-        indices.push_back(i);
-        labels.push_back(pred_label);
+        float score = max_score * sc; // sc is like a global confidence scale?
+        if (!(score > score_threshold)){
+            continue;
+        }
+        m_nms_scores.push_back(score);
+        m_nms_boxes.emplace_back((int)(cx - w / 2 + 0.5), (int)(cy - h / 2 + 0.5), int(w + 0.5), int(h + 0.5));
+        m_nms_labels.push_back(pred_label);
     }
 
-    cv::dnn::NMSBoxes(pixel_boxes, scores, 0.2f, 0.45f, indices);
-
-    // std::cout << "num found pixel_boxes " << indices.size() << std::endl;
-    // return;
-
-    for (int index : indices)
-    {
-        // Note the model predicts on (640x640) images, we need to convert the detected pixel_boxes back to
-        // the full frame dimension.
-        double x = (pixel_boxes[index].x - x_shift) * x_scale;
-        double y = (pixel_boxes[index].y - y_shift) * y_scale;
-        double w = pixel_boxes[index].width * x_scale;
-        double h = pixel_boxes[index].height * y_scale;
-        // std::cout << scores[index] << " " <<  x << " " << y << " " << w << " " << h << std::endl;
+    std::vector<int> indices;
+    cv::dnn::NMSBoxes(m_nms_boxes, m_nms_scores, score_threshold, 0.45f, indices);
+
+    // Note the model predicts on (640x640) images, we need to convert the detected pixel_boxes back to
+    // the full frame dimension.
+    const Letterbox& box = m_slots[slot].letterbox;
+    double x_scale = 1.0 / box.width;
+    double y_scale = 1.0 / box.height;
+    for (int index : indices){
+        const cv::Rect& pixel_box = m_nms_boxes[index];
+        double x = (pixel_box.x - (double)box.x) * x_scale;
+        double y = (pixel_box.y - (double)box.y) * y_scale;
+        double w = pixel_box.width * x_scale;
+        double h = pixel_box.height * y_scale;
 
         YOLOv5Session::DetectionBox b;
         b.box = ImageFloatBox(x, y, w, h);
-        b.score = scores[index];
-        b.label_idx = labels[index];
+        b.score = m_nms_scores[index];
+        b.label_idx = m_nms_labels[index];
         output_boxes.push_back(b);
     }
 }
 
 
+// input: rgb color order
+void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
+    CV_Assert(input_image.depth() == CV_8U);
+    CV_Assert(input_image.channels() == 3);
+
+    cv::Mat image_bgra;
+    cv::cvtColor(input_image, image_bgra, cv::COLOR_RGB2BGRA);
+    ImageViewRGB32 image(
+        (uint32_t*)image_bgra.data, image_bgra.step[0],
+        image_bgra.cols, image_bgra.rows
+    );
+    run(image, output_boxes);
+}
+
+void YOLOv5Session::run(const ImageViewRGB32& image, std::vector<YOLOv5Session::DetectionBox>& output_boxes){
+    WallClock time0 = current_time();
+    preprocess(0, image);
+    WallClock time1 = current_time();
+    infer(1);
+    WallClock time2 = current_time();
+    postprocess(0, output_boxes);
+    WallClock time3 = current_time();
+
+    m_latency.preprocess += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    m_latency.inference += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count();
+    m_latency.postprocess += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time3 - time2).count();
+}
+
+void YOLOv5Session::run(
+    const std::vector<ImageViewRGB32>& images,
+    std::vector<std::vector<YOLOv5Session::DetectionBox>>& detections
+){
+    detections.resize(images.size());
+    if (images.empty()){
+        return;
+    }
+
+    reserve_batch(images.size());
+
+    WallClock time0 = current_time();
+    for (size_t c = 0; c < images.size(); c++){
+        preprocess(c, images[c]);
+    }
+    WallClock time1 = current_time();
+    infer(images.size());
+    WallClock time2 = current_time();
+    for (size_t c = 0; c < images.size(); c++){
+        detections[c].clear();
+        postprocess(c, detections[c]);
+    }
+    WallClock time3 = current_time();
+
+    m_latency.preprocess += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    m_latency.inference += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time2 - time1).count();
+    m_latency.postprocess += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time3 - time2).count();
+}
+
+
 size_t YOLOv5Session::label_index(const std::string& label_name) const{
     for (size_t i = 0; i < m_label_names.size(); i++){
         if (label_name == m_label_names[i]){
@@ -10,9 +10,15 @@
 
 
 #include <onnxruntime_cxx_api.h>
+#include <opencv2/core/types.hpp>
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/Tools/StatAccumulator.h"
+#include "Kernels/ImageToTensor/Kernels_ImageToTensor.h"
 
 namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
 namespace ML{
 
 
@@ -28,15 +34,60 @@ public:
         size_t label_idx;
     };
 
+    // Time spent in each stage of run(), in microseconds.
+    struct StageLatency{
+        StatAccumulatorI32 preprocess;
+        StatAccumulatorI32 inference;
+        StatAccumulatorI32 postprocess;
+    };
+
     YOLOv5Session(const std::string& model_path, bool use_gpu);
 
+    // Detect objects and append them to `detections`.
+    // input_image: rgb color order
     void run(const cv::Mat& input_image, std::vector<DetectionBox>& detections);
+    void run(const ImageViewRGB32& image, std::vector<DetectionBox>& detections);
+
+    // Detect objects on several images at once. `detections[i]` is overwritten
+    // with the detections of `images[i]`.
+    // If the model has a dynamic batch dimension the whole batch is a single
+    // inference call. Otherwise the images are run one after another.
+    void run(const std::vector<ImageViewRGB32>& images, std::vector<std::vector<DetectionBox>>& detections);
+
+    bool supports_batching() const { return m_dynamic_batch; }
+
+    const StageLatency& latency() const { return m_latency; }
+    void clear_latency(){ m_latency = StageLatency(); }
 
     const std::string& label_name(size_t idx) const { return m_label_names[idx]; }
     const std::vector<std::string>& get_label_names() const { return m_label_names; }
     // Return SIZE_MAX if no such label name exists.
     size_t label_index(const std::string& label_name) const;
     
+private:
+    // Where the resized image sits inside the model input.
+    struct Letterbox{
+        size_t x;
+        size_t y;
+        size_t width;
+        size_t height;
+    };
+
+    // Per batch entry state of the input tensor.
+    struct InputSlot{
+        // Letterbox last written into this slot. The border is only
+        // repainted when it changes.
+        Letterbox letterbox{0, 0, 0, 0};
+        // Resize plan for the last image size seen in this slot.
+        Kernels::ImageToTensorPlan resize_plan;
+    };
+
+    void reserve_batch(size_t batch_size);
+    Letterbox letterbox(size_t width, size_t height) const;
+    void preprocess(size_t slot, const ImageViewRGB32& image);
+    void infer(size_t batch_size);
+    void postprocess(size_t slot, std::vector<DetectionBox>& output_boxes);
+
 private:
     const int YOLO5_INPUT_IMAGE_SIZE = 640;
     const int YOLO5_NUM_CANDIDATES = 25200;
@@ -49,11 +100,21 @@ private:
     Ort::RunOptions m_run_options;
     std::vector<std::string> m_input_names, m_output_names;
 
-    const std::array<int64_t, 4> m_input_shape{1, 3, YOLO5_INPUT_IMAGE_SIZE, YOLO5_INPUT_IMAGE_SIZE};
+    bool m_dynamic_batch = false;
+    std::array<int64_t, 4> m_input_shape{1, 3, YOLO5_INPUT_IMAGE_SIZE, YOLO5_INPUT_IMAGE_SIZE};
     std::array<int64_t, 3> m_output_shape{1, YOLO5_NUM_CANDIDATES, 0};
 
+    // One input and output slot per batch entry. They only grow.
     std::vector<float> m_model_input;
     std::vector<float> m_model_output;
+    std::vector<InputSlot> m_slots;
+
+    // Scratch space for postprocess().
+    std::vector<cv::Rect> m_nms_boxes;
+    std::vector<float> m_nms_scores;
+    std::vector<size_t> m_nms_labels;
+
+    StageLatency m_latency;
 };
 
 // Find the first detection matching the given label ID from a YOLOv5Session detection output.
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <filesystem>
+#include <deque>
 #include <QMessageBox>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -57,6 +58,79 @@ void RunYOLO::program(NintendoSwitch::SingleSwitchProgramEnvironment& env, Ninte
 }
 
 
+
+RunYOLOMulti_Descriptor::RunYOLOMulti_Descriptor()
+    : MultiSwitchProgramDescriptor(
+        "NintendoSwitch:RunYOLOMulti",
+        "Nintendo Switch", "Run YOLO (Multi-Switch)",
+        "Programs/NintendoSwitch/RunYOLO.html",
+        "Run YOLO object detection model on several Switches at once.",
+        ProgramControllerClass::StandardController_NoRestrictions,
+        FeedbackType::NONE,
+        AllowCommandsWhenRunning::ENABLE_COMMANDS,
+        1, 4, 2
+    )
+{}
+
+RunYOLOMulti::RunYOLOMulti()
+    : MODEL_PATH(
+        "<b>YOLO Model Path:</b>",
+        LockMode::UNLOCK_WHILE_RUNNING,
+        RESOURCE_PATH() + "ML/yolov5.onnx",
+        "*.onnx",
+        "Path to YOLO .onnx model file"
+    )
+{
+    PA_ADD_OPTION(MODEL_PATH);
+}
+
+void RunYOLOMulti::program(NintendoSwitch::MultiSwitchProgramEnvironment& env, CancellableScope& scope){
+    std::string model_path = MODEL_PATH;
+    YOLOv5Detector detector(model_path);
+
+    std::deque<VideoOverlaySet> overlays;
+    for (NintendoSwitch::ConsoleHandle& console : env.consoles){
+        overlays.emplace_back(console.overlay());
+    }
+
+    std::vector<VideoSnapshot> snapshots;
+    std::vector<ImageViewRGB32> images;
+    std::vector<size_t> image_console;
+    std::vector<std::vector<YOLOv5Detector::DetectionBox>> detections;
+    while (true){
+        scope.throw_if_cancelled();
+
+        //  Consoles without a frame are left out of the batch.
+        snapshots.clear();
+        images.clear();
+        image_console.clear();
+        for (size_t c = 0; c < env.consoles.size(); c++){
+            VideoSnapshot snapshot = env.consoles[c].video().snapshot();
+            if (!snapshot){
+                overlays[c].clear();
+                continue;
+            }
+            images.emplace_back(*snapshot.frame);
+            image_console.emplace_back(c);
+            snapshots.emplace_back(std::move(snapshot));
+        }
+
+        detector.detect(images, detections);
+
+        for (size_t c = 0; c < images.size(); c++){
+            VideoOverlaySet& overlay = overlays[image_console[c]];
+            overlay.clear();
+            for (const auto& box : detections[c]){
+                std::string text = detector.label_name(box.label_idx) + ": " + tostr_fixed(box.score, 2);
+                overlay.add(COLOR_RED, box.box, text);
+            }
+        }
+
+        scope.wait_for(std::chrono::milliseconds(50));
+    }
+}
+
+
 }
 }
 
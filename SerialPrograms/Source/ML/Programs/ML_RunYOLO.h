@@ -10,6 +10,7 @@
 
 #include "Common/Cpp/Options/PathOption.h"
 #include "NintendoSwitch/NintendoSwitch_SingleSwitchProgram.h"
+#include "NintendoSwitch/NintendoSwitch_MultiSwitchProgram.h"
 
 namespace PokemonAutomation{
 namespace ML{
@@ -32,6 +33,26 @@ private:
 };
 
 
+
+class RunYOLOMulti_Descriptor : public NintendoSwitch::MultiSwitchProgramDescriptor{
+public:
+    RunYOLOMulti_Descriptor();
+};
+
+
+//  Same as RunYOLO, but on every console at once. The frames of all consoles
+//  go through the model as one batch.
+class RunYOLOMulti : public NintendoSwitch::MultiSwitchProgramInstance{
+public:
+    RunYOLOMulti();
+
+    virtual void program(NintendoSwitch::MultiSwitchProgramEnvironment& env, CancellableScope& scope) override;
+
+private:
+    PathOption MODEL_PATH;
+};
+
+
 }
 }
 #endif
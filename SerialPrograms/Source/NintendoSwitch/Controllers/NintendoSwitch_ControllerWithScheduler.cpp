@@ -17,6 +17,21 @@ using namespace std::chrono_literals;
 
 
 
+//  A button command has no state other than which button it is. So every
+//  press of the same button can share one command instead of allocating.
+static const SchedulerResourcePtr& button_command(size_t button){
+    static const std::vector<SchedulerResourcePtr> COMMANDS = []{
+        std::vector<SchedulerResourcePtr> ret;
+        for (size_t c = 0; c < TOTAL_BUTTONS; c++){
+            ret.emplace_back(std::make_unique<SwitchCommand_Button>((SwitchResource)c));
+        }
+        return ret;
+    }();
+    return COMMANDS[button];
+}
+
+
+
 void ControllerWithScheduler::issue_buttons(
     Cancellable* cancellable,
     Milliseconds delay, Milliseconds hold, Milliseconds cooldown,
@@ -40,7 +55,7 @@ void ControllerWithScheduler::issue_buttons(
             if (button & mask){
                 m_scheduler.issue_to_resource(
                     schedule,
-                    std::make_unique<SwitchCommand_Button>((SwitchResource)c),
+                    button_command(c),
                     WallDuration::zero(), hold, cooldown
                 );
             }
@@ -221,7 +236,7 @@ void ControllerWithScheduler::issue_full_controller_state(
             if (button & mask){
                 m_scheduler.issue_to_resource(
                     schedule,
-                    std::make_unique<SwitchCommand_Button>((SwitchResource)c),
+                    button_command(c),
                     WallDuration::zero(), hold, WallDuration::zero()
                 );
             }
@@ -4,11 +4,13 @@
  *
  */
 
+#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/EarlyShutdown.h"
 #include "Common/Cpp/Logging/GlobalLogger.h"
 #include "CommonFramework/VideoPipeline/Stats/MemoryUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Stats/CpuUtilizationStats.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "Integrations/ProgramTracker.h"
 #include "NintendoSwitch_SwitchSystemOption.h"
 #include "NintendoSwitch_SwitchSystemSession.h"
@@ -96,7 +98,18 @@ void SwitchSystemSession::set_allow_user_commands(std::string disallow_reason){
     m_controller.set_user_input_blocked(std::move(disallow_reason));
 }
 void SwitchSystemSession::save_history(const std::string& filename){
-    m_history.save(filename);
+    //  Nobody waits on this task. So report the failure from inside it.
+    m_history_save = GlobalThreadPools::unlimited_normal().dispatch_now_blocking(
+        [this, filename]{
+            try{
+                if (m_history.save(filename)){
+                    m_logger.log("Saved stream history to: " + filename, COLOR_BLUE);
+                }
+            }catch (Exception& e){
+                m_logger.log("Unable to save stream history: " + e.to_str(), COLOR_RED);
+            }
+        }
+    );
 }
 
 
@@ -96,6 +96,10 @@ private:
     std::unique_ptr<MemoryUtilizationStats> m_memory_usage;
     std::unique_ptr<CpuUtilizationStat> m_cpu_utilization;
     std::unique_ptr<ThreadUtilizationStat> m_main_thread_utilization;
+
+    //  The last history save. Only the latest one is kept. Starting a new one
+    //  waits for the previous one to finish.
+    AsyncTask m_history_save;
 };
 
 
@@ -13,6 +13,8 @@
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Qt/CollapsibleGroupBox.h"
 #include "CommonFramework/Globals.h"
+#include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Recording/StreamHistoryOption.h"
 #include "CommonFramework/AudioPipeline/UI/AudioSelectorWidget.h"
 #include "CommonFramework/AudioPipeline/UI/AudioDisplayWidget.h"
 #include "CommonFramework/VideoPipeline/UI/VideoSourceSelectorWidget.h"
@@ -171,7 +173,7 @@ SwitchSystemWidget::SwitchSystemWidget(
         m_command, &CommandRow::video_requested,
         m_video_display, [this](){
             global_dispatcher.dispatch([this]{
-                std::string filename = SCREENSHOTS_PATH() + "video-" + now_to_filestring() + ".mp4";
+                std::string filename = SCREENSHOTS_PATH() + "video-" + now_to_filestring() + GlobalSettings::instance().STREAM_HISTORY->file_extension();
                 m_session.logger().log("Saving screenshot to: " + filename, COLOR_PURPLE);
                 m_session.save_history(filename);
             });
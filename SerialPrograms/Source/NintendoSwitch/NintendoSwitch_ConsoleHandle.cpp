@@ -7,6 +7,7 @@
 #include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h"
+#include "CommonFramework/VideoPipeline/Stats/VideoSnapshotCacheStats.h"
 #include "CommonTools/InferencePivots/VisualInferencePivot.h"
 #include "CommonTools/InferencePivots/AudioInferencePivot.h"
 #include "CommonFramework/Recording/StreamHistorySession.h"
@@ -22,6 +23,7 @@ namespace NintendoSwitch{
 
 //ConsoleHandle::ConsoleHandle(ConsoleHandle&& x) = default;
 ConsoleHandle::~ConsoleHandle(){
+    overlay().remove_stat(*m_snapshot_cache);
     overlay().remove_stat(*m_thread_utilization);
     overlay().remove_stat(*m_normal_inference_utilization);
     overlay().remove_stat(*m_realtime_inference_utilization);
@@ -58,10 +60,14 @@ ConsoleHandle::ConsoleHandle(
             "Program Thread:"
         )
     )
+    , m_snapshot_cache(
+        new VideoSnapshotCacheStat(video.snapshot_cache_counters(), "Frame Cache Hits:")
+    )
 {
     overlay.add_stat(*m_realtime_inference_utilization);
     overlay.add_stat(*m_normal_inference_utilization);
     overlay.add_stat(*m_thread_utilization);
+    overlay.add_stat(*m_snapshot_cache);
 }
 
 
@@ -5,7 +5,10 @@
  */
 
 #include <cstddef>
+#include <array>
 #include <algorithm>
+#include <iterator>
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "Pokemon_AdvRng.h"
 
 namespace PokemonAutomation{
@@ -32,6 +35,59 @@ uint32_t increment_internal_rng_state(uint32_t state){
     return state * 0x41c64e6d + 0x6073;
 }
 
+//  Advancing the LCG n times is also an LCG: state * mul + add.
+struct AdvLcgJump{
+    uint32_t mul;
+    uint32_t add;
+};
+
+//  Entry k advances the LCG 2^k times.
+const std::array<AdvLcgJump, 64>& lcg_jump_table(){
+    static const std::array<AdvLcgJump, 64> table = []{
+        std::array<AdvLcgJump, 64> ret;
+        AdvLcgJump jump{0x41c64e6d, 0x6073};
+        for (AdvLcgJump& item : ret){
+            item = jump;
+            jump = {jump.mul * jump.mul, jump.add * jump.mul + jump.add};
+        }
+        return ret;
+    }();
+    return table;
+}
+
+//  Advance the LCG "advances" times in O(log(advances)).
+uint32_t jump_internal_rng_state(uint32_t state, uint64_t advances){
+    const std::array<AdvLcgJump, 64>& table = lcg_jump_table();
+    for (size_t c = 0; advances != 0; c++, advances >>= 1){
+        if (advances & 1){
+            state = state * table[c].mul + table[c].add;
+        }
+    }
+    return state;
+}
+
+//  Fill "states" with "count" consecutive LCG states starting with "state".
+//  Stepping one state at a time is a serial dependency chain. So run 8
+//  independent lanes that each jump 8 advances at a time instead. The inner
+//  loop has no dependencies and gets vectorized.
+void generate_internal_rng_states(uint32_t* states, size_t count, uint32_t state){
+    constexpr size_t LANES = 8;
+    size_t c = 0;
+    for (; c < std::min(count, LANES); c++){
+        states[c] = state;
+        state = increment_internal_rng_state(state);
+    }
+    const AdvLcgJump jump = lcg_jump_table()[3];
+    for (; c + LANES <= count; c += LANES){
+        for (size_t l = 0; l < LANES; l++){
+            states[c + l] = states[c + l - LANES] * jump.mul + jump.add;
+        }
+    }
+    for (; c < count; c++){
+        states[c] = increment_internal_rng_state(states[c - 1]);
+    }
+}
+
 AdvRngState rngstate_from_internal_state(uint16_t seed, uint64_t advances, uint32_t state, AdvRngMethod method){
     uint32_t s0 = state;
     uint32_t s1 = increment_internal_rng_state(s0);
@@ -44,12 +100,7 @@ AdvRngState rngstate_from_internal_state(uint16_t seed, uint64_t advances, uint3
 }
 
 AdvRngState rngstate_from_seed(uint16_t seed, uint64_t advances, AdvRngMethod method){
-    uint32_t state = seed;
-    state = increment_internal_rng_state(state);
-    for (uint64_t i=0; i<advances; i++){ 
-        state = increment_internal_rng_state(state);
-    }
-
+    uint32_t state = jump_internal_rng_state(seed, advances + 1);
     return rngstate_from_internal_state(seed, advances, state, method);
 }
 
@@ -259,7 +310,7 @@ uint8_t slot_number_from_roll(uint8_t roll, size_t size, bool super_rod) {
     }
 }
 
-int slot_to_unownform(AdvEncounterSlot slot){
+int slot_to_unownform(const AdvEncounterSlot& slot){
     if (slot.species.find("unown") == std::string::npos){
         return -1;
     }else{
@@ -327,14 +378,14 @@ int slot_to_unownform(AdvEncounterSlot slot){
     }
 }
 
-AdvWildPokemonResult wild_pokemon_from_state(AdvRngState state, std::vector<AdvEncounterSlot> slots, bool super_rod){
+AdvWildPokemonResult wild_pokemon_from_state(const AdvRngState& state, const std::vector<AdvEncounterSlot>& slots, bool super_rod){
 
     uint8_t slot_roll = (state.s0 >> 16) % 100;
     uint16_t level_roll = state.s1 >> 16;
     uint8_t nature = (state.s2 >> 16) % 25;
 
     uint8_t slot_num = slot_number_from_roll(slot_roll, slots.size(), super_rod);
-    AdvEncounterSlot slot = slots[slot_num];
+    const AdvEncounterSlot& slot = slots[slot_num];
     int unownform = slot_to_unownform(slot);
 
     uint8_t diff = slot.maxlevel - slot.minlevel;
@@ -380,7 +431,7 @@ bool egg_held_at_state(uint32_t state, AdvEggCompatibility compatibility){
     return (((state >> 16) * 100) / 0xffff) < compat_threshold;
 }
 
-AdvIVs get_inherited_ivs(AdvRngState state){
+AdvIVs get_inherited_ivs(const AdvRngState& state){
     uint8_t inherited_index_0 = (state.s0 >> 16) % 6;
     uint8_t inherited_index_1 = (state.s1 >> 16) % 5;
     uint8_t inherited_index_2 = (state.s2 >> 16) % 4;
@@ -389,18 +440,27 @@ AdvIVs get_inherited_ivs(AdvRngState state){
     uint8_t parent_1 = (state.s4 >> 16) % 2;
     uint8_t parent_2 = (state.s5 >> 16) % 2;
 
-    std::vector<uint8_t> stats_left = { 0, 1, 2, 3, 4, 5 };
+    //  Erasing from a fixed array instead of a vector. This runs for every
+    //  advance of an egg search.
+    uint8_t stats_left[6] = { 0, 1, 2, 3, 4, 5 };
+    size_t stats_left_size = 6;
+    auto erase_stat = [&](size_t index){
+        for (size_t c = index; c + 1 < stats_left_size; c++){
+            stats_left[c] = stats_left[c + 1];
+        }
+        stats_left_size--;
+    };
 
     AdvIVs inherited_ivs; // 0 -> not inherited, 1 -> from parent A, 2 -> from parent B
 
     uint8_t stat_index = stats_left[inherited_index_0];
     inherited_ivs[stat_index] = parent_0 + 1;
-    stats_left.erase(stats_left.begin() + stat_index);
+    erase_stat(stat_index);
 
     stat_index = stats_left[inherited_index_1];
     inherited_ivs[stat_index] = parent_1 + 1;
     if (stat_index < 5){
-        stats_left.erase(stats_left.begin() + stat_index);
+        erase_stat(stat_index);
     }
 
     stat_index = stats_left[inherited_index_2];
@@ -496,22 +556,35 @@ AdvShinyType shiny_type_from_pid(uint32_t pid, uint16_t tid_xor_sid){
 }
 
 
-bool check_for_match(AdvPokemonResult res, AdvRngFilters target, int16_t gender_threshold, uint16_t tid_xor_sid){
+// the parts of check_for_match() that only depend on the pid
+bool check_pid_for_match(uint32_t pid, const AdvRngFilters& target, int16_t gender_threshold, uint16_t tid_xor_sid){
+    return (target.nature == AdvNature::Any || (nature_from_pid(pid) == target.nature))
+        && (target.ability == AdvAbility::Any || (ability_from_pid(pid) == target.ability))
+        && (target.gender == AdvGender::Any || (gender_from_gender_value(gender_value_from_pid(pid), gender_threshold) == target.gender))
+        && (target.shiny == AdvShinyType::Any || (shiny_type_from_pid(pid, tid_xor_sid) == target.shiny));
+}
+
+// the parts of check_for_match() that only depend on the IVs
+bool check_ivs_for_match(const AdvIVs& ivs, const AdvRngFilters& target){
+    return ((target.ivs.hp.low <= ivs.hp) && (target.ivs.hp.high >= ivs.hp))
+        && ((target.ivs.attack.low <= ivs.attack) && (target.ivs.attack.high >= ivs.attack))
+        && ((target.ivs.defense.low <= ivs.defense) && (target.ivs.defense.high >= ivs.defense))
+        && ((target.ivs.spatk.low <= ivs.spatk) && (target.ivs.spatk.high >= ivs.spatk))
+        && ((target.ivs.spdef.low <= ivs.spdef) && (target.ivs.spdef.high >= ivs.spdef))
+        && ((target.ivs.speed.low <= ivs.speed) && (target.ivs.speed.high >= ivs.speed));
+}
+
+bool check_for_match(const AdvPokemonResult& res, const AdvRngFilters& target, int16_t gender_threshold, uint16_t tid_xor_sid){
     return (target.nature == AdvNature::Any || (res.nature == target.nature))
         && (target.ability == AdvAbility::Any || (res.ability == target.ability))
         && (target.gender == AdvGender::Any || (gender_from_gender_value(res.gender, gender_threshold) == target.gender))
         && (target.shiny == AdvShinyType::Any || (shiny_type_from_pid(res.pid, tid_xor_sid) == target.shiny))
-        && ((target.ivs.hp.low <= res.ivs.hp) && (target.ivs.hp.high >= res.ivs.hp))
-        && ((target.ivs.attack.low <= res.ivs.attack) && (target.ivs.attack.high >= res.ivs.attack))
-        && ((target.ivs.defense.low <= res.ivs.defense) && (target.ivs.defense.high >= res.ivs.defense))
-        && ((target.ivs.spatk.low <= res.ivs.spatk) && (target.ivs.spatk.high >= res.ivs.spatk))
-        && ((target.ivs.spdef.low <= res.ivs.spdef) && (target.ivs.spdef.high >= res.ivs.spdef))
-        && ((target.ivs.speed.low <= res.ivs.speed) && (target.ivs.speed.high >= res.ivs.speed));
+        && check_ivs_for_match(res.ivs, target);
 }
 
-bool check_for_match(AdvWildPokemonResult res, AdvRngFilters target, int16_t gender_threshold, uint16_t tid_xor_sid){
-    std::string res_name = res.species.find("unown") != std::string::npos ? "unown" : res.species;
-    return (target.species == res_name)
+bool check_for_match(const AdvWildPokemonResult& res, const AdvRngFilters& target, int16_t gender_threshold, uint16_t tid_xor_sid){
+    bool is_unown = res.species.find("unown") != std::string::npos;
+    return (is_unown ? target.species == "unown" : target.species == res.species)
         && (target.level == res.level)
         && (target.nature == AdvNature::Any || (res.nature == target.nature))
         && (target.ability == AdvAbility::Any || (res.ability == target.ability))
@@ -770,6 +843,124 @@ std::string gender_to_string(const AdvGender& gender){
 }
 
 
+//  Searches split the advance range into blocks of this size. The
+//  (seed, block) pairs are handed out to at most ADV_SEARCH_MAX_TASKS tasks
+//  on the thread pool, each covering a contiguous run of them.
+const uint64_t ADV_SEARCH_BLOCK_SIZE = 1024;
+const size_t ADV_SEARCH_MAX_TASKS = 256;
+
+//  The raw LCG states of a contiguous range of advances.
+class AdvRngStateBlock{
+public:
+    //  Covers advances [min_advances, max_advances] plus "lookahead" more raw
+    //  states past the end for the s1...s5 of the last advance.
+    AdvRngStateBlock(uint16_t seed, uint64_t min_advances, uint64_t max_advances, size_t lookahead = 5)
+        : m_seed(seed)
+        , m_min_advances(min_advances)
+        , m_states((size_t)(max_advances - min_advances) + 1 + lookahead)
+    {
+        generate_internal_rng_states(
+            m_states.data(), m_states.size(),
+            jump_internal_rng_state(seed, min_advances + 1)
+        );
+    }
+
+    uint32_t raw_state(uint64_t advance, size_t offset = 0) const{
+        return m_states[(size_t)(advance - m_min_advances) + offset];
+    }
+    AdvRngState state(uint64_t advance, AdvRngMethod method) const{
+        const uint32_t* s = m_states.data() + (size_t)(advance - m_min_advances);
+        return {m_seed, advance, method, s[0], s[1], s[2], s[3], s[4], s[5]};
+    }
+
+private:
+    uint16_t m_seed;
+    uint64_t m_min_advances;
+    std::vector<uint32_t> m_states;
+};
+
+//  The subset of "methods" that "target" allows, in the same order.
+std::vector<AdvRngMethod> methods_to_search(AdvRngMethod target, std::initializer_list<AdvRngMethod> methods){
+    std::vector<AdvRngMethod> ret;
+    for (AdvRngMethod method : methods){
+        if (target == AdvRngMethod::Any || target == method){
+            ret.emplace_back(method);
+        }
+    }
+    return ret;
+}
+
+//  Run "search_block(seed, min_advances, max_advances, hits)" over every seed
+//  and every block of advances in parallel. "hits" points to one hit list
+//  per method.
+//
+//  The results are returned in the same order a serial search finds them:
+//  seed -> method -> advance.
+template <typename HitType, typename SearchBlock>
+std::vector<HitType> parallel_advance_search(
+    const std::vector<uint16_t>& seeds, size_t methods,
+    uint64_t min_advances, uint64_t max_advances,
+    SearchBlock&& search_block
+){
+    std::vector<HitType> hits;
+    if (seeds.empty() || methods == 0 || min_advances > max_advances){
+        return hits;
+    }
+
+    const size_t blocks = (size_t)((max_advances - min_advances) / ADV_SEARCH_BLOCK_SIZE) + 1;
+    const size_t units = seeds.size() * blocks;
+    const size_t units_per_task = (units + ADV_SEARCH_MAX_TASKS - 1) / ADV_SEARCH_MAX_TASKS;
+    const size_t tasks = (units + units_per_task - 1) / units_per_task;
+
+    //  Each task tags its hits with (seed, method, block) so they can be put
+    //  in serial order with one sort at the end. Hits within one block and
+    //  method are already in advance order.
+    using TaggedHit = std::pair<size_t, HitType>;
+    std::vector<std::vector<TaggedHit>> task_hits(tasks);
+    GlobalThreadPools::computation_normal().run_in_parallel(
+        [&](size_t task){
+            std::vector<TaggedHit>& tagged = task_hits[task];
+            std::vector<std::vector<HitType>> block_hits(methods);
+            size_t end = std::min(units, (task + 1) * units_per_task);
+            for (size_t index = task * units_per_task; index < end; index++){
+                size_t s = index / blocks;
+                size_t b = index % blocks;
+                uint64_t block_min = min_advances + b * ADV_SEARCH_BLOCK_SIZE;
+                uint64_t block_max = std::min(block_min + (ADV_SEARCH_BLOCK_SIZE - 1), max_advances);
+                search_block(seeds[s], block_min, block_max, block_hits.data());
+                for (size_t m = 0; m < methods; m++){
+                    size_t key = (s * methods + m) * blocks + b;
+                    for (HitType& hit : block_hits[m]){
+                        tagged.emplace_back(key, std::move(hit));
+                    }
+                    block_hits[m].clear();
+                }
+            }
+        },
+        0, tasks
+    );
+
+    std::vector<TaggedHit> all_hits;
+    for (std::vector<TaggedHit>& tagged : task_hits){
+        all_hits.insert(all_hits.end(), std::make_move_iterator(tagged.begin()), std::make_move_iterator(tagged.end()));
+        tagged = std::vector<TaggedHit>();
+    }
+    std::stable_sort(
+        all_hits.begin(), all_hits.end(),
+        [](const TaggedHit& x, const TaggedHit& y){
+            return x.first < y.first;
+        }
+    );
+
+    hits.reserve(all_hits.size());
+    for (TaggedHit& hit : all_hits){
+        hits.emplace_back(std::move(hit.second));
+    }
+    return hits;
+}
+
+
+
 AdvRngSearcher::AdvRngSearcher(uint16_t seed, AdvRngState state, bool roaming)
     : seed(seed)
     , state(state)
@@ -800,43 +991,24 @@ AdvPokemonResult AdvRngSearcher::generate_pokemon(){
 }
 
 void AdvRngSearcher::search_advance_range(
-    std::vector<AdvRngState>& hits,
-    AdvRngFilters& target,
+    std::vector<AdvRngState>* hits,
+    const std::vector<AdvRngMethod>& methods,
+    const AdvRngFilters& target,
+    uint16_t seed,
     uint64_t min_advances,
     uint64_t max_advances,
     int16_t gender_threshold,
     uint16_t tid_xor_sid
-){
-    for (uint8_t m=0; m<3; m++){
-        set_state_advances(min_advances);
-
-        AdvRngMethod method;
-        switch (m){
-        case 1:
-            method = AdvRngMethod::Method2;
-            break;
-        case 2:
-            method = AdvRngMethod::Method4;
-            break;
-        case 0:
-        default:
-            method = AdvRngMethod::Method1;
-            break;
-        }
-
-        if ((target.method != AdvRngMethod::Any) && (target.method != method)){
-            continue;
-        }else{
-            state.method = method;
-        }
-
-        for (uint64_t a=min_advances; a<=max_advances; a++){
-            AdvPokemonResult res = pokemon_from_state(state, roaming);
+) const{
+    AdvRngStateBlock states(seed, min_advances, max_advances);
+    for (size_t m = 0; m < methods.size(); m++){
+        for (uint64_t a = min_advances; a <= max_advances; a++){
+            AdvRngState current = states.state(a, methods[m]);
+            AdvPokemonResult res = pokemon_from_state(current, roaming);
             bool match = check_for_match(res, target, gender_threshold, tid_xor_sid);
             if (match){
-               hits.emplace_back(state);
+               hits[m].emplace_back(current);
             }
-            advance_state();
         }
     }
 }
@@ -849,12 +1021,19 @@ std::vector<AdvRngState> AdvRngSearcher::search(
     int16_t gender_threshold,
     uint16_t tid_xor_sid
 ){
-    std::vector<AdvRngState> hits;
-    for (uint16_t seed : seeds){
-        set_seed(seed);
-        search_advance_range(hits, target, min_advances, max_advances, gender_threshold, tid_xor_sid);
-    }
-    return hits;
+    std::vector<AdvRngMethod> methods = methods_to_search(
+        target.method,
+        {AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method4}
+    );
+    return parallel_advance_search<AdvRngState>(
+        seeds, methods.size(), min_advances, max_advances,
+        [&](uint16_t s, uint64_t block_min, uint64_t block_max, std::vector<AdvRngState>* hits){
+            search_advance_range(
+                hits, methods, target, s, block_min, block_max,
+                gender_threshold, tid_xor_sid
+            );
+        }
+    );
 }
 
 
@@ -889,44 +1068,25 @@ AdvWildPokemonResult AdvRngWildSearcher::generate_pokemon(bool super_rod){
 }
 
 void AdvRngWildSearcher::search_advance_range(
-    std::vector<AdvRngState>& hits,
-    AdvRngFilters& target,
+    std::vector<AdvRngState>* hits,
+    const std::vector<AdvRngMethod>& methods,
+    const AdvRngFilters& target,
+    uint16_t seed,
     uint64_t min_advances,
     uint64_t max_advances,
     int16_t gender_threshold,
     bool super_rod,
     uint16_t tid_xor_sid
-){
-    for (uint8_t m=0; m<3; m++){
-        set_state_advances(min_advances);
-
-        AdvRngMethod method;
-        switch (m){
-        case 1:
-            method = AdvRngMethod::Method2;
-            break;
-        case 2:
-            method = AdvRngMethod::Method4;
-            break;
-        case 0:
-        default:
-            method = AdvRngMethod::Method1;
-            break;
-        }
-
-        if ((target.method != AdvRngMethod::Any) && (target.method != method)){
-            continue;
-        }else{
-            state.method = method;
-        }
-
-        for (uint64_t a=min_advances; a<=max_advances; a++){
-            AdvWildPokemonResult res = wild_pokemon_from_state(state, encounter_slots, super_rod);
+) const{
+    AdvRngStateBlock states(seed, min_advances, max_advances);
+    for (size_t m = 0; m < methods.size(); m++){
+        for (uint64_t a = min_advances; a <= max_advances; a++){
+            AdvRngState current = states.state(a, methods[m]);
+            AdvWildPokemonResult res = wild_pokemon_from_state(current, encounter_slots, super_rod);
             bool match = check_for_match(res, target, gender_threshold, tid_xor_sid);
             if (match){
-                hits.emplace_back(state);
+                hits[m].emplace_back(current);
             }
-            advance_state();
         }
     }
 }
@@ -940,12 +1100,19 @@ std::vector<AdvRngState> AdvRngWildSearcher::search(
     bool super_rod,
     uint16_t tid_xor_sid
 ){
-    std::vector<AdvRngState> hits;
-    for (uint16_t seed : seeds){
-        set_seed(seed);
-        search_advance_range(hits, target, min_advances, max_advances, gender_threshold, super_rod, tid_xor_sid);
-    }
-    return hits;
+    std::vector<AdvRngMethod> methods = methods_to_search(
+        target.method,
+        {AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method4}
+    );
+    return parallel_advance_search<AdvRngState>(
+        seeds, methods.size(), min_advances, max_advances,
+        [&](uint16_t s, uint64_t block_min, uint64_t block_max, std::vector<AdvRngState>* hits){
+            search_advance_range(
+                hits, methods, target, s, block_min, block_max,
+                gender_threshold, super_rod, tid_xor_sid
+            );
+        }
+    );
 }
 
 
@@ -1007,104 +1174,54 @@ AdvPokemonResult AdvRngEggSearcher::generate_pokemon(AdvIVs& parentA_ivs, AdvIVs
 }
 
 void AdvRngEggSearcher::search_pickup_advances_range(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint16_t held_pid_half,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    ){
-    for (uint8_t m=0; m<4; m++){
-        set_pickup_state_advances(min_pickup_advances);
-
-        AdvRngMethod method;
-        switch (m){
-        case 1:
-            method = AdvRngMethod::Method2;
-            break;
-        case 2:
-            method = AdvRngMethod::Method3;
-            break;
-        case 3:
-            method = AdvRngMethod::Method4;
-            break;
-        case 0:
-        default:
-            method = AdvRngMethod::Method1;
-            break;
-        }
-
-        if ((target.method != AdvRngMethod::Any) && (target.method != method)){
-            continue;
-        }else{
-            pickup_state.method = method;
-        }
-
-        for (uint64_t a=min_pickup_advances; a<=max_pickup_advances; a++){
-            AdvEggResult egg_res = egg_from_pickup_state(pickup_state, held_pid_half);
-            AdvPokemonResult poke_res = egg_to_pokemon(egg_res, parentA_ivs, parentB_ivs);
-            bool match = check_for_match(poke_res, target, gender_threshold, tid_xor_sid);
-            if (match){
-                std::pair<AdvRngState, AdvRngState> state_pair = { held_state, pickup_state };
-                hits.emplace_back(state_pair);
-            }
-            advance_pickup_state();
-        }
-    }
-}
-
-void AdvRngEggSearcher::search_pickups(
-    std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-    AdvRngFilters& target,
-    uint16_t held_pid_half,
-    const std::vector<uint16_t>& pickup_seeds,
+    std::vector<PickupCandidate>* candidates,
+    const std::vector<AdvRngMethod>& methods,
+    const AdvRngFilters& target,
+    uint16_t seed,
     uint64_t min_pickup_advances,
     uint64_t max_pickup_advances,
     AdvIVs& parentA_ivs,
-    AdvIVs& parentB_ivs,
-    int16_t gender_threshold,
-    uint16_t tid_xor_sid
-){
-    for (uint16_t pickup_seed : pickup_seeds){
-        set_pickup_seed(pickup_seed);
-        search_pickup_advances_range(hits, target, held_pid_half, min_pickup_advances, max_pickup_advances, parentA_ivs, parentB_ivs, gender_threshold, tid_xor_sid);
+    AdvIVs& parentB_ivs
+) const{
+    //  egg_from_pickup_state() looks at most 6 advances past the pickup state.
+    AdvRngStateBlock states(seed, min_pickup_advances, max_pickup_advances, 5 + 6);
+    for (size_t m = 0; m < methods.size(); m++){
+        for (uint64_t a = min_pickup_advances; a <= max_pickup_advances; a++){
+            AdvRngState current = states.state(a, methods[m]);
+            AdvEggResult egg_res = egg_from_pickup_state(current, 0);
+            AdvIVs ivs = apply_inherited_ivs(egg_res.ivs, egg_res.inherited_ivs, parentA_ivs, parentB_ivs);
+            if (check_ivs_for_match(ivs, target)){
+                candidates[m].emplace_back(PickupCandidate{current, (uint16_t)(current.s0 >> 16)});
+            }
+        }
     }
 }
 
 void AdvRngEggSearcher::search_held_advances_range(
     std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-    AdvRngFilters& target,
+    const AdvRngFilters& target,
+    uint16_t seed,
     uint64_t min_held_advances,
     uint64_t max_held_advances,
-    const std::vector<uint16_t>& pickup_seeds,
-    uint64_t min_pickup_advances,
-    uint64_t max_pickup_advances,
-    AdvIVs& parentA_ivs,
-    AdvIVs& parentB_ivs,
+    const std::vector<PickupCandidate>& candidates,
     AdvEggCompatibility compatibility,
     int16_t gender_threshold,
     uint16_t tid_xor_sid
-){
-    set_held_state_advances(min_held_advances);
-    for (uint64_t a=min_held_advances; a<=max_held_advances; a++){
-        if (egg_held_at_state(held_state.s0, compatibility)){
-            uint16_t held_pid_half = (((held_state.s1) >> 16) % 0xfffe) + 1;
-            search_pickups(
-                hits, target, 
-                held_pid_half, pickup_seeds, 
-                min_pickup_advances, max_pickup_advances,
-                parentA_ivs, parentB_ivs,
-                gender_threshold, tid_xor_sid
-            );
+) const{
+    AdvRngStateBlock states(seed, min_held_advances, max_held_advances);
+    for (uint64_t a = min_held_advances; a <= max_held_advances; a++){
+        if (!egg_held_at_state(states.raw_state(a), compatibility)){
+            continue;
+        }
+        uint16_t held_pid_half = ((states.raw_state(a, 1) >> 16) % 0xfffe) + 1;
+        AdvRngState current_held = states.state(a, held_state.method);
+        for (const PickupCandidate& candidate : candidates){
+            uint32_t pid = ((uint32_t)candidate.pid_half << 16) + held_pid_half;
+            if (check_pid_for_match(pid, target, gender_threshold, tid_xor_sid)){
+                hits.emplace_back(current_held, candidate.state);
+            }
         }
-        
-        advance_held_state();
     }
-
-    
 }
 
 std::vector<std::pair<AdvRngState, AdvRngState>> AdvRngEggSearcher::search(
@@ -1121,19 +1238,37 @@ std::vector<std::pair<AdvRngState, AdvRngState>> AdvRngEggSearcher::search(
     int16_t gender_threshold,
     uint16_t tid_xor_sid
 ){
-    std::vector<std::pair<AdvRngState, AdvRngState>> hits;
-    for (uint16_t h_seed : held_seeds){
-        set_held_seed(h_seed);
-        search_held_advances_range(
-            hits, target,
-            min_held_advances, max_held_advances, 
-            pickup_seeds, min_pickup_advances, max_pickup_advances,
-            parentA_ivs, parentB_ivs, compatibility, 
-            gender_threshold, tid_xor_sid
-        );
+    //  The IVs of an egg only depend on the pickup state. Only the pid mixes
+    //  in the held state. So find the pickup states with matching IVs once
+    //  instead of once per held advance.
+    std::vector<AdvRngMethod> methods = methods_to_search(
+        target.method,
+        {AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method3, AdvRngMethod::Method4}
+    );
+    std::vector<PickupCandidate> candidates = parallel_advance_search<PickupCandidate>(
+        pickup_seeds, methods.size(), min_pickup_advances, max_pickup_advances,
+        [&](uint16_t s, uint64_t block_min, uint64_t block_max, std::vector<PickupCandidate>* block_candidates){
+            search_pickup_advances_range(
+                block_candidates, methods, target, s, block_min, block_max,
+                parentA_ivs, parentB_ivs
+            );
+        }
+    );
+
+    if (candidates.empty()){
+        return {};
     }
 
-    return hits;
+    return parallel_advance_search<std::pair<AdvRngState, AdvRngState>>(
+        held_seeds, 1, min_held_advances, max_held_advances,
+        [&](uint16_t s, uint64_t block_min, uint64_t block_max, std::vector<std::pair<AdvRngState, AdvRngState>>* hits){
+            search_held_advances_range(
+                *hits, target, s, block_min, block_max,
+                candidates, compatibility,
+                gender_threshold, tid_xor_sid
+            );
+        }
+    );
 }
 
 
@@ -240,14 +240,17 @@ public:
     );
 
 private:
+    // search one seed over [min_advances, max_advances], appending the hits of methods[i] to hits[i]
     void search_advance_range(
-        std::vector<AdvRngState>& hits,
-        AdvRngFilters& target,
+        std::vector<AdvRngState>* hits,
+        const std::vector<AdvRngMethod>& methods,
+        const AdvRngFilters& target,
+        uint16_t seed,
         uint64_t min_advances,
         uint64_t max_advances,
         int16_t gender_threshold,
         uint16_t tid_xor_sid
-    );
+    ) const;
 };
 
 class AdvRngWildSearcher{
@@ -276,15 +279,18 @@ public:
     );
 
 private:
+    // search one seed over [min_advances, max_advances], appending the hits of methods[i] to hits[i]
     void search_advance_range(
-        std::vector<AdvRngState>& hits,
-        AdvRngFilters& target,
+        std::vector<AdvRngState>* hits,
+        const std::vector<AdvRngMethod>& methods,
+        const AdvRngFilters& target,
+        uint16_t seed,
         uint64_t min_advances,
         uint64_t max_advances,
         int16_t gender_threshold,
         bool super_rod,
         uint16_t tid_xor_sid
-    );
+    ) const;
 };
 
 
@@ -330,46 +336,37 @@ public:
     );
 
 private:
+    // a pickup state whose egg IVs match the target
+    struct PickupCandidate{
+        AdvRngState state;
+        uint16_t pid_half;
+    };
+
+    // search one pickup seed over [min_pickup_advances, max_pickup_advances],
+    // appending the matching states of methods[i] to candidates[i]
+    void search_pickup_advances_range(
+        std::vector<PickupCandidate>* candidates,
+        const std::vector<AdvRngMethod>& methods,
+        const AdvRngFilters& target,
+        uint16_t seed,
+        uint64_t min_pickup_advances,
+        uint64_t max_pickup_advances,
+        AdvIVs& parentA_ivs,
+        AdvIVs& parentB_ivs
+    ) const;
 
+    // search one held seed over [min_held_advances, max_held_advances] against all pickup candidates
     void search_held_advances_range(
         std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
+        const AdvRngFilters& target,
+        uint16_t seed,
         uint64_t min_held_advances,
         uint64_t max_held_advances,
-        const std::vector<uint16_t>& pickup_seeds,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
+        const std::vector<PickupCandidate>& candidates,
         AdvEggCompatibility compatibility,
         int16_t gender_threshold,
         uint16_t tid_xor_sid
-    );
-
-    void search_pickups(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint16_t held_pid_half,
-        const std::vector<uint16_t>& pickup_seeds,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    );
-
-    void search_pickup_advances_range(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint16_t held_pid_half,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    );
+    ) const;
 };
 
 
@@ -5,6 +5,8 @@
  */
 
 #include <cstddef>
+#include <cmath>
+#include <algorithm>
 #include "Pokemon_Xoroshiro128Plus.h"
 
 namespace PokemonAutomation{
@@ -24,22 +26,6 @@ Xoroshiro128Plus::Xoroshiro128Plus(uint64_t s0, uint64_t s1)
     : state(Xoroshiro128PlusState(s0, s1))
 {}
 
-uint64_t Xoroshiro128Plus::rotl(const uint64_t x, const int k){
-    return (x << k) | (x >> (64 - k));
-}
-
-uint64_t Xoroshiro128Plus::next(){
-    const uint64_t s0 = state.s0;
-    uint64_t s1 = state.s1;
-    const uint64_t result = s0 + s1;
-
-    s1 ^= s0;
-    state.s0 = rotl(s0, 24) ^ s1 ^ (s1 << 16);
-    state.s1 = rotl(s1, 37);
-
-    return result;
-}
-
 Xoroshiro128PlusState Xoroshiro128Plus::get_state(){
     return state;
 }
@@ -78,7 +64,7 @@ std::vector<bool> Xoroshiro128Plus::generate_last_bit_sequence(size_t max_advanc
 }
 
 
-std::pair<bool, uint64_t> Xoroshiro128Plus::advances_to_state(Xoroshiro128PlusState other_state, uint64_t max_advances){
+std::pair<bool, uint64_t> Xoroshiro128Plus::advances_to_state_stepping(Xoroshiro128PlusState other_state, uint64_t max_advances){
     Xoroshiro128Plus temp_rng(get_state());
     uint64_t advances = 0;
 
@@ -93,6 +79,196 @@ std::pair<bool, uint64_t> Xoroshiro128Plus::advances_to_state(Xoroshiro128PlusSt
     return { false, advances };
 }
 
+
+
+//  A 128x128 matrix over GF(2) acting on the state. Bits 0-63 are s0 and bits
+//  64-127 are s1. Column i is what bit i of the state maps to.
+struct Xoroshiro128PlusMatrix{
+    uint64_t columns[128][2];
+
+    PA_FORCE_INLINE Xoroshiro128PlusState apply(Xoroshiro128PlusState state) const{
+        uint64_t s0 = 0;
+        uint64_t s1 = 0;
+        for (size_t c = 0; c < 64; c++){
+            uint64_t mask = 0 - ((state.s0 >> c) & 1);
+            s0 ^= columns[c][0] & mask;
+            s1 ^= columns[c][1] & mask;
+        }
+        for (size_t c = 0; c < 64; c++){
+            uint64_t mask = 0 - ((state.s1 >> c) & 1);
+            s0 ^= columns[c + 64][0] & mask;
+            s1 ^= columns[c + 64][1] & mask;
+        }
+        return Xoroshiro128PlusState(s0, s1);
+    }
+
+    //  Returns (this * x). Applying the result is the same as applying "x"
+    //  then "this".
+    Xoroshiro128PlusMatrix operator*(const Xoroshiro128PlusMatrix& x) const{
+        Xoroshiro128PlusMatrix ret;
+        for (size_t c = 0; c < 128; c++){
+            Xoroshiro128PlusState column = apply(Xoroshiro128PlusState(x.columns[c][0], x.columns[c][1]));
+            ret.columns[c][0] = column.s0;
+            ret.columns[c][1] = column.s1;
+        }
+        return ret;
+    }
+
+    static Xoroshiro128PlusMatrix identity(){
+        Xoroshiro128PlusMatrix ret;
+        for (size_t c = 0; c < 64; c++){
+            ret.columns[c][0] = (uint64_t)1 << c;
+            ret.columns[c][1] = 0;
+            ret.columns[c + 64][0] = 0;
+            ret.columns[c + 64][1] = (uint64_t)1 << c;
+        }
+        return ret;
+    }
+
+    //  The matrix for a single call to next(). Read it off by running next()
+    //  on each basis vector.
+    static Xoroshiro128PlusMatrix transition(){
+        Xoroshiro128PlusMatrix ret;
+        for (size_t c = 0; c < 64; c++){
+            Xoroshiro128Plus rng0((uint64_t)1 << c, 0);
+            rng0.next();
+            ret.columns[c][0] = rng0.state.s0;
+            ret.columns[c][1] = rng0.state.s1;
+            Xoroshiro128Plus rng1(0, (uint64_t)1 << c);
+            rng1.next();
+            ret.columns[c + 64][0] = rng1.state.s0;
+            ret.columns[c + 64][1] = rng1.state.s1;
+        }
+        return ret;
+    }
+};
+
+//  T^(2^k) for k = 0 ... 63.
+class Xoroshiro128PlusJumpTable{
+public:
+    static const Xoroshiro128PlusJumpTable& instance(){
+        static Xoroshiro128PlusJumpTable table;
+        return table;
+    }
+
+    const Xoroshiro128PlusMatrix& operator[](size_t k) const{
+        return m_powers[k];
+    }
+
+    //  T^advances
+    Xoroshiro128PlusMatrix power(uint64_t advances) const{
+        Xoroshiro128PlusMatrix ret = Xoroshiro128PlusMatrix::identity();
+        for (size_t k = 0; advances != 0; k++, advances >>= 1){
+            if (advances & 1){
+                ret = m_powers[k] * ret;
+            }
+        }
+        return ret;
+    }
+
+private:
+    Xoroshiro128PlusJumpTable(){
+        m_powers[0] = Xoroshiro128PlusMatrix::transition();
+        for (size_t k = 1; k < 64; k++){
+            m_powers[k] = m_powers[k - 1] * m_powers[k - 1];
+        }
+    }
+
+private:
+    Xoroshiro128PlusMatrix m_powers[64];
+};
+
+
+void Xoroshiro128Plus::advance(uint64_t advances){
+    //  Stepping is cheaper than a single matrix multiply for short distances.
+    if (advances < 128){
+        for (uint64_t c = 0; c < advances; c++){
+            next();
+        }
+        return;
+    }
+
+    const Xoroshiro128PlusJumpTable& table = Xoroshiro128PlusJumpTable::instance();
+    for (size_t k = 0; advances != 0; k++, advances >>= 1){
+        if (advances & 1){
+            state = table[k].apply(state);
+        }
+    }
+}
+
+
+std::pair<bool, uint64_t> Xoroshiro128Plus::advances_to_state(Xoroshiro128PlusState other_state, uint64_t max_advances){
+    //  For short ranges, setting up the search costs more than stepping.
+    if (max_advances < 4096){
+        return advances_to_state_stepping(other_state, max_advances);
+    }
+
+    //  Baby-step/giant-step:
+    //  Any n in [1, max_advances] can be written as (i*m - j) with i >= 1 and
+    //  0 <= j < m. Then T^n(start) == target <=> T^(i*m)(start) == T^j(target).
+    //  Store T^j(target) for all j, then walk T^(i*m)(start) for increasing i.
+    //  The period is 2^128 - 1 so there is at most one match in range.
+
+    Xoroshiro128PlusState start = get_state();
+    if (start.s0 == other_state.s0 && start.s1 == other_state.s1){
+        return { true, 0 };
+    }
+
+    //  Cap the table at 4M entries (96 MB). Past that, do more giant steps.
+    uint64_t m = (uint64_t)std::ceil(std::sqrt((double)max_advances));
+    m = std::min<uint64_t>(m, (uint64_t)1 << 22);
+
+    struct BabyStep{
+        uint64_t s0;
+        uint64_t s1;
+        uint64_t j;
+    };
+    std::vector<BabyStep> baby_steps;
+    baby_steps.reserve(m);
+    {
+        Xoroshiro128Plus rng(other_state);
+        for (uint64_t j = 0; j < m; j++){
+            baby_steps.emplace_back(BabyStep{rng.state.s0, rng.state.s1, j});
+            rng.next();
+        }
+    }
+    std::sort(
+        baby_steps.begin(), baby_steps.end(),
+        [](const BabyStep& x, const BabyStep& y){
+            return x.s0 != y.s0 ? x.s0 < y.s0 : x.s1 < y.s1;
+        }
+    );
+
+    const Xoroshiro128PlusMatrix giant_step = Xoroshiro128PlusJumpTable::instance().power(m);
+    Xoroshiro128PlusState current = start;
+    for (uint64_t i = 1;; i++){
+        //  Smallest n this giant step can produce.
+        uint64_t base = (i - 1) * m + 1;
+        if (base > max_advances){
+            break;
+        }
+        current = giant_step.apply(current);
+
+        auto iter = std::lower_bound(
+            baby_steps.begin(), baby_steps.end(), current,
+            [](const BabyStep& x, const Xoroshiro128PlusState& y){
+                return x.s0 != y.s0 ? x.s0 < y.s0 : x.s1 < y.s1;
+            }
+        );
+        if (iter == baby_steps.end() || iter->s0 != current.s0 || iter->s1 != current.s1){
+            continue;
+        }
+
+        uint64_t advances = i * m - iter->j;
+        if (advances > max_advances){
+            break;
+        }
+        return { true, advances };
+    }
+
+    return { false, max_advances + 1 };
+}
+
 // The generic solution to the system of equations to calculate the initial state from the last bits of 128 consecutive Xoroshiro128+ results.
 uint64_t Xoroshiro128Plus::last_bits_reverse_matrix[128][2] = {
     /*s0 bit 0*/ {0b0101001100100001111011111110111001010011111110101011100011001101, 0b0111010111110111000101010100001111101001111001011111001011010111} ,
@@ -7,9 +7,11 @@
 #ifndef PokemonAutomation_PokemonSwSh_Xoroshiro128Plus_H
 #define PokemonAutomation_PokemonSwSh_Xoroshiro128Plus_H
 
+#include <stddef.h>
 #include <stdint.h>
 #include <utility>
 #include <vector>
+#include "Common/Compiler.h"
 
 namespace PokemonAutomation{
 namespace Pokemon{
@@ -26,25 +28,50 @@ public:
 
     Xoroshiro128Plus(Xoroshiro128PlusState state);
     Xoroshiro128Plus(uint64_t s0, uint64_t s1);
-    uint64_t next();
+
+    //  Inline since the seed searches call this in their innermost loops.
+    PA_FORCE_INLINE uint64_t next(){
+        const uint64_t s0 = state.s0;
+        uint64_t s1 = state.s1;
+        const uint64_t result = s0 + s1;
+
+        s1 ^= s0;
+        state.s0 = rotl(s0, 24) ^ s1 ^ (s1 << 16);
+        state.s1 = rotl(s1, 37);
+
+        return result;
+    }
     uint64_t nextInt(uint64_t);
     Xoroshiro128PlusState get_state();
     std::vector<bool> generate_last_bit_sequence(size_t max_advances);
 
+    //  Same as calling next() "advances" times, but in O(log(advances)).
+    //  The state transition is linear over GF(2) so this multiplies the state
+    //  by precomputed powers of the transition matrix.
+    void advance(uint64_t advances);
+
     // Calculates how many advances are required to reach the given state.
     // The given state must be reachable within max_advances advances.
     // Returns a pair:
     // first: true if the state is reachable within max_advances, false otherwise
     // second: the number of advances required (if first is true)
+    //
+    // Large ranges use a baby-step/giant-step search which takes
+    // O(sqrt(max_advances)) time and memory. Distances up to ~2^40 are fine.
     std::pair<bool, uint64_t> advances_to_state(Xoroshiro128PlusState other_state, uint64_t max_advances = 100000);
 
+    //  The original linear search. Kept as the reference for the tests.
+    std::pair<bool, uint64_t> advances_to_state_stepping(Xoroshiro128PlusState other_state, uint64_t max_advances = 100000);
+
     static Xoroshiro128Plus xoroshiro128plus_from_last_bits(std::pair<uint64_t, uint64_t> last_bits);
 
 
 private:
     static uint64_t last_bits_reverse_matrix[128][2];
 
-    uint64_t rotl(const uint64_t x, int k);
+    static PA_FORCE_INLINE uint64_t rotl(const uint64_t x, int k){
+        return (x << k) | (x >> (64 - k));
+    }
 };
 
 }
@@ -54,7 +54,9 @@ bool MapDetector::detect(const ImageViewRGB32& screen){
 MapWatcher::MapWatcher(Color color)
     : MapDetector(color)
     , VisualInferenceCallback("MapWatcher")
-{}
+{
+    skip_unchanged_frames({m_box0, m_box1, m_box2});
+}
 void MapWatcher::make_overlays(VideoOverlaySet& items) const{
     MapDetector::make_overlays(items);
 }
@@ -24,7 +24,7 @@ public:
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
 
-private:
+protected:
     Color m_color;
     ImageFloatBox m_box0;
     ImageFloatBox m_box1;
@@ -66,7 +66,9 @@ bool MenuDetector::detect(const ImageViewRGB32& screen){
 MenuWatcher::MenuWatcher(Color color)
     : MenuDetector(color)
     , VisualInferenceCallback("MenuWatcher")
-{}
+{
+    skip_unchanged_frames({m_line0, m_line1, m_line2, m_line3, m_line4, m_cross});
+}
 void MenuWatcher::make_overlays(VideoOverlaySet& items) const{
     MenuDetector::make_overlays(items);
 }
@@ -22,7 +22,7 @@ PokemonSpriteMatcherExact::PokemonSpriteMatcherExact(const std::set<std::string>
 {
     for (const auto& item : (flipped ? FLIPPED_POKEMON_SPRITES() : ALL_POKEMON_SPRITES())){
         if (subset == nullptr || subset->find(item.first) != subset->end()){
-            add(item.first, item.second.sprite.copy());
+            add(item.first, item.second.sprite, item.second.sprite_stats);
         }
     }
 }
@@ -34,7 +34,7 @@ PokemonSpriteMatcherCropped::PokemonSpriteMatcherCropped(const std::set<std::str
 {
     for (const auto& item : (flipped ? FLIPPED_POKEMON_SPRITES() : ALL_POKEMON_SPRITES())){
         if (subset == nullptr || subset->find(item.first) != subset->end()){
-            add(item.first, item.second.sprite);
+            add_cropped(item.first, item.second.icon, item.second.icon_stats);
         }
     }
 }
@@ -52,7 +52,7 @@ DonutBerriesMatcher::DonutBerriesMatcher(const std::vector<double>& min_euclidea
         m_min_euclidean_distance_squared.emplace_back(x * x);
     }
     for (const auto& item : DONUT_BERRIES_DATABASE()){
-        add(item.first, item.second.sprite);
+        add_cropped(item.first, item.second.icon, item.second.icon_stats);
     }
 }
 auto DonutBerriesMatcher::get_crop_candidates(const ImageViewRGB32& image) const -> std::vector<ImageViewRGB32>{
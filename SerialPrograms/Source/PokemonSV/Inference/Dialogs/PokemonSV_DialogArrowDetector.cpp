@@ -10,6 +10,7 @@
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonTools/Images/BinaryImage_FilterRgb32.h"
+#include "CommonTools/Images/SnapshotCachedFilters.h"
 #include "CommonTools/Images/WaterfillUtilities.h"
 #include "CommonTools/ImageMatch/ExactImageMatcher.h"
 #include "CommonTools/ImageMatch/WaterfillTemplateMatcher.h"
@@ -88,8 +89,32 @@ bool DialogArrowDetector::detect(const ImageViewRGB32& screen){
     std::vector<ImageFloatBox> hits = detect_all(screen);
     return !hits.empty();
 }
+bool DialogArrowDetector::detect_snapshot(const VideoSnapshot& snapshot){
+    std::vector<ImageFloatBox> hits = detect_all(snapshot);
+    return !hits.empty();
+}
 
 std::vector<ImageFloatBox> DialogArrowDetector::detect_all(const ImageViewRGB32& screen) const{
+    ImageViewRGB32 region = extract_box_reference(screen, m_box);
+    return find_arrows(
+        screen,
+        compress_rgb32_to_binary_range(region, 0xff000000, 0xff7f7fbf),
+        compress_rgb32_to_binary_range(region, 0xff808080, 0xffffffff)
+    );
+}
+std::vector<ImageFloatBox> DialogArrowDetector::detect_all(const VideoSnapshot& snapshot) const{
+    return find_arrows(
+        *snapshot.frame,
+        cached_compress_rgb32_to_binary_range(snapshot, m_box, 0xff000000, 0xff7f7fbf)->copy(),
+        cached_compress_rgb32_to_binary_range(snapshot, m_box, 0xff808080, 0xffffffff)->copy()
+    );
+}
+
+std::vector<ImageFloatBox> DialogArrowDetector::find_arrows(
+    const ImageViewRGB32& screen,
+    PackedBinaryMatrix black_matrix,
+    PackedBinaryMatrix white_matrix
+) const{
     using namespace Kernels::Waterfill;
 
     ImageViewRGB32 region = extract_box_reference(screen, m_box);
@@ -97,8 +122,7 @@ std::vector<ImageFloatBox> DialogArrowDetector::detect_all(const ImageViewRGB32&
     std::vector<ImageFloatBox> hits;
 
     {
-        PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(region, 0xff000000, 0xff7f7fbf);
-        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(black_matrix);
         auto iter = session->make_iterator(20);
         WaterfillObject object;
         while (iter->find_next(object, false)){
@@ -108,8 +132,7 @@ std::vector<ImageFloatBox> DialogArrowDetector::detect_all(const ImageViewRGB32&
         }
     }
     {
-        PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(region, 0xff808080, 0xffffffff);
-        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+        std::unique_ptr<WaterfillSession> session = make_WaterfillSession(white_matrix);
         auto iter = session->make_iterator(20);
         WaterfillObject object;
         while (iter->find_next(object, false)){
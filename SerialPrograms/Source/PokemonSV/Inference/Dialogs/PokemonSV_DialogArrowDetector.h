@@ -10,6 +10,7 @@
 #include <vector>
 #include "Common/Cpp/Color.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonTools/InferenceCallbacks/VisualInferenceCallback.h"
 #include "CommonTools/VisualDetector.h"
@@ -25,11 +26,20 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
+    virtual bool detect_snapshot(const VideoSnapshot& snapshot) override;
 
     std::vector<ImageFloatBox> detect_all(const ImageViewRGB32& screen) const;
+    std::vector<ImageFloatBox> detect_all(const VideoSnapshot& snapshot) const;
 
     std::pair<double, double> locate_dialog_arrow(const ImageViewRGB32& screen) const;
 
+private:
+    std::vector<ImageFloatBox> find_arrows(
+        const ImageViewRGB32& screen,
+        PackedBinaryMatrix black_matrix,
+        PackedBinaryMatrix white_matrix
+    ) const;
+
 protected:
     Color m_color;
     ImageFloatBox m_box;
@@ -99,6 +99,15 @@ bool AdvanceDialogDetector::detect(const ImageViewRGB32& screen){
     DialogArrowDetector arrow_detector(COLOR_RED, m_arrow);
     return arrow_detector.detect(screen);
 }
+bool AdvanceDialogDetector::detect_snapshot(const VideoSnapshot& snapshot){
+    if (!m_box.detect(*snapshot.frame)){
+        return false;
+    }
+
+    //  Every AdvanceDialogWatcher looks at the same arrow box.
+    DialogArrowDetector arrow_detector(COLOR_RED, m_arrow);
+    return arrow_detector.detect_snapshot(snapshot);
+}
 
 
 
@@ -65,6 +65,7 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
+    virtual bool detect_snapshot(const VideoSnapshot& snapshot) override;
 
 private:
     DialogBoxDetector m_box;
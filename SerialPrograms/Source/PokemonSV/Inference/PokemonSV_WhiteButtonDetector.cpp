@@ -10,6 +10,7 @@
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonTools/Images/BinaryImage_FilterRgb32.h"
+#include "CommonTools/Images/SnapshotCachedFilters.h"
 #include "PokemonSV_WhiteButtonDetector.h"
 
 //#include <iostream>
@@ -146,10 +147,27 @@ bool WhiteButtonDetector::detect(const ImageViewRGB32& screen){
     std::vector<ImageFloatBox> hits = detect_all(screen);
     return !hits.empty();
 }
+bool WhiteButtonDetector::detect_snapshot(const VideoSnapshot& snapshot){
+    std::vector<ImageFloatBox> hits = detect_all(snapshot);
+    return !hits.empty();
+}
 
 std::vector<ImageFloatBox> WhiteButtonDetector::detect_all(const ImageViewRGB32& screen) const{
     ImageViewRGB32 region = extract_box_reference(screen, m_box);
-    PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(region, 0xff808080, 0xffffffff);
+    return find_buttons(screen, compress_rgb32_to_binary_range(region, 0xff808080, 0xffffffff));
+}
+std::vector<ImageFloatBox> WhiteButtonDetector::detect_all(const VideoSnapshot& snapshot) const{
+    return find_buttons(
+        *snapshot.frame,
+        cached_compress_rgb32_to_binary_range(snapshot, m_box, 0xff808080, 0xffffffff)->copy()
+    );
+}
+
+std::vector<ImageFloatBox> WhiteButtonDetector::find_buttons(
+    const ImageViewRGB32& screen,
+    PackedBinaryMatrix matrix
+) const{
+    ImageViewRGB32 region = extract_box_reference(screen, m_box);
 
     std::vector<ImageFloatBox> hits;
 
@@ -14,6 +14,7 @@
 #include <vector>
 #include "Common/Cpp/Color.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonTools/ImageMatch/WaterfillTemplateMatcher.h"
 #include "CommonTools/InferenceCallbacks/VisualInferenceCallback.h"
@@ -70,8 +71,16 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
+    virtual bool detect_snapshot(const VideoSnapshot& snapshot) override;
 
     std::vector<ImageFloatBox> detect_all(const ImageViewRGB32& screen) const;
+    std::vector<ImageFloatBox> detect_all(const VideoSnapshot& snapshot) const;
+
+private:
+    std::vector<ImageFloatBox> find_buttons(
+        const ImageViewRGB32& screen,
+        PackedBinaryMatrix matrix
+    ) const;
 
 protected:
     const WhiteButtonMatcher& m_matcher;
@@ -134,6 +134,7 @@ ItemPrinterRNG::ItemPrinterRNG()
         "<b>Rounds Table:</b><br>Run the following prints in order and repeat. "
         "Changes to this table take effect the next time the table starts from the beginning."
     )
+    , SEED_SEARCH(DATE_SEED_TABLE)
     , DELAY_MILLIS(
         "<b>Delay (Milliseconds):</b><br>"
         "The delay from when you press A to when the game reads the date for the seed. "
@@ -213,6 +214,7 @@ ItemPrinterRNG::ItemPrinterRNG()
     PA_ADD_OPTION(DESIRED_ITEM_TABLE);
     PA_ADD_OPTION(NUM_ITEM_PRINTER_ROUNDS);
     PA_ADD_OPTION(DATE_SEED_TABLE);
+    PA_ADD_OPTION(SEED_SEARCH);
     PA_ADD_OPTION(OVERLAPPING_BONUS_WARNING);
     PA_ADD_OPTION(DELAY_MILLIS);
     PA_ADD_OPTION(ADJUST_DELAY);
@@ -257,6 +259,10 @@ void ItemPrinterRNG::on_config_value_changed(void* object){
         MODE == ItemPrinterMode::AUTO_MODE ? ConfigOptionState::HIDDEN : ConfigOptionState::ENABLED
     );
 
+    SEED_SEARCH.set_visibility(
+        MODE == ItemPrinterMode::AUTO_MODE ? ConfigOptionState::HIDDEN : ConfigOptionState::ENABLED
+    );
+
     ADJUST_DELAY.set_visibility(
         MODE == ItemPrinterMode::AUTO_MODE ? ConfigOptionState::HIDDEN : ConfigOptionState::ENABLED
     );
@@ -123,6 +123,7 @@ private:
     EnumDropdownOption<ItemPrinterMode> MODE;
     ItemPrinterDesiredItemTable DESIRED_ITEM_TABLE;
     ItemPrinterRngTable DATE_SEED_TABLE;
+    ItemPrinterSeedSearchGroup SEED_SEARCH;
 
     SimpleIntegerOption<uint16_t> DELAY_MILLIS;
     BooleanCheckBoxOption ADJUST_DELAY;
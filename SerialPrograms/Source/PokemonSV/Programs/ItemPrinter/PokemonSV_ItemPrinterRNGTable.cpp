@@ -4,7 +4,10 @@
  *
  */
 
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Qt/TimeQt.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "PokemonSV_ItemPrinterRNGTable.h"
 
 //#include <iostream>
@@ -161,6 +164,205 @@ std::vector<std::unique_ptr<EditableTableRow>> ItemPrinterRngTable::make_default
     ret.emplace_back(std::make_unique<ItemPrinterRngRow>(*this, false, DateTime{2020,  3,  3,  6, 38, 18}, ItemPrinterJobs::Jobs_10));
     return ret;
 }
+void ItemPrinterRngTable::set_seed_matches(const std::vector<ItemPrinter::SeedSearchMatch>& matches, ItemPrinterJobs jobs){
+    //  Build all the rows first and swap them in with one load so the table
+    //  only redraws once.
+    JsonArray rows;
+    for (const ItemPrinter::SeedSearchMatch& match : matches){
+        rows.push_back(ItemPrinterRngRow(*this, false, from_seconds_since_epoch(match.seed), jobs).to_json());
+    }
+    load_json(JsonValue(std::move(rows)));
+}
+
+
+
+static const EnumDropdownDatabase<ItemPrinter::PrintMode>& SeedSearchBonus_Database(){
+    static const EnumDropdownDatabase<ItemPrinter::PrintMode> database({
+        {ItemPrinter::PrintMode::Regular,   "none",         "Don't care"},
+        {ItemPrinter::PrintMode::ItemBonus, "item-bonus",   "Item Bonus"},
+        {ItemPrinter::PrintMode::BallBonus, "ball-bonus",   "Ball Bonus"},
+    });
+    return database;
+}
+
+//  Reports the progress in the status text and keeps the best matches so far
+//  for when the search is cancelled. Only updates the text when the percentage
+//  changes since this is called once per block.
+class ItemPrinterSeedSearchProgress : public ItemPrinter::SeedSearchListener{
+public:
+    ItemPrinterSeedSearchProgress(StaticTextOption& status)
+        : m_status(status)
+    {}
+    const std::vector<ItemPrinter::SeedSearchMatch>& matches() const{
+        return m_matches;
+    }
+    virtual void on_matches(const std::vector<ItemPrinter::SeedSearchMatch>& matches) override{
+        m_matches = matches;
+    }
+    virtual void on_progress(uint64_t seeds_searched, uint64_t seeds_total) override{
+        uint64_t percent = seeds_searched * 100 / seeds_total;
+        if (percent == m_last_percent){
+            return;
+        }
+        m_last_percent = percent;
+        m_status.set_text(
+            "Searching... " + std::to_string(percent) + "% (" +
+            std::to_string(seeds_searched) + " / " + std::to_string(seeds_total) + " seeds)"
+        );
+    }
+
+private:
+    StaticTextOption& m_status;
+    uint64_t m_last_percent = (uint64_t)-1;
+    std::vector<ItemPrinter::SeedSearchMatch> m_matches;
+};
+
+
+ItemPrinterSeedSearchGroup::~ItemPrinterSeedSearchGroup(){
+    SEARCH.remove_listener(*this);
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        if (m_running){
+            m_scope->cancel(nullptr);
+        }
+    }
+    m_task.wait_and_ignore_exceptions();
+}
+ItemPrinterSeedSearchGroup::ItemPrinterSeedSearchGroup(ItemPrinterRngTable& table)
+    : GroupOption(
+        "Seed Search",
+        LockMode::LOCK_WHILE_RUNNING,
+        GroupOption::EnableMode::ALWAYS_ENABLED
+    )
+    , DESIRED_ITEM(
+        "<b>Desired Item:</b>",
+        ItemPrinter::PrebuiltOptions_AutoMode_Database(),
+        LockMode::LOCK_WHILE_RUNNING,
+        ItemPrinter::PrebuiltOptions::ABILITY_PATCH
+    )
+    , MIN_QUANTITY(
+        "<b>Minimum Quantity:</b><br>Only keep seeds that print at least this many of the desired item.",
+        LockMode::LOCK_WHILE_RUNNING,
+        1, 1, 999
+    )
+    , JOBS(
+        "<b>Jobs to Print:</b>",
+        ItemPrinterJobs_Database(),
+        LockMode::LOCK_WHILE_RUNNING,
+        ItemPrinterJobs::Jobs_10
+    )
+    , DESIRED_BONUS(
+        "<b>Desired Bonus:</b><br>Only keep seeds that also roll this bonus mode.",
+        SeedSearchBonus_Database(),
+        LockMode::LOCK_WHILE_RUNNING,
+        ItemPrinter::PrintMode::Regular
+    )
+    , FIRST_DATE(
+        "<b>Search From:</b>",
+        LockMode::LOCK_WHILE_RUNNING,
+        DateTimeOption::DATE_HOUR_MIN_SEC,
+        DateTime{2000, 1, 1, 0, 1, 0},
+        DateTime{2060, 12, 31, 23, 59, 59},
+        DateTime{2024, 1, 1, 0, 0, 0}
+    )
+    , LAST_DATE(
+        "<b>Search To:</b>",
+        LockMode::LOCK_WHILE_RUNNING,
+        DateTimeOption::DATE_HOUR_MIN_SEC,
+        DateTime{2000, 1, 1, 0, 1, 0},
+        DateTime{2060, 12, 31, 23, 59, 59},
+        DateTime{2025, 1, 1, 0, 0, 0}
+    )
+    , MAX_RESULTS(
+        "<b>Max Results:</b><br>Replace the rounds table with up to this many of the best seeds.",
+        LockMode::LOCK_WHILE_RUNNING,
+        10, 1, 1000
+    )
+    , SEARCH(
+        "<b>Search for Seeds:</b><br>"
+        "When the search ends, <b>the rounds table above is replaced</b> with the best seeds found.",
+        "Search", 0, 16
+    )
+    , STATUS("")
+    , m_table(table)
+{
+    PA_ADD_OPTION(DESIRED_ITEM);
+    PA_ADD_OPTION(MIN_QUANTITY);
+    PA_ADD_OPTION(JOBS);
+    PA_ADD_OPTION(DESIRED_BONUS);
+    PA_ADD_OPTION(FIRST_DATE);
+    PA_ADD_OPTION(LAST_DATE);
+    PA_ADD_OPTION(MAX_RESULTS);
+    PA_ADD_OPTION(SEARCH);
+    PA_ADD_OPTION(STATUS);
+
+    SEARCH.add_listener(*this);
+}
+
+void ItemPrinterSeedSearchGroup::on_press(){
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        if (m_running){
+            m_scope->cancel(nullptr);
+            SEARCH.set_text("Cancelling...");
+            return;
+        }
+        m_running = true;
+    }
+
+    //  The previous search (if any) has already finished.
+    m_task.wait_and_ignore_exceptions();
+    m_scope.reset(new CancellableHolder<CancellableScope>());
+
+    ItemPrinter::SeedSearchQuery query;
+    query.first_seed = to_seconds_since_epoch(FIRST_DATE);
+    query.last_seed = to_seconds_since_epoch(LAST_DATE);
+    query.jobs = (size_t)JOBS.get();
+    query.desired_items.emplace_back(ItemPrinter::PrebuiltOptions_AutoMode_Database().find(DESIRED_ITEM)->slug);
+    query.min_quantity = MIN_QUANTITY;
+    query.desired_bonus = DESIRED_BONUS;
+    query.max_results = MAX_RESULTS;
+
+    SEARCH.set_text("Cancel");
+    STATUS.set_text("Searching...");
+    m_task = GlobalThreadPools::unlimited_normal().dispatch_now_blocking(
+        [this, query = std::move(query), jobs = JOBS.get()]{
+            run_search(std::move(query), jobs);
+        }
+    );
+}
+void ItemPrinterSeedSearchGroup::run_search(ItemPrinter::SeedSearchQuery query, ItemPrinterJobs jobs){
+    std::string status;
+    ItemPrinterSeedSearchProgress listener(STATUS);
+    try{
+        std::vector<ItemPrinter::SeedSearchMatch> matches = ItemPrinter::search_seeds(query, m_scope.get(), &listener);
+        if (matches.empty()){
+            status = "No seeds matched. The rounds table was not changed.";
+        }else{
+            m_table.set_seed_matches(matches, jobs);
+            status = "Found " + std::to_string(matches.size()) + " seed(s). The rounds table was replaced with them.";
+        }
+    }catch (OperationCancelledException&){
+        const std::vector<ItemPrinter::SeedSearchMatch>& matches = listener.matches();
+        if (matches.empty()){
+            status = "Search cancelled. No seeds matched so far. The rounds table was not changed.";
+        }else{
+            m_table.set_seed_matches(matches, jobs);
+            status = "Search cancelled. The rounds table was replaced with the best " +
+                std::to_string(matches.size()) + " seed(s) found so far.";
+        }
+    }catch (Exception& e){
+        status = "<font color=\"red\">" + e.message() + "</font>";
+    }catch (std::exception& e){
+        status = std::string("<font color=\"red\">") + e.what() + "</font>";
+    }
+
+    STATUS.set_text(std::move(status));
+    SEARCH.set_text("Search");
+
+    std::lock_guard<Mutex> lg(m_lock);
+    m_running = false;
+}
 
 
 
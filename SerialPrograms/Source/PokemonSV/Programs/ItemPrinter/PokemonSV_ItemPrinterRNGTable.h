@@ -8,14 +8,20 @@
 #define PokemonAutomation_PokemonSV_ItemPrinterRNGTable_H
 
 #include <deque>
+#include "Common/Cpp/CancellableScope.h"
 #include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "Common/Cpp/Options/BooleanCheckBoxOption.h"
+#include "Common/Cpp/Options/ButtonOption.h"
 #include "Common/Cpp/Options/EnumDropdownOption.h"
 #include "Common/Cpp/Options/DateOption.h"
 #include "Common/Cpp/Options/EditableTableOption.h"
+#include "Common/Cpp/Options/GroupOption.h"
 #include "Common/Cpp/Options/SimpleIntegerOption.h"
+#include "Common/Cpp/Options/StaticTextOption.h"
 #include "PokemonSV_ItemPrinterTools.h"
 #include "PokemonSV_ItemPrinterDatabase.h"
+#include "PokemonSV_ItemPrinterSeedSearch.h"
 
 namespace PokemonAutomation{
 namespace NintendoSwitch{
@@ -66,9 +72,46 @@ public:
     virtual std::vector<std::string> make_header() const override;
     std::vector<std::unique_ptr<EditableTableRow>> make_defaults();
 
+    //  Replace the rows with the results of a seed search, one print per row.
+    //  This is a single update of the table.
+    void set_seed_matches(const std::vector<ItemPrinter::SeedSearchMatch>& matches, ItemPrinterJobs jobs);
+
     friend class ItemPrinterRngRow;
 };
 
+//  Search a range of dates for seeds that print the desired item. The search
+//  runs in the background. The rounds table is left alone until it ends. Then
+//  it is replaced with the best seeds found, including when it is cancelled.
+//  Pressing the button again while it runs cancels it.
+class ItemPrinterSeedSearchGroup : public GroupOption, private ButtonListener{
+public:
+    ~ItemPrinterSeedSearchGroup();
+    ItemPrinterSeedSearchGroup(ItemPrinterRngTable& table);
+
+private:
+    virtual void on_press() override;
+    void run_search(ItemPrinter::SeedSearchQuery query, ItemPrinterJobs jobs);
+
+public:
+    EnumDropdownOption<ItemPrinter::PrebuiltOptions> DESIRED_ITEM;
+    SimpleIntegerOption<uint16_t> MIN_QUANTITY;
+    EnumDropdownOption<ItemPrinterJobs> JOBS;
+    EnumDropdownOption<ItemPrinter::PrintMode> DESIRED_BONUS;
+    DateTimeOption FIRST_DATE;
+    DateTimeOption LAST_DATE;
+    SimpleIntegerOption<uint16_t> MAX_RESULTS;
+    ButtonOption SEARCH;
+    StaticTextOption STATUS;
+
+private:
+    ItemPrinterRngTable& m_table;
+
+    Mutex m_lock;
+    bool m_running = false;
+    std::unique_ptr<CancellableHolder<CancellableScope>> m_scope;
+    AsyncTask m_task;
+};
+
 struct ItemPrinterDesiredItemRowSnapshot{
     ItemPrinter::PrebuiltOptions item;
     uint16_t quantity;
@@ -15,6 +15,7 @@
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonArray.h"
 #include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonBinary.h"
 #include "CommonFramework/Globals.h"
 #include "Pokemon/Pokemon_Xoroshiro128Plus.h"
 #include "PokemonSV_ItemPrinterSeedCalc.h"
@@ -247,7 +248,7 @@ std::vector<ItemPrinterItemData> make_item_prize_list(){
     //      https://github.com/kwsch/ItemPrinterDeGacha/blob/main/ItemPrinterDeGacha.Core/Resources/item_table_array.json
     //  The file itself is originally from a pkNX dump of the game.
     const std::string path = "PokemonSV/ItemPrinterItems.json";
-    JsonValue json = load_json_file(RESOURCE_PATH() + path);
+    JsonValue json = load_json_file_cached(RESOURCE_PATH() + path, RESOURCE_CACHE_PATH());
     const JsonArray& array = json
         .to_object_throw(path)
         .get_array_throw("Table", path);
@@ -279,7 +280,7 @@ std::vector<ItemPrinterItemData> make_ball_prize_list(){
     //      https://github.com/kwsch/ItemPrinterDeGacha/blob/main/ItemPrinterDeGacha.Core/Resources/special_item_table_array.json
     //  The file itself is originally from a pkNX dump of the game.
     const std::string path = "PokemonSV/ItemPrinterBalls.json";
-    JsonValue json = load_json_file(RESOURCE_PATH() + path);
+    JsonValue json = load_json_file_cached(RESOURCE_PATH() + path, RESOURCE_CACHE_PATH());
     const JsonArray& array = json
         .to_object_throw(path)
         .get_array_throw("Table", path)[0]
@@ -339,59 +340,121 @@ std::vector<const ItemPrinterItemData*> make_item_prize_table(const std::vector<
 }
 
 
-std::vector<const ItemPrinterItemData*> make_item_prize_table(){
-    static const std::vector<ItemPrinterItemData>& PRIZE_LIST = make_item_prize_list();
-    return make_item_prize_table(PRIZE_LIST);
-}
-std::vector<const ItemPrinterItemData*> make_ball_prize_table(){
-    static const std::vector<ItemPrinterItemData>& PRIZE_LIST = make_ball_prize_list();
-    return make_item_prize_table(PRIZE_LIST);
-}
+//  A slot of the roll table. Integer-only so that the seed search doesn't
+//  touch strings.
+struct PrizeSlot{
+    uint16_t id;
+    uint8_t min_quantity;
+    uint8_t quantity_range;     //  max - min + 1
+};
 
+struct PrizeTables{
+    std::vector<std::string> slugs;
+    std::map<std::string, uint16_t> ids;
+    std::vector<PrizeSlot> item_table;
+    std::vector<PrizeSlot> ball_table;
 
-enum class PrintMode{
-    Regular = 0,
-    ItemBonus = 1,
-    BallBonus = 2,
+    PrizeTables(){
+        item_table = make_slots(make_item_prize_list());
+        ball_table = make_slots(make_ball_prize_list());
+    }
+    std::vector<PrizeSlot> make_slots(const std::vector<ItemPrinterItemData>& prize_list){
+        std::vector<PrizeSlot> ret;
+        for (const ItemPrinterItemData* item : make_item_prize_table(prize_list)){
+            auto iter = ids.find(item->slug);
+            if (iter == ids.end()){
+                iter = ids.emplace(item->slug, (uint16_t)slugs.size()).first;
+                slugs.emplace_back(item->slug);
+            }
+            ret.emplace_back(PrizeSlot{
+                iter->second,
+                item->min_quantity,
+                (uint8_t)(item->max_quantity - item->min_quantity + 1)
+            });
+        }
+        return ret;
+    }
 };
+const PrizeTables& prize_tables(){
+    static const PrizeTables tables;
+    return tables;
+}
 
 
-std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
-    static const std::vector<const ItemPrinterItemData*> ITEM_TABLE = make_item_prize_table();
-    static const std::vector<const ItemPrinterItemData*> BALL_TABLE = make_ball_prize_table();
+const std::vector<std::string>& prize_slugs(){
+    return prize_tables().slugs;
+}
+int prize_id(const std::string& slug){
+    const std::map<std::string, uint16_t>& ids = prize_tables().ids;
+    auto iter = ids.find(slug);
+    return iter == ids.end() ? -1 : iter->second;
+}
+
 
-    const std::vector<const ItemPrinterItemData*>& table = mode == PrintMode::BallBonus
-        ? BALL_TABLE
-        : ITEM_TABLE;
+
+//  Same as Xoroshiro128Plus::nextInt(), but with the mask precomputed.
+PA_FORCE_INLINE uint64_t next_int(Pokemon::Xoroshiro128Plus& rand, uint64_t bound, uint64_t mask){
+    uint64_t result = rand.next() & mask;
+    while (result >= bound){
+        result = rand.next() & mask;
+    }
+    return result;
+}
+PA_FORCE_INLINE uint64_t power_of_two_mask(uint64_t bound){
+    uint64_t mask = 1;
+    while (mask < bound){
+        mask <<= 1;
+    }
+    return mask - 1;
+}
+
+void calculate_prize_ids(SeedPrizes& prizes, int64_t seed, PrintMode mode, size_t count){
+    const PrizeTables& tables = prize_tables();
+    const std::vector<PrizeSlot>& table = mode == PrintMode::BallBonus
+        ? tables.ball_table
+        : tables.item_table;
+    const uint64_t table_size = table.size();
+    const uint64_t table_mask = power_of_two_mask(table_size);
 
     Pokemon::Xoroshiro128Plus rand(seed, 0x82A2B175229D6A5B);
 
-    PrintMode return_mode = PrintMode::Regular;
-    std::array<std::string, 10> ret;
-    for (size_t c = 0; c < 10; c++){
+    prizes.bonus = PrintMode::Regular;
+    for (size_t c = 0; c < count; c++){
         //  Always check for next bonus mode, even if not possible.
-        uint64_t roll = rand.nextInt(1000);
+        uint64_t roll = next_int(rand, 1000, 1023);
         bool bonus = roll < 20;
 
         //  Determine the item to print.
-        uint64_t item_roll = rand.nextInt(table.size());
-        const ItemPrinterItemData& item = *table[item_roll];
-        ret[c] = item.slug;
+        const PrizeSlot& item = table[next_int(rand, table_size, table_mask)];
+        prizes.items[c] = item.id;
 
         //  Determine quantity.
-        if (item.min_quantity != item.max_quantity){
-            rand.nextInt(item.max_quantity - item.min_quantity + 1);
+        uint8_t quantity = item.min_quantity;
+        if (item.quantity_range > 1){
+            quantity += (uint8_t)rand.nextInt(item.quantity_range);
         }
+        prizes.quantities[c] = quantity;
 
         //  If we're lucky enough to get a bonus mode, pick one.
         //  Assume the player has both modes unlocked.
         //  If a bonus mode was previously set, don't recalculate.
-        if (mode == PrintMode::Regular && bonus && return_mode == PrintMode::Regular){
-            return_mode = (PrintMode)(1 + rand.nextInt(2));
+        if (mode == PrintMode::Regular && bonus && prizes.bonus == PrintMode::Regular){
+            prizes.bonus = (PrintMode)(1 + next_int(rand, 2, 1));
         }
-
     }
+}
 
+
+std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
+    const std::vector<std::string>& slugs = prize_slugs();
+
+    SeedPrizes prizes;
+    calculate_prize_ids(prizes, seed, mode);
+
+    std::array<std::string, 10> ret;
+    for (size_t c = 0; c < 10; c++){
+        ret[c] = slugs[prizes.items[c]];
+    }
     return ret;
 }
 
@@ -12,6 +12,10 @@
 #ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedCalc_H
 #define PokemonAutomation_PokemonSV_ItemPrinterSeedCalc_H
 
+#include <stdint.h>
+#include <array>
+#include <string>
+#include <vector>
 #include "PokemonSV_ItemPrinterDatabase.h"
 
 namespace PokemonAutomation{
@@ -20,6 +24,37 @@ namespace PokemonSV{
 namespace ItemPrinter{
 
 
+enum class PrintMode : uint8_t{
+    Regular = 0,
+    ItemBonus = 1,
+    BallBonus = 2,
+};
+
+
+//  Every slug the item printer can print in either table.
+//  Prize IDs are indices into this list.
+const std::vector<std::string>& prize_slugs();
+
+//  Returns -1 if the slug is not a prize.
+int prize_id(const std::string& slug);
+
+
+//  The prizes of a print as prize IDs. Unlike the string version, this does
+//  not allocate.
+struct SeedPrizes{
+    std::array<uint16_t, 10> items;
+    std::array<uint8_t, 10> quantities;
+
+    //  The bonus mode rolled by a regular print. Regular if none.
+    PrintMode bonus;
+};
+
+//  Calculate the first "count" prizes of the seed. (count <= 10)
+void calculate_prize_ids(SeedPrizes& prizes, int64_t seed, PrintMode mode, size_t count = 10);
+
+
+std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode);
+
 DateSeed calculate_seed_prizes(int64_t seed);
 
 
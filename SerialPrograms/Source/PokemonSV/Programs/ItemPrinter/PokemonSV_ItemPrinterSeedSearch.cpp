@@ -0,0 +1,176 @@
+/*  Item Printer Seed Search
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include <mutex>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CancellableScope.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "PokemonSV_ItemPrinterSeedSearch.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+
+//  # of seeds in each unit of work.
+const uint64_t SEED_SEARCH_BLOCK_SIZE = (uint64_t)1 << 16;
+
+
+static bool is_better_match(const SeedSearchMatch& x, const SeedSearchMatch& y){
+    if (x.quantity != y.quantity){
+        return x.quantity > y.quantity;
+    }
+    return x.seed < y.seed;
+}
+
+static void rank_matches(std::vector<SeedSearchMatch>& matches, size_t limit){
+    std::sort(matches.begin(), matches.end(), is_better_match);
+    if (matches.size() > limit){
+        matches.resize(limit);
+    }
+}
+
+//  Merge ranked "new_matches" into ranked "matches".
+//  Returns true if "matches" changed.
+static bool merge_matches(std::vector<SeedSearchMatch>& matches, const std::vector<SeedSearchMatch>& new_matches, size_t limit){
+    if (new_matches.empty()){
+        return false;
+    }
+    std::vector<SeedSearchMatch> merged;
+    merged.reserve(matches.size() + new_matches.size());
+    std::merge(
+        matches.begin(), matches.end(),
+        new_matches.begin(), new_matches.end(),
+        std::back_inserter(merged),
+        is_better_match
+    );
+    if (merged.size() > limit){
+        merged.resize(limit);
+    }
+    bool changed = merged.size() != matches.size() || !std::equal(
+        merged.begin(), merged.end(), matches.begin(),
+        [](const SeedSearchMatch& x, const SeedSearchMatch& y){
+            return x.seed == y.seed;
+        }
+    );
+    matches = std::move(merged);
+    return changed;
+}
+
+
+//  Scan the seeds [first, last] and return the best matches, ranked.
+static std::vector<SeedSearchMatch> search_seed_block(
+    const SeedSearchQuery& query,
+    const std::vector<uint8_t>& desired,
+    int64_t first, int64_t last
+){
+    std::vector<SeedSearchMatch> ret;
+    SeedPrizes prizes;
+    for (int64_t seed = first; seed <= last; seed++){
+        calculate_prize_ids(prizes, seed, query.mode, query.jobs);
+        if (query.desired_bonus != PrintMode::Regular && prizes.bonus != query.desired_bonus){
+            continue;
+        }
+
+        uint32_t quantity = 0;
+        for (size_t c = 0; c < query.jobs; c++){
+            quantity += desired[prizes.items[c]] ? prizes.quantities[c] : 0;
+        }
+        if (quantity < query.min_quantity){
+            continue;
+        }
+
+        ret.emplace_back(SeedSearchMatch{seed, quantity, prizes.bonus});
+
+        //  Don't let this grow unbounded if almost everything matches.
+        if (ret.size() >= 2 * query.max_results){
+            rank_matches(ret, query.max_results);
+        }
+    }
+    rank_matches(ret, query.max_results);
+    return ret;
+}
+
+
+
+std::vector<SeedSearchMatch> search_seeds(
+    const SeedSearchQuery& query,
+    Cancellable* cancellable,
+    SeedSearchListener* listener
+){
+    if (query.jobs < 1 || query.jobs > 10){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid # of jobs: " + std::to_string(query.jobs));
+    }
+    if (query.mode != PrintMode::Regular && query.desired_bonus != PrintMode::Regular){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Bonus modes can only be rolled by regular prints.");
+    }
+    if (query.first_seed > query.last_seed || query.max_results == 0){
+        return {};
+    }
+
+    //  Lookup table of prize ID -> is desired.
+    const size_t prizes = prize_slugs().size();
+    std::vector<uint8_t> desired(prizes, query.desired_items.empty());
+    for (const std::string& slug : query.desired_items){
+        int id = prize_id(slug);
+        if (id < 0){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Item printer cannot print: " + slug);
+        }
+        desired[id] = 1;
+    }
+
+    const uint64_t total = (uint64_t)(query.last_seed - query.first_seed) + 1;
+    const uint64_t blocks = (total + SEED_SEARCH_BLOCK_SIZE - 1) / SEED_SEARCH_BLOCK_SIZE;
+
+    Mutex lock;
+    std::vector<SeedSearchMatch> matches;
+    uint64_t searched = 0;
+
+    GlobalThreadPools::computation_normal().run_in_parallel(
+        [&](size_t index){
+            if (cancellable != nullptr && cancellable->cancelled()){
+                return;
+            }
+
+            int64_t first = query.first_seed + (int64_t)(index * SEED_SEARCH_BLOCK_SIZE);
+            int64_t last = std::min<int64_t>(first + (int64_t)SEED_SEARCH_BLOCK_SIZE - 1, query.last_seed);
+            std::vector<SeedSearchMatch> block_matches = search_seed_block(query, desired, first, last);
+
+            std::lock_guard<Mutex> lg(lock);
+            searched += (uint64_t)(last - first) + 1;
+            bool changed = merge_matches(matches, block_matches, query.max_results);
+            if (listener == nullptr){
+                return;
+            }
+            if (changed){
+                listener->on_matches(matches);
+            }
+            listener->on_progress(searched, total);
+        },
+        0, blocks, 1
+    );
+
+    if (cancellable != nullptr){
+        cancellable->throw_if_cancelled();
+    }
+
+    return matches;
+}
+
+
+
+}
+}
+}
+}
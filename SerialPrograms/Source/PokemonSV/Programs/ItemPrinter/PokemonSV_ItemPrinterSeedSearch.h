@@ -0,0 +1,87 @@
+/*  Item Printer Seed Search
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Search a range of dates for item printer seeds that print the desired
+ *  items or roll a bonus mode.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_H
+#define PokemonAutomation_PokemonSV_ItemPrinterSeedSearch_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "PokemonSV_ItemPrinterSeedCalc.h"
+
+namespace PokemonAutomation{
+    class Cancellable;
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+struct SeedSearchQuery{
+    //  Seeds to search. (inclusive, seconds since epoch)
+    int64_t first_seed = 0;
+    int64_t last_seed = 0;
+
+    //  The mode the print will be done in.
+    PrintMode mode = PrintMode::Regular;
+
+    //  # of prizes in the print. (1 to 10)
+    size_t jobs = 10;
+
+    //  A seed matches if it prints at least "min_quantity" in total of these
+    //  items. If empty, any prize counts.
+    std::vector<std::string> desired_items;
+    uint32_t min_quantity = 1;
+
+    //  If not Regular, the print must also roll this bonus mode.
+    //  Only possible when "mode" is Regular.
+    PrintMode desired_bonus = PrintMode::Regular;
+
+    //  Keep only this many of the best matches.
+    size_t max_results = 100;
+};
+
+struct SeedSearchMatch{
+    int64_t seed;
+
+    //  Total quantity of the desired items.
+    uint32_t quantity;
+
+    //  The bonus mode rolled by the print.
+    PrintMode bonus;
+};
+
+
+//  Callbacks are made from the search threads, but never concurrently.
+struct SeedSearchListener{
+    virtual void on_progress(uint64_t seeds_searched, uint64_t seeds_total){}
+
+    //  The best matches found so far, ranked best first. Called each time
+    //  this list changes.
+    virtual void on_matches(const std::vector<SeedSearchMatch>& matches){}
+};
+
+
+//  Search the seeds in parallel on the computation thread pool.
+//  Returns the best matches, ranked best first: most desired items, then
+//  earliest seed.
+//
+//  Throws if "cancellable" is cancelled before the search finishes.
+std::vector<SeedSearchMatch> search_seeds(
+    const SeedSearchQuery& query,
+    Cancellable* cancellable = nullptr,
+    SeedSearchListener* listener = nullptr
+);
+
+
+
+}
+}
+}
+}
+#endif
@@ -25,7 +25,7 @@ PokemonSpriteMatcherExact::PokemonSpriteMatcherExact(const std::set<std::string>
     for (const auto& item : ALL_POKEMON_SPRITES()){
         if (subset == nullptr || subset->find(item.first) != subset->end()){
 //            cout << item.first << endl;
-            add(item.first, item.second.sprite.copy());
+            add(item.first, item.second.sprite, item.second.sprite_stats);
         }
     }
 }
@@ -55,7 +55,7 @@ PokemonSpriteMatcherCropped::PokemonSpriteMatcherCropped(const std::set<std::str
     for (const auto& item : ALL_POKEMON_SPRITES()){
         if (subset == nullptr || subset->find(item.first) != subset->end()){
 //            cout << item.first << endl;
-            add(item.first, item.second.sprite);
+            add_cropped(item.first, item.second.icon, item.second.icon_stats);
         }
     }
 }
@@ -4,6 +4,7 @@
  *
  */
 
+#include <cmath>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -20,15 +21,42 @@ namespace PokemonSwSh{
 namespace MaxLairInternal{
 
 
+//  # of columns in the type tables. Indexed by PokemonType.
+const size_t TYPE_COUNT = (size_t)PokemonType::FAIRY + 1;
+
+
 struct PathMatchDatabase{
     std::map<PokemonType, std::set<std::string>> rentals_by_type;
-    std::map<std::string, std::map<PokemonType, double>> type_vs_boss;
+
+    //  Boss slugs are interned to dense IDs at load time.
+    std::map<std::string, size_t> boss_ids;
+
+    //  bosses x TYPE_COUNT, row-major. The NONE column is NaN.
+    std::vector<double> type_vs_boss;
+
+    //  TYPE_COUNT x TYPE_COUNT. Row "t" is the average of type_vs_boss over
+    //  all the bosses that have type "t". Row NONE is over all bosses.
+    std::vector<double> type_vs_boss_type;
 
     static const PathMatchDatabase& instance(){
         static PathMatchDatabase database;
         return database;
     }
 
+    const double* boss_row(const std::string& boss_slug) const{
+        auto iter = boss_ids.find(boss_slug);
+        if (iter == boss_ids.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
+        }
+        return &type_vs_boss[iter->second * TYPE_COUNT];
+    }
+    const double* boss_type_row(PokemonType boss_type) const{
+        if ((size_t)boss_type >= TYPE_COUNT){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)boss_type));
+        }
+        return &type_vs_boss_type[(size_t)boss_type * TYPE_COUNT];
+    }
+
 private:
     PathMatchDatabase(){
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/path_tree.json";
@@ -52,7 +80,11 @@ private:
 
         JsonObject& node = root.get_object_throw("base_node", path).get_object_throw("hash_table");
         for (auto& item : node){
-            std::map<PokemonType, double>& boss = type_vs_boss[item.first];
+            if (!boss_ids.emplace(item.first, boss_ids.size()).second){
+                continue;
+            }
+            type_vs_boss.resize(boss_ids.size() * TYPE_COUNT, std::nan(""));
+            double* row = &type_vs_boss[(boss_ids.size() - 1) * TYPE_COUNT];
 
             JsonObject& obj = item.second.to_object_throw(path).get_object_throw("hash_table", path);
 
@@ -60,8 +92,44 @@ private:
                 if (type.first == PokemonType::NONE){
                     continue;
                 }
-                boss[type.first] = obj.get_double_throw(type.second, path);
+                row[(size_t)type.first] = obj.get_double_throw(type.second, path);
+            }
+        }
+
+        build_boss_type_table();
+    }
+
+    void build_boss_type_table(){
+        using namespace papkmnlib;
+
+        //  A boss that's missing from the table makes its rows NaN so that
+        //  they throw when used.
+        std::vector<const double*> boss_rows;
+        std::vector<const Pokemon*> bosses;
+        for (const auto& item : all_bosses_by_dex()){
+            auto iter = boss_ids.find(item.second);
+            boss_rows.emplace_back(iter == boss_ids.end() ? nullptr : &type_vs_boss[iter->second * TYPE_COUNT]);
+            bosses.emplace_back(&get_pokemon(item.second));
+        }
+
+        type_vs_boss_type.resize(TYPE_COUNT * TYPE_COUNT);
+        for (size_t boss_type = 0; boss_type < TYPE_COUNT; boss_type++){
+            Type pkmnlib_type = serial_type_to_pkmnlib((PokemonType)boss_type);
+            double* row = &type_vs_boss_type[boss_type * TYPE_COUNT];
+            size_t count = 0;
+            for (size_t c = 0; c < bosses.size(); c++){
+                if (boss_type != (size_t)PokemonType::NONE && !bosses[c]->has_type(pkmnlib_type)){
+                    continue;
+                }
+                for (size_t type = 0; type < TYPE_COUNT; type++){
+                    row[type] += boss_rows[c] == nullptr ? std::nan("") : boss_rows[c][type];
+                }
+                count++;
+            }
+            for (size_t type = 0; type < TYPE_COUNT; type++){
+                row[type] /= (double)count;
             }
+            row[(size_t)PokemonType::NONE] = std::nan("");
         }
     }
 
@@ -78,37 +146,18 @@ const std::set<std::string>& rentals_by_type(PokemonType type){
     return iter->second;
 }
 
-double type_vs_boss(PokemonType type, const std::string& boss_slug){
-    const PathMatchDatabase& database = PathMatchDatabase::instance();
-
-    auto iter0 = database.type_vs_boss.find(boss_slug);
-    if (iter0 == database.type_vs_boss.end()){
-        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Boss: " + boss_slug);
-    }
-
-    auto iter1 = iter0->second.find(type);
-    if (iter1 == iter0->second.end()){
+//  Look up a type in a row of one of the type tables.
+static double type_vs_boss(PokemonType type, const double* row){
+    if ((size_t)type >= TYPE_COUNT || std::isnan(row[(size_t)type])){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Invalid Type: " + std::to_string((int)type));
     }
-
-    return iter1->second;
+    return row[(size_t)type];
+}
+double type_vs_boss(PokemonType type, const std::string& boss_slug){
+    return type_vs_boss(type, PathMatchDatabase::instance().boss_row(boss_slug));
 }
 double type_vs_boss(PokemonType type, PokemonType boss_type){
-    using namespace papkmnlib;
-
-    Type pkmnlib_type = serial_type_to_pkmnlib(boss_type);
-
-    double weight = 0;
-    size_t count = 0;
-    for (const auto& item : all_bosses_by_dex()){
-        const Pokemon& boss = get_pokemon(item.second);
-        if (boss_type == PokemonType::NONE || boss.has_type(pkmnlib_type)){
-            weight += type_vs_boss(type, boss.name());
-            count++;
-        }
-    }
-
-    return weight / (double)count;
+    return type_vs_boss(type, PathMatchDatabase::instance().boss_type_row(boss_type));
 }
 
 
@@ -227,8 +276,8 @@ std::vector<std::vector<PathNode>> generate_paths(
 }
 
 
-template <typename Boss>
-double evaluate_path(const Boss& boss, const std::vector<PathNode>& path){
+//  "boss" is a row of one of the type tables.
+double evaluate_path(const double* boss, const std::vector<PathNode>& path){
     if (path.size() > 3){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Path is longer than 3: " + std::to_string(path.size()));
     }
@@ -262,15 +311,15 @@ std::vector<PathNode> select_path(
         return {};
     }
 
+    //  Resolve the boss once. Each path is then just a few table lookups.
+    const PathMatchDatabase& database = PathMatchDatabase::instance();
+    const double* boss_row = boss.empty()
+        ? database.boss_type_row(pathmap.boss)
+        : database.boss_row(boss);
+
     std::multimap<double, std::vector<PathNode>, std::greater<double>> rank;
-    if (boss.empty()){
-        for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(pathmap.boss, path), path);
-        }
-    }else{
-        for (const std::vector<PathNode>& path : paths){
-            rank.emplace(evaluate_path(boss, path), path);
-        }
+    for (const std::vector<PathNode>& path : paths){
+        rank.emplace(evaluate_path(boss_row, path), path);
     }
     std::string str = "Available Paths:\n";
     for (const auto& path : rank){
@@ -4,6 +4,7 @@
  *
  */
 
+#include <cmath>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Json/JsonValue.h"
@@ -20,23 +21,46 @@ namespace MaxLairInternal{
 
 
 struct MatchupDatabase{
-    std::map<std::string, std::map<std::string, double>> map;
+    //  Slugs are interned to dense IDs at load time.
+    std::map<std::string, size_t> rental_ids;
+    std::map<std::string, size_t> boss_ids;
+    std::vector<std::string> bosses;
+
+    //  rentals x bosses, row-major. NaN for pairs missing from the JSON.
+    std::vector<double> matchups;
+
+    //  Average over all_rental_pokemon() for each boss.
+    std::vector<double> average_by_boss;
 
     static const MatchupDatabase& instance(){
         static MatchupDatabase database;
         return database;
     }
 
-    double get(const std::string& rental, const std::string& boss) const{
-        auto iter0 = map.find(rental);
-        if (iter0 == map.end()){
+    size_t rental_id(const std::string& rental) const{
+        auto iter = rental_ids.find(rental);
+        if (iter == rental_ids.end()){
             throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Rental not found: " + rental);
         }
-        auto iter1 = iter0->second.find(boss);
-        if (iter1 == iter0->second.end()){
-            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + rental);
+        return iter->second;
+    }
+    size_t boss_id(const std::string& boss) const{
+        auto iter = boss_ids.find(boss);
+        if (iter == boss_ids.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + boss);
+        }
+        return iter->second;
+    }
+
+    double get(size_t rental_id, size_t boss_id) const{
+        if (rental_id >= rental_ids.size() || boss_id >= bosses.size()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Matchup ID out of range.");
+        }
+        double ret = matchups[rental_id * bosses.size() + boss_id];
+        if (std::isnan(ret)){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + bosses[boss_id]);
         }
-        return iter1->second;
+        return ret;
     }
 
 private:
@@ -44,32 +68,88 @@ private:
         std::string path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
         JsonValue json = load_json_file(path);
         JsonObject& root = json.to_object_throw(path);
+
+        //  First pass: assign the IDs.
+        for (auto& item0 : root){
+            rental_ids.emplace(item0.first, rental_ids.size());
+            JsonObject& obj = item0.second.to_object_throw(path);
+            for (auto& item1 : obj){
+                if (boss_ids.emplace(item1.first, bosses.size()).second){
+                    bosses.emplace_back(item1.first);
+                }
+            }
+        }
+
+        //  Second pass: fill in the matrix.
+        matchups.resize(rental_ids.size() * bosses.size(), std::nan(""));
         for (auto& item0 : root){
-            std::map<std::string, double>& sub = map[item0.first];
+            double* row = &matchups[rental_ids[item0.first] * bosses.size()];
             JsonObject& obj = item0.second.to_object_throw(path);
             for (auto& item1 : obj){
-                sub[item1.first] = item1.second.to_double_throw(path);
+                row[boss_ids[item1.first]] = item1.second.to_double_throw(path);
             }
         }
+
+        //  A rental that's missing from the table leaves the averages as NaN
+        //  so they throw when used. (same as looking it up by slug)
+        const std::map<std::string, papkmnlib::Pokemon>& all_rentals = papkmnlib::all_rental_pokemon();
+        average_by_boss.resize(bosses.size(), 0);
+        for (const auto& rental : all_rentals){
+            auto iter = rental_ids.find(rental.first);
+            const double* row = iter == rental_ids.end()
+                ? nullptr
+                : &matchups[iter->second * bosses.size()];
+            for (size_t boss = 0; boss < bosses.size(); boss++){
+                average_by_boss[boss] += row == nullptr ? std::nan("") : row[boss];
+            }
+        }
+        for (double& score : average_by_boss){
+            score /= all_rentals.size();
+        }
     }
 };
 
+size_t rental_matchup_id(const std::string& rental){
+    return MatchupDatabase::instance().rental_id(rental);
+}
+size_t boss_matchup_id(const std::string& boss){
+    return MatchupDatabase::instance().boss_id(boss);
+}
+double rental_vs_boss_matchup(size_t rental_id, size_t boss_id){
+    return MatchupDatabase::instance().get(rental_id, boss_id);
+}
+double average_rental_vs_boss_matchup(size_t boss_id){
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    if (boss_id >= database.bosses.size()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Matchup ID out of range.");
+    }
+    double ret = database.average_by_boss[boss_id];
+    if (std::isnan(ret)){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Boss not found: " + database.bosses[boss_id]);
+    }
+    return ret;
+}
+
 double rental_vs_boss_matchup(const std::string& rental, const std::string& boss){
-    return MatchupDatabase::instance().get(rental, boss);
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    return database.get(database.rental_id(rental), database.boss_id(boss));
 }
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses){
     using namespace papkmnlib;
 
+    const MatchupDatabase& database = MatchupDatabase::instance();
+    size_t rental_id = database.rental_id(rental);
+
     double score = 0;
     if (bosses.empty()){
         const auto& all_bosses = all_boss_pokemon();
         for (const auto& boss : all_bosses){
-            score += rental_vs_boss_matchup(rental, boss.second.name());
+            score += database.get(rental_id, database.boss_id(boss.second.name()));
         }
-        score /= bosses.size();
+        score /= all_bosses.size();
     }else{
         for (const std::string& boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss);
+            score += database.get(rental_id, database.boss_id(boss));
         }
         score /= bosses.size();
     }
@@ -20,6 +20,16 @@ double rental_vs_boss_matchup(const std::string& rental, const std::string& boss
 double rental_vs_boss_matchup(const std::string& rental, const std::vector<std::string>& bosses);
 
 
+//  The matchup table is stored as a dense (rental x boss) matrix. Resolve the
+//  slugs to IDs once and use these in loops. Throws if the slug isn't known.
+size_t rental_matchup_id(const std::string& rental);
+size_t boss_matchup_id(const std::string& boss);
+double rental_vs_boss_matchup(size_t rental_id, size_t boss_id);
+
+//  Average matchup of all the rentals against this boss.
+double average_rental_vs_boss_matchup(size_t boss_id);
+
+
 
 }
 }
@@ -4,6 +4,7 @@
  *
  */
 
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Matchup.h"
 #include "PokemonSwSh/Resources/PokemonSwSh_TypeMatchup.h"
 #include "PokemonSwSh/Resources/PokemonSwSh_MaxLairDatabase.h"
@@ -56,7 +57,8 @@ std::pair<uint8_t, bool> select_move_ai(
         teammates_v.emplace_back(item.get());
     }
 
-    std::multimap<double, std::pair<uint8_t, bool>, std::greater<double>> rank;
+    //  Collect the candidates first so they can be scored in parallel.
+    std::vector<std::pair<uint8_t, bool>> candidates;
 
     //  No dmax.
     if (state.players[player_index].dmax_turns_left <= 0){
@@ -67,39 +69,51 @@ std::pair<uint8_t, bool> select_move_ai(
             if (state.players[player_index].move_blocked[c]){
                 continue;
             }
-            double score = calc_move_score(*self, boss, teammates_v, c, field);
-            rank.emplace(
-                score,
-                std::pair<uint8_t, bool>{(uint8_t)c, false}
-            );
+            candidates.emplace_back((uint8_t)c, false);
         }
     }
 
     //  Dmax
-    self->set_is_dynamax(true);
+    Pokemon self_dmax = *self;
+    self_dmax.set_is_dynamax(true);
     if (state.players[player_index].dmax_turns_left > 0 || state.players[player_index].can_dmax){
-        for (size_t c = 0; c < self->num_moves(); c++){
-            if (self->pp(c) <= 0){
+        for (size_t c = 0; c < self_dmax.num_moves(); c++){
+            if (self_dmax.pp(c) <= 0){
                 continue;
             }
             if (state.players[player_index].move_blocked[c]){
                 continue;
             }
-            double score = calc_move_score(*self, boss, teammates_v, c, field);
-            rank.emplace(
-                score,
-                std::pair<uint8_t, bool>{(uint8_t)c, true}
-            );
+            candidates.emplace_back((uint8_t)c, true);
         }
     }
 
+    //  Each score is a full damage calc against the boss and all teammates.
+    //  With 4 consoles, all of them are picking moves at the same time.
+    std::vector<double> scores(candidates.size());
+    GlobalThreadPools::computation_normal().run_in_parallel(
+        [&](size_t index){
+            const std::pair<uint8_t, bool>& candidate = candidates[index];
+            scores[index] = calc_move_score(
+                candidate.second ? self_dmax : *self,
+                boss, teammates_v, candidate.first, field
+            );
+        },
+        0, candidates.size(), 1
+    );
+
+    std::multimap<double, std::pair<uint8_t, bool>, std::greater<double>> rank;
+    for (size_t c = 0; c < candidates.size(); c++){
+        rank.emplace(scores[c], candidates[c]);
+    }
+
     //  Print options and scores.
     std::string move_dump = "Move Score:\n";
     for (const auto& move : rank){
         uint8_t slot = move.second.first;
         move_dump += std::to_string(move.first) + " : ";
         move_dump += move.second.second
-            ? self->max_move(slot).name()
+            ? self_dmax.max_move(slot).name()
             : self->move(slot).name();
         move_dump += "\n";
     }
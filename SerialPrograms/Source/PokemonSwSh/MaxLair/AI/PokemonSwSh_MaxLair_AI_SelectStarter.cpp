@@ -44,10 +44,11 @@ int8_t select_starter(
             continue;
         }
 //        const Pokemon& rental = get_pokemon(options[c]);
+        size_t rental_id = rental_matchup_id(options[c]);
         double score = 0;
         for (const Pokemon* boss : bosses){
 //            score += evaluate_matchup(rental, *boss, {}, 4);
-            score += rental_vs_boss_matchup(options[c], boss->name());
+            score += rental_vs_boss_matchup(rental_id, boss_matchup_id(boss->name()));
         }
         score /= bosses.size();
         rank.emplace(score, c);
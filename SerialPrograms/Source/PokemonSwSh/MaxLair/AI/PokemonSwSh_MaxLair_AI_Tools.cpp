@@ -100,17 +100,15 @@ double rental_vs_boss_matchup(const std::string& rental, const std::vector<const
     double score = 0;
     if (rental.empty()){
         for (const Pokemon* boss : bosses){
-            for (const auto& candidate : all_rental_pokemon()){
-                score += rental_vs_boss_matchup(candidate.first, boss->name());
-            }
+            score += average_rental_vs_boss_matchup(boss_matchup_id(boss->name()));
         }
-        score /= bosses.size() * all_rental_pokemon().size();
     }else{
+        size_t rental_id = rental_matchup_id(rental);
         for (const Pokemon* boss : bosses){
-            score += rental_vs_boss_matchup(rental, boss->name());
+            score += rental_vs_boss_matchup(rental_id, boss_matchup_id(boss->name()));
         }
-        score /= bosses.size();
     }
+    score /= bosses.size();
     return score;
 }
 double rental_vs_boss_matchup(const papkmnlib::Pokemon* rental, const std::vector<const papkmnlib::Pokemon*>& bosses){
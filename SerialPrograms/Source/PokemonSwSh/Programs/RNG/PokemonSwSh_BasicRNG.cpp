@@ -89,9 +89,7 @@ std::pair<Xoroshiro128PlusState, uint64_t> refind_rng_state_and_animations(
 )
 {
     Xoroshiro128Plus rng(last_known_state.s0, last_known_state.s1);
-    for (size_t i = 0; i < min_advances; i++){
-        rng.next();
-    }
+    rng.advance(min_advances);
     OrbeetleAttackAnimationDetector detector(stream, context);
     size_t possible_indices = SIZE_MAX;
     std::vector<bool> sequence = {};
@@ -145,9 +143,7 @@ std::pair<Xoroshiro128PlusState, uint64_t> refind_rng_state_and_animations(
     distance += sequence.size();
     stream.log("RNG: needed " + std::to_string(sequence.size()) + " animations.");
     stream.log("RNG: new state is " + std::to_string(distance + min_advances) + " advances from last known state.");
-    for (size_t advance = 0; advance < distance; advance++){
-        rng.next();
-    }
+    rng.advance(distance);
     stream.log("RNG: state[0] = " + tostr_hex(rng.get_state().s0));
     stream.log("RNG: state[1] = " + tostr_hex(rng.get_state().s1));
 
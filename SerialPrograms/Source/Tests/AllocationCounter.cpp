@@ -0,0 +1,80 @@
+/*  Allocation Counter
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Only built with PA_COUNT_ALLOCATIONS. (see AllocationCounter.h)
+ *
+ */
+
+#include <stdlib.h>
+#include <new>
+#include "AllocationCounter.h"
+
+namespace PokemonAutomation{
+
+
+static thread_local AllocationScope* current_scope = nullptr;
+
+AllocationScope::AllocationScope()
+    : m_parent(current_scope)
+{
+    current_scope = this;
+}
+AllocationScope::~AllocationScope(){
+    current_scope = m_parent;
+}
+
+void AllocationScope::count_allocation(){
+    AllocationScope* scope = current_scope;
+    if (scope != nullptr){
+        scope->m_allocations++;
+    }
+}
+
+
+}
+
+
+//  Replacements for the global operator new/delete. Everything else (aligned
+//  and placement forms) keeps the default implementation.
+//
+//  These only add a thread-local increment to each allocation. The matching
+//  deletes are replaced as well so that both sides agree on malloc()/free().
+
+void* operator new(size_t size){
+    PokemonAutomation::AllocationScope::count_allocation();
+    void* ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr){
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+void* operator new[](size_t size){
+    return operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept{
+    PokemonAutomation::AllocationScope::count_allocation();
+    return malloc(size == 0 ? 1 : size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept{
+    return operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept{
+    free(ptr);
+}
+void operator delete[](void* ptr) noexcept{
+    free(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept{
+    free(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept{
+    free(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept{
+    free(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept{
+    free(ptr);
+}
@@ -0,0 +1,64 @@
+/*  Allocation Counter
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Counts calls to the global operator new so the command line tests can
+ *  report how many allocations each test file makes.
+ *
+ *  Counting replaces the global operator new/delete of the whole program. So
+ *  it is only built with the CMake option PA_COUNT_ALLOCATIONS. Otherwise
+ *  AllocationScope counts nothing and the reports leave the column out.
+ *
+ *  Allocations made on other threads on behalf of the caller (e.g. inside a
+ *  nested run_in_parallel()) are not included. In parallel mode, a test that
+ *  waits on a global thread pool may run, and be charged for, pool work that
+ *  belongs to another test. Use serial mode for exact counts of those tests.
+ *
+ */
+
+#ifndef PokemonAutomation_Tests_AllocationCounter_H
+#define PokemonAutomation_Tests_AllocationCounter_H
+
+#include <stdint.h>
+
+namespace PokemonAutomation{
+
+
+#ifdef PA_COUNT_ALLOCATIONS
+constexpr bool ALLOCATION_COUNTING_ENABLED = true;
+#else
+constexpr bool ALLOCATION_COUNTING_ENABLED = false;
+#endif
+
+
+//  Counts the allocations made by the calling thread while the scope is alive.
+//  Scopes nest. An allocation is only counted by the innermost scope. So a job
+//  that another job's thread picks up while it waits isn't charged to both.
+class AllocationScope{
+public:
+#ifdef PA_COUNT_ALLOCATIONS
+    AllocationScope();
+    ~AllocationScope();
+#else
+    AllocationScope() = default;
+#endif
+    AllocationScope(const AllocationScope&) = delete;
+    void operator=(const AllocationScope&) = delete;
+
+    uint64_t allocations() const{
+        return m_allocations;
+    }
+
+public:
+    //  Called by the replacement operator new.
+    static void count_allocation();
+
+private:
+    AllocationScope* m_parent = nullptr;
+    uint64_t m_allocations = 0;
+};
+
+
+
+}
+#endif
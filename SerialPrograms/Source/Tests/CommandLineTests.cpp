@@ -7,13 +7,21 @@
 
 #include "CommandLineTests.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/Backends/ThreadPool_Default.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "AllocationCounter.h"
 #include "PokemonLA_Tests.h"
 #include "TestMap.h"
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <functional>
@@ -43,26 +51,18 @@ void print_equals(){
         } \
     } while (0)
 
-#define RETURN_IF_TEST_FAILED(test_func, file_path, num_passed) \
-    do { \
-        int _ret = 0; \
-        try{ \
-            _ret = test_func(file_path); \
-        }catch (const std::exception& e){ \
-            cout << "Test: " << (file_path) << " threw exception: " << e.what() << endl; \
-            _ret = 1; \
-        }catch (const Exception& e){\
-           cout << "Test: " << (file_path) << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl; \
-           _ret = 1; \
-        } \
-        if (_ret > 0){\
-            print_equals(); \
-            cout << "Test: " << (file_path) << " failed." << endl; \
-            return _ret; \
-        }else if (_ret == 0){ \
-            num_passed++; \
-        } \
-    }while (0)
+//  One test file to run with the test function of its test object.
+struct TestJob{
+    std::string test_name;      //  "<test space>/<test object>"
+    TestFunction test_func;
+    std::string file_path;
+};
+struct TestResult{
+    int ret = 0;
+    std::string error;
+    uint64_t microseconds = 0;
+    uint64_t allocations = 0;
+};
 
 bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ignore_list){
     for (const auto& path_prefix : ignore_list){
@@ -74,16 +74,15 @@ bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ign
     return false;
 }
 
-int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size_t& num_passed, const std::vector<QString>& ignore_list){
+//  Collect the test files under a folder of a test object.
+void collect_test_obj_dir(
+    std::vector<TestJob>& jobs,
+    const std::string& test_name, const TestFunction& test_func,
+    const QString& directory_path, const std::vector<QString>& ignore_list
+){
     QDirIterator file_iter(directory_path, QDir::Filter::Files, QDirIterator::IteratorFlag::Subdirectories);
 
-    bool first_test_file = true;
     while (file_iter.hasNext()){
-        if (first_test_file == false){
-            cout << "-------------------------------------------" << endl;
-        }
-        first_test_file = false;
-
         const QString next_file = file_iter.next();
         
         // If filename or folder name starts with _, its considered a "hidden" file so skip it.
@@ -98,43 +97,36 @@ int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size
             continue;
         }
 
-        // Call the function to do the actual test:
-        cout << file_path << endl;
-        RETURN_IF_TEST_FAILED(test_func, file_path, num_passed);
+        jobs.emplace_back(TestJob{test_name, test_func, file_path});
     }
-
-    return 0;
 }
 
 // Run the tests inside a folder representing a "test object".
 // It is usually defined as one detector, e.g. CommandLineTests/PokemonLA/BattleMenuDetector/
-int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+void collect_test_obj(std::vector<TestJob>& jobs, const std::string& test_space, const QFileInfo& obj_info, const std::vector<QString>& ignore_list){
     const std::string test_name = obj_info.fileName().toStdString();
     if (test_name == "." || test_name == ".."){
-        return 0;
+        return;
     }
 
-    print_equals();
     const TestFunction test_func = find_test_function(test_space, test_name);
     if (test_func == nullptr){
         // No corresponding test code, skip the folder.
-        return 0;
+        return;
     }
 
     if (skip_ignored_path(obj_info.filePath(), ignore_list)){
-        return 0;
+        return;
     }
 
-    cout << "Testing " << test_name << ":" << endl;
-
     // Recursively get test filenames, like:
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/IngoBattleMenuDayTime_True.png
-    return run_test_obj_dir(test_func, obj_info.filePath(), num_passed, ignore_list);
+    collect_test_obj_dir(jobs, test_space + "/" + test_name, test_func, obj_info.filePath(), ignore_list);
 }
 
 // Run the tests inside a folder representing a "test space".
 // It is usually defined as one pokemon game, e.g. CommandLineTests/PokemonLA/
-int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+int collect_test_space(std::vector<TestJob>& jobs, const QFileInfo& space_info, const std::vector<QString>& ignore_list){
     QDir sub_dir(space_info.filePath());
     if (!sub_dir.exists()){
         cerr << "Error: cannot access " << space_info.filePath().toStdString() << endl;
@@ -156,7 +148,7 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/
     const QFileInfoList obj_list = sub_dir.entryInfoList();
     for (const QFileInfo& obj_info : obj_list){
-        RETURN_IF_NOT_ZERO(run_test_obj(test_space, obj_info, num_passed, ignore_list));
+        collect_test_obj(jobs, test_space, obj_info, ignore_list);
     }
 
     return 0;
@@ -164,6 +156,215 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
 
 
 
+//  Run one test file. Exceptions count as failures.
+void run_test_job(const TestJob& job, TestResult& result){
+    AllocationScope allocations;
+    WallClock time0 = current_time();
+    try{
+        result.ret = job.test_func(job.file_path);
+    }catch (const std::exception& e){
+        result.error = std::string("threw exception: ") + e.what();
+        result.ret = 1;
+    }catch (const Exception& e){
+        result.error = std::string("threw ") + e.name() + ": <<<" + e.message() + ">>>";
+        result.ret = 1;
+    }
+    WallClock time1 = current_time();
+    result.microseconds = std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    result.allocations = allocations.allocations();
+}
+
+//  Run the tests one at a time. Stops at the first failure.
+//  Returns the # of tests that were run.
+size_t run_tests_serial(const std::vector<TestJob>& jobs, std::vector<TestResult>& results){
+    const std::string* current_test = nullptr;
+    for (size_t c = 0; c < jobs.size(); c++){
+        const TestJob& job = jobs[c];
+        if (current_test == nullptr || *current_test != job.test_name){
+            print_equals();
+            cout << "Testing " << job.test_name << ":" << endl;
+            current_test = &job.test_name;
+        }else{
+            cout << "-------------------------------------------" << endl;
+        }
+        cout << job.file_path << endl;
+
+        TestResult& result = results[c];
+        run_test_job(job, result);
+        if (!result.error.empty()){
+            cout << "Test: " << job.file_path << " " << result.error << endl;
+        }
+        if (result.ret > 0){
+            print_equals();
+            cout << "Test: " << job.file_path << " failed." << endl;
+            return c + 1;
+        }
+    }
+    return jobs.size();
+}
+
+//  Shard the test files across a pool of their own. Everything runs to
+//  completion. The failures are printed afterwards in test order.
+//
+//  The pool is separate from the global computation pools so that a test that
+//  calls run_in_parallel() on those never picks up another test file while it
+//  waits. That would add the other test to its time and allocation counts.
+size_t run_tests_parallel(const std::vector<TestJob>& jobs, std::vector<TestResult>& results){
+    ThreadPool_Default pool(
+        [](){},
+        0, GlobalThreadPools::computation_normal().max_threads()
+    );
+    print_equals();
+    cout << "Running " << jobs.size() << " test files on up to " << pool.max_threads() << " threads..." << endl;
+
+    pool.run_in_parallel(
+        [&](size_t index){
+            run_test_job(jobs[index], results[index]);
+        },
+        0, jobs.size(), 1
+    );
+
+    for (size_t c = 0; c < jobs.size(); c++){
+        const TestResult& result = results[c];
+        if (result.ret <= 0){
+            continue;
+        }
+        print_equals();
+        if (!result.error.empty()){
+            cout << "Test: " << jobs[c].file_path << " " << result.error << endl;
+        }
+        cout << "Test: " << jobs[c].file_path << " failed." << endl;
+    }
+    return jobs.size();
+}
+
+
+
+const char* result_to_string(const TestResult& result){
+    if (result.ret > 0){
+        return "failed";
+    }
+    if (result.ret < 0){
+        return "skipped";
+    }
+    return "passed";
+}
+
+//  Write the timings of the tests that were run. Rows are sorted by test and
+//  file with paths relative to the test folder so that reports from different
+//  builds or machines can be diffed directly.
+//  The format is CSV if the filename ends in ".csv". Otherwise it is JSON with
+//  an additional summary for each test object. Allocations are only reported
+//  when they are counted. (see AllocationCounter.h)
+void write_test_report(
+    const std::string& filename,
+    const QDir& root_dir,
+    const std::vector<TestJob>& jobs,
+    const std::vector<TestResult>& results,
+    size_t tests_run
+){
+    struct Row{
+        const std::string* test_name;
+        std::string file;
+        const TestResult* result;
+    };
+    std::vector<Row> rows;
+    for (size_t c = 0; c < tests_run; c++){
+        rows.emplace_back(Row{
+            &jobs[c].test_name,
+            root_dir.relativeFilePath(QString::fromStdString(jobs[c].file_path)).toStdString(),
+            &results[c]
+        });
+    }
+    std::sort(
+        rows.begin(), rows.end(),
+        [](const Row& x, const Row& y){
+            if (*x.test_name != *y.test_name){
+                return *x.test_name < *y.test_name;
+            }
+            return x.file < y.file;
+        }
+    );
+
+    if (QString::fromStdString(filename).endsWith(".csv", Qt::CaseInsensitive)){
+        std::string csv = ALLOCATION_COUNTING_ENABLED
+            ? "Test,File,Result,Microseconds,Allocations\n"
+            : "Test,File,Result,Microseconds\n";
+        for (const Row& row : rows){
+            std::string file;
+            for (char ch : row.file){
+                if (ch == '"'){
+                    file += '"';
+                }
+                file += ch;
+            }
+            csv += *row.test_name;
+            csv += ",\"" + file + "\",";
+            csv += result_to_string(*row.result);
+            csv += "," + std::to_string(row.result->microseconds);
+            if (ALLOCATION_COUNTING_ENABLED){
+                csv += "," + std::to_string(row.result->allocations);
+            }
+            csv += "\n";
+        }
+        string_to_file(filename, csv);
+        return;
+    }
+
+    JsonArray files;
+    JsonArray detectors;
+    for (size_t c = 0; c < rows.size();){
+        const std::string& test_name = *rows[c].test_name;
+        size_t passed = 0;
+        size_t failed = 0;
+        size_t skipped = 0;
+        uint64_t total_us = 0;
+        uint64_t max_us = 0;
+        uint64_t allocations = 0;
+        for (; c < rows.size() && *rows[c].test_name == test_name; c++){
+            const TestResult& result = *rows[c].result;
+            JsonObject file;
+            file["Test"] = test_name;
+            file["File"] = rows[c].file;
+            file["Result"] = result_to_string(result);
+            file["Microseconds"] = (int64_t)result.microseconds;
+            if (ALLOCATION_COUNTING_ENABLED){
+                file["Allocations"] = (int64_t)result.allocations;
+            }
+            files.push_back(std::move(file));
+
+            if (result.ret > 0){
+                failed++;
+            }else if (result.ret < 0){
+                skipped++;
+            }else{
+                passed++;
+            }
+            total_us += result.microseconds;
+            max_us = std::max(max_us, result.microseconds);
+            allocations += result.allocations;
+        }
+        JsonObject detector;
+        detector["Test"] = test_name;
+        detector["Passed"] = (int64_t)passed;
+        detector["Failed"] = (int64_t)failed;
+        detector["Skipped"] = (int64_t)skipped;
+        detector["TotalMicroseconds"] = (int64_t)total_us;
+        detector["MaxMicroseconds"] = (int64_t)max_us;
+        if (ALLOCATION_COUNTING_ENABLED){
+            detector["Allocations"] = (int64_t)allocations;
+        }
+        detectors.push_back(std::move(detector));
+    }
+
+    JsonObject report;
+    report["TestObjects"] = std::move(detectors);
+    report["TestFiles"] = std::move(files);
+    JsonValue(std::move(report)).dump(filename);
+}
+
+
+
 
 } // end of anonymous namespace
 
@@ -181,7 +382,7 @@ int run_command_line_tests(){
     QFileInfo test_root_info(root_folder_name.c_str());
     cout << "Looking for tests under test root folder: " << root_folder_name << endl;
 
-    size_t num_passed = 0;
+    std::vector<TestJob> jobs;
 
     const auto& selected_test_list = GlobalSettings::instance().COMMAND_LINE_TEST_LIST;
 
@@ -206,7 +407,7 @@ int run_command_line_tests(){
         test_root_dir.setFilter(QDir::Filter::Dirs);
         const QFileInfoList sub_dir_list = test_root_dir.entryInfoList();
         for (const QFileInfo& sub_dir_info : sub_dir_list){
-            RETURN_IF_NOT_ZERO(run_test_space(sub_dir_info, num_passed, ignore_list));
+            RETURN_IF_NOT_ZERO(collect_test_space(jobs, sub_dir_info, ignore_list));
         }
     }else{
         // Only run on selected tests
@@ -259,7 +460,7 @@ int run_command_line_tests(){
             QFileInfo test_space_info(cur_dir.filePath(*it));
             cur_dir = QDir(test_space_info.filePath());
             if (path_components.size() == 1){
-                RETURN_IF_NOT_ZERO(run_test_space(test_space_info, num_passed, ignore_list));
+                RETURN_IF_NOT_ZERO(collect_test_space(jobs, test_space_info, ignore_list));
                 continue;
             }
 
@@ -267,7 +468,7 @@ int run_command_line_tests(){
             std::string test_name = it->toStdString();
             QFileInfo test_obj_info(cur_dir.filePath(*it));
             if (path_components.size() == 2){
-                RETURN_IF_NOT_ZERO(run_test_obj(test_space, test_obj_info, num_passed, ignore_list));
+                collect_test_obj(jobs, test_space, test_obj_info, ignore_list);
                 continue;
             }
 
@@ -276,20 +477,46 @@ int run_command_line_tests(){
                 return 2;
             }
 
-            print_equals();
             if (selected_path_info.isFile()){
-                // Call the function to do the actual test:
-                RETURN_IF_TEST_FAILED(test_func, full_path_cleaned.toStdString(), num_passed);
+                jobs.emplace_back(TestJob{test_space + "/" + test_name, test_func, full_path_cleaned.toStdString()});
             }else{
                 // selected_path_info is a directory, go through each file recursively in the directory
-                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_func, full_path_cleaned, num_passed, ignore_list));
+                collect_test_obj_dir(jobs, test_space + "/" + test_name, test_func, full_path_cleaned, ignore_list);
             }
         } // end selected_test_list
     }
 
+    std::vector<TestResult> results(jobs.size());
+    const size_t tests_run = GlobalSettings::instance().COMMAND_LINE_TEST_PARALLEL
+        ? run_tests_parallel(jobs, results)
+        : run_tests_serial(jobs, results);
+
+    const std::string& report_filename = GlobalSettings::instance().COMMAND_LINE_TEST_REPORT;
+    if (!report_filename.empty()){
+        write_test_report(report_filename, test_root_dir, jobs, results, tests_run);
+        cout << "Test report written to " << report_filename << endl;
+    }
+
+    // Return the error code of the first failed test.
+    size_t num_passed = 0;
+    size_t num_failed = 0;
+    int ret = 0;
+    for (size_t c = 0; c < tests_run; c++){
+        if (results[c].ret == 0){
+            num_passed++;
+        }else if (results[c].ret > 0){
+            if (num_failed++ == 0){
+                ret = results[c].ret;
+            }
+        }
+    }
+
     print_equals();
     cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed" << std::endl;
-    return 0;
+    if (num_failed > 0){
+        cout << num_failed << " test" << (num_failed > 1 ? "s" : "") << " failed" << std::endl;
+    }
+    return ret;
 }
 
 
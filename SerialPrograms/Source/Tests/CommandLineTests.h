@@ -49,6 +49,19 @@
  * or serving as an extra file in case some tests need more than one test files. Files whose parent directory name starts with "_"
  * are skipped as well.
  * 
+ *  Running in parallel and timing reports:
+ * 
+ *  Setting "20-GlobalSettings": "COMMAND_LINE_TESTS": "PARALLEL" to true (or passing --command-line-test-parallel) shards the
+ *  test files across the computation thread pool. Unlike the default serial mode, which stops at the first failure, every test
+ *  runs and the failures are listed at the end. Console output from the tests themselves will be interleaved.
+ *  Test functions must be safe to run concurrently with other tests for this to work.
+ * 
+ *  Setting "20-GlobalSettings": "COMMAND_LINE_TESTS": "REPORT" to a filename (or passing --command-line-test-report <file>)
+ *  writes the result, wall time and # of allocations of each test file to that file. If the filename ends in ".csv", it is
+ *  a CSV with one row per test file. Otherwise it is JSON which also has the totals for each test object.
+ *  The rows are sorted and the paths are relative to the test folder so that reports from two builds can be diffed.
+ *  Allocations are counted on the thread that runs the test only.
+ * 
  *  How to add new test code:
  * 
  *  The test framework calls TestMap.h: find_test_function(test_space, test_obj_name) to find the test function related to a test path.
@@ -5,16 +5,61 @@
  */
 
 
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <map>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <string.h>
+#include <cmath>
+#include <random>
+#include <fstream>
+#include <filesystem>
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "Common/Cpp/Concurrency/Backends/ThreadPool_Default.h"
+#include "Common/Cpp/Concurrency/Backends/ThreadPool_WorkStealing.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Json/JsonTools.h"
+#include "Common/Cpp/Json/JsonParser.h"
+#include "Common/Cpp/Json/JsonBinary.h"
+#include "Common/Cpp/SourceFileCache.h"
+#include "Common/Cpp/SerialConnection/SerialConnection.h"
+#include "Common/PABotBase2/PABotBase2FW_PtyEmulator.h"
+#include "Common/PABotBase2/ReliableConnectionLayer/PABotBase2CC_ReliableStreamConnection.h"
+#include "Common/PABotBase2/Controllers/PABotBase2_Controller_NS_WiredController.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
+#include "CommonFramework/VideoPipeline/VideoTileMap.h"
+#include "CommonFramework/AudioPipeline/Spectrum/AudioSpectrumRing.h"
+#include "CommonFramework/ProgramStats/StatsDatabase.h"
+#include "CommonTools/Images/BinaryImage_FilterRgb32.h"
+#include "CommonTools/Images/SnapshotCachedFilters.h"
+#include "CommonTools/ImageMatch/ImageCropper.h"
+#include "CommonTools/ImageMatch/ExactImageMatcher.h"
+#include "CommonTools/OCR/OCR_TextMatcher.h"
+#include "CommonTools/OCR/OCR_LevenshteinPattern.h"
+#include "CommonTools/Resources/SpriteBundle.h"
 #include "CommonTools/VisualDetectors/BlackBorderDetector.h"
+#include "Controllers/PABotBase2/PABotBase2_DeviceHandle.h"
 #include "CommonFramework_Tests.h"
 #include "TestUtils.h"
 
+#if defined(__linux__)
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
-//#include <iostream>
-//using std::cout;
-//using std::cerr;
-//using std::endl;
+#include <iostream>
+using std::cout;
+using std::cerr;
+using std::endl;
 
 namespace PokemonAutomation{
 
@@ -29,4 +74,1395 @@ int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool t
 }
 
 
+//  Compare ThreadPool_Default against ThreadPool_WorkStealing. Both must get
+//  the same answers. Prints dispatch latency and throughput for each.
+template <typename PoolType>
+int test_thread_pool(const char* name){
+    const size_t threads = std::max((size_t)std::thread::hardware_concurrency(), (size_t)2);
+    PoolType pool(nullptr, threads, threads);
+
+    cout << "---- " << name << " (" << threads << " threads) ----" << endl;
+
+    //  Latency: Time from dispatch() to the task starting.
+    {
+        const size_t TASKS = 20000;
+        std::vector<uint32_t> latencies(TASKS);
+        for (size_t c = 0; c < TASKS; c++){
+            WallClock dispatched = current_time();
+            WallClock started;
+            AsyncTask task = pool.dispatch([&]{ started = current_time(); });
+            task.wait_and_rethrow_exceptions();
+            latencies[c] = (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(started - dispatched).count();
+        }
+        std::sort(latencies.begin(), latencies.end());
+        cout << "Dispatch Latency: p50 = " << latencies[TASKS / 2] / 1000. << " us"
+             << ", p99 = " << latencies[TASKS * 99 / 100] / 1000. << " us" << endl;
+    }
+
+    //  Throughput: Dispatch a lot of tiny tasks, then wait for all of them.
+    {
+        const size_t TASKS = 200000;
+        std::atomic<size_t> counter(0);
+        std::vector<AsyncTask> tasks;
+        tasks.reserve(TASKS);
+        auto time0 = current_time();
+        for (size_t c = 0; c < TASKS; c++){
+            tasks.emplace_back(pool.dispatch([&]{ counter.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        for (AsyncTask& task : tasks){
+            task.wait_and_rethrow_exceptions();
+        }
+        auto time1 = current_time();
+        TEST_RESULT_COMPONENT_EQUAL(counter.load(), TASKS, "dispatch counter");
+        double seconds = std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count() / 1000000.;
+        cout << "Dispatch Throughput: " << TASKS / seconds << " tasks/s" << endl;
+    }
+
+    //  run_in_parallel(): Lots of small calls.
+    {
+        const size_t CALLS = 2000;
+        const size_t INDICES = 10000;
+        std::vector<uint64_t> output(INDICES);
+        uint64_t sum = 0;
+        auto time0 = current_time();
+        for (size_t c = 0; c < CALLS; c++){
+            pool.run_in_parallel(
+                [&](size_t index){ output[index] = index * c; },
+                0, INDICES
+            );
+            sum += std::accumulate(output.begin(), output.end(), (uint64_t)0);
+        }
+        auto time1 = current_time();
+        uint64_t expected = (uint64_t)INDICES * (INDICES - 1) / 2 * ((uint64_t)CALLS * (CALLS - 1) / 2);
+        TEST_RESULT_COMPONENT_EQUAL(sum, expected, "run_in_parallel() sum");
+        double seconds = std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count() / 1000000.;
+        cout << "run_in_parallel(): " << CALLS / seconds << " calls/s" << endl;
+    }
+
+    //  Exceptions come back out of run_in_parallel().
+    {
+        bool caught = false;
+        try{
+            pool.run_in_parallel(
+                [](size_t index){
+                    if (index == 77){
+                        throw std::runtime_error("index 77");
+                    }
+                },
+                0, 1000, 10
+            );
+        }catch (std::runtime_error&){
+            caught = true;
+        }
+        TEST_RESULT_COMPONENT_EQUAL(caught, true, "run_in_parallel() exception");
+    }
+
+    return 0;
+}
+
+
+int test_CommonFramework_ThreadPool(const std::string& test_path){
+    if (test_thread_pool<ThreadPool_Default>("ThreadPool_Default") != 0){
+        return 1;
+    }
+    if (test_thread_pool<ThreadPool_WorkStealing>("ThreadPool_WorkStealing") != 0){
+        return 1;
+    }
+
+    //  Nested run_in_parallel() on a small pool. Every thread ends up waiting
+    //  on an inner loop while the inner loops still have blocks queued.
+    ThreadPool_WorkStealing pool(nullptr, 2, 2);
+    std::atomic<size_t> counter(0);
+    pool.run_in_parallel(
+        [&](size_t){
+            pool.run_in_parallel(
+                [&](size_t){ counter.fetch_add(1, std::memory_order_relaxed); },
+                0, 1000, 1
+            );
+        },
+        0, 64, 1
+    );
+    TEST_RESULT_COMPONENT_EQUAL(counter.load(), (size_t)64000, "nested run_in_parallel()");
+
+    //  Nested run_in_parallel() from inside a dispatched task.
+    counter.store(0);
+    AsyncTask task = pool.dispatch([&]{
+        pool.run_in_parallel(
+            [&](size_t){ counter.fetch_add(1, std::memory_order_relaxed); },
+            0, 1000, 1
+        );
+    });
+    task.wait_and_rethrow_exceptions();
+    TEST_RESULT_COMPONENT_EQUAL(counter.load(), (size_t)1000, "run_in_parallel() in task");
+
+    cout << "Nested run_in_parallel(): OK" << endl;
+
+    return 0;
+}
+
+
+
+int test_CommonFramework_AudioSpectrumRing(const std::string& test_path){
+    AudioSpectrumRing ring(40);
+    auto magnitudes = std::make_shared<const AlignedVector<float>>(16);
+
+    TEST_RESULT_COMPONENT_EQUAL(ring.since(0).size(), (size_t)0, "since() on empty ring");
+    TEST_RESULT_COMPONENT_EQUAL(ring.latest(1).size(), (size_t)0, "latest() on empty ring");
+
+    for (uint64_t c = 0; c < 10; c++){
+        TEST_RESULT_COMPONENT_EQUAL(ring.push(48000, magnitudes), c, "push() stamp");
+    }
+    {
+        AudioSpectrumView view = ring.since(0);
+        TEST_RESULT_COMPONENT_EQUAL(view.size(), (size_t)10, "since(0)");
+        TEST_RESULT_COMPONENT_EQUAL(view.get(0)->stamp, (uint64_t)9, "newest stamp");
+        TEST_RESULT_COMPONENT_EQUAL(view.get(9)->stamp, (uint64_t)0, "oldest stamp");
+        TEST_RESULT_COMPONENT_EQUAL(ring.since(7).size(), (size_t)3, "since(7)");
+        TEST_RESULT_COMPONENT_EQUAL(ring.since(10).size(), (size_t)0, "since(10)");
+        TEST_RESULT_COMPONENT_EQUAL(ring.latest(1).get(0)->stamp, (uint64_t)9, "latest(1)");
+    }
+
+    //  Wrap around the ring. Only the history is visible.
+    for (uint64_t c = 10; c < 300; c++){
+        ring.push(48000, magnitudes);
+    }
+    AudioSpectrumView view = ring.since(0);
+    TEST_RESULT_COMPONENT_EQUAL(view.size(), (size_t)40, "history length");
+    TEST_RESULT_COMPONENT_EQUAL(view.begin_stamp(), (uint64_t)260, "oldest visible stamp");
+    for (size_t c = 0; c < view.size(); c++){
+        TEST_RESULT_COMPONENT_EQUAL(view.get(c)->stamp, (uint64_t)(299 - c), "stamp after wrap");
+    }
+    TEST_RESULT_COMPONENT_EQUAL(ring.latest(5).begin_stamp(), (uint64_t)295, "latest(5)");
+
+    std::vector<AudioSpectrum> copy;
+    view.copy_to(copy);
+    TEST_RESULT_COMPONENT_EQUAL(copy.size(), (size_t)40, "copy_to() size");
+    TEST_RESULT_COMPONENT_EQUAL(copy.front().stamp, (uint64_t)299, "copy_to() newest");
+    TEST_RESULT_COMPONENT_EQUAL(copy.back().stamp, (uint64_t)260, "copy_to() oldest");
+
+    //  The view goes stale once the writer comes back around to its oldest slot.
+    while (!view.stale()){
+        ring.push(48000, magnitudes);
+    }
+    TEST_RESULT_COMPONENT_EQUAL(ring.latest(1).get(0)->stamp, (uint64_t)(260 + AudioSpectrumRing::CAPACITY - 1), "stale point");
+
+    //  Lap the oldest 20 spectrums of the view. Only the newer 20 come out.
+    for (size_t c = 0; c < 20; c++){
+        ring.push(48000, magnitudes);
+    }
+    view.copy_to(copy);
+    TEST_RESULT_COMPONENT_EQUAL(copy.size(), (size_t)20, "copy_to() after lap");
+    TEST_RESULT_COMPONENT_EQUAL(copy.front().stamp, (uint64_t)299, "copy_to() newest after lap");
+    TEST_RESULT_COMPONENT_EQUAL(copy.back().stamp, (uint64_t)280, "copy_to() oldest after lap");
+    TEST_RESULT_COMPONENT_EQUAL(view.get(19).has_value(), true, "get() not lapped");
+    TEST_RESULT_COMPONENT_EQUAL(view.get(20).has_value(), false, "get() lapped");
+
+    //  Lap all of it.
+    for (size_t c = 0; c < 20; c++){
+        ring.push(48000, magnitudes);
+    }
+    view.copy_to(copy);
+    TEST_RESULT_COMPONENT_EQUAL(copy.size(), (size_t)0, "copy_to() after full lap");
+    TEST_RESULT_COMPONENT_EQUAL(view.get(0).has_value(), false, "get() after full lap");
+
+    //  Clear hides everything, but stamps keep going.
+    ring.clear();
+    TEST_RESULT_COMPONENT_EQUAL(ring.since(0).size(), (size_t)0, "since() after clear()");
+    uint64_t stamp = ring.push(48000, magnitudes);
+    TEST_RESULT_COMPONENT_EQUAL(stamp, (uint64_t)(260 + AudioSpectrumRing::CAPACITY + 40), "stamp after clear()");
+    TEST_RESULT_COMPONENT_EQUAL(ring.latest(10).size(), (size_t)1, "latest() after clear()");
+
+    //  Concurrent writer. Every spectrum carries its own stamp in its
+    //  magnitudes, so a torn or mismatched copy shows up. Readers sometimes
+    //  wait for the writer to lap them before copying.
+    {
+        AudioSpectrumRing shared(40);
+        std::atomic<bool> done(false);
+        std::thread writer([&]{
+            while (!done.load(std::memory_order_relaxed)){
+                uint64_t stamp = shared.since(~(uint64_t)0).end_stamp();
+                auto values = std::make_shared<AlignedVector<float>>(2);
+                (*values)[0] = (float)(stamp & 0xffff);
+                (*values)[1] = (float)((stamp >> 16) & 0xffff);
+                shared.push(48000, std::move(values));
+            }
+        });
+
+        std::atomic<size_t> errors(0);
+        std::atomic<size_t> laps(0);
+        auto reader = [&]{
+            std::vector<AudioSpectrum> spectrums;
+            for (size_t iteration = 0; iteration < 2000; iteration++){
+                AudioSpectrumView view = shared.since(0);
+                if (iteration % 16 == 0){
+                    while (!view.stale()){
+                        std::this_thread::yield();
+                    }
+                }
+                view.copy_to(spectrums);
+                if (spectrums.size() < view.size()){
+                    laps++;
+                }
+                uint64_t expected = view.end_stamp();
+                for (const AudioSpectrum& spectrum : spectrums){
+                    expected--;
+                    const AlignedVector<float>& values = *spectrum.magnitudes;
+                    if (spectrum.stamp != expected ||
+                        values[0] != (float)(expected & 0xffff) ||
+                        values[1] != (float)((expected >> 16) & 0xffff)
+                    ){
+                        errors++;
+                    }
+                }
+            }
+        };
+        std::thread reader0(reader);
+        std::thread reader1(reader);
+        reader0.join();
+        reader1.join();
+        done.store(true);
+        writer.join();
+
+        TEST_RESULT_COMPONENT_EQUAL(errors.load(), (size_t)0, "concurrent copies");
+        cout << "AudioSpectrumRing: " << laps.load() << " lapped copies dropped old spectrums." << endl;
+    }
+
+    cout << "AudioSpectrumRing: OK" << endl;
+    return 0;
+}
+
+
+
+namespace{
+
+class StatsDatabaseTestStats : public StatsTracker{
+public:
+    StatsDatabaseTestStats(uint64_t runs = 0){
+        m_display_order.emplace_back("Runs");
+        m_stats["Runs"] = runs;
+    }
+    uint64_t runs(){
+        return m_stats["Runs"].load();
+    }
+};
+
+uint64_t stats_database_total(const std::string& filepath){
+    StatsDatabase database;
+    StatsDatabaseTestStats stats;
+    database.aggregate(filepath, "Test", stats);
+    return stats.runs();
+}
+
+}
+
+int test_CommonFramework_StatsDatabase(const std::string& test_path){
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "PokemonAutomation_StatsDatabaseTest";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    const std::string filepath = (folder / "Stats.txt").string();
+    const std::string journal = filepath + ".journal";
+
+    //  Append and replay.
+    {
+        StatsDatabase database;
+        for (uint64_t c = 1; c <= 3; c++){
+            StatsDatabaseTestStats stats(c);
+            TEST_RESULT_COMPONENT_EQUAL(database.append(filepath, "Test", stats), true, "append()");
+        }
+        TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(journal), true, "journal exists");
+        TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(filepath), false, "stats file before compaction");
+    }
+    TEST_RESULT_COMPONENT_EQUAL(stats_database_total(filepath), (uint64_t)6, "replay journal");
+    cout << "StatsDatabase Replay: OK" << endl;
+
+    //  The load above merged the journal into the stats file.
+    TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(filepath), true, "stats file after compaction");
+    TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(journal), false, "journal after compaction");
+    TEST_RESULT_COMPONENT_EQUAL(stats_database_total(filepath), (uint64_t)6, "reload after compaction");
+
+    //  A crash in the middle of writing a record.
+    {
+        std::ofstream file(journal, std::ios::binary | std::ios::app);
+        file << "Test\t2026-01-01 00:00:00 - Runs: 1000";
+    }
+    TEST_RESULT_COMPONENT_EQUAL(stats_database_total(filepath), (uint64_t)6, "torn record is not read");
+    {
+        StatsDatabase database;
+        StatsDatabaseTestStats stats(10);
+        TEST_RESULT_COMPONENT_EQUAL(database.append(filepath, "Test", stats), true, "append() after torn record");
+    }
+    TEST_RESULT_COMPONENT_EQUAL(stats_database_total(filepath), (uint64_t)16, "append after torn record");
+    cout << "StatsDatabase Crash Recovery: OK" << endl;
+
+    //  Two instances appending and compacting the same files at once.
+    const size_t APPENDS = 200;
+    std::atomic<size_t> failures(0);
+    {
+        StatsDatabase database0;
+        StatsDatabase database1;
+        auto writer = [&](StatsDatabase& database){
+            for (size_t c = 0; c < APPENDS; c++){
+                StatsDatabaseTestStats stats(1);
+                if (!database.append(filepath, "Test", stats)){
+                    failures++;
+                }
+            }
+        };
+        std::thread thread0(writer, std::ref(database0));
+        std::thread thread1(writer, std::ref(database1));
+        thread0.join();
+        thread1.join();
+        TEST_RESULT_COMPONENT_EQUAL(database0.compact(filepath), true, "compact() 0");
+        TEST_RESULT_COMPONENT_EQUAL(database1.compact(filepath), true, "compact() 1");
+    }
+    TEST_RESULT_COMPONENT_EQUAL(failures.load(), (size_t)0, "failed appends");
+    TEST_RESULT_COMPONENT_EQUAL(stats_database_total(filepath), (uint64_t)(16 + 2 * APPENDS), "two writers");
+    TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(journal), false, "journal after two writers");
+    cout << "StatsDatabase Two Writers: OK" << endl;
+
+    std::filesystem::remove_all(folder);
+    return 0;
+}
+
+
+
+namespace{
+
+//  Random "width" x "height" frame inside a larger buffer, so the rows are
+//  padded and the padding is garbage.
+ImageViewRGB32 random_padded_frame(std::mt19937& rng, ImageRGB32& buffer, size_t width, size_t height){
+    buffer = ImageRGB32(width + 5, height + 2);
+    for (size_t r = 0; r < buffer.height(); r++){
+        for (size_t c = 0; c < buffer.width(); c++){
+            buffer.pixel(c, r) = (uint32_t)rng();
+        }
+    }
+    return buffer.sub_image(3, 1, width, height);
+}
+
+//  Returns an empty string if the tile map of "current" agrees with a full
+//  pixel comparison of the two frames. Otherwise, what is different.
+std::string check_tile_map(
+    std::mt19937& rng,
+    const ImageViewRGB32& previous, const ImageViewRGB32& current
+){
+    const size_t TILE = VideoTileMap::TILE_SIZE;
+    const size_t width = current.width();
+    const size_t height = current.height();
+
+    VideoTileMap previous_map(previous);
+    VideoTileMap current_map(current);
+    if (current_map.tiles_x() != (width + TILE - 1) / TILE || current_map.tiles_y() != (height + TILE - 1) / TILE){
+        return "tile count";
+    }
+
+    //  Which tiles have a pixel that changed.
+    std::vector<bool> dirty(current_map.tiles_x() * current_map.tiles_y());
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            if (current.pixel(c, r) != previous.pixel(c, r)){
+                dirty[r / TILE * current_map.tiles_x() + c / TILE] = true;
+            }
+        }
+    }
+    for (size_t y = 0; y < current_map.tiles_y(); y++){
+        for (size_t x = 0; x < current_map.tiles_x(); x++){
+            bool changed = current_map.hash(x, y) != previous_map.hash(x, y);
+            if (changed != dirty[y * current_map.tiles_x() + x]){
+                return "hash of tile (" + std::to_string(x) + ", " + std::to_string(y) + ")";
+            }
+        }
+    }
+
+    //  Random boxes, some of them hanging off the frame. A box is unchanged
+    //  only if no tile it touches, after padding it by a pixel, is dirty.
+    std::uniform_real_distribution<double> position(-0.2, 1.1);
+    std::uniform_real_distribution<double> size(0, 0.6);
+    for (size_t c = 0; c < 200; c++){
+        ImageFloatBox box(position(rng), position(rng), size(rng), size(rng));
+        double min_x = std::max(std::floor(width * box.x) - 1, 0.);
+        double min_y = std::max(std::floor(height * box.y) - 1, 0.);
+        double max_x = std::max(std::min(std::ceil(width * (box.x + box.width)) + 1, width - 1.), 0.);
+        double max_y = std::max(std::min(std::ceil(height * (box.y + box.height)) + 1, height - 1.), 0.);
+        bool expected = true;
+        for (size_t y = (size_t)min_y / TILE; y <= (size_t)max_y / TILE; y++){
+            for (size_t x = (size_t)min_x / TILE; x <= (size_t)max_x / TILE; x++){
+                if (x < current_map.tiles_x() && y < current_map.tiles_y() && dirty[y * current_map.tiles_x() + x]){
+                    expected = false;
+                }
+            }
+        }
+        if (current_map.unchanged(previous_map, box) != expected){
+            return "box (" + std::to_string(box.x) + ", " + std::to_string(box.y) + ", " +
+                std::to_string(box.width) + ", " + std::to_string(box.height) + ")";
+        }
+    }
+
+    return "";
+}
+
+}
+
+int test_CommonFramework_VideoTileMap(const std::string& test_path){
+    const std::vector<std::pair<size_t, size_t>> SIZES{
+        {1, 1}, {31, 33}, {64, 64}, {100, 70}, {160, 90},
+    };
+
+    std::mt19937 rng(0);
+    size_t trials = 0;
+    for (const auto& size : SIZES){
+        size_t width = size.first;
+        size_t height = size.second;
+        std::uniform_int_distribution<size_t> pick_x(0, width - 1);
+        std::uniform_int_distribution<size_t> pick_y(0, height - 1);
+        for (size_t c = 0; c < 50; c++){
+            ImageRGB32 buffer;
+            ImageViewRGB32 previous = random_padded_frame(rng, buffer, width, height);
+
+            //  Same pixels with different padding. Then change a few single
+            //  bits, which is the smallest change a tile must notice.
+            ImageRGB32 current_buffer;
+            ImageViewRGB32 current = random_padded_frame(rng, current_buffer, width, height);
+            for (size_t r = 0; r < height; r++){
+                for (size_t x = 0; x < width; x++){
+                    current_buffer.pixel(x + 3, r + 1) = previous.pixel(x, r);
+                }
+            }
+            for (size_t edits = c % 4; edits > 0; edits--){
+                current_buffer.pixel(pick_x(rng) + 3, pick_y(rng) + 1) ^= (uint32_t)1 << (rng() % 32);
+            }
+
+            trials++;
+            std::string error = check_tile_map(rng, previous, current);
+            TEST_RESULT_COMPONENT_EQUAL(error, std::string(), "tile map of " + std::to_string(width) + " x " + std::to_string(height));
+        }
+    }
+    cout << "VideoTileMap Dirty Tracking: " << trials << " random frames OK" << endl;
+
+    //  Frames of different sizes are never the same.
+    {
+        ImageRGB32 buffer;
+        ImageViewRGB32 frame = random_padded_frame(rng, buffer, 100, 70);
+        VideoTileMap full(frame);
+        VideoTileMap narrower(frame.sub_image(0, 0, 99, 70));
+        VideoTileMap shorter(frame.sub_image(0, 0, 100, 69));
+        ImageFloatBox box(0.0, 0.0, 1.0, 1.0);
+        TEST_RESULT_COMPONENT_EQUAL(full.unchanged(full, box), true, "same frame");
+        TEST_RESULT_COMPONENT_EQUAL(narrower.unchanged(full, box), false, "narrower frame");
+        TEST_RESULT_COMPONENT_EQUAL(shorter.unchanged(full, box), false, "shorter frame");
+    }
+    cout << "VideoTileMap Size Change: OK" << endl;
+
+    //  The map is built once per snapshot and shared by its copies.
+    {
+        ImageRGB32 buffer;
+        ImageRGB32 frame = random_padded_frame(rng, buffer, 100, 70).copy();
+        VideoSnapshot snapshot(std::move(frame), current_time());
+        VideoSnapshot copy = snapshot;
+        std::shared_ptr<const VideoTileMap> map = get_tile_map(snapshot);
+        TEST_RESULT_COMPONENT_EQUAL(map != nullptr, true, "snapshot tile map");
+        TEST_RESULT_COMPONENT_EQUAL(map == get_tile_map(copy), true, "shared tile map");
+        TEST_RESULT_COMPONENT_EQUAL(map->unchanged(VideoTileMap(*snapshot.frame), ImageFloatBox(0.0, 0.0, 1.0, 1.0)), true, "snapshot tile map contents");
+        VideoSnapshot empty;
+        TEST_RESULT_COMPONENT_EQUAL(get_tile_map(empty) == nullptr, true, "empty snapshot");
+    }
+    cout << "VideoTileMap Snapshot: OK" << endl;
+
+    return 0;
+}
+
+
+
+namespace{
+
+class SnapshotTestDetector : public StaticScreenDetector{
+public:
+    virtual void make_overlays(VideoOverlaySet& items) const override{}
+    virtual bool detect(const ImageViewRGB32& screen) override{
+        frame_calls++;
+        return true;
+    }
+    virtual bool detect_snapshot(const VideoSnapshot& snapshot) override{
+        snapshot_calls++;
+        return true;
+    }
+
+    size_t frame_calls = 0;
+    size_t snapshot_calls = 0;
+};
+class SnapshotTestWatcher : public DetectorToFinder<SnapshotTestDetector>{
+public:
+    SnapshotTestWatcher()
+        : DetectorToFinder("SnapshotTestWatcher", std::chrono::milliseconds(0))
+    {}
+};
+
+//  Looks at a crop instead of the frame it was given.
+class SnapshotTestCroppingWatcher : public SnapshotTestWatcher{
+public:
+    using SnapshotTestWatcher::process_frame;
+    virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override{
+        return SnapshotTestWatcher::process_frame(
+            extract_box_reference(frame, ImageFloatBox(0.5, 0.5, 0.5, 0.5)),
+            timestamp
+        );
+    }
+};
+
+bool same_pixels(const ImageViewRGB32& x, const ImageViewRGB32& y){
+    if (x.width() != y.width() || x.height() != y.height()){
+        return false;
+    }
+    for (size_t r = 0; r < x.height(); r++){
+        for (size_t c = 0; c < x.width(); c++){
+            if (x.pixel(c, r) != y.pixel(c, r)){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+}
+
+int test_CommonFramework_SnapshotCachedFilters(const std::string& test_path){
+    ImageRGB32 image(203, 117);
+    for (size_t r = 0; r < image.height(); r++){
+        for (size_t c = 0; c < image.width(); c++){
+            image.pixel(c, r) = 0xff000000 | (uint32_t)((c * 2654435761u + r * 40503u) & 0x00ffffff);
+        }
+    }
+    //  Rounding the far edge of this box gives one more pixel than rounding
+    //  its width. The cache must crop the same as extract_box_reference().
+    const ImageFloatBox box(0.1005, 0.271, 0.199, 0.353);
+    const uint32_t mins = 0xff808080;
+    const uint32_t maxs = 0xffffffff;
+
+    VideoSnapshot snapshot(image.copy(), current_time());
+
+    //  Repeated calls on the same snapshot (or a copy of it) get the same buffer.
+    uint64_t misses = VideoSnapshotCache::total_misses();
+    std::shared_ptr<const PackedBinaryMatrix> matrix0 = cached_compress_rgb32_to_binary_range(snapshot, box, mins, maxs);
+    std::shared_ptr<const PackedBinaryMatrix> matrix1 = cached_compress_rgb32_to_binary_range(snapshot, box, mins, maxs);
+    VideoSnapshot copy = snapshot;
+    std::shared_ptr<const PackedBinaryMatrix> matrix2 = cached_compress_rgb32_to_binary_range(copy, box, mins, maxs);
+    TEST_RESULT_COMPONENT_EQUAL(matrix0.get() == matrix1.get(), true, "binary filter cached");
+    TEST_RESULT_COMPONENT_EQUAL(matrix0.get() == matrix2.get(), true, "binary filter shared by copies");
+    TEST_RESULT_COMPONENT_EQUAL(VideoSnapshotCache::total_misses() - misses, (uint64_t)1, "binary filter misses");
+
+    //  Same result as doing it directly.
+    PackedBinaryMatrix direct = compress_rgb32_to_binary_range(extract_box_reference(image, box), mins, maxs);
+    TEST_RESULT_COMPONENT_EQUAL(matrix0->width(), direct.width(), "binary filter width");
+    TEST_RESULT_COMPONENT_EQUAL(matrix0->height(), direct.height(), "binary filter height");
+    TEST_RESULT_COMPONENT_EQUAL(matrix0->dump() == direct.dump(), true, "binary filter contents");
+
+    //  Different parameters are different entries.
+    std::shared_ptr<const PackedBinaryMatrix> other = cached_compress_rgb32_to_binary_range(snapshot, box, 0xff000000, 0xff7f7f7f);
+    TEST_RESULT_COMPONENT_EQUAL(matrix0.get() == other.get(), false, "binary filter parameters");
+
+    std::shared_ptr<const ImageRGB32> scaled0 = cached_scale_to(snapshot, box, 31, 17);
+    std::shared_ptr<const ImageRGB32> scaled1 = cached_scale_to(snapshot, box, 31, 17);
+    TEST_RESULT_COMPONENT_EQUAL(scaled0.get() == scaled1.get(), true, "scale_to cached");
+    TEST_RESULT_COMPONENT_EQUAL(same_pixels(*scaled0, extract_box_reference(image, box).scale_to(31, 17)), true, "scale_to contents");
+    TEST_RESULT_COMPONENT_EQUAL(cached_scale_to(snapshot, box, 32, 17).get() == scaled0.get(), false, "scale_to size");
+
+    //  A new snapshot of the same image starts over.
+    VideoSnapshot next(image.copy(), current_time());
+    std::shared_ptr<const PackedBinaryMatrix> matrix3 = cached_compress_rgb32_to_binary_range(next, box, mins, maxs);
+    TEST_RESULT_COMPONENT_EQUAL(matrix0.get() == matrix3.get(), false, "new snapshot");
+    TEST_RESULT_COMPONENT_EQUAL(matrix3->dump() == direct.dump(), true, "new snapshot contents");
+
+    //  No cache. Still works, nothing is kept.
+    VideoSnapshot uncached(image.copy(), current_time());
+    uncached.cache.reset();
+    std::shared_ptr<const PackedBinaryMatrix> matrix4 = cached_compress_rgb32_to_binary_range(uncached, box, mins, maxs);
+    std::shared_ptr<const PackedBinaryMatrix> matrix5 = cached_compress_rgb32_to_binary_range(uncached, box, mins, maxs);
+    TEST_RESULT_COMPONENT_EQUAL(matrix4.get() == matrix5.get(), false, "no cache");
+    TEST_RESULT_COMPONENT_EQUAL(matrix4->dump() == direct.dump(), true, "no cache contents");
+    cout << "SnapshotCachedFilters: OK" << endl;
+
+    //  A full cache still computes, but stops keeping new entries. The
+    //  attached counters only see this snapshot.
+    {
+        VideoSnapshot bounded(image.copy(), current_time());
+        auto counters = std::make_shared<VideoSnapshotCacheCounters>();
+        bounded.cache->attach_counters(counters);
+        const size_t LIMIT = VideoSnapshotCache::MAX_ENTRIES;
+        std::shared_ptr<const ImageRGB32> first = cached_scale_to(bounded, box, 1, 1);
+        for (size_t c = 2; c <= LIMIT + 5; c++){
+            TEST_RESULT_COMPONENT_EQUAL(cached_scale_to(bounded, box, c, 1)->width(), c, "scale_to past the limit");
+        }
+        TEST_RESULT_COMPONENT_EQUAL(bounded.cache->size(), LIMIT, "cache entries");
+        TEST_RESULT_COMPONENT_EQUAL(cached_scale_to(bounded, box, 1, 1).get() == first.get(), true, "kept entry");
+        TEST_RESULT_COMPONENT_EQUAL(
+            cached_scale_to(bounded, box, LIMIT + 5, 1).get() == cached_scale_to(bounded, box, LIMIT + 5, 1).get(),
+            false, "entry past the limit"
+        );
+        TEST_RESULT_COMPONENT_EQUAL(counters->hits.load(), (uint64_t)1, "attached hits");
+        TEST_RESULT_COMPONENT_EQUAL(counters->misses.load(), (uint64_t)(LIMIT + 7), "attached misses");
+    }
+    cout << "SnapshotCache Limit: OK" << endl;
+
+    //  DetectorToFinder hands the snapshot to the detector, but not when a
+    //  derived watcher passes something else.
+    SnapshotTestWatcher watcher;
+    static_cast<VisualInferenceCallback&>(watcher).process_frame(snapshot);
+    TEST_RESULT_COMPONENT_EQUAL(watcher.snapshot_calls, (size_t)1, "watcher detect_snapshot()");
+    TEST_RESULT_COMPONENT_EQUAL(watcher.frame_calls, (size_t)0, "watcher detect()");
+    static_cast<VisualInferenceCallback&>(watcher).process_frame(*snapshot.frame, snapshot.timestamp);
+    TEST_RESULT_COMPONENT_EQUAL(watcher.frame_calls, (size_t)1, "watcher without snapshot");
+
+    SnapshotTestCroppingWatcher cropping;
+    static_cast<VisualInferenceCallback&>(cropping).process_frame(snapshot);
+    TEST_RESULT_COMPONENT_EQUAL(cropping.snapshot_calls, (size_t)0, "cropping watcher detect_snapshot()");
+    TEST_RESULT_COMPONENT_EQUAL(cropping.frame_calls, (size_t)1, "cropping watcher detect()");
+    cout << "DetectorToFinder snapshots: OK" << endl;
+
+    return 0;
+}
+
+
+
+namespace{
+
+//  Parse "text" with both parsers. Returns false if they disagree.
+bool json_parsers_agree(const std::string& text){
+    JsonValue value;
+    bool ok = parse_json(value, text.data(), text.size());
+    JsonValue reference = from_nlohmann(nlohmann::json::parse(text, nullptr, false));
+    if (!ok && !reference.is_null()){
+        cout << "Parsers disagree on success: " << text << endl;
+        return false;
+    }
+    //  dump() throws on strings that aren't valid UTF-8.
+    std::string dump = "(invalid)";
+    std::string reference_dump = "(invalid)";
+    try{
+        dump = value.dump();
+    }catch (...){}
+    try{
+        reference_dump = reference.dump();
+    }catch (...){}
+    if (value.type() != reference.type() || dump != reference_dump || dump == "(invalid)"){
+        cout << "Parsers disagree on value: " << text << endl;
+        cout << "    " << dump << " vs. " << reference_dump << endl;
+        return false;
+    }
+    return true;
+}
+
+void write_test_file(const std::string& path, const std::string& text){
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+}
+
+}
+
+int test_CommonFramework_JsonParser(const std::string& test_path){
+    const std::vector<std::string> CASES{
+        //  Escapes
+        R"("\"\\\/\b\f\n\r\t")",
+        R"("\u0041\u00e9\u4e2d")",
+        R"("a\u0000b")",
+        R"("\x")",
+        R"("\u12")",
+        R"("\u12g4")",
+
+        //  Surrogate pairs
+        R"("\ud83d\ude00")",
+        R"("\ud83d\ude00 tail")",
+        R"("\ud83d")",
+        R"("\ude00")",
+        R"("\ud83dx")",
+        R"("\ud83d\u0041")",
+        R"("\ud83d\ud83d")",
+
+        //  Numbers
+        "0", "-0", "-0.0", "1.5e3", "1E-2", "1e+2", "123456789.125",
+        "9223372036854775807",
+        "-9223372036854775808",
+        "-9223372036854775809",
+        "18446744073709551615",
+        "18446744073709551616",
+        "100000000000000000000000",
+        "1e308", "1e309", "-1e309", "1e-400",
+        "2.2250738585072014e-308", "4.9e-324",
+        "01", "-01", "1.", ".5", "-", "+1", "1e", "1e+", "0x10", "NaN", "Infinity", "--1",
+
+        //  Structure
+        "null", "true", "false",
+        "[]", "{}", " [ 1 , 2 ] \n",
+        "\xef\xbb\xbf{\"a\": 1}",
+        R"({"a": [1, {"b": null}], "c": "d"})",
+        R"({"a": 1, "a": 2})",
+
+        //  Malformed
+        "", " ", "[", "]", "[1,]", "[,1]", "[1 2]", "[1]]",
+        R"({"a"})", R"({"a":1,})", R"({"a" 1})", "{1:2}", "{'a':1}",
+        "nul", "truex", "True", R"("abc)", "\"a\tb\"", "\"a\nb\"",
+        "[1] x", "/* comment */ 1",
+
+        //  UTF-8
+        "\"\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\"",
+        "\"\x7f\"",
+        "\"\xc2\x80\xdf\xbf\xe0\xa0\x80\xef\xbf\xbf\xf0\x90\x80\x80\xf4\x8f\xbf\xbf\"",
+        "\"\x80\"",
+        "\"\xbf\"",
+        "\"\xc0\xaf\"",
+        "\"\xc1\xbf\"",
+        "\"\xe0\x80\xaf\"",
+        "\"\xe0\x9f\xbf\"",
+        "\"\xed\xa0\x80\"",
+        "\"\xed\xbf\xbf\"",
+        "\"\xf0\x80\x80\xaf\"",
+        "\"\xf0\x8f\xbf\xbf\"",
+        "\"\xf4\x90\x80\x80\"",
+        "\"\xf5\x80\x80\x80\"",
+        "\"\xf8\x88\x80\x80\x80\"",
+        "\"\xfe\"", "\"\xff\"",
+        "\"\xc3\"",
+        "\"\xe4\xb8\"",
+        "\"\xf0\x9f\x98\"",
+        "\"\xc3\x28\"",
+        "\"\xe4\x28\xad\"",
+        "\"\xf0\x9f\x28\x80\"",
+        "{\"\xc3\xa9\": 1}",
+        "{\"\xc3\": 1}",
+    };
+    size_t failures = 0;
+    for (const std::string& text : CASES){
+        if (!json_parsers_agree(text)){
+            failures++;
+        }
+    }
+    TEST_RESULT_COMPONENT_EQUAL(failures, (size_t)0, "cases that disagree with nlohmann");
+    cout << "JsonParser Conformance: OK" << endl;
+
+    //  Deep nesting is fine up to the limit. Past it, parse_json() refuses
+    //  instead of recursing further. (nlohmann has no limit)
+    {
+        const size_t LIMIT = 512;
+        std::string text = std::string(LIMIT, '[') + std::string(LIMIT, ']');
+        TEST_RESULT_COMPONENT_EQUAL(json_parsers_agree(text), true, "nesting at the limit");
+        text = std::string(LIMIT / 2, '[') + "{\"a\":" + std::string(LIMIT / 2 - 1, '[') +
+            std::string(LIMIT / 2 - 1, ']') + "}" + std::string(LIMIT / 2, ']');
+        TEST_RESULT_COMPONENT_EQUAL(json_parsers_agree(text), true, "mixed nesting at the limit");
+
+        text = std::string(LIMIT + 1, '[') + std::string(LIMIT + 1, ']');
+        JsonValue value;
+        std::string error;
+        TEST_RESULT_COMPONENT_EQUAL(parse_json(value, text.data(), text.size(), &error), false, "nesting past the limit");
+        TEST_RESULT_COMPONENT_EQUAL(value.is_null(), true, "value after nesting past the limit");
+        TEST_RESULT_COMPONENT_EQUAL(error.find("Nesting") != std::string::npos, true, "error for nesting past the limit");
+    }
+    cout << "JsonParser Nesting: OK" << endl;
+
+    //  The binary cache lives in its own folder and follows edits to the source.
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "PokemonAutomation_JsonCacheTest";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder / "Resources");
+    const std::string source = (folder / "Resources" / "Table.json").string();
+    const std::string cache_folder = (folder / "Cache").string() + "/";
+    const std::string cache = source_cache_path(cache_folder, source, ".json.bin");
+
+    write_test_file(source, R"({"value": 1})");
+    JsonValue value = load_json_file_cached(source, cache_folder);
+    TEST_RESULT_COMPONENT_EQUAL(value.to_object_throw().get_integer_throw("value"), (int64_t)1, "cold load");
+    TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(cache), true, "cache written");
+    TEST_RESULT_COMPONENT_EQUAL(
+        (size_t)std::distance(std::filesystem::directory_iterator(folder / "Resources"), {}), (size_t)1,
+        "nothing written next to the source"
+    );
+
+    //  Replace the cache with a different value for the same source text to
+    //  see that a warm load reads the cache instead of the text.
+    {
+        std::string text = file_to_string(source);
+        JsonObject object;
+        object["value"] = 2;
+        write_test_file(cache, json_to_binary(JsonValue(std::move(object)), fingerprint_source(text.data(), text.size())));
+    }
+    value = load_json_file_cached(source, cache_folder);
+    TEST_RESULT_COMPONENT_EQUAL(value.to_object_throw().get_integer_throw("value"), (int64_t)2, "warm load");
+
+    //  Edit the source. The stale cache is ignored and rebuilt.
+    write_test_file(source, R"({"value": 3})");
+    value = load_json_file_cached(source, cache_folder);
+    TEST_RESULT_COMPONENT_EQUAL(value.to_object_throw().get_integer_throw("value"), (int64_t)3, "load after edit");
+    {
+        std::string text = file_to_string(source);
+        std::string binary = file_to_string(cache);
+        JsonValue cached;
+        TEST_RESULT_COMPONENT_EQUAL(
+            json_from_binary(cached, binary.data(), binary.size(), fingerprint_source(text.data(), text.size())), true,
+            "cache rebuilt after edit"
+        );
+        TEST_RESULT_COMPONENT_EQUAL(cached.to_object_throw().get_integer_throw("value"), (int64_t)3, "rebuilt cache value");
+    }
+
+    //  A truncated cache is rebuilt too.
+    {
+        std::string binary = file_to_string(cache);
+        write_test_file(cache, binary.substr(0, binary.size() - 1));
+    }
+    value = load_json_file_cached(source, cache_folder);
+    TEST_RESULT_COMPONENT_EQUAL(value.to_object_throw().get_integer_throw("value"), (int64_t)3, "load with truncated cache");
+    TEST_RESULT_COMPONENT_EQUAL(file_to_string(cache).size() > 0, true, "cache rebuilt after truncation");
+
+    //  No cache folder means no caching.
+    std::filesystem::remove_all(folder / "Cache");
+    value = load_json_file_cached(source, "");
+    TEST_RESULT_COMPONENT_EQUAL(value.to_object_throw().get_integer_throw("value"), (int64_t)3, "load without cache");
+    TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(folder / "Cache"), false, "no cache folder");
+    cout << "JsonParser Binary Cache: OK" << endl;
+
+    std::filesystem::remove_all(folder);
+    return 0;
+}
+
+
+
+namespace{
+
+//  Random string over "alphabet". Small alphabets give lots of partial matches.
+std::u32string random_u32string(std::mt19937& rng, const std::u32string& alphabet, size_t length){
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::u32string ret;
+    for (size_t c = 0; c < length; c++){
+        ret += alphabet[pick(rng)];
+    }
+    return ret;
+}
+
+//  "str" with a few random edits, embedded in random padding. This is what
+//  OCR output of a dictionary entry looks like.
+std::u32string random_u32string_edit(std::mt19937& rng, const std::u32string& alphabet, std::u32string str){
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    std::uniform_int_distribution<size_t> edits(0, 4);
+    for (size_t c = edits(rng); c > 0; c--){
+        size_t index = std::uniform_int_distribution<size_t>(0, str.size())(rng);
+        switch (rng() % 3){
+        case 0:
+            str.insert(str.begin() + index, alphabet[pick(rng)]);
+            break;
+        case 1:
+            if (index < str.size()){
+                str.erase(str.begin() + index);
+            }
+            break;
+        default:
+            if (index < str.size()){
+                str[index] = alphabet[pick(rng)];
+            }
+        }
+    }
+    std::uniform_int_distribution<size_t> padding(0, 8);
+    return random_u32string(rng, alphabet, padding(rng)) + str + random_u32string(rng, alphabet, padding(rng));
+}
+
+//  Returns false if the pattern disagrees with the reference DP on "text".
+bool levenshtein_pattern_agrees(const std::u32string& pattern, const std::u32string& text){
+    OCR::LevenshteinPattern preprocessed(pattern);
+    size_t distance = preprocessed.distance(text);
+    size_t reference = OCR::levenshtein_distance(pattern, text);
+    size_t distance_substring = preprocessed.distance_substring(text);
+    size_t reference_substring = OCR::levenshtein_distance_substring(pattern, text);
+    if (distance == reference && distance_substring == reference_substring){
+        return true;
+    }
+    cout << "LevenshteinPattern disagrees on pattern length " << pattern.size()
+         << ", text length " << text.size() << ": distance = " << distance
+         << " vs. " << reference << ", substring = " << distance_substring
+         << " vs. " << reference_substring << endl;
+    return false;
+}
+
+}
+
+int test_CommonFramework_LevenshteinPattern(const std::string& test_path){
+    const std::vector<std::u32string> ALPHABETS{
+        U"ab",
+        U"abcdefghijklmnopqrstuvwxyz",
+        //  Non-ASCII, including characters outside the BMP.
+        U"a\u00e9\u00df\u30dd\u9738\u9739\U0001F600",
+    };
+
+    std::mt19937 rng(0);
+    size_t trials = 0;
+    size_t failures = 0;
+
+    //  Empty strings and the boundary around the 64 character word.
+    for (const std::u32string& alphabet : ALPHABETS){
+        for (size_t length : {0, 1, 2, 63, 64, 65, 127, 128, 129}){
+            std::u32string pattern = random_u32string(rng, alphabet, length);
+            for (const std::u32string& text : {
+                std::u32string(),
+                pattern,
+                random_u32string(rng, alphabet, length),
+                random_u32string_edit(rng, alphabet, pattern),
+            }){
+                trials++;
+                if (!levenshtein_pattern_agrees(pattern, text)){
+                    failures++;
+                }
+            }
+        }
+    }
+
+    //  Random patterns of up to 150 characters. Half of the texts are edited
+    //  copies of the pattern and half are unrelated.
+    std::uniform_int_distribution<size_t> length(0, 150);
+    for (size_t c = 0; c < 6000; c++){
+        const std::u32string& alphabet = ALPHABETS[c % ALPHABETS.size()];
+        std::u32string pattern = random_u32string(rng, alphabet, length(rng));
+        std::u32string text = c % 2 == 0
+            ? random_u32string_edit(rng, alphabet, pattern)
+            : random_u32string(rng, alphabet, length(rng));
+        trials++;
+        if (!levenshtein_pattern_agrees(pattern, text)){
+            failures++;
+        }
+    }
+
+    TEST_RESULT_COMPONENT_EQUAL(failures, (size_t)0, "random cases that disagree with the DP");
+    cout << "LevenshteinPattern: " << trials << " random cases OK" << endl;
+    return 0;
+}
+
+
+
+namespace{
+
+bool same_box(const ImagePixelBox& x, const ImagePixelBox& y){
+    return x.min_x == y.min_x && x.min_y == y.min_y && x.max_x == y.max_x && x.max_y == y.max_y;
+}
+bool same_stats(const ImageMatch::TemplateStats& x, const ImageMatch::TemplateStats& y){
+    return x.opaque_pixels == y.opaque_pixels &&
+        x.stats.count == y.stats.count &&
+        x.stats.average.r == y.stats.average.r &&
+        x.stats.average.g == y.stats.average.g &&
+        x.stats.average.b == y.stats.average.b &&
+        x.stats.stddev.r == y.stats.stddev.r &&
+        x.stats.stddev.g == y.stats.stddev.g &&
+        x.stats.stddev.b == y.stats.stddev.b;
+}
+
+//  Returns an empty string if "bundle" holds exactly the sprites of "atlas"
+//  at "locations". Otherwise, what is different.
+std::string check_sprite_bundle(
+    const SpriteBundle& bundle, const ImageViewRGB32& atlas,
+    const std::map<std::string, ImagePixelBox>& locations
+){
+    ImageViewRGB32 bundle_atlas = bundle.atlas();
+    if (bundle_atlas.width() != atlas.width() || bundle_atlas.height() != atlas.height()){
+        return "atlas dimensions";
+    }
+    for (size_t r = 0; r < atlas.height(); r++){
+        for (size_t c = 0; c < atlas.width(); c++){
+            if (bundle_atlas.pixel(c, r) != atlas.pixel(c, r)){
+                return "atlas pixels";
+            }
+        }
+    }
+    if (bundle.size() != locations.size()){
+        return "sprite count";
+    }
+    for (size_t c = 0; c < bundle.size(); c++){
+        SpriteBundle::Sprite item = bundle[c];
+        auto iter = locations.find(std::string(item.slug));
+        if (iter == locations.end()){
+            return "unknown slug: " + std::string(item.slug);
+        }
+        ImageViewRGB32 sprite = extract_box_reference(atlas, iter->second);
+        ImagePixelBox icon_box = ImageMatch::trim_image_alpha_box(sprite);
+        if (!same_box(item.sprite, iter->second) || !same_box(item.icon, icon_box)){
+            return "boxes of " + iter->first;
+        }
+        if (!same_stats(item.sprite_stats, ImageMatch::template_stats(sprite)) ||
+            !same_stats(item.icon_stats, ImageMatch::template_stats(extract_box_reference(sprite, icon_box)))
+        ){
+            return "stats of " + iter->first;
+        }
+    }
+    return "";
+}
+
+}
+
+int test_CommonFramework_SpriteBundle(const std::string& test_path){
+    //  A 40x20 sheet of 16x16 sprites. Each sprite is an opaque square inside a
+    //  transparent border so that the icons are trimmed. The last one hangs
+    //  over the right edge and gets clipped.
+    ImageRGB32 atlas(40, 20);
+    for (size_t r = 0; r < atlas.height(); r++){
+        for (size_t c = 0; c < atlas.width(); c++){
+            atlas.pixel(c, r) = 0x00000000;
+        }
+    }
+    const std::map<std::string, ImagePixelBox> LOCATIONS{
+        {"first",   ImagePixelBox( 0, 0, 16, 16)},
+        {"second",  ImagePixelBox(16, 2, 32, 18)},
+        {"clipped", ImagePixelBox(30, 4, 40, 20)},
+    };
+    uint32_t color = 0xff102030;
+    for (const auto& item : LOCATIONS){
+        const ImagePixelBox& box = item.second;
+        for (size_t r = box.min_y + 3; r < box.max_y - 2; r++){
+            for (size_t c = box.min_x + 2; c < box.max_x - 1; c++){
+                atlas.pixel(c, r) = color + (uint32_t)(r * 7 + c * 3);
+            }
+        }
+        color += 0x00203040;
+    }
+    const std::string json_text = R"({
+        "spriteWidth": 16,
+        "spriteHeight": 16,
+        "spriteLocations": {
+            "first":    {"top": 0, "left": 0},
+            "second":   {"top": 2, "left": 16},
+            "clipped":  {"top": 4, "left": 30}
+        }
+    })";
+    JsonValue json = parse_json(json_text);
+
+    SpriteBundle::Sources sources;
+    sources.image = fingerprint_source(atlas.data(), atlas.bytes_per_row() * atlas.height());
+    sources.json = fingerprint_source(json_text.data(), json_text.size());
+
+    //  Build
+    std::unique_ptr<SpriteBundle> built = SpriteBundle::build(atlas, json, "sprites.json", sources);
+    TEST_RESULT_COMPONENT_EQUAL(check_sprite_bundle(*built, atlas, LOCATIONS), std::string(), "built bundle");
+    cout << "SpriteBundle Build: OK" << endl;
+
+    //  Save into a cache folder that doesn't exist yet, then load it back.
+    std::filesystem::path folder = std::filesystem::temp_directory_path() / "PA-SpriteBundle-Test";
+    std::filesystem::remove_all(folder);
+    std::filesystem::create_directories(folder);
+    std::string cache_folder = (folder / "Cache").string() + "/";
+    std::string path = source_cache_path(cache_folder, (folder / "sprites.png").string(), ".bundle");
+
+    TEST_RESULT_COMPONENT_EQUAL(built->save(path), true, "save bundle");
+    TEST_RESULT_COMPONENT_EQUAL(std::filesystem::exists(path), true, "bundle in the cache folder");
+    {
+        std::unique_ptr<SpriteBundle> loaded = SpriteBundle::open(path, sources);
+        TEST_RESULT_COMPONENT_EQUAL(loaded != nullptr, true, "open fresh bundle");
+        TEST_RESULT_COMPONENT_EQUAL(check_sprite_bundle(*loaded, atlas, LOCATIONS), std::string(), "loaded bundle");
+    }
+    cout << "SpriteBundle Load: OK" << endl;
+
+    //  A bundle built from other sources is stale.
+    SpriteBundle::Sources stale = sources;
+    stale.image.hash ^= 1;
+    TEST_RESULT_COMPONENT_EQUAL(SpriteBundle::open(path, stale) == nullptr, true, "image changed");
+    stale = sources;
+    stale.json.size++;
+    TEST_RESULT_COMPONENT_EQUAL(SpriteBundle::open(path, stale) == nullptr, true, "json changed");
+    TEST_RESULT_COMPONENT_EQUAL(SpriteBundle::open(path + ".missing", sources) == nullptr, true, "missing bundle");
+
+    //  So is a damaged one.
+    std::string bytes;
+    {
+        std::ifstream file(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    write_test_file(path, bytes.substr(0, bytes.size() - 1));
+    TEST_RESULT_COMPONENT_EQUAL(SpriteBundle::open(path, sources) == nullptr, true, "truncated bundle");
+    std::string bad_version = bytes;
+    bad_version[8]++;
+    write_test_file(path, bad_version);
+    TEST_RESULT_COMPONENT_EQUAL(SpriteBundle::open(path, sources) == nullptr, true, "other version");
+
+    //  Rebuilding replaces the stale bundle.
+    stale.json = fingerprint_source("changed", 7);
+    std::unique_ptr<SpriteBundle> rebuilt = SpriteBundle::build(atlas, json, "sprites.json", stale);
+    TEST_RESULT_COMPONENT_EQUAL(rebuilt->save(path), true, "save rebuilt bundle");
+    TEST_RESULT_COMPONENT_EQUAL(SpriteBundle::open(path, sources) == nullptr, true, "old sources after rebuild");
+    {
+        std::unique_ptr<SpriteBundle> loaded = SpriteBundle::open(path, stale);
+        TEST_RESULT_COMPONENT_EQUAL(loaded != nullptr, true, "open rebuilt bundle");
+        TEST_RESULT_COMPONENT_EQUAL(check_sprite_bundle(*loaded, atlas, LOCATIONS), std::string(), "rebuilt bundle");
+    }
+    cout << "SpriteBundle Invalidation: OK" << endl;
+
+    std::filesystem::remove_all(folder);
+    return 0;
+}
+
+
+
+#if defined(__linux__)
+
+//  One end of a PTY pair. The slave end is opened as a serial port.
+struct PtyPair{
+    int master;
+    std::string slave_name;
+
+    PtyPair(){
+        master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+            throw std::runtime_error("Unable to open PTY.");
+        }
+        slave_name = ptsname(master);
+    }
+    ~PtyPair(){
+        if (master >= 0){
+            close(master);
+        }
+    }
+
+    //  Read whatever is available into "data".
+    void read_available(std::string& data){
+        char buffer[4096];
+        ssize_t actual;
+        while ((actual = read(master, buffer, sizeof(buffer))) > 0){
+            data.append(buffer, actual);
+        }
+    }
+};
+
+struct SerialTestListener : public StreamListener{
+    Mutex lock;
+    std::string data;
+
+    virtual void on_recv(const void* p, size_t bytes) override{
+        std::lock_guard<Mutex> lg(lock);
+        data.append((const char*)p, bytes);
+    }
+    size_t size(){
+        std::lock_guard<Mutex> lg(lock);
+        return data.size();
+    }
+};
+
+static std::string make_serial_test_pattern(size_t port, size_t bytes){
+    std::string ret(bytes, 0);
+    for (size_t c = 0; c < bytes; c++){
+        ret[c] = (char)(c * 31 + port * 7);
+    }
+    return ret;
+}
+
+int test_CommonFramework_SerialEventLoop(const std::string& test_path){
+    const size_t PORTS = 8;
+    const size_t RECV_BYTES = 4096;
+    const size_t SEND_BYTES = 256 * 1024;
+
+    //  1 thread for the event loop + 1 sender per port.
+    ThreadPool_Default pool(nullptr, 0, PORTS + 1);
+    SerialEventLoop loop(pool);
+
+    std::vector<std::unique_ptr<PtyPair>> ptys;
+    std::vector<std::unique_ptr<SerialTestListener>> listeners;
+    std::vector<std::unique_ptr<SerialConnection>> connections;
+    for (size_t c = 0; c < PORTS; c++){
+        ptys.emplace_back(new PtyPair());
+        listeners.emplace_back(new SerialTestListener());
+        connections.emplace_back(new SerialConnection(loop, ptys.back()->slave_name, 115200));
+        connections.back()->add_listener(*listeners.back());
+    }
+    TEST_RESULT_COMPONENT_EQUAL(loop.ports(), PORTS, "ports after open");
+
+    //  Device -> host on all ports at once.
+    for (size_t c = 0; c < PORTS; c++){
+        std::string pattern = make_serial_test_pattern(c, RECV_BYTES);
+        TEST_RESULT_COMPONENT_EQUAL(write(ptys[c]->master, pattern.data(), pattern.size()), (ssize_t)pattern.size(), "pty write");
+    }
+    WallClock deadline = current_time() + std::chrono::seconds(10);
+    for (size_t c = 0; c < PORTS; c++){
+        while (listeners[c]->size() < RECV_BYTES && current_time() < deadline){
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        std::lock_guard<Mutex> lg(listeners[c]->lock);
+        TEST_RESULT_COMPONENT_EQUAL(listeners[c]->data == make_serial_test_pattern(c, RECV_BYTES), true, "recv port " + std::to_string(c));
+    }
+    cout << "Serial recv on " << PORTS << " ports: OK" << endl;
+
+    //  Host -> device. This is much more than the PTY buffers so the senders
+    //  have to wait for write-readiness while the device side drains.
+    std::vector<size_t> sent(PORTS);
+    {
+        std::vector<AsyncTask> senders;
+        for (size_t c = 0; c < PORTS; c++){
+            senders.emplace_back(pool.dispatch_now_blocking([&, c]{
+                std::string pattern = make_serial_test_pattern(c + PORTS, SEND_BYTES);
+                UnreliableStreamConnectionPushing& connection = *connections[c];
+                sent[c] = connection.unreliable_send(pattern.data(), pattern.size());
+            }));
+        }
+        std::vector<std::string> received(PORTS);
+        deadline = current_time() + std::chrono::seconds(10);
+        while (current_time() < deadline){
+            bool done = true;
+            for (size_t c = 0; c < PORTS; c++){
+                ptys[c]->read_available(received[c]);
+                done &= received[c].size() >= SEND_BYTES;
+            }
+            if (done){
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        for (AsyncTask& task : senders){
+            task.wait_and_rethrow_exceptions();
+        }
+        for (size_t c = 0; c < PORTS; c++){
+            TEST_RESULT_COMPONENT_EQUAL(sent[c], SEND_BYTES, "sent port " + std::to_string(c));
+            TEST_RESULT_COMPONENT_EQUAL(received[c] == make_serial_test_pattern(c + PORTS, SEND_BYTES), true, "send port " + std::to_string(c));
+        }
+    }
+    cout << "Serial send on " << PORTS << " ports: OK" << endl;
+
+    //  A device that goes away stops being polled and fails sends.
+    close(ptys[0]->master);
+    ptys[0]->master = -1;
+    deadline = current_time() + std::chrono::seconds(10);
+    while (loop.ports() == PORTS && current_time() < deadline){
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    TEST_RESULT_COMPONENT_EQUAL(loop.ports(), PORTS - 1, "ports after hangup");
+    char byte = 0;
+    UnreliableStreamConnectionPushing& hung_up = *connections[0];
+    TEST_RESULT_COMPONENT_EQUAL(hung_up.unreliable_send(&byte, 1), (size_t)0, "send after hangup");
+
+    //  Stopping doesn't wait for a read timeout.
+    WallClock time0 = current_time();
+    for (size_t c = 0; c < PORTS; c++){
+        connections[c]->remove_listener(*listeners[c]);
+        connections[c].reset();
+    }
+    WallClock time1 = current_time();
+    auto stop_time = std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
+    cout << "Stopped " << PORTS << " ports in " << stop_time << " us" << endl;
+    TEST_RESULT_COMPONENT_EQUAL(loop.ports(), (size_t)0, "ports after stop");
+
+    return 0;
+}
+
+#else
+
+int test_CommonFramework_SerialEventLoop(const std::string& test_path){
+    cout << "SerialEventLoop is Linux only. Skipping." << endl;
+    return 0;
+}
+
+#endif
+
+
+
+
+
+
+#if defined(__linux__)
+
+int test_CommonFramework_PABotBase2Benchmark(const std::string& test_path){
+    using namespace std::chrono_literals;
+
+    const size_t LATENCY_COMMANDS = 1000;
+    const size_t THROUGHPUT_COMMANDS = 5000;
+
+    struct Profile{
+        const char* name;
+        WallDuration latency;
+        WallDuration jitter;
+        double drop_rate;
+    };
+    const Profile PROFILES[] = {
+        {"Ideal Line",                      0ms,    0ms,    0},
+        {"1ms + 1ms Jitter",                1ms,    1ms,    0},
+        {"1ms + 1ms Jitter, 1% Loss",       1ms,    1ms,    0.01},
+    };
+
+    Logger& logger = global_logger_command_line();
+
+    for (const Profile& profile : PROFILES){
+        PABotBase2::PtyEmulatorOptions options;
+        options.latency = profile.latency;
+        options.jitter = profile.jitter;
+        options.drop_rate = profile.drop_rate;
+        options.seed = 0;
+
+        //  Emulator (2) + event loop (1) + retransmit thread (1).
+        ThreadPool_Default pool(nullptr, 0, 4);
+        SerialEventLoop loop(pool);
+        PABotBase2::PtyEmulator emulator(pool, options);
+        SerialConnection serial(loop, emulator.slave_name(), 921600);
+
+        CancellableHolder<CancellableScope> scope;
+        PABotBase2::ReliableStreamConnection connection(
+            &scope, logger, false, pool, serial, 80ms
+        );
+        TEST_RESULT_COMPONENT_EQUAL(connection.reset(5000ms), true, "reset");
+        connection.send_request(PABB2_CONNECTION_OPCODE_ASK_VERSION);
+        connection.wait_for_pending();
+        connection.send_request(PABB2_CONNECTION_OPCODE_ASK_PACKET_SIZE);
+        connection.wait_for_pending();
+        connection.send_request(PABB2_CONNECTION_OPCODE_ASK_BUFFER_SLOTS);
+        connection.wait_for_pending();
+
+        PABotBase2::DeviceHandle device(&scope, logger, connection);
+        device.message_logger().add_message<PABotBase2::pabb2_Message_Command_NS_WiredController_State>(
+            "PABB2_MESSAGE_CMD_NS_WIRED_CONTROLLER_STATE",
+            PABB2_MESSAGE_CMD_NS_WIRED_CONTROLLER_STATE,
+            false,
+            [](const PABotBase2::pabb2_Message_Command_NS_WiredController_State* message){
+                return "id = " + std::to_string(message->id);
+            }
+        );
+        device.query_command_queue();
+        PABotBase2::CommandQueueManager& queue = device.command_queue();
+
+        PABotBase2::pabb2_Message_Command_NS_WiredController_State command;
+        memset(&command, 0, sizeof(command));
+        command.message_bytes = sizeof(command);
+        command.opcode = PABB2_MESSAGE_CMD_NS_WIRED_CONTROLLER_STATE;
+        command.milliseconds = 0;
+
+        //  Latency: One command in flight at a time.
+        std::vector<uint64_t> latencies;
+        for (size_t c = 0; c < LATENCY_COMMANDS; c++){
+            WallClock time0 = current_time();
+            uint8_t id = queue.send_command(nullptr, command);
+            queue.wait_for_command_finish(nullptr, id);
+            WallClock time1 = current_time();
+            latencies.emplace_back(
+                std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count()
+            );
+        }
+        std::sort(latencies.begin(), latencies.end());
+
+        //  Throughput: Keep the command queue full.
+        WallClock time0 = current_time();
+        for (size_t c = 0; c < THROUGHPUT_COMMANDS; c++){
+            queue.send_command(nullptr, command);
+        }
+        queue.wait_for_all(nullptr);
+        WallClock time1 = current_time();
+        double seconds = std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count() / 1000000.;
+
+        cout << profile.name << ":" << endl;
+        cout << "    Latency (p50): " << latencies[latencies.size() * 50 / 100] << " us" << endl;
+        cout << "    Latency (p99): " << latencies[latencies.size() * 99 / 100] << " us" << endl;
+        cout << "    Throughput:    " << (uint64_t)(THROUGHPUT_COMMANDS / seconds) << " commands/s" << endl;
+        cout << "    Chunks Dropped: " << emulator.chunks_dropped() << endl;
+
+        TEST_RESULT_COMPONENT_EQUAL(
+            emulator.commands_finished(),
+            (uint64_t)(LATENCY_COMMANDS + THROUGHPUT_COMMANDS),
+            "commands finished"
+        );
+    }
+
+    return 0;
+}
+
+#else
+
+int test_CommonFramework_PABotBase2Benchmark(const std::string& test_path){
+    cout << "PABotBase2 benchmark is Linux only. Skipping." << endl;
+    return 0;
+}
+
+#endif
+
+
 }
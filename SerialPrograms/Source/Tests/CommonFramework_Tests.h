@@ -9,12 +9,34 @@
 #ifndef PokemonAutomation_Tests_CommonFramework_Tests_H
 #define PokemonAutomation_Tests_CommonFramework_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
 
 int test_CommonFramework_BlackBorderDetector(const ImageViewRGB32& image, bool target);
 
+int test_CommonFramework_ThreadPool(const std::string& test_path);
+
+int test_CommonFramework_AudioSpectrumRing(const std::string& test_path);
+
+int test_CommonFramework_StatsDatabase(const std::string& test_path);
+
+int test_CommonFramework_SnapshotCachedFilters(const std::string& test_path);
+
+int test_CommonFramework_JsonParser(const std::string& test_path);
+
+int test_CommonFramework_LevenshteinPattern(const std::string& test_path);
+
+int test_CommonFramework_SpriteBundle(const std::string& test_path);
+
+int test_CommonFramework_VideoTileMap(const std::string& test_path);
+
+int test_CommonFramework_SerialEventLoop(const std::string& test_path);
+
+int test_CommonFramework_PABotBase2Benchmark(const std::string& test_path);
+
 }
 
 #endif
@@ -26,7 +26,10 @@
 #include "Kernels/ImageFilters/Kernels_ImageFilter_Basic.h"
 #include "Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h"
 #include "Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.h"
 #include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageToTensor/Kernels_ImageToTensor.h"
+#include "Kernels/YUVToRGB32/Kernels_YUVToRGB32.h"
 #include "Kernels/Waterfill/Kernels_Waterfill.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Session.h"
 #include "Kernels/Waterfill/Kernels_Waterfill_Core_64xH_Default.h"
@@ -34,7 +37,10 @@
 #include "Kernels_Tests.h"
 #include "TestUtils.h"
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
+#include <vector>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -75,6 +81,332 @@ int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image){
 }
 
 
+int test_kernels_ImageToTensor(const ImageViewRGB32& image){
+    const size_t width = image.width(), height = image.height();
+    const size_t out_size = 640;
+    const size_t out_width = std::min(out_size, width * out_size / std::max(width, height));
+    const size_t out_height = std::min(out_size, height * out_size / std::max(width, height));
+    const size_t plane_size = out_size * out_size;
+
+    std::vector<float> tensor(3 * plane_size);
+    ImageToTensorPlan plan;
+
+    int num_iterations = 100;
+    auto time_start = current_time();
+    for (int i = 0; i < num_iterations; i++){
+        resize_rgb32_to_planar_f32(
+            plan,
+            image.data(), image.bytes_per_row(), width, height,
+            tensor.data(), tensor.data() + plane_size, tensor.data() + 2 * plane_size, out_size,
+            out_width, out_height,
+            1.f / 255.f
+        );
+    }
+    auto time_end = current_time();
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+    cout << "Resize " << width << " x " << height << " -> " << out_width << " x " << out_height
+         << " planar float. Time: " << us / (double)num_iterations / 1000. << " ms" << endl;
+
+    //  Compare against a straightforward bilinear resize.
+    auto sample = [&](size_t in, size_t out, size_t c, size_t& i0, size_t& i1, double& w){
+        double src = std::max(0.0, (c + 0.5) * in / out - 0.5);
+        i0 = std::min((size_t)src, in - 1);
+        i1 = std::min(i0 + 1, in - 1);
+        w = i0 == in - 1 ? 0 : src - i0;
+    };
+    size_t error_count = 0;
+    for (size_t y = 0; y < out_height; y++){
+        size_t y0, y1;
+        double wy;
+        sample(height, out_height, y, y0, y1, wy);
+        for (size_t x = 0; x < out_width; x++){
+            size_t x0, x1;
+            double wx;
+            sample(width, out_width, x, x0, x1, wx);
+            for (size_t ch = 0; ch < 3; ch++){
+                int shift = 16 - 8 * (int)ch;
+                auto get = [&](size_t px, size_t py){
+                    return (double)((image.pixel(px, py) >> shift) & 0xff);
+                };
+                double top = get(x0, y0) * (1 - wx) + get(x1, y0) * wx;
+                double bottom = get(x0, y1) * (1 - wx) + get(x1, y1) * wx;
+                double expected = (top * (1 - wy) + bottom * wy) / 255.;
+                float actual = tensor[ch * plane_size + y * out_size + x];
+                if (std::abs(actual - expected) > 1e-5 && error_count < 10){
+                    cout << "Error: (" << x << ", " << y << ") channel " << ch << " is "
+                         << actual << ", but should be " << expected << endl;
+                    ++error_count;
+                }
+            }
+        }
+    }
+    if (error_count){
+        return 1;
+    }
+
+    return 0;
+}
+
+
+int test_kernels_YUVToRGB32(const ImageViewRGB32& image){
+    //  Odd sizes so the scalar tails get exercised too.
+    const size_t width = image.width() - 1;
+    const size_t height = image.height() - 1;
+    const size_t chroma_width = (width + 1) / 2;
+    const size_t chroma_height = (height + 1) / 2;
+
+    //  Turn the image into YUV. (BT.709, video range) Chroma is taken from the
+    //  top-left pixel of each 2x2 block.
+    auto to_y = [](uint32_t p){
+        double r = (p >> 16) & 0xff, g = (p >> 8) & 0xff, b = p & 0xff;
+        return (uint8_t)std::lround(16 + 219 * (0.2126 * r + 0.7152 * g + 0.0722 * b) / 255);
+    };
+    auto to_u = [](uint32_t p){
+        double r = (p >> 16) & 0xff, g = (p >> 8) & 0xff, b = p & 0xff;
+        double y = 0.2126 * r + 0.7152 * g + 0.0722 * b;
+        return (uint8_t)std::lround(128 + 224 * (b - y) / 1.8556 / 255);
+    };
+    auto to_v = [](uint32_t p){
+        double r = (p >> 16) & 0xff, g = (p >> 8) & 0xff, b = p & 0xff;
+        double y = 0.2126 * r + 0.7152 * g + 0.0722 * b;
+        return (uint8_t)std::lround(128 + 224 * (r - y) / 1.5748 / 255);
+    };
+
+    std::vector<uint8_t> y_plane(width * height);
+    std::vector<uint8_t> uv_plane(2 * chroma_width * chroma_height);
+    std::vector<uint8_t> u_plane(chroma_width * chroma_height);
+    std::vector<uint8_t> v_plane(chroma_width * chroma_height);
+    std::vector<uint8_t> yuyv(4 * chroma_width * height);
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t chroma_pixel = image.pixel(x & ~(size_t)1, y & ~(size_t)1);
+            uint8_t Y = to_y(image.pixel(x, y));
+            uint8_t U = to_u(chroma_pixel);
+            uint8_t V = to_v(chroma_pixel);
+            y_plane[y * width + x] = Y;
+            uv_plane[y / 2 * 2 * chroma_width + (x & ~(size_t)1) + 0] = U;
+            uv_plane[y / 2 * 2 * chroma_width + (x & ~(size_t)1) + 1] = V;
+            u_plane[y / 2 * chroma_width + x / 2] = U;
+            v_plane[y / 2 * chroma_width + x / 2] = V;
+
+            //  Packed YUYV carries chroma on every row.
+            uint32_t row_chroma_pixel = image.pixel(x & ~(size_t)1, y);
+            uint8_t* pair = &yuyv[y * 4 * chroma_width + 2 * (x & ~(size_t)1)];
+            pair[(x & 1) * 2] = Y;
+            pair[1] = to_u(row_chroma_pixel);
+            pair[3] = to_v(row_chroma_pixel);
+        }
+    }
+    if (width & 1){
+        //  The dangling half of the last YUYV pair.
+        for (size_t y = 0; y < height; y++){
+            yuyv[y * 4 * chroma_width + 2 * (width - 1) + 2] = 16;
+        }
+    }
+
+    const YUVToRGB32Coefficients coefficients = YUVToRGB32Coefficients::make(true, false);
+    ImageRGB32 output(width, height);
+
+    auto check = [&](const char* name, auto&& convert, auto&& get_yuv){
+        const int num_iterations = 100;
+        auto time_start = current_time();
+        for (int i = 0; i < num_iterations; i++){
+            convert();
+        }
+        auto time_end = current_time();
+        const auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+        cout << name << " -> RGB32 " << width << " x " << height
+             << ". Time: " << us / (double)num_iterations / 1000. << " ms" << endl;
+
+        //  Compare against the floating-point formula.
+        size_t error_count = 0;
+        for (size_t y = 0; y < height; y++){
+            for (size_t x = 0; x < width; x++){
+                int Y, U, V;
+                get_yuv(x, y, Y, U, V);
+                double luma = (Y - 16) * 255. / 219;
+                double u = (U - 128) * 255. / 224;
+                double v = (V - 128) * 255. / 224;
+                double expected[3] = {
+                    luma + 1.5748 * v,
+                    luma - 0.1873 * u - 0.4681 * v,
+                    luma + 1.8556 * u,
+                };
+                uint32_t pixel = output.pixel(x, y);
+                int actual[3] = {
+                    (int)((pixel >> 16) & 0xff),
+                    (int)((pixel >> 8) & 0xff),
+                    (int)(pixel & 0xff),
+                };
+                bool ok = (pixel >> 24) == 0xff;
+                for (size_t c = 0; c < 3; c++){
+                    double e = std::min(std::max(expected[c], 0.), 255.);
+                    ok &= std::abs(actual[c] - e) <= 1;
+                }
+                if (!ok && error_count < 10){
+                    cout << "Error: " << name << " (" << x << ", " << y << ") is "
+                         << std::hex << pixel << std::dec << ", but should be ("
+                         << expected[0] << ", " << expected[1] << ", " << expected[2] << ")" << endl;
+                    ++error_count;
+                }
+            }
+        }
+        return error_count;
+    };
+
+    size_t errors = 0;
+    errors += check(
+        "NV12",
+        [&]{
+            convert_nv12_to_rgb32(
+                coefficients, width, height,
+                y_plane.data(), width,
+                uv_plane.data(), 2 * chroma_width,
+                output.data(), output.bytes_per_row()
+            );
+        },
+        [&](size_t x, size_t y, int& Y, int& U, int& V){
+            Y = y_plane[y * width + x];
+            U = uv_plane[y / 2 * 2 * chroma_width + (x & ~(size_t)1) + 0];
+            V = uv_plane[y / 2 * 2 * chroma_width + (x & ~(size_t)1) + 1];
+        }
+    );
+    errors += check(
+        "YUV420P",
+        [&]{
+            convert_yuv420p_to_rgb32(
+                coefficients, width, height,
+                y_plane.data(), width,
+                u_plane.data(), chroma_width,
+                v_plane.data(), chroma_width,
+                output.data(), output.bytes_per_row()
+            );
+        },
+        [&](size_t x, size_t y, int& Y, int& U, int& V){
+            Y = y_plane[y * width + x];
+            U = u_plane[y / 2 * chroma_width + x / 2];
+            V = v_plane[y / 2 * chroma_width + x / 2];
+        }
+    );
+    errors += check(
+        "YUYV",
+        [&]{
+            convert_yuyv_to_rgb32(
+                coefficients, width, height,
+                yuyv.data(), 4 * chroma_width,
+                output.data(), output.bytes_per_row()
+            );
+        },
+        [&](size_t x, size_t y, int& Y, int& U, int& V){
+            const uint8_t* pair = &yuyv[y * 4 * chroma_width + 2 * (x & ~(size_t)1)];
+            Y = pair[(x & 1) * 2];
+            U = pair[1];
+            V = pair[3];
+        }
+    );
+
+    return errors == 0 ? 0 : 1;
+}
+
+
+int test_kernels_RGB32ToHSV32(const ImageViewRGB32& image){
+    //  Odd sizes so the scalar tails get exercised too.
+    const size_t width = image.width() - 1;
+    const size_t height = image.height() - 1;
+
+    //  The original floating-point conversion.
+    auto reference = [](uint32_t p){
+        int r = (p >> 16) & 0xff, g = (p >> 8) & 0xff, b = p & 0xff;
+        int M = std::max(std::max(r, g), b);
+        int m = std::min(std::min(r, g), b);
+        int delta = M - m;
+        int S = M > 0 ? 255 - (m * 255 + M / 2) / M : 0;
+        double Hf = 0;
+        if (delta > 0){
+            if (M == r){
+                Hf = std::fmod(std::fmod((g - b) / (double)delta, 6.0) + 6.0, 6.0);
+            }else if (M == g){
+                Hf = (b - r) / (double)delta + 2.0;
+            }else{
+                Hf = (r - g) / (double)delta + 4.0;
+            }
+        }
+        int H = int(Hf * 256.0 / 6.0 + 0.5) % 256;
+        return (p & 0xff000000) | ((uint32_t)H << 16) | ((uint32_t)S << 8) | (uint32_t)M;
+    };
+
+    ImageRGB32 output(width, height);
+
+    const int num_iterations = 100;
+    auto time_start = current_time();
+    for (int i = 0; i < num_iterations; i++){
+        convert_rgb32_to_hsv32(
+            image.data(), image.bytes_per_row(), width, height,
+            output.data(), output.bytes_per_row()
+        );
+    }
+    auto time_end = current_time();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+    cout << "RGB32 -> HSV32 " << width << " x " << height
+         << ". Time: " << us / (double)num_iterations / 1000. << " ms" << endl;
+
+    size_t error_count = 0;
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t expected = reference(image.pixel(x, y));
+            uint32_t actual = output.pixel(x, y);
+            if (expected != actual && error_count < 10){
+                cout << "Error: (" << x << ", " << y << ") is " << std::hex << actual
+                     << ", but should be " << expected << std::dec << endl;
+                ++error_count;
+            }
+        }
+    }
+
+    //  The fused filter must match filtering the converted image. Use a hue
+    //  range that wraps around through red.
+    const uint32_t mins = 0xffe04020;
+    const uint32_t maxs = 0xff20ffff;
+    PackedBinaryMatrix fused(width, height);
+    PackedBinaryMatrix separate(width, height);
+
+    time_start = current_time();
+    for (int i = 0; i < num_iterations; i++){
+        Kernels::compress_rgb32_to_binary_hsv_range(
+            image.data(), image.bytes_per_row(),
+            fused, mins, maxs
+        );
+    }
+    time_end = current_time();
+    us = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count();
+    cout << "RGB32 -> HSV32 range filter " << width << " x " << height
+         << ". Time: " << us / (double)num_iterations / 1000. << " ms" << endl;
+
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            uint32_t p = output.pixel(x, y);
+            bool hue_ok = ((p >> 16) & 0xff) >= ((mins >> 16) & 0xff) || ((p >> 16) & 0xff) <= ((maxs >> 16) & 0xff);
+            bool rest_ok = true;
+            for (int shift : {24, 8, 0}){
+                uint32_t c = (p >> shift) & 0xff;
+                rest_ok &= ((mins >> shift) & 0xff) <= c && c <= ((maxs >> shift) & 0xff);
+            }
+            separate.set(x, y, hue_ok && rest_ok);
+        }
+    }
+    for (size_t y = 0; y < height; y++){
+        for (size_t x = 0; x < width; x++){
+            if (fused.get(x, y) != separate.get(x, y) && error_count < 20){
+                cout << "Error: Filter mismatch at (" << x << ", " << y << ")" << endl;
+                ++error_count;
+            }
+        }
+    }
+
+    return error_count == 0 ? 0 : 1;
+}
+
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image){
 
     if (test_binary_matrix_tile() != 0){
@@ -15,6 +15,12 @@ class ImageViewRGB32;
 
 int test_kernels_ImageScaleBrightness(const ImageViewRGB32& image);
 
+int test_kernels_ImageToTensor(const ImageViewRGB32& image);
+
+int test_kernels_YUVToRGB32(const ImageViewRGB32& image);
+
+int test_kernels_RGB32ToHSV32(const ImageViewRGB32& image);
+
 int test_kernels_BinaryMatrix(const ImageViewRGB32& image);
 
 int test_kernels_FilterRGB32Range(const ImageViewRGB32& image);
@@ -0,0 +1,72 @@
+/*  ML Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+
+#include "CommonFramework/Globals.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "ML/Models/ML_YOLOv5Model.h"
+#include "ML_Tests.h"
+#include "TestUtils.h"
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+
+using namespace ML;
+
+
+//  Run the YOLOv5 model on the image at several batch sizes and print how long
+//  each stage of YOLOv5Session::run() takes.
+int test_ML_YOLOv5Benchmark(const ImageViewRGB32& image){
+    const std::string model_path = RESOURCE_PATH() + "ML/yolov5.onnx";
+    YOLOv5Session session(model_path, false);
+
+    cout << "Model: " << model_path << endl;
+    cout << "Dynamic batch: " << (session.supports_batching() ? "yes" : "no") << endl;
+
+    const size_t num_iterations = 20;
+
+    //  Warm up. The first run includes one-time setup in the runtime.
+    std::vector<YOLOv5Session::DetectionBox> boxes;
+    session.run(image, boxes);
+    session.clear_latency();
+
+    for (size_t c = 0; c < num_iterations; c++){
+        boxes.clear();
+        session.run(image, boxes);
+    }
+    cout << "Single image: " << boxes.size() << " detections" << endl;
+    cout << "    Preprocess:  " << session.latency().preprocess.dump("ms", 1000) << endl;
+    cout << "    Inference:   " << session.latency().inference.dump("ms", 1000) << endl;
+    cout << "    Postprocess: " << session.latency().postprocess.dump("ms", 1000) << endl;
+
+    for (size_t batch_size : {2, 4}){
+        std::vector<ImageViewRGB32> images(batch_size, image);
+        std::vector<std::vector<YOLOv5Session::DetectionBox>> detections;
+        session.clear_latency();
+        for (size_t c = 0; c < num_iterations; c++){
+            session.run(images, detections);
+        }
+        for (const auto& item : detections){
+            if (item.size() != boxes.size()){
+                cout << "Error: batch of " << batch_size << " found " << item.size()
+                     << " detections, but a single image found " << boxes.size() << endl;
+                return 1;
+            }
+        }
+        cout << "Batch of " << batch_size << ":" << endl;
+        cout << "    Preprocess:  " << session.latency().preprocess.dump("ms", 1000) << endl;
+        cout << "    Inference:   " << session.latency().inference.dump("ms", 1000) << endl;
+        cout << "    Postprocess: " << session.latency().postprocess.dump("ms", 1000) << endl;
+    }
+
+    return 0;
+}
+
+
+}
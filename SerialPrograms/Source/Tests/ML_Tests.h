@@ -0,0 +1,20 @@
+/*  ML Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *  
+ *  
+ */
+
+
+#ifndef PokemonAutomation_Tests_ML_Tests_H
+#define PokemonAutomation_Tests_ML_Tests_H
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
+int test_ML_YOLOv5Benchmark(const ImageViewRGB32& image);
+
+}
+
+#endif
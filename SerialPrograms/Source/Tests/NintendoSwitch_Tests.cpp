@@ -5,12 +5,17 @@
  */
 
 
+#include <set>
+#include <map>
+#include <random>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/Logging/Logger.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
 #include "CommonFramework/Recording/StreamHistorySession.h"
+#include "Controllers/Schedulers/SuperscalarScheduler.h"
+#include "NintendoSwitch/Controllers/NintendoSwitch_ControllerWithScheduler.h"
 #include "NintendoSwitch/Controllers/SerialPABotBase/NintendoSwitch_SerialPABotBase_WiredController.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_CheckOnlineDetector.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_FailedToConnectDetector.h"
@@ -26,6 +31,7 @@ using std::endl;
 namespace PokemonAutomation{
 
 using namespace NintendoSwitch;
+using namespace std::chrono_literals;
 
 int test_NintendoSwitch_CheckOnlineDetector(const ImageViewRGB32& image, bool target){
     CheckOnlineDetector detector{};
@@ -62,5 +68,341 @@ int test_NintendoSwitch_UpdatePopupDetector(const ImageViewRGB32& image, bool ta
 }
 
 
+namespace{
+
+//  The scheduler as it was before it stopped allocating. (std::set and
+//  std::map based) The test checks that both produce the same schedules.
+class ReferenceSuperscalarScheduler{
+public:
+    struct ScheduleEntry{
+        WallDuration duration;
+        std::vector<size_t> state;
+    };
+    using Schedule = std::vector<ScheduleEntry>;
+
+    ReferenceSuperscalarScheduler(){
+        WallClock now = current_time();
+        m_device_issue_time = now;
+        m_device_sent_time = now;
+        m_max_free_time = now;
+    }
+
+    void issue_wait_for_all(Schedule& schedule){
+        m_device_issue_time = std::max(m_device_issue_time, m_max_free_time);
+        m_max_free_time = m_device_issue_time;
+        process_schedule(schedule);
+    }
+    void issue_nop(Schedule& schedule, WallDuration delay){
+        if (delay <= WallDuration::zero()){
+            return;
+        }
+        WallClock next_issue_time = m_device_issue_time + delay;
+        m_state_changes.insert(next_issue_time);
+        m_device_issue_time = next_issue_time;
+        m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
+        process_schedule(schedule);
+    }
+    void issue_wait_for_resource(Schedule& schedule, size_t resource_id){
+        auto iter = m_live_commands.find(resource_id);
+        if (iter != m_live_commands.end() && m_device_sent_time < iter->second.free_time){
+            m_device_issue_time = iter->second.free_time;
+        }
+        process_schedule(schedule);
+    }
+    void issue_to_resource(
+        Schedule& schedule,
+        size_t resource_id,
+        WallDuration delay, WallDuration hold, WallDuration cooldown
+    ){
+        auto iter = m_live_commands.find(resource_id);
+        if (iter != m_live_commands.end()){
+            m_device_issue_time = std::max(m_device_issue_time, iter->second.free_time);
+            process_schedule(schedule);
+        }
+        Command& command = m_live_commands[resource_id];
+
+        delay    = std::max(delay, WallDuration::zero());
+        hold     = std::max(hold, WallDuration::zero());
+        cooldown = std::max(cooldown, WallDuration::zero());
+
+        WallClock release_time = m_device_issue_time + hold;
+        WallClock free_time = release_time + cooldown;
+
+        m_state_changes.insert(m_device_issue_time);
+        m_state_changes.insert(release_time);
+
+        command.busy_time = m_device_issue_time;
+        command.done_time = release_time;
+        command.free_time = free_time;
+
+        m_device_issue_time += delay;
+        m_max_free_time = std::max(m_max_free_time, free_time);
+        m_max_free_time = std::max(m_max_free_time, m_device_issue_time);
+
+        process_schedule(schedule);
+    }
+
+private:
+    bool iterate_schedule(Schedule& schedule){
+        if (m_state_changes.empty()){
+            m_device_sent_time = m_device_issue_time;
+            return false;
+        }
+
+        auto iter = m_state_changes.begin();
+
+        WallClock next_state_change;
+        if (m_device_sent_time < *iter){
+            next_state_change = *iter;
+        }else{
+            auto next = iter;
+            ++next;
+            next_state_change = next == m_state_changes.end()
+                ? m_device_issue_time
+                : *next;
+        }
+        if (next_state_change > m_device_issue_time){
+            next_state_change = m_device_issue_time;
+        }
+
+        WallDuration duration = next_state_change - m_device_sent_time;
+        if (duration == WallDuration::zero()){
+            return false;
+        }
+
+        ScheduleEntry& entry = schedule.emplace_back();
+        entry.duration = duration;
+        for (auto& item : m_live_commands){
+            if (item.second.busy_time <= m_device_sent_time && m_device_sent_time < item.second.done_time){
+                entry.state.emplace_back(item.first);
+            }
+        }
+        for (auto item = m_live_commands.begin(); item != m_live_commands.end();){
+            if (m_device_sent_time >= item->second.free_time){
+                item = m_live_commands.erase(item);
+            }else{
+                ++item;
+            }
+        }
+
+        m_device_sent_time = next_state_change;
+        if (next_state_change > *iter){
+            m_state_changes.erase(iter);
+        }
+        return true;
+    }
+    void process_schedule(Schedule& schedule){
+        while (iterate_schedule(schedule));
+    }
+
+private:
+    WallClock m_device_issue_time;
+    WallClock m_device_sent_time;
+    WallClock m_max_free_time;
+    std::set<WallClock> m_state_changes;
+
+    struct Command{
+        WallClock busy_time;
+        WallClock done_time;
+        WallClock free_time;
+    };
+    std::map<size_t, Command> m_live_commands;
+};
+
+class SchedulerTestResource : public SchedulerResource{
+public:
+    using SchedulerResource::SchedulerResource;
+};
+
+//  Returns an empty string if the two schedules are the same.
+std::string compare_schedules(
+    const SuperscalarScheduler::Schedule& schedule,
+    const ReferenceSuperscalarScheduler::Schedule& reference
+){
+    if (schedule.size() != reference.size()){
+        return "schedule size: " + std::to_string(schedule.size()) + " vs. " + std::to_string(reference.size());
+    }
+    for (size_t c = 0; c < schedule.size(); c++){
+        const SuperscalarScheduler::ScheduleEntry& x = schedule[c];
+        const ReferenceSuperscalarScheduler::ScheduleEntry& y = reference[c];
+        bool same = x.duration == y.duration && x.state.size() == y.state.size();
+        for (size_t i = 0; same && i < x.state.size(); i++){
+            same = x.state[i]->id == y.state[i];
+        }
+        if (!same){
+            return "entry " + std::to_string(c);
+        }
+    }
+    return "";
+}
+
+}
+
+
+//  Check the schedule of a small hand-worked example. Then check that the
+//  scheduler gives the same schedules as the reference implementation above,
+//  with every resource in use at once and on random issue traces. Last, time
+//  how many button presses per second the scheduler can issue.
+int test_NintendoSwitch_SuperscalarScheduler(const std::string& test_path){
+    auto& logger = global_logger_command_line();
+
+    {
+        SuperscalarScheduler scheduler(logger, Milliseconds(4));
+        SuperscalarScheduler::Schedule schedule;
+
+        //  A is held for [0, 50). B is held for [20, 70). So the timeline is:
+        //  A alone, then A + B, then B alone.
+        scheduler.issue_to_resource(
+            schedule, std::make_unique<SwitchCommand_Button>(SwitchResource::BUTTON_A),
+            20ms, 50ms, 0ms
+        );
+        scheduler.issue_to_resource(
+            schedule, std::make_unique<SwitchCommand_Button>(SwitchResource::BUTTON_B),
+            0ms, 50ms, 0ms
+        );
+        scheduler.issue_nop(schedule, 30ms);
+        scheduler.issue_wait_for_all(schedule);
+
+        const std::vector<std::pair<Milliseconds, std::vector<size_t>>> expected{
+            {20ms, {(size_t)SwitchResource::BUTTON_A}},
+            {30ms, {(size_t)SwitchResource::BUTTON_B, (size_t)SwitchResource::BUTTON_A}},
+            {20ms, {(size_t)SwitchResource::BUTTON_B}},
+        };
+        TEST_RESULT_COMPONENT_EQUAL(schedule.size(), expected.size(), "schedule size");
+        for (size_t c = 0; c < expected.size(); c++){
+            const SuperscalarScheduler::ScheduleEntry& entry = schedule[c];
+            TEST_RESULT_COMPONENT_EQUAL(
+                std::chrono::duration_cast<Milliseconds>(entry.duration).count(),
+                expected[c].first.count(),
+                "duration of entry " + std::to_string(c)
+            );
+            TEST_RESULT_COMPONENT_EQUAL(entry.state.size(), expected[c].second.size(), "state size of entry " + std::to_string(c));
+            for (size_t i = 0; i < expected[c].second.size(); i++){
+                TEST_RESULT_COMPONENT_EQUAL(entry.state[i]->id, expected[c].second[i], "resource in entry " + std::to_string(c));
+            }
+        }
+    }
+
+    //  Every resource in use at once, each with a different release time. The
+    //  later rounds stall on resources that are still busy.
+    {
+        const size_t RESOURCES = SuperscalarScheduler::MAX_RESOURCES;
+        SuperscalarScheduler scheduler(logger, Milliseconds(4));
+        ReferenceSuperscalarScheduler reference;
+        SuperscalarScheduler::Schedule schedule;
+        ReferenceSuperscalarScheduler::Schedule reference_schedule;
+        for (size_t round = 0; round < 3; round++){
+            for (size_t c = 0; c < RESOURCES; c++){
+                size_t id = (c * 97 + round) % RESOURCES;
+                WallDuration hold = Milliseconds(1000 + 7 * ((c * 31) % RESOURCES));
+                WallDuration cooldown = Milliseconds(c % 5);
+                WallDuration delay = round == 1 ? 0ms : 1ms;
+                scheduler.issue_to_resource(
+                    schedule, std::make_unique<SchedulerTestResource>(id),
+                    delay, hold, cooldown
+                );
+                reference.issue_to_resource(reference_schedule, id, delay, hold, cooldown);
+            }
+        }
+        scheduler.issue_wait_for_all(schedule);
+        reference.issue_wait_for_all(reference_schedule);
+
+        std::string difference = compare_schedules(schedule, reference_schedule);
+        if (!difference.empty()){
+            cout << "All resources: Schedules differ at " << difference << endl;
+        }
+        TEST_RESULT_COMPONENT_EQUAL(difference.empty(), true, "all resources match the reference");
+        cout << "All resources: " << schedule.size() << " schedule entries, OK" << endl;
+    }
+
+    //  Random issue traces. Zero delays are common so that state changes pile
+    //  up before they are sent.
+    {
+        std::mt19937 rng(0);
+        size_t mismatches = 0;
+        for (size_t trace = 0; trace < 2000; trace++){
+            const size_t resources = trace % 2 == 0 ? 8 : SuperscalarScheduler::MAX_RESOURCES;
+            SuperscalarScheduler scheduler(logger, Milliseconds(4));
+            ReferenceSuperscalarScheduler reference;
+            SuperscalarScheduler::Schedule schedule;
+            ReferenceSuperscalarScheduler::Schedule reference_schedule;
+            for (size_t c = 0; c < 300; c++){
+                size_t id = rng() % resources;
+                switch (rng() % 16){
+                case 0:
+                    scheduler.issue_wait_for_all(schedule);
+                    reference.issue_wait_for_all(reference_schedule);
+                    break;
+                case 1:
+                case 2:
+                    scheduler.issue_wait_for_resource(schedule, id);
+                    reference.issue_wait_for_resource(reference_schedule, id);
+                    break;
+                case 3:
+                case 4:{
+                    WallDuration delay = Milliseconds(rng() % 40);
+                    scheduler.issue_nop(schedule, delay);
+                    reference.issue_nop(reference_schedule, delay);
+                    break;
+                }
+                default:{
+                    WallDuration delay = Milliseconds(rng() % 2 == 0 ? 0 : rng() % 50);
+                    WallDuration hold = Milliseconds(rng() % 80);
+                    WallDuration cooldown = Milliseconds(rng() % 30);
+                    scheduler.issue_to_resource(
+                        schedule, std::make_unique<SchedulerTestResource>(id),
+                        delay, hold, cooldown
+                    );
+                    reference.issue_to_resource(reference_schedule, id, delay, hold, cooldown);
+                }
+                }
+            }
+            scheduler.issue_wait_for_all(schedule);
+            reference.issue_wait_for_all(reference_schedule);
+
+            std::string difference = compare_schedules(schedule, reference_schedule);
+            if (!difference.empty()){
+                cout << "Trace " << trace << ": Schedules differ at " << difference << endl;
+                mismatches++;
+            }
+        }
+        TEST_RESULT_COMPONENT_EQUAL(mismatches, (size_t)0, "random traces that differ from the reference");
+        cout << "Random traces: OK" << endl;
+    }
+
+    //  Issue throughput. Each iteration is what issue_buttons() does for a
+    //  single button followed by a short delay.
+    const size_t num_iterations = 1000000;
+    std::vector<SchedulerResourcePtr> buttons;
+    for (size_t c = 0; c < TOTAL_BUTTONS; c++){
+        buttons.emplace_back(std::make_unique<SwitchCommand_Button>((SwitchResource)c));
+    }
+    auto run = [&](const char* label, auto&& make_command){
+        SuperscalarScheduler scheduler(logger, Milliseconds(4));
+        size_t entries = 0;
+        auto time_start = current_time();
+        for (size_t c = 0; c < num_iterations; c++){
+            SuperscalarScheduler::Schedule schedule;
+            size_t button = (c * 7) % TOTAL_BUTTONS;
+            scheduler.issue_wait_for_resource(schedule, button);
+            scheduler.issue_to_resource(schedule, make_command(button), 0ms, 48ms, 24ms);
+            scheduler.issue_nop(schedule, 16ms);
+            entries += schedule.size();
+        }
+        auto time_end = current_time();
+        double seconds = std::chrono::duration_cast<std::chrono::microseconds>(time_end - time_start).count() / 1000000.;
+        cout << label << ": " << num_iterations / seconds << " issues/s, "
+             << entries << " schedule entries" << endl;
+    };
+    run("New command per press", [](size_t button){
+        return SchedulerResourcePtr(std::make_unique<SwitchCommand_Button>((SwitchResource)button));
+    });
+    run("Shared command per button", [&](size_t button){
+        return buttons[button];
+    });
+
+    return 0;
+}
+
 
 }
@@ -9,6 +9,8 @@
 #ifndef PokemonAutomation_Tests_NintendoSwitch_Tests_H
 #define PokemonAutomation_Tests_NintendoSwitch_Tests_H
 
+#include <string>
+
 namespace PokemonAutomation{
 
 class ImageViewRGB32;
@@ -17,6 +19,8 @@ int test_NintendoSwitch_CheckOnlineDetector(const ImageViewRGB32& image, bool ta
 int test_NintendoSwitch_FailedToConnectDetector(const ImageViewRGB32& image, bool target);
 int test_NintendoSwitch_UpdatePopupDetector(const ImageViewRGB32& image, bool target);
 
+int test_NintendoSwitch_SuperscalarScheduler(const std::string& test_path);
+
 }
 
 #endif
@@ -15,6 +15,7 @@
 #include "PokemonFRLG/Inference/Dialogs/PokemonFRLG_BattleDialogs.h"
 #include "PokemonFRLG/Inference/Dialogs/PokemonFRLG_PrizeSelectDetector.h"
 #include "PokemonFRLG/Inference/PokemonFRLG_ShinySymbolDetector.h"
+#include "Pokemon/Pokemon_AdvRng.h"
 #include "PokemonFRLG_Tests.h"
 #include "TestUtils.h"
 
@@ -27,6 +28,7 @@ namespace PokemonAutomation{
 
 using namespace NintendoSwitch;
 using namespace NintendoSwitch::PokemonFRLG;
+using namespace Pokemon;
 
 int test_pokemonFRLG_AdvanceWhiteDialogDetector(const ImageViewRGB32& image, bool target){
     auto overlay = DummyVideoOverlay();
@@ -77,4 +79,213 @@ int test_pokemonFRLG_PrizeSelectDetector(const ImageViewRGB32& image, bool targe
     return 0;
 }
 
+
+namespace{
+
+//  The searches below use filters that only look at the nature and the IVs.
+bool reference_match(AdvNature nature, const AdvIVs& ivs, const AdvRngFilters& target){
+    auto in_range = [](uint8_t iv, const IvRange& range){
+        return range.low <= iv && iv <= range.high;
+    };
+    return (target.nature == AdvNature::Any || nature == target.nature)
+        && in_range(ivs.hp, target.ivs.hp)
+        && in_range(ivs.attack, target.ivs.attack)
+        && in_range(ivs.defense, target.ivs.defense)
+        && in_range(ivs.spatk, target.ivs.spatk)
+        && in_range(ivs.spdef, target.ivs.spdef)
+        && in_range(ivs.speed, target.ivs.speed);
+}
+bool reference_egg_held(uint32_t state, AdvEggCompatibility compatibility){
+    uint32_t threshold = compatibility == AdvEggCompatibility::high
+        ? 70
+        : compatibility == AdvEggCompatibility::medium ? 50 : 20;
+    return ((state >> 16) * 100) / 0xffff < threshold;
+}
+bool same_state(const AdvRngState& x, const AdvRngState& y){
+    return x.seed == y.seed && x.advance == y.advance && x.method == y.method
+        && x.s0 == y.s0 && x.s1 == y.s1 && x.s2 == y.s2
+        && x.s3 == y.s3 && x.s4 == y.s4 && x.s5 == y.s5;
+}
+int compare_states(
+    const std::string& name,
+    const std::vector<AdvRngState>& result,
+    const std::vector<AdvRngState>& target
+){
+    TEST_RESULT_COMPONENT_EQUAL(result.size(), target.size(), name + " hit count");
+    for (size_t c = 0; c < result.size(); c++){
+        TEST_RESULT_COMPONENT_EQUAL(same_state(result[c], target[c]), true, name + " hit " + std::to_string(c));
+    }
+    if (target.empty()){
+        cerr << "Error: " << name << " found nothing. The test doesn't cover anything." << endl;
+        return 1;
+    }
+    cout << name << ": " << target.size() << " hits OK" << endl;
+    return 0;
+}
+
+//  The advance windows are longer than one search block (1024 advances) so
+//  the block boundaries are covered.
+const std::vector<uint16_t> ADV_TEST_SEEDS{0x0000, 0x5a5a, 0xffff};
+const uint64_t ADV_TEST_MIN_ADVANCES = 100;
+const uint64_t ADV_TEST_MAX_ADVANCES = 2200;
+
+AdvRngFilters adv_test_filters(AdvRngMethod method){
+    AdvRngFilters ret;
+    ret.level = 3;
+    ret.gender = AdvGender::Any;
+    ret.nature = AdvNature::Adamant;
+    ret.ability = AdvAbility::Any;
+    ret.ivs.hp = {10, 31};
+    ret.ivs.attack = {0, 31};
+    ret.ivs.defense = {0, 31};
+    ret.ivs.spatk = {0, 31};
+    ret.ivs.spdef = {0, 31};
+    ret.ivs.speed = {0, 31};
+    ret.shiny = AdvShinyType::Any;
+    ret.method = method;
+    return ret;
+}
+
+}
+
+//  Compare the jump-ahead parallel searches against stepping through the
+//  advances one at a time.
+int test_pokemonFRLG_AdvRngSearch(const std::string& test_path){
+    const std::vector<AdvRngMethod> METHODS{AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method4};
+
+    {
+        AdvRngFilters target = adv_test_filters(AdvRngMethod::Any);
+
+        std::vector<AdvRngState> expected;
+        for (uint16_t seed : ADV_TEST_SEEDS){
+            for (AdvRngMethod method : METHODS){
+                AdvRngSearcher searcher(seed, 0, method);
+                for (uint64_t a = 0; a < ADV_TEST_MIN_ADVANCES; a++){
+                    searcher.advance_state();
+                }
+                for (uint64_t a = ADV_TEST_MIN_ADVANCES; a <= ADV_TEST_MAX_ADVANCES; a++){
+                    AdvPokemonResult res = searcher.generate_pokemon();
+                    if (reference_match(res.nature, res.ivs, target)){
+                        expected.emplace_back(searcher.state);
+                    }
+                    searcher.advance_state();
+                }
+            }
+        }
+
+        AdvRngSearcher searcher(0, 0);
+        std::vector<AdvRngState> result = searcher.search(
+            target, ADV_TEST_SEEDS, ADV_TEST_MIN_ADVANCES, ADV_TEST_MAX_ADVANCES
+        );
+        if (compare_states("AdvRngSearcher", result, expected)){
+            return 1;
+        }
+    }
+
+    {
+        //  Slots 0 and 1 are the only level 3 pidgeys.
+        std::vector<AdvEncounterSlot> slots(12, AdvEncounterSlot{"rattata", 2, 4});
+        slots[0] = {"pidgey", 3, 3};
+        slots[1] = {"pidgey", 2, 5};
+        AdvRngFilters target = adv_test_filters(AdvRngMethod::Any);
+        target.species = "pidgey";
+
+        std::vector<AdvRngState> expected;
+        for (uint16_t seed : ADV_TEST_SEEDS){
+            for (AdvRngMethod method : METHODS){
+                AdvRngWildSearcher searcher(seed, 0, slots, method);
+                for (uint64_t a = 0; a < ADV_TEST_MIN_ADVANCES; a++){
+                    searcher.advance_state();
+                }
+                for (uint64_t a = ADV_TEST_MIN_ADVANCES; a <= ADV_TEST_MAX_ADVANCES; a++){
+                    AdvWildPokemonResult res = searcher.generate_pokemon();
+                    if (res.species == target.species && res.level == target.level &&
+                        reference_match(res.nature, res.ivs, target)
+                    ){
+                        expected.emplace_back(searcher.state);
+                    }
+                    searcher.advance_state();
+                }
+            }
+        }
+
+        AdvRngWildSearcher searcher(0, 0, slots);
+        std::vector<AdvRngState> result = searcher.search(
+            target, ADV_TEST_SEEDS, ADV_TEST_MIN_ADVANCES, ADV_TEST_MAX_ADVANCES
+        );
+        if (compare_states("AdvRngWildSearcher", result, expected)){
+            return 1;
+        }
+    }
+
+    {
+        //  Eggs: the held advance decides whether there is an egg and half of
+        //  its pid. The pickup advance decides the rest.
+        const std::vector<AdvRngMethod> EGG_METHODS{
+            AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method3, AdvRngMethod::Method4
+        };
+        const std::vector<uint16_t> held_seeds{0x5a5a};
+        const std::vector<uint16_t> pickup_seeds{0x1234};
+        const uint64_t min_held = ADV_TEST_MIN_ADVANCES, max_held = 1150;
+        const uint64_t min_pickup = ADV_TEST_MIN_ADVANCES, max_pickup = 1200;
+        const AdvEggCompatibility compatibility = AdvEggCompatibility::medium;
+        AdvIVs parentA{31, 31, 31, 31, 31, 31};
+        AdvIVs parentB{0, 0, 0, 0, 0, 0};
+        AdvRngFilters target = adv_test_filters(AdvRngMethod::Any);
+
+        std::vector<AdvRngState> expected_held;
+        std::vector<AdvRngState> expected_pickup;
+        for (uint16_t held_seed : held_seeds){
+            AdvRngEggSearcher searcher(held_seed, 0, 0, 0, AdvRngMethod::Method1);
+            for (uint64_t a = 0; a < min_held; a++){
+                searcher.advance_held_state();
+            }
+            for (uint64_t a = min_held; a <= max_held; a++){
+                if (reference_egg_held(searcher.held_state.s0, compatibility)){
+                    for (uint16_t pickup_seed : pickup_seeds){
+                        for (AdvRngMethod method : EGG_METHODS){
+                            searcher.set_pickup_seed(pickup_seed);
+                            searcher.pickup_state.method = method;
+                            for (uint64_t p = 0; p < min_pickup; p++){
+                                searcher.advance_pickup_state();
+                            }
+                            for (uint64_t p = min_pickup; p <= max_pickup; p++){
+                                AdvPokemonResult res = searcher.generate_pokemon(parentA, parentB);
+                                if (reference_match(res.nature, res.ivs, target)){
+                                    expected_held.emplace_back(searcher.held_state);
+                                    expected_pickup.emplace_back(searcher.pickup_state);
+                                }
+                                searcher.advance_pickup_state();
+                            }
+                        }
+                    }
+                }
+                searcher.advance_held_state();
+            }
+        }
+
+        AdvRngEggSearcher searcher(0, 0, 0, 0, AdvRngMethod::Method1);
+        std::vector<std::pair<AdvRngState, AdvRngState>> result = searcher.search(
+            target,
+            held_seeds, min_held, max_held,
+            pickup_seeds, min_pickup, max_pickup,
+            parentA, parentB, compatibility
+        );
+        std::vector<AdvRngState> result_held;
+        std::vector<AdvRngState> result_pickup;
+        for (const auto& item : result){
+            result_held.emplace_back(item.first);
+            result_pickup.emplace_back(item.second);
+        }
+        if (compare_states("AdvRngEggSearcher (held)", result_held, expected_held)){
+            return 1;
+        }
+        if (compare_states("AdvRngEggSearcher (pickup)", result_pickup, expected_pickup)){
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
 }
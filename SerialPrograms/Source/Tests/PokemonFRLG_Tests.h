@@ -29,6 +29,8 @@ int test_pokemonFRLG_BattleMenuDetector(const ImageViewRGB32& image, bool target
 
 int test_pokemonFRLG_PrizeSelectDetector(const ImageViewRGB32& image, bool target);
 
+int test_pokemonFRLG_AdvRngSearch(const std::string& test_path);
+
 }
 
 #endif
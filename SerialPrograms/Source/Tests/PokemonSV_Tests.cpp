@@ -29,9 +29,12 @@
 #include "PokemonSV/Inference/Overworld/PokemonSV_OverworldDetector.h"
 #include "PokemonSV/Inference/Dialogs/PokemonSV_DialogDetector.h"
 #include "PokemonSV/Inference/PokemonSV_ESPEmotionDetector.h"
+#include "PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.h"
+#include "PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.h"
 #include "TestUtils.h"
 #include "PokemonSV_Tests.h"
 
+#include <algorithm>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -579,4 +582,64 @@ int test_pokemonSV_RecentlyBattledDetector(const ImageViewRGB32& image, bool tar
     return 0;
 }
 
+int test_pokemonSV_ItemPrinterSeedSearch(const std::string& test_path){
+    using namespace ItemPrinter;
+
+    //  The integer prizes must match the string prizes.
+    const std::vector<std::string>& slugs = prize_slugs();
+    for (int64_t seed = 1717461428 - 1000; seed <= 1717461428 + 1000; seed++){
+        DateSeed expected = calculate_seed_prizes(seed);
+        SeedPrizes prizes;
+        calculate_prize_ids(prizes, seed, PrintMode::Regular);
+        for (size_t c = 0; c < 10; c++){
+            TEST_RESULT_COMPONENT_EQUAL(slugs[prizes.items[c]], expected.regular[c], "seed " + std::to_string(seed));
+        }
+    }
+
+    //  Compare the parallel search against a brute force scan.
+    SeedSearchQuery query;
+    query.first_seed = 958172368 - 200000;
+    query.last_seed = 958172368 + 200000;
+    query.mode = PrintMode::ItemBonus;
+    query.jobs = 5;
+    query.desired_items = {"ability-patch"};
+    query.min_quantity = 2;
+    query.max_results = 20;
+
+    std::vector<SeedSearchMatch> expected;
+    const int ability_patch = prize_id("ability-patch");
+    for (int64_t seed = query.first_seed; seed <= query.last_seed; seed++){
+        SeedPrizes prizes;
+        calculate_prize_ids(prizes, seed, query.mode, query.jobs);
+        uint32_t quantity = 0;
+        for (size_t c = 0; c < query.jobs; c++){
+            if (prizes.items[c] == ability_patch){
+                quantity += prizes.quantities[c];
+            }
+        }
+        if (quantity >= query.min_quantity){
+            expected.emplace_back(SeedSearchMatch{seed, quantity, prizes.bonus});
+        }
+    }
+    std::stable_sort(
+        expected.begin(), expected.end(),
+        [](const SeedSearchMatch& x, const SeedSearchMatch& y){
+            return x.quantity > y.quantity;
+        }
+    );
+    if (expected.size() > query.max_results){
+        expected.resize(query.max_results);
+    }
+
+    std::vector<SeedSearchMatch> matches = search_seeds(query);
+    TEST_RESULT_COMPONENT_EQUAL(matches.size(), expected.size(), "# of matches");
+    for (size_t c = 0; c < matches.size(); c++){
+        TEST_RESULT_COMPONENT_EQUAL(matches[c].seed, expected[c].seed, "match " + std::to_string(c));
+        TEST_RESULT_COMPONENT_EQUAL(matches[c].quantity, expected[c].quantity, "match " + std::to_string(c));
+    }
+    cout << "Found " << matches.size() << " matching seeds." << endl;
+
+    return 0;
+}
+
 }
@@ -6,6 +6,10 @@
 
 
 #include "Common/Compiler.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "CommonFramework/Globals.h"
 #include "PokemonSwSh_Tests.h"
 #include "TestUtils.h"
 
@@ -16,6 +20,12 @@
 #include "PokemonSwSh/MaxLair/Inference/PokemonSwSh_MaxLair_Detect_BattleMenu.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_DialogBoxDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxShinySymbolDetector.h"
+#include "PokemonSwSh/Inference/PokemonSwSh_PokemonSpriteReader.h"
+#include "Pokemon/Pokemon_Xoroshiro128Plus.h"
+#include "PokemonSwSh/PkmnLib/PokemonSwSh_PkmnLib_Pokemon.h"
+#include "PokemonSwSh/Resources/PokemonSwSh_MaxLairDatabase.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_RentalBossMatchup.h"
+#include "PokemonSwSh/MaxLair/AI/PokemonSwSh_MaxLair_AI_PathMatchup.h"
 
 #include <QFileInfo>
 #include <QDir>
@@ -24,6 +34,7 @@
 #include <iomanip>
 #include <sstream>
 #include <map>
+#include <set>
 using std::cout;
 using std::cerr;
 using std::endl;
@@ -134,4 +145,337 @@ int test_pokemonSwSh_SelectionArrowFinder(const ImageViewRGB32& image, int targe
     return 0;
 }
 
+//  Benchmark the pruned sprite search against the exhaustive one on the full
+//  and left-half SwSh sprite sets. The whole image is matched.
+int test_pokemonSwSh_PokemonSpriteMatcherExact(const ImageViewRGB32& image){
+    const PokemonSpriteMatcherExact full_matcher(nullptr);
+    const PokemonLeftSpriteMatcherExact left_matcher(nullptr);
+    const ImageFloatBox box(0, 0, 1, 1);
+    const size_t tolerance = 2;
+    const double alpha_spread = 0.10;
+    const int num_iterations = 10;
+
+    auto run = [&](const char* label, const ImageMatch::ExactImageDictionaryMatcher& matcher) -> int{
+        ImageMatch::ImageMatchResult exhaustive;
+        ImageMatch::ImageMatchResult pruned;
+
+        auto time_start = current_time();
+        for (int i = 0; i < num_iterations; i++){
+            exhaustive = matcher.match_exhaustive(image, box, tolerance, alpha_spread);
+        }
+        auto time_mid = current_time();
+        for (int i = 0; i < num_iterations; i++){
+            pruned = matcher.match(image, box, tolerance, alpha_spread);
+        }
+        auto time_end = current_time();
+
+        const auto ms_exhaustive = std::chrono::duration_cast<Milliseconds>(time_mid - time_start).count();
+        const auto ms_pruned = std::chrono::duration_cast<Milliseconds>(time_end - time_mid).count();
+        cout << label << ": exhaustive " << ms_exhaustive / (double)num_iterations << " ms"
+             << ", pruned " << ms_pruned / (double)num_iterations << " ms" << endl;
+
+        TEST_RESULT_COMPONENT_EQUAL(pruned.results.size(), exhaustive.results.size(), label);
+        auto iter0 = pruned.results.begin();
+        auto iter1 = exhaustive.results.begin();
+        for (; iter0 != pruned.results.end(); ++iter0, ++iter1){
+            TEST_RESULT_COMPONENT_EQUAL(iter0->first, iter1->first, label);
+            TEST_RESULT_COMPONENT_EQUAL(iter0->second, iter1->second, label);
+        }
+        return 0;
+    };
+
+    int ret = run("Full Sprites", full_matcher);
+    if (ret != 0){
+        return ret;
+    }
+    return run("Left Sprites", left_matcher);
+}
+
+
+int test_pokemonSwSh_Xoroshiro128Plus(const std::string& test_path){
+    using Pokemon::Xoroshiro128Plus;
+    using Pokemon::Xoroshiro128PlusState;
+
+    const Xoroshiro128PlusState start(0x0123456789abcdef, 0xfedcba9876543210);
+
+    //  advance() must match stepping.
+    {
+        Xoroshiro128Plus stepped(start);
+        uint64_t steps = 0;
+        for (uint64_t target : {0, 1, 2, 127, 128, 129, 1000, 65535, 65536, 1000003}){
+            while (steps < target){
+                stepped.next();
+                steps++;
+            }
+            Xoroshiro128Plus jumped(start);
+            jumped.advance(target);
+            TEST_RESULT_COMPONENT_EQUAL(jumped.state.s0, stepped.state.s0, "advance(" + std::to_string(target) + ")");
+            TEST_RESULT_COMPONENT_EQUAL(jumped.state.s1, stepped.state.s1, "advance(" + std::to_string(target) + ")");
+        }
+    }
+
+    //  Jumps compose. (too far to step)
+    {
+        const uint64_t x = ((uint64_t)1 << 40) + 12345;
+        const uint64_t y = 0x0123456789abcdef;
+        Xoroshiro128Plus rng0(start);
+        rng0.advance(x);
+        rng0.advance(y);
+        Xoroshiro128Plus rng1(start);
+        rng1.advance(x + y);
+        TEST_RESULT_COMPONENT_EQUAL(rng0.state.s0, rng1.state.s0, "advance(x) + advance(y)");
+        TEST_RESULT_COMPONENT_EQUAL(rng0.state.s1, rng1.state.s1, "advance(x) + advance(y)");
+    }
+
+    //  advances_to_state() must match the stepping implementation.
+    for (uint64_t distance : {0, 1, 100, 4095, 4096, 4097, 99999, 100000, 100001, 250000}){
+        Xoroshiro128Plus target(start);
+        target.advance(distance);
+        Xoroshiro128Plus rng(start);
+        for (uint64_t max_advances : {(uint64_t)100000, (uint64_t)200000, distance}){
+            std::string label = std::to_string(distance) + " / " + std::to_string(max_advances);
+            std::pair<bool, uint64_t> expected = rng.advances_to_state_stepping(target.state, max_advances);
+            std::pair<bool, uint64_t> actual = rng.advances_to_state(target.state, max_advances);
+            TEST_RESULT_COMPONENT_EQUAL(actual.first, expected.first, label);
+            if (expected.first){
+                TEST_RESULT_COMPONENT_EQUAL(actual.second, expected.second, label);
+            }
+        }
+    }
+
+    //  Far distances.
+    for (uint64_t distance : {((uint64_t)1 << 32) + 7, ((uint64_t)1 << 40) - 12345}){
+        Xoroshiro128Plus target(start);
+        target.advance(distance);
+        Xoroshiro128Plus rng(start);
+
+        auto time0 = current_time();
+        std::pair<bool, uint64_t> found = rng.advances_to_state(target.state, (uint64_t)1 << 40);
+        auto time1 = current_time();
+        cout << "advances_to_state(" << distance << "): "
+             << std::chrono::duration_cast<Milliseconds>(time1 - time0).count() << " ms" << endl;
+
+        TEST_RESULT_COMPONENT_EQUAL(found.first, true, std::to_string(distance));
+        TEST_RESULT_COMPONENT_EQUAL(found.second, distance, std::to_string(distance));
+
+        found = rng.advances_to_state(target.state, distance - 1);
+        TEST_RESULT_COMPONENT_EQUAL(found.first, false, std::to_string(distance) + " out of range");
+    }
+
+    return 0;
+}
+
+
+
+namespace{
+
+//  Map-based versions of the Max Lair matchup tables that are loaded straight
+//  from the JSON. Anything missing is NaN.
+struct MaxLairMatchupReference{
+    std::map<std::string, std::map<std::string, double>> rental_vs_boss;
+    std::map<std::string, std::map<Pokemon::PokemonType, double>> type_vs_boss;
+
+    double matchup(const std::string& rental, const std::string& boss) const{
+        auto iter0 = rental_vs_boss.find(rental);
+        if (iter0 == rental_vs_boss.end()){
+            return std::nan("");
+        }
+        auto iter1 = iter0->second.find(boss);
+        return iter1 == iter0->second.end() ? std::nan("") : iter1->second;
+    }
+    double type_matchup(Pokemon::PokemonType type, const std::string& boss) const{
+        auto iter0 = type_vs_boss.find(boss);
+        if (iter0 == type_vs_boss.end()){
+            return std::nan("");
+        }
+        auto iter1 = iter0->second.find(type);
+        return iter1 == iter0->second.end() ? std::nan("") : iter1->second;
+    }
+};
+
+//  The tables throw for anything that's missing.
+template <typename Function>
+double matchup_or_nan(Function&& function){
+    try{
+        return function();
+    }catch (InternalProgramError&){
+        return std::nan("");
+    }
+}
+
+int compare_matchup(const std::string& name, double result, double target){
+    bool ok = std::isnan(target)
+        ? std::isnan(result)
+        : std::fabs(result - target) <= 1e-9;
+    if (!ok){
+        cerr << "Error: " << name << " result is " << result << " but should be " << target << "." << endl;
+        return 1;
+    }
+    return 0;
+}
+
+}
+
+//  Compare the dense Max Lair matchup tables against map lookups done the way
+//  the AI used to do them. Needs the Max Lair resources.
+int test_pokemonSwSh_MaxLair_Matchups(const std::string& test_path){
+    using namespace MaxLairInternal;
+    using Pokemon::PokemonType;
+
+    const std::string lut_path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/boss_matchup_LUT.json";
+    const std::string path_tree_path = RESOURCE_PATH() + "PokemonSwSh/MaxLair/path_tree.json";
+    if (!QFileInfo(QString::fromStdString(lut_path)).exists() ||
+        !QFileInfo(QString::fromStdString(path_tree_path)).exists()
+    ){
+        cout << "Skip " << test_path << " as the Max Lair resources are not in " << RESOURCE_PATH() << endl;
+        return -1;
+    }
+
+    MaxLairMatchupReference reference;
+    std::set<std::string> boss_slugs;
+    {
+        JsonValue json = load_json_file(lut_path);
+        JsonObject& root = json.to_object_throw(lut_path);
+        for (auto& item0 : root){
+            std::map<std::string, double>& sub = reference.rental_vs_boss[item0.first];
+            JsonObject& obj = item0.second.to_object_throw(lut_path);
+            for (auto& item1 : obj){
+                sub[item1.first] = item1.second.to_double_throw(lut_path);
+                boss_slugs.insert(item1.first);
+            }
+        }
+    }
+    {
+        JsonValue json = load_json_file(path_tree_path);
+        JsonObject& root = json.to_object_throw(path_tree_path);
+        JsonObject& node = root.get_object_throw("base_node", path_tree_path).get_object_throw("hash_table");
+        for (auto& item : node){
+            std::map<PokemonType, double>& boss = reference.type_vs_boss[item.first];
+            JsonObject& obj = item.second.to_object_throw(path_tree_path).get_object_throw("hash_table", path_tree_path);
+            for (const auto& type : POKEMON_TYPE_SLUGS()){
+                if (type.first == PokemonType::NONE){
+                    continue;
+                }
+                boss[type.first] = obj.get_double_throw(type.second, path_tree_path);
+            }
+        }
+    }
+
+    //  Every rental against every boss, including the pairs that aren't in
+    //  the table.
+    size_t pairs = 0;
+    for (const auto& rental : reference.rental_vs_boss){
+        for (const std::string& boss : boss_slugs){
+            std::string name = "rental_vs_boss_matchup(" + rental.first + ", " + boss + ")";
+            double target = reference.matchup(rental.first, boss);
+            double by_slug = matchup_or_nan([&]{
+                return rental_vs_boss_matchup(rental.first, boss);
+            });
+            double by_id = matchup_or_nan([&]{
+                return rental_vs_boss_matchup(rental_matchup_id(rental.first), boss_matchup_id(boss));
+            });
+            if (compare_matchup(name, by_slug, target) || compare_matchup(name + " by ID", by_id, target)){
+                return 1;
+            }
+            pairs++;
+        }
+    }
+    cout << "rental_vs_boss_matchup(): " << pairs << " pairs OK" << endl;
+
+    //  Averages over a list of bosses. An empty list means all of them.
+    const std::map<std::string, papkmnlib::Pokemon>& all_bosses = papkmnlib::all_boss_pokemon();
+    std::vector<std::string> some_bosses;
+    for (const auto& boss : all_bosses){
+        if (some_bosses.size() < 3){
+            some_bosses.emplace_back(boss.second.name());
+        }
+    }
+    for (const auto& rental : reference.rental_vs_boss){
+        double all_target = 0;
+        for (const auto& boss : all_bosses){
+            all_target += reference.matchup(rental.first, boss.second.name());
+        }
+        all_target /= all_bosses.size();
+        double some_target = 0;
+        for (const std::string& boss : some_bosses){
+            some_target += reference.matchup(rental.first, boss);
+        }
+        some_target /= some_bosses.size();
+
+        double all_result = matchup_or_nan([&]{
+            return rental_vs_boss_matchup(rental.first, std::vector<std::string>());
+        });
+        double some_result = matchup_or_nan([&]{
+            return rental_vs_boss_matchup(rental.first, some_bosses);
+        });
+        if (compare_matchup("rental_vs_boss_matchup(" + rental.first + ", all bosses)", all_result, all_target) ||
+            compare_matchup("rental_vs_boss_matchup(" + rental.first + ", 3 bosses)", some_result, some_target)
+        ){
+            return 1;
+        }
+    }
+    cout << "rental_vs_boss_matchup() over bosses: OK" << endl;
+
+    //  Average of all the rentals against each boss.
+    const std::map<std::string, papkmnlib::Pokemon>& all_rentals = papkmnlib::all_rental_pokemon();
+    for (const std::string& boss : boss_slugs){
+        double target = 0;
+        for (const auto& rental : all_rentals){
+            target += reference.matchup(rental.first, boss);
+        }
+        target /= all_rentals.size();
+        double result = matchup_or_nan([&]{
+            return average_rental_vs_boss_matchup(boss_matchup_id(boss));
+        });
+        if (compare_matchup("average_rental_vs_boss_matchup(" + boss + ")", result, target)){
+            return 1;
+        }
+    }
+    cout << "average_rental_vs_boss_matchup(): " << boss_slugs.size() << " bosses OK" << endl;
+
+    //  Every type against every boss. NONE isn't in the table.
+    for (const auto& boss : reference.type_vs_boss){
+        for (const auto& type : POKEMON_TYPE_SLUGS()){
+            double result = matchup_or_nan([&]{
+                return type_vs_boss(type.first, boss.first);
+            });
+            double target = reference.type_matchup(type.first, boss.first);
+            if (compare_matchup("type_vs_boss(" + type.second + ", " + boss.first + ")", result, target)){
+                return 1;
+            }
+        }
+    }
+    cout << "type_vs_boss(type, boss): " << reference.type_vs_boss.size() << " bosses OK" << endl;
+
+    //  Every type against the average boss of each type. NONE is all bosses.
+    for (const auto& boss_type : POKEMON_TYPE_SLUGS()){
+        papkmnlib::Type pkmnlib_type = papkmnlib::serial_type_to_pkmnlib(boss_type.first);
+        for (const auto& type : POKEMON_TYPE_SLUGS()){
+            double target = 0;
+            size_t count = 0;
+            for (const auto& item : all_bosses_by_dex()){
+                const papkmnlib::Pokemon& boss = papkmnlib::get_pokemon(item.second);
+                if (boss_type.first == PokemonType::NONE || boss.has_type(pkmnlib_type)){
+                    target += reference.type_matchup(type.first, boss.name());
+                    count++;
+                }
+            }
+            if (count == 0){
+                continue;
+            }
+            target /= (double)count;
+            double result = matchup_or_nan([&]{
+                return type_vs_boss(type.first, boss_type.first);
+            });
+            if (compare_matchup("type_vs_boss(" + type.second + ", " + boss_type.second + " bosses)", result, target)){
+                return 1;
+            }
+        }
+    }
+    cout << "type_vs_boss(type, boss type): OK" << endl;
+
+    return 0;
+}
+
+
 }
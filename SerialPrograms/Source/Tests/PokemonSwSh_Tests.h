@@ -40,6 +40,12 @@ int test_pokemonSwSh_BoxGenderDetector(const ImageViewRGB32& image, int target);
 
 int test_pokemonSwSh_SelectionArrowFinder(const ImageViewRGB32& image, int target);
 
+int test_pokemonSwSh_PokemonSpriteMatcherExact(const ImageViewRGB32& image);
+
+int test_pokemonSwSh_Xoroshiro128Plus(const std::string& test_path);
+
+int test_pokemonSwSh_MaxLair_Matchups(const std::string& test_path);
+
 }
 
 #endif
@@ -8,6 +8,7 @@
 #include "Common/Cpp/Containers/AlignedVector.tpp"
 #include "CommonFramework_Tests.h"
 #include "Kernels_Tests.h"
+#include "ML_Tests.h"
 #include "NintendoSwitch_Tests.h"
 #include "PokemonFRLG_Tests.h"
 #include "PokemonHome_Tests.h"
@@ -223,6 +224,9 @@ int sound_bool_detector_helper(SoundBoolDetectorFunction test_func, const std::s
 
 const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_ImageScaleBrightness", std::bind(image_void_detector_helper, test_kernels_ImageScaleBrightness, _1)},
+    {"Kernels_ImageToTensor", std::bind(image_void_detector_helper, test_kernels_ImageToTensor, _1)},
+    {"Kernels_YUVToRGB32", std::bind(image_void_detector_helper, test_kernels_YUVToRGB32, _1)},
+    {"Kernels_RGB32ToHSV32", std::bind(image_void_detector_helper, test_kernels_RGB32ToHSV32, _1)},
     {"Kernels_BinaryMatrix", std::bind(image_void_detector_helper, test_kernels_BinaryMatrix, _1)},
     {"Kernels_FilterRGB32Range", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Range, _1)},
     {"Kernels_FilterRGB32Euclidean", std::bind(image_void_detector_helper, test_kernels_FilterRGB32Euclidean, _1)},
@@ -230,10 +234,22 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"Kernels_FilterByMask", std::bind(image_void_detector_helper, test_kernels_FilterByMask, _1)},
     {"Kernels_CompressRGB32ToBinaryEuclidean", std::bind(image_void_detector_helper, test_kernels_CompressRGB32ToBinaryEuclidean, _1)},
     {"Kernels_Waterfill", std::bind(image_void_detector_helper, test_kernels_Waterfill, _1)},
+    {"ML_YOLOv5Benchmark", std::bind(image_void_detector_helper, test_ML_YOLOv5Benchmark, _1)},
     {"CommonFramework_BlackBorderDetector", std::bind(image_bool_detector_helper, test_CommonFramework_BlackBorderDetector, _1)},
+    {"CommonFramework_ThreadPool", test_CommonFramework_ThreadPool},
+    {"CommonFramework_AudioSpectrumRing", test_CommonFramework_AudioSpectrumRing},
+    {"CommonFramework_StatsDatabase", test_CommonFramework_StatsDatabase},
+    {"CommonFramework_SnapshotCachedFilters", test_CommonFramework_SnapshotCachedFilters},
+    {"CommonFramework_JsonParser", test_CommonFramework_JsonParser},
+    {"CommonFramework_LevenshteinPattern", test_CommonFramework_LevenshteinPattern},
+    {"CommonFramework_SpriteBundle", test_CommonFramework_SpriteBundle},
+    {"CommonFramework_VideoTileMap", test_CommonFramework_VideoTileMap},
+    {"CommonFramework_SerialEventLoop", test_CommonFramework_SerialEventLoop},
+    {"CommonFramework_PABotBase2Benchmark", test_CommonFramework_PABotBase2Benchmark},
     {"NintendoSwitch_CheckOnlineDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_CheckOnlineDetector, _1)},
     {"NintendoSwitch_FailedToConnectDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_FailedToConnectDetector, _1)},
     {"NintendoSwitch_UpdatePopupDetector", std::bind(image_bool_detector_helper, test_NintendoSwitch_UpdatePopupDetector, _1)},
+    {"NintendoSwitch_SuperscalarScheduler", test_NintendoSwitch_SuperscalarScheduler},
     {"PokemonSwSh_YCommMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_YCommMenuDetector, _1)},
     {"PokemonSwSh_MaxLair_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_MaxLair_BattleMenuDetector, _1)},
     {"PokemonSwSh_DialogTriangleDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_DialogTriangleDetector, _1)},
@@ -246,6 +262,9 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSwSh_BoxShinySymbolDetector", std::bind(image_bool_detector_helper, test_pokemonSwSh_BoxShinySymbolDetector, _1)},
     {"PokemonSwSh_BoxGenderDetector", std::bind(image_int_detector_helper, test_pokemonSwSh_BoxGenderDetector, _1)},
     {"PokemonSwSh_SelectionArrowFinder", std::bind(image_int_detector_helper, test_pokemonSwSh_SelectionArrowFinder, _1)},
+    {"PokemonSwSh_PokemonSpriteMatcherExact", std::bind(image_void_detector_helper, test_pokemonSwSh_PokemonSpriteMatcherExact, _1)},
+    {"PokemonSwSh_Xoroshiro128Plus", test_pokemonSwSh_Xoroshiro128Plus},
+    {"PokemonSwSh_MaxLair_Matchups", test_pokemonSwSh_MaxLair_Matchups},
     {"PokemonLA_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattleMenuDetector, _1)},
     {"PokemonLA_BattlePokemonSwitchDetector", std::bind(image_bool_detector_helper, test_pokemonLA_BattlePokemonSwitchDetector, _1)},
     {"PokemonLA_TransparentDialogueDetector", std::bind(image_bool_detector_helper, test_pokemonLA_TransparentDialogueDetector, _1)},
@@ -283,6 +302,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonSV_BoxPartyEggDetector", std::bind(image_int_detector_helper, test_pokemonSV_BoxPartyEggDetector, _1)},
     {"PokemonSV_OverworldDetector", std::bind(image_bool_detector_helper, test_pokemonSV_OverworldDetector, _1)},
     {"PokemonSV_BoxBottomButtonDetector", std::bind(image_words_detector_helper, test_pokemonSV_BoxBottomButtonDetector, _1)},
+    {"PokemonSV_ItemPrinterSeedSearch", test_pokemonSV_ItemPrinterSeedSearch},
     {"PokemonSV_SandwichIngredientsDetector", std::bind(image_words_detector_helper, test_pokemonSV_SandwichIngredientsDetector, _1)},
     {"PokemonSV_SandwichIngredientReader", test_pokemonSV_SandwichIngredientReader},
     {"PokemonSV_AdvanceDialogDetector", std::bind(image_bool_detector_helper, test_pokemonSV_AdvanceDialogDetector, _1)},
@@ -315,6 +335,7 @@ const std::map<std::string, TestFunction> TEST_MAP = {
     {"PokemonFRLG_AdvanceBattleDialogDetector", std::bind(image_bool_detector_helper, test_pokemonFRLG_AdvanceBattleDialogDetector, _1)},
     {"PokemonFRLG_BattleMenuDetector", std::bind(image_bool_detector_helper, test_pokemonFRLG_BattleMenuDetector, _1)},
     {"PokemonFRLG_PrizeSelectDetector", std::bind(image_bool_detector_helper, test_pokemonFRLG_PrizeSelectDetector, _1)},
+    {"PokemonFRLG_AdvRngSearch", test_pokemonFRLG_AdvRngSearch},
 };
 
 TestFunction find_test_function(const std::string& test_space, const std::string& test_name){
@@ -141,6 +141,10 @@ public:
 
     virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) override { return std::vector<AudioSpectrum>(); }
 
+    virtual AudioSpectrumView spectrum_view_since(uint64_t starting_seqnum) override { return AudioSpectrumView(); }
+
+    virtual AudioSpectrumView spectrum_view_latest(size_t num_last_spectrums) override { return AudioSpectrumView(); }
+
     void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) override {}
 };
 
@@ -33,6 +33,8 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Concurrency/Backends/Thread_StdThreadDetach.tpp
     ../Common/Cpp/Concurrency/Backends/ThreadPool_Default.cpp
     ../Common/Cpp/Concurrency/Backends/ThreadPool_Default.h
+    ../Common/Cpp/Concurrency/Backends/ThreadPool_WorkStealing.cpp
+    ../Common/Cpp/Concurrency/Backends/ThreadPool_WorkStealing.h
     ../Common/Cpp/Concurrency/BusyPeriodicRunner.cpp
     ../Common/Cpp/Concurrency/BusyPeriodicRunner.h
     ../Common/Cpp/Concurrency/ConditionVariable.h
@@ -53,6 +55,7 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Concurrency/ThreadPool.h
     ../Common/Cpp/Concurrency/Watchdog.cpp
     ../Common/Cpp/Concurrency/Watchdog.h
+    ../Common/Cpp/Concurrency/WorkStealingDeque.h
     ../Common/Cpp/Containers/AlignedMalloc.cpp
     ../Common/Cpp/Containers/AlignedMalloc.h
     ../Common/Cpp/Containers/AlignedVector.h
@@ -64,6 +67,7 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Containers/FixedLimitVector.tpp
     ../Common/Cpp/Containers/Pimpl.h
     ../Common/Cpp/Containers/Pimpl.tpp
+    ../Common/Cpp/Containers/SmallVector.h
     ../Common/Cpp/Containers/SparseArray.cpp
     ../Common/Cpp/Containers/SparseArray.h
     ../Common/Cpp/CpuId/CpuId.cpp
@@ -100,8 +104,12 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/ImageResolution.h
     ../Common/Cpp/Json/JsonArray.cpp
     ../Common/Cpp/Json/JsonArray.h
+    ../Common/Cpp/Json/JsonBinary.cpp
+    ../Common/Cpp/Json/JsonBinary.h
     ../Common/Cpp/Json/JsonObject.cpp
     ../Common/Cpp/Json/JsonObject.h
+    ../Common/Cpp/Json/JsonParser.cpp
+    ../Common/Cpp/Json/JsonParser.h
     ../Common/Cpp/Json/JsonTools.cpp
     ../Common/Cpp/Json/JsonTools.h
     ../Common/Cpp/Json/JsonValue.cpp
@@ -196,8 +204,13 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/SparseRegion.h
     ../Common/Cpp/SerialConnection/SerialConnection.cpp
     ../Common/Cpp/SerialConnection/SerialConnection.h
+    ../Common/Cpp/SerialConnection/SerialConnectionEpoll.cpp
+    ../Common/Cpp/SerialConnection/SerialConnectionEpoll.h
     ../Common/Cpp/SerialConnection/SerialConnectionPOSIX.h
     ../Common/Cpp/SerialConnection/SerialConnectionWinAPI.h
+    ../Common/Cpp/SerialConnection/SerialEventLoop.cpp
+    ../Common/Cpp/SerialConnection/SerialEventLoop.h
+    ../Common/Cpp/SerialConnection/SerialPortPOSIX.h
     ../Common/Cpp/StreamConnections/MockDevice.cpp
     ../Common/Cpp/StreamConnections/MockDevice.h
     ../Common/Cpp/StreamConnections/PollingStreamConnections.h
@@ -209,6 +222,8 @@ file(GLOB LIBRARY_SOURCES
     ../Common/Cpp/Sockets/ClientSocket_POSIX.h
     ../Common/Cpp/Sockets/ClientSocket_Qt.h
     ../Common/Cpp/Sockets/ClientSocket_WinSocket.h
+    ../Common/Cpp/SourceFileCache.cpp
+    ../Common/Cpp/SourceFileCache.h
     ../Common/Cpp/Stopwatch.h
     ../Common/Cpp/StreamConverters.cpp
     ../Common/Cpp/StreamConverters.h
@@ -312,6 +327,8 @@ file(GLOB LIBRARY_SOURCES
     ../Common/PABotBase2/Controllers/PABotBase2_Controller_NS1_OemController.h
     ../Common/PABotBase2/PABotBase2CC_MessageDumper.cpp
     ../Common/PABotBase2/PABotBase2CC_MessageDumper.h
+    ../Common/PABotBase2/PABotBase2FW_PtyEmulator.cpp
+    ../Common/PABotBase2/PABotBase2FW_PtyEmulator.h
     ../Common/PABotBase2/PABotBase2_MessageProtocol.h
     ../Common/SerialPABotBase/SerialPABotBase_Messages_HID_Keyboard.h
     ../Common/SerialPABotBase/SerialPABotBase_Messages_NS1_OemControllers.h
@@ -345,6 +362,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/AudioPipeline/IO/AudioSource.h
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.cpp
     Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumHolder.h
+    Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumRing.cpp
+    Source/CommonFramework/AudioPipeline/Spectrum/AudioSpectrumRing.h
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.cpp
     Source/CommonFramework/AudioPipeline/Spectrum/FFTStreamer.h
     Source/CommonFramework/AudioPipeline/Spectrum/Spectrograph.cpp
@@ -408,6 +427,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/ImageTypes/ImageHSV32.h
     Source/CommonFramework/ImageTypes/ImageRGB32.cpp
     Source/CommonFramework/ImageTypes/ImageRGB32.h
+    Source/CommonFramework/ImageTypes/ImageRGB32Pool.cpp
+    Source/CommonFramework/ImageTypes/ImageRGB32Pool.h
     Source/CommonFramework/ImageTypes/ImageViewHSV32.cpp
     Source/CommonFramework/ImageTypes/ImageViewHSV32.h
     Source/CommonFramework/ImageTypes/ImageViewPlanar32.cpp
@@ -495,6 +516,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/Recording/StreamHistoryTracker_RecordOnTheFly.h
     Source/CommonFramework/Recording/StreamHistoryTracker_SaveFrames.cpp
     Source/CommonFramework/Recording/StreamHistoryTracker_SaveFrames.h
+    Source/CommonFramework/Recording/StreamHistoryVideoWriter.cpp
+    Source/CommonFramework/Recording/StreamHistoryVideoWriter.h
     Source/CommonFramework/Recording/StreamRecorder.cpp
     Source/CommonFramework/Recording/StreamRecorder.h
     Source/CommonFramework/ResourceDownload/DownloadThread.cpp
@@ -560,6 +583,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/Stats/MemoryUtilizationStats.h
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.cpp
     Source/CommonFramework/VideoPipeline/Stats/ThreadUtilizationStats.h
+    Source/CommonFramework/VideoPipeline/Stats/VideoSnapshotCacheStats.cpp
+    Source/CommonFramework/VideoPipeline/Stats/VideoSnapshotCacheStats.h
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.cpp
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWidget.h
     Source/CommonFramework/VideoPipeline/UI/VideoDisplayWindow.cpp
@@ -583,6 +608,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/VideoPipelineOptions.h
     Source/CommonFramework/VideoPipeline/VideoSession.cpp
     Source/CommonFramework/VideoPipeline/VideoSession.h
+    Source/CommonFramework/VideoPipeline/VideoSnapshotCache.cpp
+    Source/CommonFramework/VideoPipeline/VideoSnapshotCache.h
     Source/CommonFramework/VideoPipeline/VideoSource.cpp
     Source/CommonFramework/VideoPipeline/VideoSource.h
     Source/CommonFramework/VideoPipeline/VideoSourceDescriptor.cpp
@@ -593,6 +620,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_Null.h
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_StillImage.cpp
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_StillImage.h
+    Source/CommonFramework/VideoPipeline/VideoTileMap.cpp
+    Source/CommonFramework/VideoPipeline/VideoTileMap.h
     Source/CommonFramework/Windows/ButtonDiagram.cpp
     Source/CommonFramework/Windows/ButtonDiagram.h
     Source/CommonFramework/Windows/DpiScaler.cpp
@@ -615,6 +644,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/Audio/AudioTemplateCache.h
     Source/CommonTools/Audio/SpectrogramMatcher.cpp
     Source/CommonTools/Audio/SpectrogramMatcher.h
+    Source/CommonTools/Audio/SpectrumPreprocessCache.cpp
+    Source/CommonTools/Audio/SpectrumPreprocessCache.h
     Source/CommonTools/DetectedBoxes.cpp
     Source/CommonTools/DetectedBoxes.h
     Source/CommonTools/DetectionDebouncer.h
@@ -652,6 +683,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/Images/ImageManip.h
     Source/CommonTools/Images/ImageTools.cpp
     Source/CommonTools/Images/ImageTools.h
+    Source/CommonTools/Images/SnapshotCachedFilters.cpp
+    Source/CommonTools/Images/SnapshotCachedFilters.h
     Source/CommonTools/Images/SolidColorTest.cpp
     Source/CommonTools/Images/SolidColorTest.h
     Source/CommonTools/Images/WaterfillUtilities.cpp
@@ -673,6 +706,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/OCR/OCR_DictionaryOCR.h
     Source/CommonTools/OCR/OCR_LargeDictionaryMatcher.cpp
     Source/CommonTools/OCR/OCR_LargeDictionaryMatcher.h
+    Source/CommonTools/OCR/OCR_LevenshteinPattern.cpp
+    Source/CommonTools/OCR/OCR_LevenshteinPattern.h
     Source/CommonTools/OCR/OCR_NumberReader.cpp
     Source/CommonTools/OCR/OCR_NumberReader.h
     Source/CommonTools/OCR/OCR_RawPaddleOCR.cpp
@@ -707,6 +742,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/Options/TrainOCRModeOption.h
     Source/CommonTools/Random.cpp
     Source/CommonTools/Random.h
+    Source/CommonTools/Resources/SpriteBundle.cpp
+    Source/CommonTools/Resources/SpriteBundle.h
     Source/CommonTools/Resources/SpriteDatabase.cpp
     Source/CommonTools/Resources/SpriteDatabase.h
     Source/CommonTools/StartupChecks/StartProgramChecks.cpp
@@ -856,6 +893,8 @@ file(GLOB LIBRARY_SOURCES
     Source/Integrations/ProgramTracker.h
     Source/Integrations/PybindSwitchController.cpp
     Source/Integrations/PybindSwitchController.h
+    Source/Integrations/PybindVideoSnapshot.cpp
+    Source/Integrations/PybindVideoSnapshot.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT.cpp
     Source/Kernels/AbsFFT/Kernels_AbsFFT.h
     Source/Kernels/AbsFFT/Kernels_AbsFFT_Arch.h
@@ -928,6 +967,11 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.h
     Source/Kernels/BinaryMatrix/Kernels_SparseBinaryMatrixCore.tpp
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.cpp
+    Source/Kernels/ImageToTensor/Kernels_ImageToTensor.cpp
+    Source/Kernels/ImageToTensor/Kernels_ImageToTensor.h
+    Source/Kernels/ImageToTensor/Kernels_ImageToTensor_Default.cpp
+    Source/Kernels/ImageToTensor/Kernels_ImageToTensor_Routines.h
+    Source/Kernels/ImageToTensor/Kernels_ImageToTensor_x64_AVX2.cpp
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic.h
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_ARM64_NEON.cpp
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_Default.cpp
@@ -942,6 +986,18 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Basic_x64_SSE42.cpp
     Source/Kernels/ImageFilters/Kernels_ImageFilter_Green_Default.cpp
     Source/Kernels/ImageFilters/RGB32_Brightness/Kernels_ImageFilter_RGB32_Brightness.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_ARM64_NEON.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Default.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_ARM64_NEON.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX2.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_x64_AVX512.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines_x64_SSE42.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_x64_AVX2.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_x64_AVX512.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_x64_SSE42.cpp
     Source/Kernels/ImageFilters/RGB32_Brightness/Kernels_ImageFilter_RGB32_Brightness.h
     Source/Kernels/ImageFilters/RGB32_Brightness/Kernels_ImageFilter_RGB32_Brightness_Default.cpp
     Source/Kernels/ImageFilters/RGB32_Brightness/Kernels_ImageFilter_RGB32_Brightness_x64_AVX2.cpp
@@ -1030,6 +1086,13 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.h
     Source/Kernels/Waterfill/Kernels_Waterfill_Session.tpp
     Source/Kernels/Waterfill/Kernels_Waterfill_Types.h
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32.cpp
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32.h
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32_Default.cpp
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32_Routines.h
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32_arm64_NEON.cpp
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32_x64_AVX2.cpp
+    Source/Kernels/YUVToRGB32/Kernels_YUVToRGB32_x64_AVX512.cpp
     Source/ML/DataLabeling/ML_AnnotationIO.cpp
     Source/ML/DataLabeling/ML_AnnotationIO.h
     Source/ML/DataLabeling/ML_ObjectAnnotation.cpp
@@ -2425,6 +2488,8 @@ file(GLOB LIBRARY_SOURCES
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNGTable.h
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.h
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.cpp
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedSearch.h
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.h
     Source/PokemonSV/Programs/PokemonSV_AreaZero.cpp
@@ -2869,12 +2934,15 @@ file(GLOB LIBRARY_SOURCES
     Source/PokemonSwSh/ShinyHuntTracker.h
     Source/StaticRegistration.h
     Source/StaticRegistrationQt.cpp
+    Source/Tests/AllocationCounter.h
     Source/Tests/CommandLineTests.cpp
     Source/Tests/CommandLineTests.h
     Source/Tests/CommonFramework_Tests.cpp
     Source/Tests/CommonFramework_Tests.h
     Source/Tests/Kernels_Tests.cpp
     Source/Tests/Kernels_Tests.h
+    Source/Tests/ML_Tests.cpp
+    Source/Tests/ML_Tests.h
     Source/Tests/NintendoSwitch_Tests.cpp
     Source/Tests/NintendoSwitch_Tests.h
     Source/Tests/PokemonFRLG_Tests.cpp